@@ -4,10 +4,18 @@
 #include <cstddef>
 #include <fstream>
 #include <iostream>
-
+#include <memory_resource>
+#include <new>
+#include <utility>
+
+/**
+ * The nodes are taken from the given std::pmr::memory_resource, or from the
+ * global heap if no resource (nullptr) is given. Copies use the global heap.
+ */
 template <typename Comparable> class BinarySearchTree {
 public:
   BinarySearchTree() = default;
+  explicit BinarySearchTree(std::pmr::memory_resource *resource);
   BinarySearchTree(const BinarySearchTree &other);
   BinarySearchTree(BinarySearchTree &&other);
   ~BinarySearchTree();
@@ -22,6 +30,11 @@ public:
 
   size_t size() const;
 
+  /**
+   * Returns the memory resource of the tree, nullptr for the global heap
+   */
+  std::pmr::memory_resource *resource() const noexcept;
+
   /**
    * Insert x into the tree; duplicates are ignored.
    */
@@ -44,6 +57,11 @@ private:
   };
 
   BinaryNode *root = nullptr;
+  std::pmr::memory_resource *memoryResource = nullptr;
+
+  template <typename... Args> BinaryNode *createNode(Args &&...args);
+  void destroyNode(BinaryNode *t) noexcept;
+
   void insert(const Comparable &x, BinaryNode *&t);
   void insert(Comparable &&x, BinaryNode *&t);
   void remove(const Comparable &x, BinaryNode *&t);
@@ -68,6 +86,11 @@ private:
   BinaryNode *clone(BinaryNode *t) const;
 };
 
+template <typename Comparable>
+BinarySearchTree<Comparable>::BinarySearchTree(
+    std::pmr::memory_resource *resource)
+    : memoryResource{resource} {}
+
 template <typename Comparable>
 BinarySearchTree<Comparable>::BinarySearchTree(const BinarySearchTree &other) {
   root = clone(other.root);
@@ -80,16 +103,52 @@ BinarySearchTree<Comparable>::clone(BinaryNode *t) const {
     return nullptr;
   }
 
-  return new BinaryNode{t->element, clone(t->left), clone(t->right)};
+  return createNode(t->element, clone(t->left), clone(t->right));
 }
 
 template <typename Comparable>
 BinarySearchTree<Comparable>::BinarySearchTree(BinarySearchTree &&other) {
   // 'steal'
   this->root = other.root;
+  this->memoryResource = other.memoryResource;
   other.root = nullptr;
 }
 
+template <typename Comparable>
+std::pmr::memory_resource *
+BinarySearchTree<Comparable>::resource() const noexcept {
+  return memoryResource;
+}
+
+template <typename Comparable>
+template <typename... Args>
+typename BinarySearchTree<Comparable>::BinaryNode *
+BinarySearchTree<Comparable>::createNode(Args &&...args) {
+  if (!memoryResource) {
+    return new BinaryNode{std::forward<Args>(args)...};
+  }
+
+  void *memory =
+      memoryResource->allocate(sizeof(BinaryNode), alignof(BinaryNode));
+  try {
+    return ::new (memory) BinaryNode{std::forward<Args>(args)...};
+  } catch (...) {
+    memoryResource->deallocate(memory, sizeof(BinaryNode), alignof(BinaryNode));
+    throw;
+  }
+}
+
+template <typename Comparable>
+void BinarySearchTree<Comparable>::destroyNode(BinaryNode *t) noexcept {
+  if (!memoryResource) {
+    delete t;
+    return;
+  }
+
+  t->~BinaryNode();
+  memoryResource->deallocate(t, sizeof(BinaryNode), alignof(BinaryNode));
+}
+
 template <typename Comparable>
 void BinarySearchTree<Comparable>::printDot(std::string fileName) const {
   std::ofstream ofs{fileName};
@@ -145,7 +204,7 @@ void BinarySearchTree<Comparable>::remove(const Comparable &x, BinaryNode *&t) {
   } else {
     BinaryNode *oldNode = t;
     t = (t->left != nullptr) ? t->left : t->right;
-    delete oldNode;
+    destroyNode(oldNode);
   }
 }
 
@@ -208,7 +267,7 @@ void BinarySearchTree<Comparable>::insert(const Comparable &x) {
 template <typename Comparable>
 void BinarySearchTree<Comparable>::insert(const Comparable &x, BinaryNode *&t) {
   if (!t) {
-    t = new BinaryNode{x, nullptr, nullptr};
+    t = createNode(x, nullptr, nullptr);
   } else if (x < t->element) {
     insert(x, t->left);
   } else if (x > t->element) {
@@ -226,7 +285,7 @@ void BinarySearchTree<Comparable>::insert(Comparable &&x) {
 template <typename Comparable>
 void BinarySearchTree<Comparable>::insert(Comparable &&x, BinaryNode *&t) {
   if (!t)
-    t = new BinaryNode{std::move(x), nullptr, nullptr};
+    t = createNode(std::move(x), nullptr, nullptr);
   else if (x < t->element) {
     insert(std::move(x), t->left);
   } else if (t->element < x) {
@@ -273,7 +332,7 @@ void BinarySearchTree<Comparable>::makeEmpty(BinaryNode *&t) {
   if (t != nullptr) {
     makeEmpty(t->left);
     makeEmpty(t->right);
-    delete t;
+    destroyNode(t);
     t = nullptr;
   }
 }
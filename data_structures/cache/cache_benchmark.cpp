@@ -0,0 +1,262 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "lru_cache.h"
+#include "sharded_cache.h"
+#include "two_queue_cache.h"
+
+/*
+Caches replaying traces of keys, where every miss is followed by a put of the
+key, as in front of an expensive query.
+
+1. A Zipfian trace: key k out of the given number of keys is drawn with a
+   probability proportional to 1 / k^0.99, as in the YCSB benchmarks.
+
+2. The same trace with a scan mixed in: every 4th access is the next key of a
+   sequential scan over keys which are used only once.
+
+The caches are LruCache, TwoQueueCache and the usual LRU cache made of a
+std::list and a std::unordered_map of list iterators, each with a capacity of
+a tenth of the keys.
+
+3. The Zipfian trace split between the given number of threads, against a
+   ShardedCache of LruCaches and against a single LruCache behind one mutex.
+
+Run:
+$> ./cache_benchmark [accesses] [keys] [threads]
+*/
+
+namespace {
+
+struct Random {
+  std::uint64_t state = 88172645463325252ull;
+
+  std::uint64_t next() {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+  }
+
+  double uniform() { return (next() >> 11) * 0x1.0p-53; }
+};
+
+std::vector<std::uint64_t> zipfianTrace(size_t accesses, size_t keys) {
+  constexpr double EXPONENT = 0.99;
+  std::vector<double> cumulative(keys);
+  double sum = 0;
+  for (size_t k = 0; k < keys; k++) {
+    sum += 1 / std::pow(static_cast<double>(k + 1), EXPONENT);
+    cumulative[k] = sum;
+  }
+
+  Random random;
+  std::vector<std::uint64_t> trace(accesses);
+  for (auto &key : trace) {
+    const double u = random.uniform() * sum;
+    const auto rank =
+        std::lower_bound(cumulative.begin(), cumulative.end(), u) -
+        cumulative.begin();
+    // scatters the ranks, so that the hot keys are not also the small ones,
+    // into even keys, which differ for ranks below 2^63
+    key = static_cast<std::uint64_t>(rank) * 0x9E3779B97F4A7C15ull << 1;
+  }
+
+  return trace;
+}
+
+std::vector<std::uint64_t> withScan(std::vector<std::uint64_t> trace) {
+  std::uint64_t scanned = 0;
+  for (size_t i = 3; i < trace.size(); i += 4) {
+    // odd keys, unlike all Zipfian ones
+    trace[i] = (scanned++ << 1) | 1;
+  }
+
+  return trace;
+}
+
+/**
+ * The LRU cache which is written again and again: a list in order of use and
+ * a hash map of list iterators
+ */
+class ListLruCache {
+ public:
+  explicit ListLruCache(size_t capacity) : m_capacity{capacity} {
+    m_index.reserve(capacity);
+  }
+
+  std::string *get(std::uint64_t key) {
+    auto found = m_index.find(key);
+    if (found == m_index.end()) {
+      return nullptr;
+    }
+
+    m_byUse.splice(m_byUse.end(), m_byUse, found->second);
+    return &found->second->second;
+  }
+
+  void put(std::uint64_t key, std::string value) {
+    if (m_byUse.size() == m_capacity) {
+      m_index.erase(m_byUse.front().first);
+      m_byUse.pop_front();
+    }
+
+    m_byUse.emplace_back(key, std::move(value));
+    m_index[key] = std::prev(m_byUse.end());
+  }
+
+ private:
+  using Entry = std::pair<std::uint64_t, std::string>;
+
+  size_t m_capacity;
+  std::list<Entry> m_byUse;
+  std::unordered_map<std::uint64_t, std::list<Entry>::iterator> m_index;
+};
+
+struct Result {
+  double hitRatio;
+  double millionAccessesPerSecond;
+};
+
+template <typename Cache>
+Result replay(Cache &cache, const std::vector<std::uint64_t> &trace) {
+  size_t hits = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (std::uint64_t key : trace) {
+    if (cache.get(key)) {
+      hits++;
+    } else {
+      cache.put(key, "the result of an expensive query");
+    }
+  }
+  const auto end = std::chrono::steady_clock::now();
+
+  const double seconds = std::chrono::duration<double>(end - start).count();
+  return {static_cast<double>(hits) / trace.size(),
+          trace.size() / seconds / 1e6};
+}
+
+void report(const char *name, Result result) {
+  std::cout << "  " << name << ": hit ratio " << result.hitRatio << ", "
+            << result.millionAccessesPerSecond << " M accesses/s\n";
+}
+
+void compareCaches(const std::vector<std::uint64_t> &trace, size_t capacity) {
+  {
+    ListLruCache cache{capacity};
+    report("std::list + std::unordered_map LRU", replay(cache, trace));
+  }
+  {
+    LruCache<std::uint64_t, std::string> cache{capacity};
+    report("LruCache", replay(cache, trace));
+  }
+  {
+    TwoQueueCache<std::uint64_t, std::string> cache{capacity};
+    report("TwoQueueCache", replay(cache, trace));
+  }
+}
+
+/**
+ * LruCache behind a single mutex, with the interface of ShardedCache
+ */
+class LockedLruCache {
+ public:
+  explicit LockedLruCache(size_t capacity) : m_cache{capacity} {}
+
+  std::optional<std::string> get(std::uint64_t key) {
+    std::lock_guard lock{m_mutex};
+    if (std::string *value = m_cache.get(key)) {
+      return *value;
+    }
+    return std::nullopt;
+  }
+
+  void put(std::uint64_t key, std::string value) {
+    std::lock_guard lock{m_mutex};
+    m_cache.put(key, std::move(value));
+  }
+
+ private:
+  std::mutex m_mutex;
+  LruCache<std::uint64_t, std::string> m_cache;
+};
+
+template <typename Cache>
+Result replayConcurrently(Cache &cache,
+                          const std::vector<std::uint64_t> &trace,
+                          size_t threadCount) {
+  std::vector<size_t> hits(threadCount);
+  std::vector<std::thread> threads;
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t t = 0; t < threadCount; t++) {
+    threads.emplace_back([&, t] {
+      size_t threadHits = 0;
+      for (size_t i = t; i < trace.size(); i += threadCount) {
+        if (cache.get(trace[i])) {
+          threadHits++;
+        } else {
+          cache.put(trace[i], "the result of an expensive query");
+        }
+      }
+      hits[t] = threadHits;
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  const auto end = std::chrono::steady_clock::now();
+
+  const double seconds = std::chrono::duration<double>(end - start).count();
+  size_t totalHits = 0;
+  for (size_t threadHits : hits) {
+    totalHits += threadHits;
+  }
+  return {static_cast<double>(totalHits) / trace.size(),
+          trace.size() / seconds / 1e6};
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  const size_t accesses =
+      argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+  const size_t keys =
+      argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1'000'000;
+  const size_t threadCount =
+      argc > 3 ? std::strtoull(argv[3], nullptr, 10)
+               : std::max(4u, std::thread::hardware_concurrency());
+  const size_t capacity = std::max<size_t>(1, keys / 10);
+
+  const std::vector<std::uint64_t> zipfian = zipfianTrace(accesses, keys);
+  std::cout << accesses << " Zipfian accesses to " << keys
+            << " keys, capacity " << capacity << '\n';
+  compareCaches(zipfian, capacity);
+
+  std::cout << "The same with every 4th access a key of a scan\n";
+  compareCaches(withScan(zipfian), capacity);
+
+  std::cout << "Zipfian accesses from " << threadCount << " threads\n";
+  {
+    LockedLruCache cache{capacity};
+    report("LruCache behind one mutex",
+           replayConcurrently(cache, zipfian, threadCount));
+  }
+  {
+    ShardedCache<LruCache<std::uint64_t, std::string>> cache{capacity};
+    report("ShardedCache of LruCaches",
+           replayConcurrently(cache, zipfian, threadCount));
+  }
+
+  return 0;
+}
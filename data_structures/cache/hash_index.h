@@ -0,0 +1,160 @@
+#ifndef HASH_INDEX_H
+#define HASH_INDEX_H
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+/**
+ * Open addressing hash table which maps keys to entries owned by somebody
+ * else: every entry has a member key, and the table stores a pointer to the
+ * entry together with the hash of its key.
+ *
+ * The table holds up to the maximum number of entries given to the
+ * constructor, which allocates all slots at once, at most half of them full;
+ * nothing is allocated or rehashed afterwards. Collisions are resolved by
+ * linear probing, so a lookup reads consecutive slots and compares stored
+ * hashes before it touches an entry. Erasing shifts the following entries of
+ * the cluster back instead of leaving tombstones, so lookups never slow down
+ * with churn.
+ *
+ * The hash is multiplied by 2^64 / golden ratio and the upper bits pick the
+ * slot, so keys with regular low bits, e.g. multiples of 1024, spread out
+ * even with an identity hash like std::hash<int>.
+ */
+template <typename K, typename Entry, typename Hash = std::hash<K>,
+          typename KeyEqual = std::equal_to<K>>
+class HashIndex {
+ public:
+  explicit HashIndex(size_t maxEntries, const Hash &hash = Hash{},
+                     const KeyEqual &equal = KeyEqual{});
+
+  HashIndex(const HashIndex &) = delete;
+  HashIndex &operator=(const HashIndex &) = delete;
+
+  /**
+   * Returns the entry with the given key, nullptr if there is none.
+   * O(1) expected time complexity
+   */
+  Entry *find(const K &key) const;
+
+  /**
+   * Adds the entry under its key, which must not be in the table yet. The
+   * table must have fewer than maxEntries() entries.
+   * O(1) expected time complexity
+   */
+  void insert(Entry *entry);
+
+  /**
+   * Removes the given entry, which must be in the table.
+   * O(1) expected time complexity
+   */
+  void erase(const Entry *entry);
+
+  size_t size() const noexcept { return m_size; }
+  size_t maxEntries() const noexcept { return m_maxEntries; }
+
+ private:
+  struct Slot {
+    uint64_t hash;
+    Entry *entry;  // nullptr if the slot is empty
+  };
+
+  uint64_t hashOf(const K &key) const {
+    return static_cast<uint64_t>(m_hash(key)) * 0x9E3779B97F4A7C15ull;
+  }
+
+  size_t home(uint64_t hash) const {
+    return static_cast<size_t>(hash >> m_shift);
+  }
+
+  size_t slotOf(const Entry *entry) const;
+
+  const size_t m_maxEntries;
+  const size_t m_mask;
+  const int m_shift;
+  const std::unique_ptr<Slot[]> m_slots;
+  size_t m_size = 0;
+  Hash m_hash;
+  KeyEqual m_equal;
+};
+
+namespace hash_index_detail {
+
+inline size_t slotCount(size_t maxEntries) {
+  return std::max<size_t>(8,
+                          std::bit_ceil(2 * std::max<size_t>(1, maxEntries)));
+}
+
+}  // namespace hash_index_detail
+
+template <typename K, typename Entry, typename Hash, typename KeyEqual>
+HashIndex<K, Entry, Hash, KeyEqual>::HashIndex(size_t maxEntries,
+                                               const Hash &hash,
+                                               const KeyEqual &equal)
+    : m_maxEntries{maxEntries},
+      m_mask{hash_index_detail::slotCount(maxEntries) - 1},
+      m_shift{64 - std::countr_zero(m_mask + 1)},
+      m_slots{new Slot[m_mask + 1]{}},
+      m_hash{hash},
+      m_equal{equal} {}
+
+template <typename K, typename Entry, typename Hash, typename KeyEqual>
+Entry *HashIndex<K, Entry, Hash, KeyEqual>::find(const K &key) const {
+  const uint64_t hash = hashOf(key);
+  for (size_t i = home(hash);; i = (i + 1) & m_mask) {
+    const Slot &slot = m_slots[i];
+    if (!slot.entry) {
+      return nullptr;
+    }
+    if (slot.hash == hash && m_equal(slot.entry->key, key)) {
+      return slot.entry;
+    }
+  }
+}
+
+template <typename K, typename Entry, typename Hash, typename KeyEqual>
+void HashIndex<K, Entry, Hash, KeyEqual>::insert(Entry *entry) {
+  const uint64_t hash = hashOf(entry->key);
+  size_t i = home(hash);
+  while (m_slots[i].entry) {
+    i = (i + 1) & m_mask;
+  }
+
+  m_slots[i] = Slot{hash, entry};
+  ++m_size;
+}
+
+template <typename K, typename Entry, typename Hash, typename KeyEqual>
+void HashIndex<K, Entry, Hash, KeyEqual>::erase(const Entry *entry) {
+  size_t hole = slotOf(entry);
+  for (size_t i = (hole + 1) & m_mask; m_slots[i].entry;
+       i = (i + 1) & m_mask) {
+    // an entry may fill the hole unless its home lies between the hole and
+    // its slot, where a lookup would then stop at the hole before it
+    const size_t distanceFromHome = (i - home(m_slots[i].hash)) & m_mask;
+    const size_t distanceFromHole = (i - hole) & m_mask;
+    if (distanceFromHome >= distanceFromHole) {
+      m_slots[hole] = m_slots[i];
+      hole = i;
+    }
+  }
+
+  m_slots[hole] = Slot{};
+  --m_size;
+}
+
+template <typename K, typename Entry, typename Hash, typename KeyEqual>
+size_t HashIndex<K, Entry, Hash, KeyEqual>::slotOf(const Entry *entry) const {
+  size_t i = home(hashOf(entry->key));
+  while (m_slots[i].entry != entry) {
+    i = (i + 1) & m_mask;
+  }
+
+  return i;
+}
+
+#endif
@@ -0,0 +1,220 @@
+#ifndef LRU_CACHE_H
+#define LRU_CACHE_H
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "../doubly_linked_list/intrusive_list.h"
+#include "hash_index.h"
+
+struct CacheStats {
+  size_t hits = 0;       // lookups which found their key
+  size_t misses = 0;     // lookups which did not
+  size_t evictions = 0;  // values dropped to make room for others
+};
+
+namespace cache_detail {
+
+/**
+ * A key and its value, on exactly one list of its cache at a time: a queue
+ * of the cache policy, or the list of free entries. A ghost entry of
+ * TwoQueueCache remembers a key without a value.
+ */
+template <typename K, typename V>
+struct CacheEntry {
+  explicit CacheEntry(const K &k) : key{k} {}
+
+  K key;
+  std::optional<V> value;
+  IntrusiveListHook hook;
+  unsigned char queue = 0;  // which list of the policy the entry is on
+};
+
+/**
+ * The entries of a cache, which are all allocated by the constructor and
+ * then recycled, and the HashIndex which finds them by key.
+ */
+template <typename K, typename V, typename Hash>
+class EntryTable {
+ public:
+  using Entry = CacheEntry<K, V>;
+
+  EntryTable(size_t maxEntries, const Hash &hash)
+      : m_index{maxEntries, hash} {
+    m_entries.reserve(maxEntries);
+  }
+
+  EntryTable(const EntryTable &) = delete;
+  EntryTable &operator=(const EntryTable &) = delete;
+
+  Entry *find(const K &key) const { return m_index.find(key); }
+
+  /**
+   * Returns an entry for key, which must not be in the table, without a
+   * value and on no list. The table must have fewer than maxEntries entries.
+   */
+  Entry &acquire(const K &key) {
+    Entry *entry;
+    if (!m_free.empty()) {
+      entry = &m_free.front();
+      m_free.pop_front();
+      entry->key = key;
+    } else {
+      // never reallocates, as the capacity is reserved
+      entry = &m_entries.emplace_back(key);
+    }
+
+    m_index.insert(entry);
+    return *entry;
+  }
+
+  /**
+   * Drops the key and the value of an entry, which must be on no list
+   */
+  void release(Entry &entry) {
+    m_index.erase(&entry);
+    entry.value.reset();
+    m_free.push_back(entry);
+  }
+
+ private:
+  std::vector<Entry> m_entries;
+  IntrusiveList<Entry, &Entry::hook> m_free;
+  HashIndex<K, Entry, Hash> m_index;
+};
+
+inline size_t checkedCapacity(size_t capacity) {
+  if (capacity == 0) {
+    throw std::invalid_argument{"Capacity must be positive."};
+  }
+
+  return capacity;
+}
+
+}  // namespace cache_detail
+
+/**
+ * Cache of up to capacity() values which evicts the least recently used one
+ * to make room for a new one.
+ *
+ * The entries are on an IntrusiveList in order of use, found through a
+ * HashIndex, and all of them are allocated by the constructor, so get, put
+ * and the eviction are O(1) and allocate nothing beyond what copying a key or
+ * value allocates. The cache is not thread safe; see ShardedCache.
+ */
+template <typename K, typename V, typename Hash = std::hash<K>>
+class LruCache {
+ public:
+  using key_type = K;
+  using mapped_type = V;
+  using hasher = Hash;
+
+  /**
+   * Throws exception if capacity is 0.
+   * @throw std::invalid_argument
+   */
+  explicit LruCache(size_t capacity, const Hash &hash = Hash{});
+
+  /**
+   * Returns the value of key, nullptr on a miss, and makes it the most
+   * recently used one. The pointer is valid until the next put or erase.
+   * O(1) time complexity
+   */
+  V *get(const K &key);
+
+  /**
+   * Returns whether key is cached, without counting a hit or a miss or
+   * changing the order of use
+   */
+  bool contains(const K &key) const { return m_table.find(key) != nullptr; }
+
+  /**
+   * Sets the value of key and makes it the most recently used one, evicting
+   * the least recently used value if key is new and the cache is full. If
+   * moving the value of a new key throws, the key is not cached, though a
+   * value may have been evicted for it.
+   * O(1) time complexity
+   */
+  void put(const K &key, V value);
+
+  /**
+   * Removes key, returning whether it was cached.
+   * O(1) time complexity
+   */
+  bool erase(const K &key);
+
+  size_t size() const noexcept { return m_byUse.size(); }
+  size_t capacity() const noexcept { return m_capacity; }
+  CacheStats stats() const noexcept { return m_stats; }
+
+ private:
+  using Entry = cache_detail::CacheEntry<K, V>;
+
+  const size_t m_capacity;
+  cache_detail::EntryTable<K, V, Hash> m_table;
+  // least recently used first
+  IntrusiveList<Entry, &Entry::hook> m_byUse;
+  CacheStats m_stats;
+};
+
+template <typename K, typename V, typename Hash>
+LruCache<K, V, Hash>::LruCache(size_t capacity, const Hash &hash)
+    : m_capacity{cache_detail::checkedCapacity(capacity)},
+      m_table{capacity, hash} {}
+
+template <typename K, typename V, typename Hash>
+V *LruCache<K, V, Hash>::get(const K &key) {
+  Entry *entry = m_table.find(key);
+  if (!entry) {
+    ++m_stats.misses;
+    return nullptr;
+  }
+
+  ++m_stats.hits;
+  m_byUse.splice(m_byUse.cend(), m_byUse, *entry);
+  return &*entry->value;
+}
+
+template <typename K, typename V, typename Hash>
+void LruCache<K, V, Hash>::put(const K &key, V value) {
+  if (Entry *entry = m_table.find(key)) {
+    entry->value = std::move(value);
+    m_byUse.splice(m_byUse.cend(), m_byUse, *entry);
+    return;
+  }
+
+  if (size() == m_capacity) {
+    Entry &evicted = m_byUse.front();
+    m_byUse.pop_front();
+    m_table.release(evicted);
+    ++m_stats.evictions;
+  }
+
+  Entry &entry = m_table.acquire(key);
+  try {
+    entry.value.emplace(std::move(value));
+  } catch (...) {
+    // the key must not stay in the index without a value
+    m_table.release(entry);
+    throw;
+  }
+  m_byUse.push_back(entry);
+}
+
+template <typename K, typename V, typename Hash>
+bool LruCache<K, V, Hash>::erase(const K &key) {
+  Entry *entry = m_table.find(key);
+  if (!entry) {
+    return false;
+  }
+
+  m_byUse.erase(*entry);
+  m_table.release(*entry);
+  return true;
+}
+
+#endif
@@ -0,0 +1,170 @@
+#ifndef SHARDED_CACHE_H
+#define SHARDED_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "lru_cache.h"
+
+/**
+ * Thread safe cache made of shardCount() caches of type Cache (LruCache or
+ * TwoQueueCache), each with a mutex of its own. A key always goes to the
+ * same shard, picked by its hash, so threads which work on different keys
+ * rarely wait for each other, where a single cache behind one mutex lets
+ * only one thread in at a time.
+ *
+ * Every shard has an equal part of the capacity and evicts on its own, so
+ * the policy is applied per shard: the evicted value is the least recently
+ * used one of its shard, not necessarily of the whole cache. get returns a
+ * copy of the value, as a pointer into a shard would not be safe once its
+ * mutex is released.
+ */
+template <typename Cache>
+class ShardedCache {
+ public:
+  using key_type = typename Cache::key_type;
+  using mapped_type = typename Cache::mapped_type;
+  using hasher = typename Cache::hasher;
+
+  static constexpr size_t DEFAULT_SHARD_COUNT = 16;
+
+  /**
+   * Splits capacity among shardCount shards. Throws exception if shardCount
+   * is 0 or capacity is less than shardCount.
+   * @throw std::invalid_argument
+   */
+  explicit ShardedCache(size_t capacity,
+                        size_t shardCount = DEFAULT_SHARD_COUNT,
+                        const hasher &hash = hasher{});
+
+  /**
+   * Returns a copy of the value of key, std::nullopt on a miss
+   */
+  std::optional<mapped_type> get(const key_type &key);
+
+  void put(const key_type &key, mapped_type value);
+
+  bool erase(const key_type &key);
+
+  size_t size() const;
+  size_t capacity() const noexcept { return m_capacity; }
+  size_t shardCount() const noexcept { return m_shards.size(); }
+
+  /**
+   * Returns the sums of the counters of all shards
+   */
+  CacheStats stats() const;
+
+ private:
+  // a cache line each, so that the mutexes of different shards are not
+  // contended by false sharing
+  struct alignas(64) Shard {
+    Shard(size_t capacity, const hasher &hash) : cache{capacity, hash} {}
+
+    mutable std::mutex mutex;
+    Cache cache;
+  };
+
+  Shard &shardOf(const key_type &key);
+
+  const size_t m_capacity;
+  hasher m_hash;
+  std::vector<std::unique_ptr<Shard>> m_shards;
+};
+
+namespace sharded_cache_detail {
+
+inline size_t checkedShardCount(size_t capacity, size_t shardCount) {
+  if (shardCount == 0 || capacity < shardCount) {
+    throw std::invalid_argument{
+        "Every shard must have a positive capacity."};
+  }
+
+  return shardCount;
+}
+
+}  // namespace sharded_cache_detail
+
+template <typename Cache>
+ShardedCache<Cache>::ShardedCache(size_t capacity, size_t shardCount,
+                                  const hasher &hash)
+    : m_capacity{capacity}, m_hash{hash} {
+  sharded_cache_detail::checkedShardCount(capacity, shardCount);
+  for (size_t i = 0; i < shardCount; i++) {
+    // the first capacity % shardCount shards get one more
+    const size_t shardCapacity =
+        capacity / shardCount + (i < capacity % shardCount ? 1 : 0);
+    m_shards.push_back(std::make_unique<Shard>(shardCapacity, hash));
+  }
+}
+
+template <typename Cache>
+auto ShardedCache<Cache>::get(const key_type &key)
+    -> std::optional<mapped_type> {
+  Shard &shard = shardOf(key);
+  std::lock_guard lock{shard.mutex};
+  if (mapped_type *value = shard.cache.get(key)) {
+    return *value;
+  }
+
+  return std::nullopt;
+}
+
+template <typename Cache>
+void ShardedCache<Cache>::put(const key_type &key, mapped_type value) {
+  Shard &shard = shardOf(key);
+  std::lock_guard lock{shard.mutex};
+  shard.cache.put(key, std::move(value));
+}
+
+template <typename Cache>
+bool ShardedCache<Cache>::erase(const key_type &key) {
+  Shard &shard = shardOf(key);
+  std::lock_guard lock{shard.mutex};
+  return shard.cache.erase(key);
+}
+
+template <typename Cache>
+size_t ShardedCache<Cache>::size() const {
+  size_t result = 0;
+  for (const auto &shard : m_shards) {
+    std::lock_guard lock{shard->mutex};
+    result += shard->cache.size();
+  }
+
+  return result;
+}
+
+template <typename Cache>
+CacheStats ShardedCache<Cache>::stats() const {
+  CacheStats result;
+  for (const auto &shard : m_shards) {
+    std::lock_guard lock{shard->mutex};
+    const CacheStats stats = shard->cache.stats();
+    result.hits += stats.hits;
+    result.misses += stats.misses;
+    result.evictions += stats.evictions;
+  }
+
+  return result;
+}
+
+template <typename Cache>
+auto ShardedCache<Cache>::shardOf(const key_type &key) -> Shard & {
+  // The shard caches pick slots by the upper bits of the hash times the
+  // golden ratio; the shard is picked by a different mix (the finalizer of
+  // splitmix64), so that the keys of a shard still spread over its slots
+  auto hash = static_cast<uint64_t>(m_hash(key));
+  hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ull;
+  hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBull;
+  hash ^= hash >> 31;
+  return *m_shards[hash % m_shards.size()];
+}
+
+#endif
@@ -0,0 +1,217 @@
+#ifndef TWO_QUEUE_CACHE_H
+#define TWO_QUEUE_CACHE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <utility>
+
+#include "lru_cache.h"
+
+/**
+ * Cache of up to capacity() values with the scan resistant 2Q policy of
+ * T. Johnson and D. Shasha.
+ *
+ * A new key enters a FIFO queue of recent values, about a quarter of the
+ * capacity. A value evicted from there leaves its key behind in a FIFO queue
+ * of ghosts, which remembers the keys of about half the capacity. Only a key
+ * which is put again while it is a ghost - one which was wanted twice within
+ * a while - gets into the main queue, an LRU list which holds the rest of the
+ * capacity. A scan of many keys which are used once therefore flushes only
+ * the queue of recent values and leaves the frequently used values alone,
+ * where an LruCache loses all of them.
+ *
+ * As in LruCache, the entries, ghosts included, are allocated by the
+ * constructor and found through a HashIndex; all operations are O(1). The
+ * cache is not thread safe; see ShardedCache.
+ */
+template <typename K, typename V, typename Hash = std::hash<K>>
+class TwoQueueCache {
+ public:
+  using key_type = K;
+  using mapped_type = V;
+  using hasher = Hash;
+
+  /**
+   * Throws exception if capacity is 0.
+   * @throw std::invalid_argument
+   */
+  explicit TwoQueueCache(size_t capacity, const Hash &hash = Hash{});
+
+  /**
+   * Returns the value of key, nullptr on a miss. A hit in the main queue
+   * makes the value its most recently used one; a hit in the queue of recent
+   * values changes nothing. The pointer is valid until the next put or erase.
+   * O(1) time complexity
+   */
+  V *get(const K &key);
+
+  /**
+   * Returns whether a value of key is cached, without counting a hit or a
+   * miss or changing the queues
+   */
+  bool contains(const K &key) const;
+
+  /**
+   * Sets the value of key, evicting a value if key is new and the cache is
+   * full. A key which is a ghost goes to the main queue, any other new key
+   * to the queue of recent values. If moving the value of a new key throws,
+   * the key is neither cached nor a ghost, though a value may have been
+   * evicted for it.
+   * O(1) time complexity
+   */
+  void put(const K &key, V value);
+
+  /**
+   * Removes the value of key (and forgets it as a ghost), returning whether
+   * a value was cached.
+   * O(1) time complexity
+   */
+  bool erase(const K &key);
+
+  size_t size() const noexcept { return m_recent.size() + m_frequent.size(); }
+  size_t capacity() const noexcept { return m_capacity; }
+  CacheStats stats() const noexcept { return m_stats; }
+
+ private:
+  using Entry = cache_detail::CacheEntry<K, V>;
+  using Queue = IntrusiveList<Entry, &Entry::hook>;
+
+  enum : unsigned char { RECENT, GHOST, FREQUENT };
+
+  static size_t recentCapacity(size_t capacity) {
+    return std::max<size_t>(1, capacity / 4);
+  }
+  static size_t ghostCapacity(size_t capacity) {
+    return std::max<size_t>(1, capacity / 2);
+  }
+
+  Queue &queueOf(const Entry &entry) {
+    return entry.queue == RECENT ? m_recent
+                                 : entry.queue == GHOST ? m_ghosts : m_frequent;
+  }
+
+  // Evicts a value if the cache is full
+  void makeRoom();
+
+  const size_t m_capacity;
+  const size_t m_recentCapacity;
+  const size_t m_ghostCapacity;
+  cache_detail::EntryTable<K, V, Hash> m_table;
+  // oldest first
+  Queue m_recent;
+  Queue m_ghosts;
+  // least recently used first
+  Queue m_frequent;
+  CacheStats m_stats;
+};
+
+template <typename K, typename V, typename Hash>
+TwoQueueCache<K, V, Hash>::TwoQueueCache(size_t capacity, const Hash &hash)
+    : m_capacity{cache_detail::checkedCapacity(capacity)},
+      m_recentCapacity{recentCapacity(capacity)},
+      m_ghostCapacity{ghostCapacity(capacity)},
+      m_table{capacity + ghostCapacity(capacity), hash} {}
+
+template <typename K, typename V, typename Hash>
+V *TwoQueueCache<K, V, Hash>::get(const K &key) {
+  Entry *entry = m_table.find(key);
+  if (!entry || entry->queue == GHOST) {
+    ++m_stats.misses;
+    return nullptr;
+  }
+
+  ++m_stats.hits;
+  if (entry->queue == FREQUENT) {
+    m_frequent.splice(m_frequent.cend(), m_frequent, *entry);
+  }
+  return &*entry->value;
+}
+
+template <typename K, typename V, typename Hash>
+bool TwoQueueCache<K, V, Hash>::contains(const K &key) const {
+  const Entry *entry = m_table.find(key);
+  return entry && entry->queue != GHOST;
+}
+
+template <typename K, typename V, typename Hash>
+void TwoQueueCache<K, V, Hash>::put(const K &key, V value) {
+  Entry *entry = m_table.find(key);
+  if (entry && entry->queue != GHOST) {
+    entry->value = std::move(value);
+    if (entry->queue == FREQUENT) {
+      m_frequent.splice(m_frequent.cend(), m_frequent, *entry);
+    }
+    return;
+  }
+
+  if (entry) {
+    // taken off the ghosts first, so that making room cannot drop it
+    m_ghosts.erase(*entry);
+    makeRoom();
+    try {
+      entry->value.emplace(std::move(value));
+    } catch (...) {
+      // the entry is on no queue any more, so the ghost is forgotten
+      m_table.release(*entry);
+      throw;
+    }
+    entry->queue = FREQUENT;
+    m_frequent.push_back(*entry);
+    return;
+  }
+
+  makeRoom();
+  Entry &added = m_table.acquire(key);
+  try {
+    added.value.emplace(std::move(value));
+  } catch (...) {
+    m_table.release(added);
+    throw;
+  }
+  added.queue = RECENT;
+  m_recent.push_back(added);
+}
+
+template <typename K, typename V, typename Hash>
+bool TwoQueueCache<K, V, Hash>::erase(const K &key) {
+  Entry *entry = m_table.find(key);
+  if (!entry) {
+    return false;
+  }
+
+  const bool cached = entry->queue != GHOST;
+  queueOf(*entry).erase(*entry);
+  m_table.release(*entry);
+  return cached;
+}
+
+template <typename K, typename V, typename Hash>
+void TwoQueueCache<K, V, Hash>::makeRoom() {
+  if (size() < m_capacity) {
+    return;
+  }
+
+  ++m_stats.evictions;
+  if (m_recent.size() >= m_recentCapacity || m_frequent.empty()) {
+    // the oldest recent value becomes a ghost
+    Entry &evicted = m_recent.front();
+    m_recent.pop_front();
+    evicted.value.reset();
+    evicted.queue = GHOST;
+    m_ghosts.push_back(evicted);
+
+    if (m_ghosts.size() > m_ghostCapacity) {
+      Entry &forgotten = m_ghosts.front();
+      m_ghosts.pop_front();
+      m_table.release(forgotten);
+    }
+    return;
+  }
+
+  Entry &evicted = m_frequent.front();
+  m_frequent.pop_front();
+  m_table.release(evicted);
+}
+
+#endif
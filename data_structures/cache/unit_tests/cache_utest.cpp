@@ -0,0 +1,288 @@
+#include "catch.hpp"
+#include "hash_index.h"
+#include "lru_cache.h"
+#include "sharded_cache.h"
+#include "two_queue_cache.h"
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Item {
+  int key;
+};
+
+// Throws from its move constructor while throwOnMove is set
+struct ThrowingValue {
+  static inline bool throwOnMove = false;
+
+  ThrowingValue(int v) : value{v} {}
+  ThrowingValue(ThrowingValue &&other) : value{other.value} {
+    if (throwOnMove) {
+      throw std::runtime_error{"move"};
+    }
+  }
+  ThrowingValue &operator=(ThrowingValue &&other) = default;
+
+  int value;
+};
+
+// Sends every key to the same few slots
+struct CollidingHash {
+  size_t operator()(int key) const { return static_cast<size_t>(key % 3); }
+};
+
+}  // namespace
+
+TEST_CASE("Hash index finds, inserts and erases entries") {
+  std::vector<Item> items;
+  for (int i = 0; i < 1000; i++) {
+    items.push_back(Item{i * 1024});
+  }
+
+  HashIndex<int, Item> index{items.size()};
+  for (Item &item : items) {
+    index.insert(&item);
+  }
+  REQUIRE(index.size() == 1000);
+
+  for (Item &item : items) {
+    REQUIRE(index.find(item.key) == &item);
+  }
+  REQUIRE(index.find(1) == nullptr);
+
+  for (size_t i = 0; i < items.size(); i += 2) {
+    index.erase(&items[i]);
+  }
+  REQUIRE(index.size() == 500);
+  for (size_t i = 0; i < items.size(); i++) {
+    REQUIRE(index.find(items[i].key) == (i % 2 ? &items[i] : nullptr));
+  }
+}
+
+TEST_CASE("Hash index keeps colliding keys findable after erasures") {
+  std::vector<Item> items;
+  for (int i = 0; i < 60; i++) {
+    items.push_back(Item{i});
+  }
+
+  HashIndex<int, Item, CollidingHash> index{items.size()};
+  for (Item &item : items) {
+    index.insert(&item);
+  }
+
+  // erases from the middle of the clusters, then reinserts
+  std::vector<bool> erased(items.size());
+  for (int round = 0; round < 3; round++) {
+    for (size_t i = round; i < items.size(); i += 3) {
+      index.erase(&items[i]);
+      erased[i] = true;
+      for (size_t j = 0; j < items.size(); j++) {
+        REQUIRE(index.find(items[j].key) == (erased[j] ? nullptr : &items[j]));
+      }
+    }
+  }
+  REQUIRE(index.size() == 0);
+
+  for (Item &item : items) {
+    index.insert(&item);
+  }
+  for (Item &item : items) {
+    REQUIRE(index.find(item.key) == &item);
+  }
+}
+
+TEST_CASE("Cache capacity must be positive") {
+  REQUIRE_THROWS_AS((LruCache<int, int>{0}), std::invalid_argument);
+  REQUIRE_THROWS_AS((TwoQueueCache<int, int>{0}), std::invalid_argument);
+  REQUIRE_THROWS_AS((ShardedCache<LruCache<int, int>>{4, 8}),
+                    std::invalid_argument);
+}
+
+TEST_CASE("LRU cache evicts the least recently used value") {
+  LruCache<int, std::string> cache{3};
+  cache.put(1, "one");
+  cache.put(2, "two");
+  cache.put(3, "three");
+  REQUIRE(cache.size() == 3);
+
+  REQUIRE(*cache.get(1) == "one");
+  cache.put(4, "four");
+  REQUIRE(cache.contains(1));
+  REQUIRE(!cache.contains(2));
+  REQUIRE(cache.get(2) == nullptr);
+
+  // an update counts as a use
+  cache.put(3, "THREE");
+  cache.put(5, "five");
+  REQUIRE(!cache.contains(1));
+  REQUIRE(*cache.get(3) == "THREE");
+  REQUIRE(cache.size() == 3);
+
+  const CacheStats stats = cache.stats();
+  REQUIRE(stats.hits == 2);
+  REQUIRE(stats.misses == 1);
+  REQUIRE(stats.evictions == 2);
+}
+
+TEST_CASE("LRU cache erases and reuses entries") {
+  LruCache<int, int> cache{100};
+  for (int round = 0; round < 10; round++) {
+    for (int i = 0; i < 100; i++) {
+      cache.put(round * 1000 + i, i);
+    }
+    for (int i = 0; i < 100; i += 2) {
+      REQUIRE(cache.erase(round * 1000 + i));
+    }
+    REQUIRE(!cache.erase(round * 1000));
+  }
+
+  REQUIRE(cache.size() == 50);
+  for (int i = 1; i < 100; i += 2) {
+    REQUIRE(*cache.get(9000 + i) == i);
+  }
+}
+
+TEST_CASE("2Q cache promotes keys which come back as ghosts") {
+  TwoQueueCache<int, int> cache{8};
+  for (int i = 0; i < 8; i++) {
+    cache.put(i, i);
+  }
+
+  // the recent queue holds 2, so 0 becomes a ghost
+  cache.put(8, 8);
+  REQUIRE(!cache.contains(0));
+  REQUIRE(cache.get(0) == nullptr);
+
+  cache.put(0, 100);
+  REQUIRE(*cache.get(0) == 100);
+  REQUIRE(cache.size() == 8);
+}
+
+TEST_CASE("2Q cache keeps its frequently used values through a scan") {
+  TwoQueueCache<int, int> twoQueue{100};
+  LruCache<int, int> lru{100};
+
+  auto put = [&](int first, int last) {
+    for (int key = first; key < last; key++) {
+      twoQueue.put(key, key);
+      lru.put(key, key);
+    }
+  };
+
+  // 20 hot keys, put again after they were evicted to the ghosts, which
+  // gets them into the main queue of the 2Q cache
+  put(0, 20);
+  put(1000, 1100);
+  put(0, 20);
+
+  // a scan of keys which are used once
+  put(10'000, 20'000);
+
+  for (int key = 0; key < 20; key++) {
+    REQUIRE(twoQueue.contains(key));
+    REQUIRE(!lru.contains(key));
+  }
+}
+
+TEST_CASE("2Q cache erases values and ghosts") {
+  TwoQueueCache<int, int> cache{4};
+  for (int i = 0; i < 5; i++) {
+    cache.put(i, i);
+  }
+
+  // 0 is a ghost: erasing it forgets it, but reports no value
+  REQUIRE(!cache.erase(0));
+  cache.put(0, 0);
+  REQUIRE(cache.erase(4));
+  REQUIRE(!cache.contains(4));
+  REQUIRE(cache.size() == 3);
+
+  for (int i = 0; i < 1000; i++) {
+    cache.put(i, i);
+    REQUIRE(cache.size() <= 4);
+  }
+}
+
+TEST_CASE("A value which throws when moved leaves no key behind") {
+  LruCache<int, ThrowingValue> lru{2};
+  lru.put(1, 1);
+  ThrowingValue::throwOnMove = true;
+  REQUIRE_THROWS_AS(lru.put(2, 2), std::runtime_error);
+  ThrowingValue::throwOnMove = false;
+  REQUIRE(!lru.contains(2));
+  REQUIRE(lru.size() == 1);
+  lru.put(2, 2);
+  lru.put(3, 3);
+  REQUIRE(lru.size() == 2);
+  REQUIRE(lru.get(2)->value == 2);
+
+  TwoQueueCache<int, ThrowingValue> twoQueue{4};
+  for (int i = 0; i < 5; i++) {
+    twoQueue.put(i, i);
+  }
+  // 0 is a ghost; putting it makes room, which makes 1 a ghost
+  ThrowingValue::throwOnMove = true;
+  REQUIRE_THROWS_AS(twoQueue.put(0, 0), std::runtime_error);
+  REQUIRE_THROWS_AS(twoQueue.put(5, 5), std::runtime_error);
+  ThrowingValue::throwOnMove = false;
+  REQUIRE(!twoQueue.contains(0));
+  REQUIRE(!twoQueue.contains(5));
+  REQUIRE(twoQueue.size() == 3);
+
+  // the cache is still consistent
+  twoQueue.put(0, 0);
+  twoQueue.put(1, 1);
+  REQUIRE(twoQueue.get(0)->value == 0);
+  REQUIRE(twoQueue.get(1)->value == 1);
+  REQUIRE(twoQueue.size() == 4);
+}
+
+TEST_CASE("Sharded cache splits its capacity") {
+  ShardedCache<LruCache<int, int>> cache{100, 8};
+  REQUIRE(cache.shardCount() == 8);
+  for (int i = 0; i < 1000; i++) {
+    cache.put(i, i);
+  }
+
+  REQUIRE(cache.size() == 100);
+  REQUIRE(cache.stats().evictions == 900);
+  REQUIRE(*cache.get(999) == 999);
+  REQUIRE(!cache.get(0));
+  REQUIRE(cache.erase(999));
+  REQUIRE(!cache.erase(999));
+}
+
+TEST_CASE("Sharded cache is safe to use from many threads") {
+  ShardedCache<TwoQueueCache<int, std::string>> cache{1000};
+  const int threadCount = 4;
+  const int operations = 20'000;
+  // Catch assertions are not thread safe
+  std::atomic<int> wrongValues{0};
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < threadCount; t++) {
+    threads.emplace_back([&cache, &wrongValues, t] {
+      for (int i = 0; i < operations; i++) {
+        const int key = (i * 7 + t) % 3000;
+        if (auto value = cache.get(key)) {
+          wrongValues += *value != std::to_string(key);
+        } else {
+          cache.put(key, std::to_string(key));
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  REQUIRE(wrongValues == 0);
+  const CacheStats stats = cache.stats();
+  REQUIRE(stats.hits > 0);
+  REQUIRE(stats.hits + stats.misses == threadCount * operations);
+  REQUIRE(cache.size() <= 1000);
+}
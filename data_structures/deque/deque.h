@@ -3,22 +3,74 @@
 
 #include <stddef.h>
 
+#include <algorithm>
+#include <bit>
 #include <cassert>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <new>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+template <typename T, typename ReferenceType, typename DequeType>
+class DqIterator;
+
+template <typename T>
+class Deque;
 
+template <typename T>
+using DequeIterator = DqIterator<T, T &, Deque<T>>;
+
+template <typename T>
+using DequeCIterator = DqIterator<T, const T &, const Deque<T>>;
+
+/**
+ * Double-ended queue kept in a ring buffer whose capacity is a power of two.
+ * The front and the back wrap around the end of the buffer, so push_front and
+ * push_back never shift the elements, and a queue which pushes to one end and
+ * pops from the other reuses the same buffer for as long as its size stays
+ * below the capacity. Element i lives at (front + i) & (capacity - 1).
+ *
+ * The buffer is taken from the given std::pmr::memory_resource, or from the
+ * global heap if no resource (nullptr) is given. Copies use the global heap
+ * and assignment never changes the resource of the target; a moved-to deque
+ * takes over the buffer, and with it the resource, of the source.
+ */
 template <typename T>
 class Deque {
  public:
   Deque() = default;
-  Deque(size_t initialSize);
+  explicit Deque(std::pmr::memory_resource *resource);
+
+  /**
+   * Creates a deque of initialSize value-initialized elements
+   */
+  Deque(size_t initialSize, std::pmr::memory_resource *resource = nullptr);
   Deque(const Deque &);
+  Deque(Deque &&) noexcept;
   Deque &operator=(const Deque &);
+  Deque &operator=(Deque &&);
   ~Deque();
 
   /**
    * Appends the given element value to the end of the container.
    */
   void push_back(const T &value);
+  void push_back(T &&value);
+
+  /**
+   * Constructs a new element in place at the end of the container from the
+   * given arguments.
+   *
+   * @return Reference to the constructed element
+   */
+  template <typename... Args>
+  T &emplace_back(Args &&...args);
 
   /**
    * Removes the last element of the container.
@@ -30,10 +82,20 @@ class Deque {
    * Appends the given element value to the beginning of the container.
    */
   void push_front(const T &value);
+  void push_front(T &&value);
+
+  /**
+   * Constructs a new element in place at the beginning of the container from
+   * the given arguments.
+   *
+   * @return Reference to the constructed element
+   */
+  template <typename... Args>
+  T &emplace_front(Args &&...args);
 
   /**
    * Removes the first element of the container.
-   * Calling pop_back on an empty container causes undefined behavior.
+   * Calling pop_front on an empty container causes undefined behavior.
    */
   void pop_front();
 
@@ -64,16 +126,38 @@ class Deque {
   T &front();
   const T &front() const;
 
+  /**
+   * @return a random access iterator to the first element
+   */
+  DequeIterator<T> begin() noexcept;
+  DequeCIterator<T> begin() const noexcept;
+  DequeCIterator<T> cbegin() const noexcept;
+
+  /**
+   * @return an iterator past the last element
+   */
+  DequeIterator<T> end() noexcept;
+  DequeCIterator<T> end() const noexcept;
+  DequeCIterator<T> cend() const noexcept;
+
+  /**
+   * @return reverse iterators to the last element and before the first one
+   */
+  std::reverse_iterator<DequeIterator<T>> rbegin() noexcept;
+  std::reverse_iterator<DequeCIterator<T>> rbegin() const noexcept;
+  std::reverse_iterator<DequeIterator<T>> rend() noexcept;
+  std::reverse_iterator<DequeCIterator<T>> rend() const noexcept;
+
   /**
    * Returns number of elements in the deque
    */
   size_t size() const;
 
   /**
-   * Returns the size of the internal buffer.
-   * Could be larger than the number of elemets in the deque
+   * Returns the number of elements the buffer has room for, zero or a power
+   * of two. Could be larger than the number of elements in the deque.
    */
-  // size_t capacity() const; TODO is it needed? std::deque lacks this.
+  size_t capacity() const;
 
   /**
    * Returns whether the deque is empty of elements or not
@@ -89,154 +173,472 @@ class Deque {
    */
   void clear(bool bDeleteInternalBuffer = false);
 
+  /**
+   * Reduces the capacity to the smallest power of two which holds the
+   * elements, and frees the buffer of an empty deque
+   */
+  void shrink_to_fit();
+
+  /**
+   * Returns the memory resource of the deque, nullptr for the global heap
+   */
+  std::pmr::memory_resource *resource() const noexcept;
+
  private:
+  // Trivially copyable elements are relocated and copied with memcpy. On the
+  // global heap their buffer is managed with malloc/realloc, so growing can
+  // happen in place.
+  static constexpr bool TRIVIAL_COPY = std::is_trivially_copyable_v<T>;
+  static constexpr bool USE_REALLOC =
+      TRIVIAL_COPY && alignof(T) <= alignof(std::max_align_t);
+
+  static constexpr size_t MIN_CAPACITY = 8;
+
+  // Returns an uninitialized buffer for capacity elements
+  T *allocate(size_t capacity) const;
+  void deallocate(T *buffer, size_t capacity) const;
+
+  // Index in the buffer of element index of the deque
+  size_t slot(size_t index) const;
+
+  // Moves the elements to a new buffer of newCapacity, with the front at 0
   void resize(size_t newCapacity);
 
-  // Helper function used to add the element when !m_arr is true
-  void addElementWhenEmpty(const T &value);
+  // Makes room for one more element
+  void grow();
+
+  // Copies (or moves, if source is an rvalue) the elements of source in
+  // order to the uninitialized buffer dest. If one throws, the elements
+  // already built in dest are destroyed.
+  template <typename Source>
+  static void relocate(Source &&source, T *dest);
 
-  void copy(const Deque &other);
+  void destroyElements();
 
  private:
   T *m_arr = nullptr;
   size_t m_currentSize = 0;
   size_t m_currentCapacity = 0;
-  size_t m_startIndex;
-  size_t m_frontIndex;
-  size_t m_backIndex;
+  size_t m_frontIndex = 0;
+  std::pmr::memory_resource *m_resource = nullptr;
+};
+
+/**
+ * Random access iterator which refers to an element by its index in the
+ * deque, so it stays the same whichever way the elements are laid out in the
+ * buffer. Like the iterators of std::deque, it is invalidated by adding and
+ * removing elements.
+ */
+template <typename T, typename ReferenceType, typename DequeType>
+class DqIterator {
+  using I = DqIterator;
+
+ public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = T;
+  using difference_type = std::ptrdiff_t;
+  using pointer = std::remove_reference_t<ReferenceType> *;
+  using reference = ReferenceType;
+
+  DqIterator() = default;
+  DqIterator(DequeType *deque, difference_type index)
+      : m_pDeque{deque}, m_index{index} {}
+
+  // An iterator converts to a const iterator
+  template <typename OtherReference, typename OtherDeque>
+    requires std::is_const_v<DequeType> && (!std::is_const_v<OtherDeque>)
+  DqIterator(const DqIterator<T, OtherReference, OtherDeque> &other)
+      : m_pDeque{other.m_pDeque}, m_index{other.m_index} {}
+
+  ReferenceType operator*() const { return (*m_pDeque)[m_index]; }
+  pointer operator->() const { return &**this; }
+  ReferenceType operator[](difference_type n) const {
+    return (*m_pDeque)[m_index + n];
+  }
+
+  I &operator++() {
+    ++m_index;
+    return *this;
+  }
+
+  I operator++(int) {
+    I old = *this;
+    ++*this;
+    return old;
+  }
+
+  I &operator--() {
+    --m_index;
+    return *this;
+  }
+
+  I operator--(int) {
+    I old = *this;
+    --*this;
+    return old;
+  }
+
+  I &operator+=(difference_type n) {
+    m_index += n;
+    return *this;
+  }
+
+  I &operator-=(difference_type n) {
+    m_index -= n;
+    return *this;
+  }
+
+  friend I operator+(I it, difference_type n) { return it += n; }
+  friend I operator+(difference_type n, I it) { return it += n; }
+  friend I operator-(I it, difference_type n) { return it -= n; }
+  friend difference_type operator-(const I &lhs, const I &rhs) {
+    return lhs.m_index - rhs.m_index;
+  }
+
+  friend bool operator==(const I &lhs, const I &rhs) {
+    return lhs.m_index == rhs.m_index;
+  }
+
+  friend auto operator<=>(const I &lhs, const I &rhs) {
+    return lhs.m_index <=> rhs.m_index;
+  }
+
+ private:
+  DequeType *m_pDeque = nullptr;
+  difference_type m_index = 0;
+
+  template <typename, typename, typename>
+  friend class DqIterator;
 };
 
 template <typename T>
-Deque<T>::Deque(size_t initialSize) {
-  m_arr = new T[initialSize];
-  m_startIndex = initialSize / 2;
-  // initialize all values with zero
-  for (int i = 0; i < initialSize; i++) {
-    m_arr[i] = 0;
+Deque<T>::Deque(std::pmr::memory_resource *resource) : m_resource{resource} {}
+
+template <typename T>
+Deque<T>::Deque(size_t initialSize, std::pmr::memory_resource *resource)
+    : m_resource{resource} {
+  if (initialSize == 0) {
+    return;
+  }
+
+  const size_t capacity = std::bit_ceil(initialSize);
+  m_arr = allocate(capacity);
+  try {
+    std::uninitialized_value_construct_n(m_arr, initialSize);
+  } catch (...) {
+    deallocate(m_arr, capacity);
+    throw;
   }
 
-  m_frontIndex = 0;
-  m_backIndex = initialSize - 1;
   m_currentSize = initialSize;
-  m_currentCapacity = initialSize;
+  m_currentCapacity = capacity;
 }
 
 template <typename T>
-Deque<T>::Deque(const Deque &other) : m_arr{nullptr} {
-  copy(other);
+Deque<T>::Deque(const Deque &other) {
+  if (other.empty()) {
+    return;
+  }
+
+  const size_t capacity = std::bit_ceil(other.m_currentSize);
+  m_arr = allocate(capacity);
+  try {
+    relocate(other, m_arr);
+  } catch (...) {
+    deallocate(m_arr, capacity);
+    throw;
+  }
+
+  m_currentSize = other.m_currentSize;
+  m_currentCapacity = capacity;
 }
 
+template <typename T>
+Deque<T>::Deque(Deque &&other) noexcept
+    : m_arr{std::exchange(other.m_arr, nullptr)},
+      m_currentSize{std::exchange(other.m_currentSize, 0)},
+      m_currentCapacity{std::exchange(other.m_currentCapacity, 0)},
+      m_frontIndex{std::exchange(other.m_frontIndex, 0)},
+      m_resource{other.m_resource} {}
+
 template <typename T>
 Deque<T> &Deque<T>::operator=(const Deque &other) {
   if (this != &other) {
-    copy(other);
+    // Built aside first, so that a throwing copy leaves the deque unchanged
+    const size_t capacity =
+        other.empty() ? 0 : std::bit_ceil(other.m_currentSize);
+    T *newArr = allocate(capacity);
+    try {
+      relocate(other, newArr);
+    } catch (...) {
+      deallocate(newArr, capacity);
+      throw;
+    }
+
+    clear(true);
+    m_arr = newArr;
+    m_currentSize = other.m_currentSize;
+    m_currentCapacity = capacity;
   }
 
   return *this;
 }
 
 template <typename T>
-void Deque<T>::copy(const Deque &other) {
-  T *newArr = new T[other.m_currentCapacity];
-  m_startIndex = other.m_startIndex;
-  m_frontIndex = other.m_frontIndex;
-  m_backIndex = other.m_backIndex;
-  for (int i = other.m_frontIndex; i <= other.m_backIndex; i++) {
-    newArr[i] = other.m_arr[i];
+Deque<T> &Deque<T>::operator=(Deque &&other) {
+  if (this == &other) {
+    return *this;
+  }
+
+  if (m_resource == other.m_resource) {
+    clear(true);
+    m_arr = std::exchange(other.m_arr, nullptr);
+    m_currentSize = std::exchange(other.m_currentSize, 0);
+    m_currentCapacity = std::exchange(other.m_currentCapacity, 0);
+    m_frontIndex = std::exchange(other.m_frontIndex, 0);
+    return *this;
   }
 
-  delete[] m_arr;
-  m_arr = newArr;
+  // The buffer of other belongs to another resource, so only the elements
+  // can be moved over
+  clear();
+  if (m_currentCapacity < other.m_currentSize) {
+    clear(true);
+    m_currentCapacity = std::bit_ceil(other.m_currentSize);
+    m_arr = allocate(m_currentCapacity);
+  }
+  relocate(std::move(other), m_arr);
   m_currentSize = other.m_currentSize;
-  m_currentCapacity = other.m_currentCapacity;
+  other.clear();
+  return *this;
 }
 
 template <typename T>
 void Deque<T>::push_back(const T &value) {
-  if (!m_arr) {  // 0 elements
-    addElementWhenEmpty(value);
-    return;
-  }
+  emplace_back(value);
+}
+
+template <typename T>
+void Deque<T>::push_back(T &&value) {
+  emplace_back(std::move(value));
+}
 
-  if (m_backIndex == m_currentCapacity - 1) {
-    // No more space for push_back. Resizing should be done.
-    resize(m_currentCapacity * 2);
+template <typename T>
+template <typename... Args>
+T &Deque<T>::emplace_back(Args &&...args) {
+  if (m_currentSize == m_currentCapacity) {
+    // The arguments may refer to an element, so the new one is made before
+    // the buffer is replaced
+    T value(std::forward<Args>(args)...);
+    grow();
+    T *elem = ::new (static_cast<void *>(m_arr + slot(m_currentSize)))
+        T(std::move(value));
+    ++m_currentSize;
+    return *elem;
   }
 
-  m_arr[++m_backIndex] = value;
+  T *elem = ::new (static_cast<void *>(m_arr + slot(m_currentSize)))
+      T(std::forward<Args>(args)...);
   ++m_currentSize;
+  return *elem;
 }
 
 template <typename T>
 void Deque<T>::push_front(const T &value) {
-  if (!m_arr) {  // 0 elements
-    addElementWhenEmpty(value);
-    return;
-  }
+  emplace_front(value);
+}
+
+template <typename T>
+void Deque<T>::push_front(T &&value) {
+  emplace_front(std::move(value));
+}
 
-  while (m_frontIndex == 0) {
-    // No space for push_front. Resizing should be done.
-    resize(m_currentCapacity * 2);
+template <typename T>
+template <typename... Args>
+T &Deque<T>::emplace_front(Args &&...args) {
+  if (m_currentSize == m_currentCapacity) {
+    T value(std::forward<Args>(args)...);
+    grow();
+    return emplace_front(std::move(value));
   }
 
-  m_arr[--m_frontIndex] = value;
+  const size_t newFront = (m_frontIndex - 1) & (m_currentCapacity - 1);
+  T *elem = ::new (static_cast<void *>(m_arr + newFront))
+      T(std::forward<Args>(args)...);
+  m_frontIndex = newFront;
   ++m_currentSize;
+  return *elem;
 }
 
 template <typename T>
-void Deque<T>::addElementWhenEmpty(const T &value) {
-  m_arr = new T[1];
-  m_arr[0] = value;
-  m_startIndex = m_frontIndex = m_backIndex = 0;
-  m_currentCapacity = m_currentSize = 1;
+void Deque<T>::pop_back() {
+  --m_currentSize;
+  std::destroy_at(m_arr + slot(m_currentSize));
 }
 
 template <typename T>
-void Deque<T>::pop_back() {
-  if (size() == 1) {
-    clear(true);
-    return;
-  }
-
-  --m_backIndex;
+void Deque<T>::pop_front() {
+  std::destroy_at(m_arr + m_frontIndex);
+  m_frontIndex = slot(1);
   --m_currentSize;
 }
 
 template <typename T>
-void Deque<T>::pop_front() {
-  if (size() == 1) {
-    clear(true);
-    return;
+size_t Deque<T>::slot(size_t index) const {
+  return (m_frontIndex + index) & (m_currentCapacity - 1);
+}
+
+template <typename T>
+void Deque<T>::grow() {
+  const size_t newCapacity =
+      m_currentCapacity ? m_currentCapacity * 2 : MIN_CAPACITY;
+
+  if constexpr (USE_REALLOC) {
+    if (!m_resource && m_arr) {
+      // The buffer grows in place if it can. Elements which had wrapped
+      // around to its beginning are then copied right after the old end,
+      // which the doubled buffer always has room for.
+      T *newBuff =
+          static_cast<T *>(std::realloc(m_arr, newCapacity * sizeof(T)));
+      if (!newBuff) {
+        throw std::bad_alloc{};
+      }
+
+      const size_t wrapped =
+          m_frontIndex + m_currentSize > m_currentCapacity
+              ? m_frontIndex + m_currentSize - m_currentCapacity
+              : 0;
+      std::memcpy(newBuff + m_currentCapacity, newBuff, wrapped * sizeof(T));
+      m_arr = newBuff;
+      m_currentCapacity = newCapacity;
+      return;
+    }
   }
 
-  --m_currentSize;
-  ++m_frontIndex;
+  resize(newCapacity);
 }
 
 template <typename T>
 void Deque<T>::resize(size_t newCapacity) {
-  assert(newCapacity > m_currentCapacity);
-  T *newBuff = new T[newCapacity];
+  assert(newCapacity >= m_currentSize);
+
+  // Elements are copied if moving them may throw, so that the deque is
+  // unchanged if a copy throws. Move-only elements with a throwing move are
+  // moved anyway: if one throws, the deque keeps its size and buffer but the
+  // elements already moved are left moved-from, the basic guarantee which
+  // std::vector gives too.
+  T *newBuff = allocate(newCapacity);
+  try {
+    if constexpr (std::is_nothrow_move_constructible_v<T> ||
+                  !std::is_copy_constructible_v<T>) {
+      relocate(std::move(*this), newBuff);
+    } else {
+      relocate(*this, newBuff);
+    }
+  } catch (...) {
+    // relocate has destroyed the elements it built in newBuff
+    deallocate(newBuff, newCapacity);
+    throw;
+  }
+
+  destroyElements();
+  deallocate(m_arr, m_currentCapacity);
+  m_arr = newBuff;
   m_currentCapacity = newCapacity;
+  m_frontIndex = 0;
+}
 
-  const size_t frontIndexDistanceToStart = m_startIndex - m_frontIndex;
-  const size_t backIndexDistanceToStart = m_backIndex - m_startIndex;
+template <typename T>
+template <typename Source>
+void Deque<T>::relocate(Source &&source, T *dest) {
+  if (source.m_currentSize == 0) {
+    return;
+  }
 
-  const size_t newStartIndex = (newCapacity - 1) / 2;
-  const size_t newFrontIndex = newStartIndex - frontIndexDistanceToStart;
-  const size_t newBackIndex = newStartIndex + backIndexDistanceToStart;
+  // The elements are in at most two runs: from the front to the end of the
+  // buffer, and from its beginning to the back
+  const size_t first = std::min(source.m_currentSize,
+                                source.m_currentCapacity - source.m_frontIndex);
+  const size_t second = source.m_currentSize - first;
+  T *front = source.m_arr + source.m_frontIndex;
+
+  if constexpr (TRIVIAL_COPY) {
+    std::memcpy(dest, front, first * sizeof(T));
+    std::memcpy(dest + first, source.m_arr, second * sizeof(T));
+  } else if constexpr (std::is_rvalue_reference_v<Source &&>) {
+    std::uninitialized_move_n(front, first, dest);
+    try {
+      std::uninitialized_move_n(source.m_arr, second, dest + first);
+    } catch (...) {
+      std::destroy_n(dest, first);
+      throw;
+    }
+  } else {
+    std::uninitialized_copy_n(front, first, dest);
+    try {
+      std::uninitialized_copy_n(source.m_arr, second, dest + first);
+    } catch (...) {
+      std::destroy_n(dest, first);
+      throw;
+    }
+  }
+}
 
-  size_t i = m_frontIndex;
-  size_t j = newFrontIndex;
-  for (; i <= m_backIndex; i++, j++) {
-    newBuff[j] = m_arr[i];
+template <typename T>
+void Deque<T>::destroyElements() {
+  if constexpr (!std::is_trivially_destructible_v<T>) {
+    for (size_t i = 0; i < m_currentSize; i++) {
+      std::destroy_at(m_arr + slot(i));
+    }
   }
+}
 
-  m_startIndex = newStartIndex;
-  m_frontIndex = newFrontIndex;
-  m_backIndex = newBackIndex;
-  delete[] m_arr;
-  m_arr = newBuff;
+template <typename T>
+T *Deque<T>::allocate(size_t capacity) const {
+  // An empty deque has no buffer at all
+  if (capacity == 0) {
+    return nullptr;
+  }
+
+  if (m_resource) {
+    return static_cast<T *>(
+        m_resource->allocate(capacity * sizeof(T), alignof(T)));
+  }
+
+  if constexpr (USE_REALLOC) {
+    T *buffer = static_cast<T *>(std::malloc(capacity * sizeof(T)));
+    if (!buffer) {
+      throw std::bad_alloc{};
+    }
+
+    return buffer;
+  } else {
+    return static_cast<T *>(::operator new(capacity * sizeof(T),
+                                           std::align_val_t{alignof(T)}));
+  }
+}
+
+template <typename T>
+void Deque<T>::deallocate(T *buffer, size_t capacity) const {
+  if (!buffer) {
+    return;
+  }
+
+  if (m_resource) {
+    m_resource->deallocate(buffer, capacity * sizeof(T), alignof(T));
+    return;
+  }
+
+  if constexpr (USE_REALLOC) {
+    std::free(buffer);
+  } else {
+    ::operator delete(buffer, std::align_val_t{alignof(T)});
+  }
+}
+
+template <typename T>
+std::pmr::memory_resource *Deque<T>::resource() const noexcept {
+  return m_resource;
 }
 
 template <typename T>
@@ -244,7 +646,10 @@ size_t Deque<T>::size() const {
   return m_currentSize;
 }
 
-// template <typename T> size_t Deque<T>::capacity() const {}
+template <typename T>
+size_t Deque<T>::capacity() const {
+  return m_currentCapacity;
+}
 
 template <typename T>
 bool Deque<T>::empty() const {
@@ -253,43 +658,53 @@ bool Deque<T>::empty() const {
 
 template <typename T>
 void Deque<T>::clear(bool bDeleteInternalBuffer) {
+  destroyElements();
+  m_currentSize = 0;
+  m_frontIndex = 0;
+
   if (bDeleteInternalBuffer) {
-    delete[] m_arr;
+    deallocate(m_arr, m_currentCapacity);
     m_arr = nullptr;
-    m_currentSize = m_currentCapacity = 0;
-  } else {
-    m_currentSize = 0;
-    m_frontIndex = m_backIndex = m_startIndex;
+    m_currentCapacity = 0;
+  }
+}
+
+template <typename T>
+void Deque<T>::shrink_to_fit() {
+  if (m_currentSize == 0) {
+    clear(true);
+  } else if (std::bit_ceil(m_currentSize) < m_currentCapacity) {
+    resize(std::bit_ceil(m_currentSize));
   }
 }
 
 template <typename T>
 T &Deque<T>::at(size_t index) {
-  if (index < 0 || index >= m_currentSize) {
+  if (index >= m_currentSize) {
     throw std::out_of_range{"Index out of range."};
   }
 
-  return m_arr[m_frontIndex + index];
+  return m_arr[slot(index)];
 }
 
 template <typename T>
 T &Deque<T>::operator[](size_t index) {
-  return m_arr[m_frontIndex + index];
+  return m_arr[slot(index)];
 }
 
 template <typename T>
 const T &Deque<T>::operator[](size_t index) const {
-  return m_arr[m_frontIndex + index];
+  return m_arr[slot(index)];
 }
 
 template <typename T>
 T &Deque<T>::back() {
-  return m_arr[m_backIndex];
+  return m_arr[slot(m_currentSize - 1)];
 }
 
 template <typename T>
 const T &Deque<T>::back() const {
-  return m_arr[m_backIndex];
+  return m_arr[slot(m_currentSize - 1)];
 }
 
 template <typename T>
@@ -302,9 +717,59 @@ const T &Deque<T>::front() const {
   return m_arr[m_frontIndex];
 }
 
+template <typename T>
+DequeIterator<T> Deque<T>::begin() noexcept {
+  return DequeIterator<T>{this, 0};
+}
+
+template <typename T>
+DequeCIterator<T> Deque<T>::begin() const noexcept {
+  return cbegin();
+}
+
+template <typename T>
+DequeCIterator<T> Deque<T>::cbegin() const noexcept {
+  return DequeCIterator<T>{this, 0};
+}
+
+template <typename T>
+DequeIterator<T> Deque<T>::end() noexcept {
+  return DequeIterator<T>{this, static_cast<std::ptrdiff_t>(size())};
+}
+
+template <typename T>
+DequeCIterator<T> Deque<T>::end() const noexcept {
+  return cend();
+}
+
+template <typename T>
+DequeCIterator<T> Deque<T>::cend() const noexcept {
+  return DequeCIterator<T>{this, static_cast<std::ptrdiff_t>(size())};
+}
+
+template <typename T>
+std::reverse_iterator<DequeIterator<T>> Deque<T>::rbegin() noexcept {
+  return std::reverse_iterator{end()};
+}
+
+template <typename T>
+std::reverse_iterator<DequeCIterator<T>> Deque<T>::rbegin() const noexcept {
+  return std::reverse_iterator{end()};
+}
+
+template <typename T>
+std::reverse_iterator<DequeIterator<T>> Deque<T>::rend() noexcept {
+  return std::reverse_iterator{begin()};
+}
+
+template <typename T>
+std::reverse_iterator<DequeCIterator<T>> Deque<T>::rend() const noexcept {
+  return std::reverse_iterator{begin()};
+}
+
 template <typename T>
 Deque<T>::~Deque() {
-  delete[] m_arr;
+  clear(true);
 }
 
 template <typename T>
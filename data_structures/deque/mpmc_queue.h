@@ -0,0 +1,335 @@
+#ifndef MPMC_QUEUE_H
+#define MPMC_QUEUE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "../parallel/event_count.h"
+#include "ring_queue_capacity.h"
+
+/**
+ * Bounded FIFO queue for any number of producer and consumer threads
+ * (D. Vyukov's bounded MPMC queue).
+ *
+ * The ring buffer is allocated by the constructor and nothing is allocated
+ * afterwards. Every cell has a sequence number which says whose turn it is:
+ * for the cell of position p it is p while the cell waits for the producer
+ * of p, p + 1 once the element is in it, and p + capacity() once the consumer
+ * has taken it out, which is the turn of the producer of the next lap.
+ * Producers claim positions with a CAS on the enqueue position and consumers
+ * with one on the dequeue position; the two are in separate cache lines, so
+ * producers and consumers contend only among themselves. The batch
+ * operations claim a run of consecutive positions with a single CAS.
+ *
+ * A claimed cell must be filled (or emptied), or the threads of the next lap
+ * wait for it forever, so copying and moving elements must not throw.
+ *
+ * The try_ operations never block. push and pop wait while the queue is full
+ * or empty, sleeping in the kernel (EventCount) rather than spinning.
+ */
+template <typename T>
+class MpmcQueue {
+  static_assert(std::is_nothrow_move_constructible_v<T>,
+                "Moving elements must not throw.");
+
+ public:
+  /**
+   * Creates a queue for at least the given number of elements; the capacity
+   * is rounded up to a power of two. Throws exception if capacity is 0.
+   * @throw std::invalid_argument
+   */
+  explicit MpmcQueue(size_t capacity);
+
+  MpmcQueue(const MpmcQueue &) = delete;
+  MpmcQueue &operator=(const MpmcQueue &) = delete;
+
+  ~MpmcQueue();
+
+  /**
+   * Adds an element at the back, or returns false if the queue is full
+   */
+  bool try_push(const T &value);
+  bool try_push(T &&value);
+
+  /**
+   * Adds an element at the back, waiting while the queue is full
+   */
+  void push(const T &value);
+  void push(T &&value);
+
+  /**
+   * Copies as many of the given elements as there are free consecutive cells
+   * for to the back and returns how many it copied. They stay in order, but
+   * elements of other producers may come right before and after them.
+   */
+  size_t try_push_n(std::span<const T> values);
+
+  /**
+   * Copies all the given elements to the back, waiting whenever the queue is
+   * full. Elements of other producers may come in between them.
+   */
+  void push_n(std::span<const T> values);
+
+  /**
+   * Removes the front element, or returns std::nullopt if the queue is empty
+   */
+  std::optional<T> try_pop();
+
+  /**
+   * Removes the front element, waiting while the queue is empty
+   */
+  T pop();
+
+  /**
+   * Moves up to out.size() elements from the front into out and returns how
+   * many it moved
+   */
+  size_t try_pop_n(std::span<T> out);
+
+  /**
+   * Like try_pop_n, but waits while the queue is empty, so it moves at least
+   * one element unless out is empty
+   */
+  size_t pop_n(std::span<T> out);
+
+  /**
+   * Returns the number of elements at the time of the call. Elements which
+   * are being pushed or popped count as in the queue.
+   */
+  size_t size() const;
+  bool empty() const { return size() == 0; }
+  size_t capacity() const { return m_mask + 1; }
+
+ private:
+  struct Cell {
+    std::atomic<size_t> sequence;
+    alignas(T) unsigned char storage[sizeof(T)];
+
+    T *element() { return std::launder(reinterpret_cast<T *>(storage)); }
+  };
+
+  Cell &cell(size_t position) { return m_cells[position & m_mask]; }
+
+  // Claims up to maxCount consecutive positions whose cells have the
+  // sequence number position + offset, returning the first one and how many
+  // it claimed (0 if the first cell is not ready)
+  std::pair<size_t, size_t> claim(std::atomic<size_t> &nextPosition,
+                                  size_t offset, size_t maxCount);
+
+  template <typename U>
+  bool pushOne(U &&value);
+
+  alignas(64) std::atomic<size_t> m_enqueuePosition{0};
+  alignas(64) std::atomic<size_t> m_dequeuePosition{0};
+
+  alignas(64) const size_t m_mask;
+  const std::unique_ptr<Cell[]> m_cells;
+  // Each is notified by a different side, so they get a cache line each
+  alignas(64) EventCount m_notEmpty;
+  alignas(64) EventCount m_notFull;
+};
+
+template <typename T>
+MpmcQueue<T>::MpmcQueue(size_t capacity)
+    : m_mask{ring_queue_detail::checkedCapacity(capacity) - 1},
+      m_cells{new Cell[m_mask + 1]} {
+  for (size_t i = 0; i <= m_mask; i++) {
+    m_cells[i].sequence.store(i, std::memory_order_relaxed);
+  }
+}
+
+template <typename T>
+MpmcQueue<T>::~MpmcQueue() {
+  const size_t end = m_enqueuePosition.load(std::memory_order_relaxed);
+  for (size_t i = m_dequeuePosition.load(std::memory_order_relaxed); i != end;
+       i++) {
+    std::destroy_at(cell(i).element());
+  }
+}
+
+template <typename T>
+bool MpmcQueue<T>::try_push(const T &value) {
+  if constexpr (std::is_nothrow_copy_constructible_v<T>) {
+    return pushOne(value);
+  } else {
+    // copies before claiming a cell, which then cannot be left empty
+    T copy(value);
+    return pushOne(std::move(copy));
+  }
+}
+
+template <typename T>
+bool MpmcQueue<T>::try_push(T &&value) {
+  return pushOne(std::move(value));
+}
+
+template <typename T>
+void MpmcQueue<T>::push(const T &value) {
+  m_notFull.await([&] { return try_push(value); });
+}
+
+template <typename T>
+void MpmcQueue<T>::push(T &&value) {
+  // try_push moves from value only when it succeeds
+  m_notFull.await([&] { return try_push(std::move(value)); });
+}
+
+template <typename T>
+size_t MpmcQueue<T>::try_push_n(std::span<const T> values) {
+  static_assert(std::is_nothrow_copy_constructible_v<T>,
+                "Copying elements must not throw.");
+
+  const auto [first, count] = claim(m_enqueuePosition, 0, values.size());
+  for (size_t i = 0; i < count; i++) {
+    Cell &target = cell(first + i);
+    ::new (static_cast<void *>(target.storage)) T(values[i]);
+    target.sequence.store(first + i + 1, std::memory_order_release);
+  }
+
+  if (count > 0) {
+    m_notEmpty.notifyAll();
+  }
+  return count;
+}
+
+template <typename T>
+void MpmcQueue<T>::push_n(std::span<const T> values) {
+  while (!values.empty()) {
+    size_t pushed = 0;
+    m_notFull.await([&] {
+      pushed = try_push_n(values);
+      return pushed > 0;
+    });
+    values = values.subspan(pushed);
+  }
+}
+
+template <typename T>
+std::optional<T> MpmcQueue<T>::try_pop() {
+  const auto [position, count] = claim(m_dequeuePosition, 1, 1);
+  if (count == 0) {
+    return std::nullopt;
+  }
+
+  Cell &source = cell(position);
+  std::optional<T> value{std::move(*source.element())};
+  std::destroy_at(source.element());
+  source.sequence.store(position + capacity(), std::memory_order_release);
+  m_notFull.notifyAll();
+  return value;
+}
+
+template <typename T>
+T MpmcQueue<T>::pop() {
+  std::optional<T> value;
+  m_notEmpty.await([&] {
+    value = try_pop();
+    return value.has_value();
+  });
+
+  return std::move(*value);
+}
+
+template <typename T>
+size_t MpmcQueue<T>::try_pop_n(std::span<T> out) {
+  static_assert(std::is_nothrow_move_assignable_v<T>,
+                "Moving elements must not throw.");
+
+  const auto [first, count] = claim(m_dequeuePosition, 1, out.size());
+  for (size_t i = 0; i < count; i++) {
+    Cell &source = cell(first + i);
+    out[i] = std::move(*source.element());
+    std::destroy_at(source.element());
+    source.sequence.store(first + i + capacity(), std::memory_order_release);
+  }
+
+  if (count > 0) {
+    m_notFull.notifyAll();
+  }
+  return count;
+}
+
+template <typename T>
+size_t MpmcQueue<T>::pop_n(std::span<T> out) {
+  if (out.empty()) {
+    return 0;
+  }
+
+  size_t popped = 0;
+  m_notEmpty.await([&] {
+    popped = try_pop_n(out);
+    return popped > 0;
+  });
+
+  return popped;
+}
+
+template <typename T>
+size_t MpmcQueue<T>::size() const {
+  const size_t dequeue = m_dequeuePosition.load(std::memory_order_acquire);
+  const size_t enqueue = m_enqueuePosition.load(std::memory_order_acquire);
+  // the consumers may claim positions whose producers are not done yet
+  return enqueue > dequeue ? enqueue - dequeue : 0;
+}
+
+template <typename T>
+std::pair<size_t, size_t> MpmcQueue<T>::claim(
+    std::atomic<size_t> &nextPosition, size_t offset, size_t maxCount) {
+  if (maxCount == 0) {
+    return {0, 0};
+  }
+
+  size_t position = nextPosition.load(std::memory_order_relaxed);
+  for (;;) {
+    const size_t sequence =
+        cell(position).sequence.load(std::memory_order_acquire);
+    const auto lag = static_cast<std::ptrdiff_t>(sequence - position - offset);
+    if (lag < 0) {
+      // the cell is a lap behind: the queue is full, or empty for consumers
+      return {position, 0};
+    }
+    if (lag > 0) {
+      // another thread took the position
+      position = nextPosition.load(std::memory_order_relaxed);
+      continue;
+    }
+
+    // the run of ready cells starting at position
+    size_t count = 1;
+    while (count < maxCount &&
+           cell(position + count).sequence.load(std::memory_order_acquire) ==
+               position + count + offset) {
+      count++;
+    }
+
+    if (nextPosition.compare_exchange_weak(position, position + count,
+                                           std::memory_order_relaxed)) {
+      return {position, count};
+    }
+  }
+}
+
+template <typename T>
+template <typename U>
+bool MpmcQueue<T>::pushOne(U &&value) {
+  const auto [position, count] = claim(m_enqueuePosition, 0, 1);
+  if (count == 0) {
+    return false;
+  }
+
+  Cell &target = cell(position);
+  ::new (static_cast<void *>(target.storage)) T(std::forward<U>(value));
+  target.sequence.store(position + 1, std::memory_order_release);
+  m_notEmpty.notifyAll();
+  return true;
+}
+
+#endif
@@ -0,0 +1,209 @@
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "deque.h"
+#include "mpmc_queue.h"
+#include "spsc_queue.h"
+
+/*
+SpscQueue and MpmcQueue against a Deque behind a mutex and a condition
+variable, the way pipeline stages used to pass items between threads.
+
+1. Throughput: producers push the given number of integers as fast as they
+   can and as many consumers pop them, one by one and in batches of 64.
+
+2. Latency: one producer pushes a timestamp every given number of
+   nanoseconds and the consumer records how long each one took to arrive.
+   The percentiles include the cost of reading the clock, some tens of
+   nanoseconds; with fewer cores than threads they mostly show the scheduler.
+
+Run:
+$> ./ring_queue_benchmark [items] [queue capacity] [latency interval in ns]
+*/
+
+namespace {
+
+const size_t BATCH = 64;
+
+template <typename T>
+class LockedDeque {
+ public:
+  explicit LockedDeque(size_t) {}
+
+  void push(T value) {
+    {
+      std::lock_guard lock{m_mutex};
+      m_deque.push_back(value);
+    }
+    m_notEmpty.notify_one();
+  }
+
+  void push_n(std::span<const T> values) {
+    {
+      std::lock_guard lock{m_mutex};
+      for (const T &value : values) {
+        m_deque.push_back(value);
+      }
+    }
+    m_notEmpty.notify_one();
+  }
+
+  T pop() {
+    std::unique_lock lock{m_mutex};
+    m_notEmpty.wait(lock, [this] { return !m_deque.empty(); });
+    T value = m_deque.front();
+    m_deque.pop_front();
+    return value;
+  }
+
+  size_t pop_n(std::span<T> out) {
+    std::unique_lock lock{m_mutex};
+    m_notEmpty.wait(lock, [this] { return !m_deque.empty(); });
+    const size_t count = std::min(out.size(), m_deque.size());
+    for (size_t i = 0; i < count; i++) {
+      out[i] = m_deque.front();
+      m_deque.pop_front();
+    }
+    return count;
+  }
+
+ private:
+  std::mutex m_mutex;
+  std::condition_variable m_notEmpty;
+  Deque<T> m_deque;
+};
+
+long long nowNanoseconds() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// Returns millions of items per second through the queue
+template <typename Queue>
+double throughput(size_t items, size_t capacity, size_t threadsPerSide,
+                  bool batched) {
+  Queue queue{capacity};
+  const size_t perThread = items / threadsPerSide;
+  std::vector<std::thread> threads;
+
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t t = 0; t < threadsPerSide; t++) {
+    threads.emplace_back([&queue, perThread, batched] {
+      std::vector<long long> batch(BATCH);
+      for (size_t i = 0; i < perThread;) {
+        if (batched) {
+          const size_t count = std::min(BATCH, perThread - i);
+          for (size_t j = 0; j < count; j++) {
+            batch[j] = static_cast<long long>(i + j);
+          }
+          queue.push_n(std::span<const long long>{batch.data(), count});
+          i += count;
+        } else {
+          queue.push(static_cast<long long>(i++));
+        }
+      }
+    });
+    threads.emplace_back([&queue, perThread, batched] {
+      std::vector<long long> batch(BATCH);
+      for (size_t i = 0; i < perThread;) {
+        if (batched) {
+          const size_t count = std::min(BATCH, perThread - i);
+          i += queue.pop_n(std::span<long long>{batch.data(), count});
+        } else {
+          queue.pop();
+          i++;
+        }
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  const auto end = std::chrono::steady_clock::now();
+
+  const double seconds = std::chrono::duration<double>(end - start).count();
+  return perThread * threadsPerSide / seconds / 1e6;
+}
+
+template <typename Queue>
+void printLatencies(const std::string &name, size_t items, size_t capacity,
+                    long long interval) {
+  Queue queue{capacity};
+  std::vector<long long> latencies(items);
+
+  std::thread consumer{[&queue, &latencies] {
+    for (long long &latency : latencies) {
+      const long long sent = queue.pop();
+      latency = nowNanoseconds() - sent;
+    }
+  }};
+
+  const long long start = nowNanoseconds();
+  for (size_t i = 0; i < items; i++) {
+    const long long due = start + static_cast<long long>(i) * interval;
+    while (nowNanoseconds() < due) {
+      std::this_thread::yield();
+    }
+    queue.push(nowNanoseconds());
+  }
+  consumer.join();
+
+  std::sort(latencies.begin(), latencies.end());
+  const auto percentile = [&latencies](double p) {
+    return latencies[static_cast<size_t>(p / 100 * (latencies.size() - 1))];
+  };
+
+  std::cout << "  " << name << ": p50 " << percentile(50) << " ns, p99 "
+            << percentile(99) << " ns, max " << latencies.back() / 1e3
+            << " us\n";
+}
+
+template <typename Queue>
+void printThroughput(const std::string &name, size_t items, size_t capacity,
+                     size_t threadsPerSide) {
+  std::cout << "  " << name << ": "
+            << throughput<Queue>(items, capacity, threadsPerSide, false)
+            << " M items/s, in batches of " << BATCH << ": "
+            << throughput<Queue>(items, capacity, threadsPerSide, true)
+            << " M items/s\n";
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  const size_t items =
+      argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+  const size_t capacity =
+      argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1024;
+  const long long interval = argc > 3 ? std::atoll(argv[3]) : 1000;
+
+  std::cout << "Throughput, 1 producer and 1 consumer\n";
+  printThroughput<LockedDeque<long long>>("locked Deque", items, capacity, 1);
+  printThroughput<SpscQueue<long long>>("SpscQueue", items, capacity, 1);
+  printThroughput<MpmcQueue<long long>>("MpmcQueue", items, capacity, 1);
+
+  std::cout << "Throughput, 2 producers and 2 consumers\n";
+  printThroughput<LockedDeque<long long>>("locked Deque", items, capacity, 2);
+  printThroughput<MpmcQueue<long long>>("MpmcQueue", items, capacity, 2);
+
+  const size_t latencyItems = std::min<size_t>(items / 10, 1'000'000);
+  std::cout << "Latency, one item every " << interval << " ns\n";
+  printLatencies<LockedDeque<long long>>("locked Deque", latencyItems,
+                                         capacity, interval);
+  printLatencies<SpscQueue<long long>>("SpscQueue", latencyItems, capacity,
+                                       interval);
+  printLatencies<MpmcQueue<long long>>("MpmcQueue", latencyItems, capacity,
+                                       interval);
+
+  return 0;
+}
@@ -0,0 +1,26 @@
+#ifndef RING_QUEUE_CAPACITY_H
+#define RING_QUEUE_CAPACITY_H
+
+#include <bit>
+#include <cstddef>
+#include <stdexcept>
+
+namespace ring_queue_detail {
+
+/**
+ * Returns the number of slots of a ring buffer queue asked for capacity
+ * elements: capacity rounded up to a power of two, so that positions wrap
+ * with a mask.
+ * @throw std::invalid_argument if capacity is 0
+ */
+inline size_t checkedCapacity(size_t capacity) {
+  if (capacity == 0) {
+    throw std::invalid_argument{"Capacity must be positive."};
+  }
+
+  return std::bit_ceil(capacity);
+}
+
+}  // namespace ring_queue_detail
+
+#endif
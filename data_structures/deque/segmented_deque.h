@@ -0,0 +1,612 @@
+#ifndef SEGMENTED_DEQUE_H
+#define SEGMENTED_DEQUE_H
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "deque.h"
+
+/**
+ * Default number of elements in a block of SegmentedDeque: the largest power
+ * of two which fits in 4 KB, but at least 16
+ */
+template <typename T>
+constexpr size_t segmentedDequeBlockSize() {
+  return std::max<size_t>(16, std::bit_floor(4096 / sizeof(T)));
+}
+
+template <typename T, size_t BlockSize = segmentedDequeBlockSize<T>()>
+class SegmentedDeque;
+
+template <typename T, size_t BlockSize = segmentedDequeBlockSize<T>()>
+using SegmentedDequeIterator =
+    DqIterator<T, T &, SegmentedDeque<T, BlockSize>>;
+
+template <typename T, size_t BlockSize = segmentedDequeBlockSize<T>()>
+using SegmentedDequeCIterator =
+    DqIterator<T, const T &, const SegmentedDeque<T, BlockSize>>;
+
+/**
+ * Double-ended queue with the interface of Deque, whose elements are kept in
+ * fixed size blocks (like std::deque). A map of pointers to the blocks, a
+ * Deque<T *>, keeps them in order.
+ *
+ * Pushing to either end allocates at most one block and never moves an
+ * element, so references and pointers to the elements stay valid until the
+ * element is popped, and a push takes the same time however large the deque
+ * is: only the map, one pointer per block, is ever copied. Deque instead
+ * copies all its elements whenever it grows, and needs the old and the new
+ * buffer at once. In exchange every access takes one more indirection.
+ *
+ * Like with std::deque, iterators are invalidated by pushes and pops.
+ *
+ * Blocks and the map are taken from the given std::pmr::memory_resource, or
+ * from the global heap if no resource (nullptr) is given. Copies use the
+ * global heap and assignment never changes the resource of the target.
+ *
+ * @tparam BlockSize Number of elements in a block, a power of two
+ */
+template <typename T, size_t BlockSize>
+class SegmentedDeque {
+  static_assert(std::has_single_bit(BlockSize),
+                "Block size must be a power of two.");
+
+ public:
+  SegmentedDeque() = default;
+  explicit SegmentedDeque(std::pmr::memory_resource *resource);
+
+  /**
+   * Creates a deque of initialSize value-initialized elements
+   */
+  SegmentedDeque(size_t initialSize,
+                 std::pmr::memory_resource *resource = nullptr);
+  SegmentedDeque(const SegmentedDeque &);
+  SegmentedDeque(SegmentedDeque &&) noexcept;
+  SegmentedDeque &operator=(const SegmentedDeque &);
+  SegmentedDeque &operator=(SegmentedDeque &&);
+  ~SegmentedDeque();
+
+  /**
+   * Appends the given element value to the end of the container.
+   */
+  void push_back(const T &value);
+  void push_back(T &&value);
+
+  /**
+   * Constructs a new element in place at the end of the container from the
+   * given arguments.
+   *
+   * @return Reference to the constructed element
+   */
+  template <typename... Args>
+  T &emplace_back(Args &&...args);
+
+  /**
+   * Removes the last element of the container.
+   * Calling pop_back on an empty container is undefined behavior.
+   */
+  void pop_back();
+
+  /**
+   * Appends the given element value to the beginning of the container.
+   */
+  void push_front(const T &value);
+  void push_front(T &&value);
+
+  /**
+   * Constructs a new element in place at the beginning of the container from
+   * the given arguments.
+   *
+   * @return Reference to the constructed element
+   */
+  template <typename... Args>
+  T &emplace_front(Args &&...args);
+
+  /**
+   * Removes the first element of the container.
+   * Calling pop_front on an empty container is undefined behavior.
+   */
+  void pop_front();
+
+  /**
+   * Checks if index is out of bounds and throws exception if it is
+   * @throw std::out_of_range
+   */
+  T &at(size_t index);
+
+  /**
+   * Access element without checking if index is out of bounds
+   * Accessing out of bounds element causes undefined behavior.
+   */
+  T &operator[](size_t index);
+  const T &operator[](size_t index) const;
+
+  /**
+   * Returns a reference to the last element in the container.
+   * Calling back on an empty container is undefined behavior.
+   */
+  T &back();
+  const T &back() const;
+
+  /**
+   * Returns a reference to the first element in the container.
+   * Calling front on an empty container is undefined behavior.
+   */
+  T &front();
+  const T &front() const;
+
+  /**
+   * @return a random access iterator to the first element
+   */
+  SegmentedDequeIterator<T, BlockSize> begin() noexcept;
+  SegmentedDequeCIterator<T, BlockSize> begin() const noexcept;
+  SegmentedDequeCIterator<T, BlockSize> cbegin() const noexcept;
+
+  /**
+   * @return an iterator past the last element
+   */
+  SegmentedDequeIterator<T, BlockSize> end() noexcept;
+  SegmentedDequeCIterator<T, BlockSize> end() const noexcept;
+  SegmentedDequeCIterator<T, BlockSize> cend() const noexcept;
+
+  /**
+   * @return reverse iterators to the last element and before the first one
+   */
+  std::reverse_iterator<SegmentedDequeIterator<T, BlockSize>>
+  rbegin() noexcept;
+  std::reverse_iterator<SegmentedDequeCIterator<T, BlockSize>> rbegin()
+      const noexcept;
+  std::reverse_iterator<SegmentedDequeIterator<T, BlockSize>> rend() noexcept;
+  std::reverse_iterator<SegmentedDequeCIterator<T, BlockSize>> rend()
+      const noexcept;
+
+  /**
+   * Returns number of elements in the deque
+   */
+  size_t size() const;
+
+  /**
+   * Returns whether the deque is empty of elements or not
+   */
+  bool empty() const;
+
+  /**
+   * Erases all elements from the container. After this call, size() returns
+   * zero.
+   *
+   * @param bDeleteInternalBuffer If true, the spare block and the map are
+   * freed as well
+   */
+  void clear(bool bDeleteInternalBuffer = false);
+
+  /**
+   * Frees the spare block and the unused part of the map
+   */
+  void shrink_to_fit();
+
+  /**
+   * Returns the memory resource of the deque, nullptr for the global heap
+   */
+  std::pmr::memory_resource *resource() const noexcept;
+
+ private:
+  static constexpr size_t BLOCK_BYTES = BlockSize * sizeof(T);
+
+  T *address(size_t index) const;
+
+  // A block emptied by a pop is kept as the spare block, which the next
+  // push that needs a block takes. A queue which moves along its blocks
+  // then reuses one block instead of freeing and allocating one every
+  // BlockSize operations.
+  T *allocateBlock();
+  void releaseBlock(T *block);
+  void deallocateBlock(T *block) const;
+
+  void swapContents(SegmentedDeque &other) noexcept;
+
+  std::pmr::memory_resource *m_resource = nullptr;
+  Deque<T *> m_blocks{m_resource};
+  T *m_spareBlock = nullptr;
+  // Offset of the first element in the first block
+  size_t m_frontOffset = 0;
+  size_t m_currentSize = 0;
+};
+
+template <typename T, size_t BlockSize>
+SegmentedDeque<T, BlockSize>::SegmentedDeque(
+    std::pmr::memory_resource *resource)
+    : m_resource{resource} {}
+
+template <typename T, size_t BlockSize>
+SegmentedDeque<T, BlockSize>::SegmentedDeque(
+    size_t initialSize, std::pmr::memory_resource *resource)
+    : m_resource{resource} {
+  try {
+    for (size_t i = 0; i < initialSize; i++) {
+      emplace_back();
+    }
+  } catch (...) {
+    clear(true);
+    throw;
+  }
+}
+
+template <typename T, size_t BlockSize>
+SegmentedDeque<T, BlockSize>::SegmentedDeque(const SegmentedDeque &other) {
+  try {
+    for (const T &value : other) {
+      push_back(value);
+    }
+  } catch (...) {
+    clear(true);
+    throw;
+  }
+}
+
+template <typename T, size_t BlockSize>
+SegmentedDeque<T, BlockSize>::SegmentedDeque(SegmentedDeque &&other) noexcept
+    : m_resource{other.m_resource},
+      m_blocks{std::move(other.m_blocks)},
+      m_spareBlock{std::exchange(other.m_spareBlock, nullptr)},
+      m_frontOffset{std::exchange(other.m_frontOffset, 0)},
+      m_currentSize{std::exchange(other.m_currentSize, 0)} {}
+
+template <typename T, size_t BlockSize>
+SegmentedDeque<T, BlockSize> &SegmentedDeque<T, BlockSize>::operator=(
+    const SegmentedDeque &other) {
+  if (this != &other) {
+    // Built aside first, so that a throwing copy leaves the deque unchanged
+    SegmentedDeque copy{m_resource};
+    for (const T &value : other) {
+      copy.push_back(value);
+    }
+    swapContents(copy);
+  }
+
+  return *this;
+}
+
+template <typename T, size_t BlockSize>
+SegmentedDeque<T, BlockSize> &SegmentedDeque<T, BlockSize>::operator=(
+    SegmentedDeque &&other) {
+  if (this == &other) {
+    return *this;
+  }
+
+  if (m_resource == other.m_resource) {
+    clear(true);
+    swapContents(other);
+    return *this;
+  }
+
+  // The blocks of other belong to another resource, so only the elements
+  // can be moved over
+  clear();
+  for (T &value : other) {
+    push_back(std::move(value));
+  }
+  other.clear();
+  return *this;
+}
+
+template <typename T, size_t BlockSize>
+SegmentedDeque<T, BlockSize>::~SegmentedDeque() {
+  clear(true);
+}
+
+template <typename T, size_t BlockSize>
+void SegmentedDeque<T, BlockSize>::push_back(const T &value) {
+  emplace_back(value);
+}
+
+template <typename T, size_t BlockSize>
+void SegmentedDeque<T, BlockSize>::push_back(T &&value) {
+  emplace_back(std::move(value));
+}
+
+template <typename T, size_t BlockSize>
+template <typename... Args>
+T &SegmentedDeque<T, BlockSize>::emplace_back(Args &&...args) {
+  // Elements never move, so args may refer to one of them
+  if (m_frontOffset + m_currentSize < m_blocks.size() * BlockSize) {
+    T *elem = ::new (static_cast<void *>(address(m_currentSize)))
+        T(std::forward<Args>(args)...);
+    ++m_currentSize;
+    return *elem;
+  }
+
+  T *block = allocateBlock();
+  try {
+    ::new (static_cast<void *>(block)) T(std::forward<Args>(args)...);
+  } catch (...) {
+    releaseBlock(block);
+    throw;
+  }
+
+  try {
+    m_blocks.push_back(block);
+  } catch (...) {
+    std::destroy_at(block);
+    releaseBlock(block);
+    throw;
+  }
+
+  ++m_currentSize;
+  return *block;
+}
+
+template <typename T, size_t BlockSize>
+void SegmentedDeque<T, BlockSize>::push_front(const T &value) {
+  emplace_front(value);
+}
+
+template <typename T, size_t BlockSize>
+void SegmentedDeque<T, BlockSize>::push_front(T &&value) {
+  emplace_front(std::move(value));
+}
+
+template <typename T, size_t BlockSize>
+template <typename... Args>
+T &SegmentedDeque<T, BlockSize>::emplace_front(Args &&...args) {
+  if (m_frontOffset > 0) {
+    T *elem = m_blocks.front() + m_frontOffset - 1;
+    ::new (static_cast<void *>(elem)) T(std::forward<Args>(args)...);
+    --m_frontOffset;
+    ++m_currentSize;
+    return *elem;
+  }
+
+  T *block = allocateBlock();
+  T *elem = block + BlockSize - 1;
+  try {
+    ::new (static_cast<void *>(elem)) T(std::forward<Args>(args)...);
+  } catch (...) {
+    releaseBlock(block);
+    throw;
+  }
+
+  try {
+    m_blocks.push_front(block);
+  } catch (...) {
+    std::destroy_at(elem);
+    releaseBlock(block);
+    throw;
+  }
+
+  m_frontOffset = BlockSize - 1;
+  ++m_currentSize;
+  return *elem;
+}
+
+template <typename T, size_t BlockSize>
+void SegmentedDeque<T, BlockSize>::pop_back() {
+  --m_currentSize;
+  std::destroy_at(address(m_currentSize));
+
+  if (m_currentSize == 0) {
+    releaseBlock(m_blocks.back());
+    m_blocks.pop_back();
+    m_frontOffset = 0;
+  } else if ((m_frontOffset + m_currentSize) % BlockSize == 0) {
+    releaseBlock(m_blocks.back());
+    m_blocks.pop_back();
+  }
+}
+
+template <typename T, size_t BlockSize>
+void SegmentedDeque<T, BlockSize>::pop_front() {
+  std::destroy_at(m_blocks.front() + m_frontOffset);
+  ++m_frontOffset;
+  --m_currentSize;
+
+  if (m_frontOffset == BlockSize || m_currentSize == 0) {
+    releaseBlock(m_blocks.front());
+    m_blocks.pop_front();
+    m_frontOffset = 0;
+  }
+}
+
+template <typename T, size_t BlockSize>
+T *SegmentedDeque<T, BlockSize>::address(size_t index) const {
+  const size_t position = m_frontOffset + index;
+  return m_blocks[position / BlockSize] + position % BlockSize;
+}
+
+template <typename T, size_t BlockSize>
+T *SegmentedDeque<T, BlockSize>::allocateBlock() {
+  if (m_spareBlock) {
+    return std::exchange(m_spareBlock, nullptr);
+  }
+
+  if (m_resource) {
+    return static_cast<T *>(m_resource->allocate(BLOCK_BYTES, alignof(T)));
+  }
+
+  return static_cast<T *>(
+      ::operator new(BLOCK_BYTES, std::align_val_t{alignof(T)}));
+}
+
+template <typename T, size_t BlockSize>
+void SegmentedDeque<T, BlockSize>::releaseBlock(T *block) {
+  if (!m_spareBlock) {
+    m_spareBlock = block;
+  } else {
+    deallocateBlock(block);
+  }
+}
+
+template <typename T, size_t BlockSize>
+void SegmentedDeque<T, BlockSize>::deallocateBlock(T *block) const {
+  if (m_resource) {
+    m_resource->deallocate(block, BLOCK_BYTES, alignof(T));
+  } else {
+    ::operator delete(block, std::align_val_t{alignof(T)});
+  }
+}
+
+template <typename T, size_t BlockSize>
+void SegmentedDeque<T, BlockSize>::swapContents(
+    SegmentedDeque &other) noexcept {
+  std::swap(m_blocks, other.m_blocks);
+  std::swap(m_spareBlock, other.m_spareBlock);
+  std::swap(m_frontOffset, other.m_frontOffset);
+  std::swap(m_currentSize, other.m_currentSize);
+}
+
+template <typename T, size_t BlockSize>
+T &SegmentedDeque<T, BlockSize>::at(size_t index) {
+  if (index >= m_currentSize) {
+    throw std::out_of_range{"Index out of range."};
+  }
+
+  return *address(index);
+}
+
+template <typename T, size_t BlockSize>
+T &SegmentedDeque<T, BlockSize>::operator[](size_t index) {
+  return *address(index);
+}
+
+template <typename T, size_t BlockSize>
+const T &SegmentedDeque<T, BlockSize>::operator[](size_t index) const {
+  return *address(index);
+}
+
+template <typename T, size_t BlockSize>
+T &SegmentedDeque<T, BlockSize>::back() {
+  return *address(m_currentSize - 1);
+}
+
+template <typename T, size_t BlockSize>
+const T &SegmentedDeque<T, BlockSize>::back() const {
+  return *address(m_currentSize - 1);
+}
+
+template <typename T, size_t BlockSize>
+T &SegmentedDeque<T, BlockSize>::front() {
+  return m_blocks.front()[m_frontOffset];
+}
+
+template <typename T, size_t BlockSize>
+const T &SegmentedDeque<T, BlockSize>::front() const {
+  return m_blocks.front()[m_frontOffset];
+}
+
+template <typename T, size_t BlockSize>
+SegmentedDequeIterator<T, BlockSize>
+SegmentedDeque<T, BlockSize>::begin() noexcept {
+  return SegmentedDequeIterator<T, BlockSize>{this, 0};
+}
+
+template <typename T, size_t BlockSize>
+SegmentedDequeCIterator<T, BlockSize> SegmentedDeque<T, BlockSize>::begin()
+    const noexcept {
+  return cbegin();
+}
+
+template <typename T, size_t BlockSize>
+SegmentedDequeCIterator<T, BlockSize> SegmentedDeque<T, BlockSize>::cbegin()
+    const noexcept {
+  return SegmentedDequeCIterator<T, BlockSize>{this, 0};
+}
+
+template <typename T, size_t BlockSize>
+SegmentedDequeIterator<T, BlockSize>
+SegmentedDeque<T, BlockSize>::end() noexcept {
+  return SegmentedDequeIterator<T, BlockSize>{
+      this, static_cast<std::ptrdiff_t>(size())};
+}
+
+template <typename T, size_t BlockSize>
+SegmentedDequeCIterator<T, BlockSize> SegmentedDeque<T, BlockSize>::end()
+    const noexcept {
+  return cend();
+}
+
+template <typename T, size_t BlockSize>
+SegmentedDequeCIterator<T, BlockSize> SegmentedDeque<T, BlockSize>::cend()
+    const noexcept {
+  return SegmentedDequeCIterator<T, BlockSize>{
+      this, static_cast<std::ptrdiff_t>(size())};
+}
+
+template <typename T, size_t BlockSize>
+std::reverse_iterator<SegmentedDequeIterator<T, BlockSize>>
+SegmentedDeque<T, BlockSize>::rbegin() noexcept {
+  return std::reverse_iterator{end()};
+}
+
+template <typename T, size_t BlockSize>
+std::reverse_iterator<SegmentedDequeCIterator<T, BlockSize>>
+SegmentedDeque<T, BlockSize>::rbegin() const noexcept {
+  return std::reverse_iterator{end()};
+}
+
+template <typename T, size_t BlockSize>
+std::reverse_iterator<SegmentedDequeIterator<T, BlockSize>>
+SegmentedDeque<T, BlockSize>::rend() noexcept {
+  return std::reverse_iterator{begin()};
+}
+
+template <typename T, size_t BlockSize>
+std::reverse_iterator<SegmentedDequeCIterator<T, BlockSize>>
+SegmentedDeque<T, BlockSize>::rend() const noexcept {
+  return std::reverse_iterator{begin()};
+}
+
+template <typename T, size_t BlockSize>
+size_t SegmentedDeque<T, BlockSize>::size() const {
+  return m_currentSize;
+}
+
+template <typename T, size_t BlockSize>
+bool SegmentedDeque<T, BlockSize>::empty() const {
+  return m_currentSize == 0;
+}
+
+template <typename T, size_t BlockSize>
+void SegmentedDeque<T, BlockSize>::clear(bool bDeleteInternalBuffer) {
+  while (!empty()) {
+    pop_back();
+  }
+
+  if (bDeleteInternalBuffer) {
+    shrink_to_fit();
+  }
+}
+
+template <typename T, size_t BlockSize>
+void SegmentedDeque<T, BlockSize>::shrink_to_fit() {
+  if (m_spareBlock) {
+    deallocateBlock(std::exchange(m_spareBlock, nullptr));
+  }
+  m_blocks.shrink_to_fit();
+}
+
+template <typename T, size_t BlockSize>
+std::pmr::memory_resource *SegmentedDeque<T, BlockSize>::resource()
+    const noexcept {
+  return m_resource;
+}
+
+template <typename T, size_t BlockSize>
+bool operator==(const SegmentedDeque<T, BlockSize> &lhs,
+                const SegmentedDeque<T, BlockSize> &rhs) {
+  return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename T, size_t BlockSize>
+bool operator!=(const SegmentedDeque<T, BlockSize> &lhs,
+                const SegmentedDeque<T, BlockSize> &rhs) {
+  return !(lhs == rhs);
+}
+
+#endif
@@ -0,0 +1,306 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
+#include <span>
+#include <utility>
+
+#include "../parallel/event_count.h"
+#include "ring_queue_capacity.h"
+
+/**
+ * Bounded FIFO queue between one producer thread and one consumer thread,
+ * for passing items between the stages of a pipeline.
+ *
+ * The elements live in a ring buffer allocated by the constructor; nothing is
+ * allocated afterwards. The producer only writes the tail index and the
+ * consumer only the head index, each in its own cache line. Both sides keep a
+ * cached copy of the other side's index and read the shared one only when
+ * the cached copy says the queue is full (or empty), so while the queue is
+ * neither, an operation touches no cache line written by the other thread
+ * besides the element itself.
+ *
+ * The try_ operations never block. push and pop wait while the queue is full
+ * or empty, sleeping in the kernel (EventCount) rather than spinning. Being
+ * able to wake a sleeper costs every push and pop an atomic read-modify-write
+ * on a line of its own side, once per call for the batch operations.
+ */
+template <typename T>
+class SpscQueue {
+ public:
+  /**
+   * Creates a queue for at least the given number of elements; the capacity
+   * is rounded up to a power of two. Throws exception if capacity is 0.
+   * @throw std::invalid_argument
+   */
+  explicit SpscQueue(size_t capacity);
+
+  SpscQueue(const SpscQueue &) = delete;
+  SpscQueue &operator=(const SpscQueue &) = delete;
+
+  ~SpscQueue();
+
+  // Producer side
+
+  /**
+   * Adds an element at the back, or returns false if the queue is full
+   */
+  bool try_push(const T &value) { return try_emplace(value); }
+  bool try_push(T &&value) { return try_emplace(std::move(value)); }
+
+  template <typename... Args>
+  bool try_emplace(Args &&...args);
+
+  /**
+   * Adds an element at the back, waiting while the queue is full
+   */
+  void push(const T &value);
+  void push(T &&value);
+
+  /**
+   * Copies as many of the given elements as there is room for to the back,
+   * in order, and returns how many it copied
+   */
+  size_t try_push_n(std::span<const T> values);
+
+  /**
+   * Copies all the given elements to the back, in order, waiting whenever the
+   * queue is full
+   */
+  void push_n(std::span<const T> values);
+
+  // Consumer side
+
+  /**
+   * Removes the front element, or returns std::nullopt if the queue is empty
+   */
+  std::optional<T> try_pop();
+
+  /**
+   * Removes the front element, waiting while the queue is empty
+   */
+  T pop();
+
+  /**
+   * Moves up to out.size() elements from the front into out and returns how
+   * many it moved
+   */
+  size_t try_pop_n(std::span<T> out);
+
+  /**
+   * Like try_pop_n, but waits while the queue is empty, so it moves at least
+   * one element unless out is empty
+   */
+  size_t pop_n(std::span<T> out);
+
+  // Either side
+
+  /**
+   * Returns the number of elements at the time of the call
+   */
+  size_t size() const;
+  bool empty() const { return size() == 0; }
+  size_t capacity() const { return m_mask + 1; }
+
+ private:
+  struct alignas(T) Slot {
+    unsigned char bytes[sizeof(T)];
+  };
+
+  T *element(size_t index) {
+    return std::launder(reinterpret_cast<T *>(&m_slots[index & m_mask]));
+  }
+
+  // Hands the slots of count popped elements back to the producer
+  void releaseSlots(size_t head, size_t count);
+
+  // The consumer's line: the index it pops at and its copy of the tail
+  alignas(64) std::atomic<size_t> m_head{0};
+  size_t m_cachedTail = 0;
+
+  // The producer's line: the index it pushes at and its copy of the head
+  alignas(64) std::atomic<size_t> m_tail{0};
+  size_t m_cachedHead = 0;
+
+  alignas(64) const size_t m_mask;
+  const std::unique_ptr<Slot[]> m_slots;
+  // Each is notified by a different side, so they get a cache line each
+  alignas(64) EventCount m_notEmpty;
+  alignas(64) EventCount m_notFull;
+};
+
+template <typename T>
+SpscQueue<T>::SpscQueue(size_t capacity)
+    : m_mask{ring_queue_detail::checkedCapacity(capacity) - 1},
+      m_slots{new Slot[m_mask + 1]} {}
+
+template <typename T>
+SpscQueue<T>::~SpscQueue() {
+  const size_t tail = m_tail.load(std::memory_order_relaxed);
+  for (size_t i = m_head.load(std::memory_order_relaxed); i != tail; i++) {
+    std::destroy_at(element(i));
+  }
+}
+
+template <typename T>
+template <typename... Args>
+bool SpscQueue<T>::try_emplace(Args &&...args) {
+  const size_t tail = m_tail.load(std::memory_order_relaxed);
+  if (tail - m_cachedHead == capacity()) {
+    m_cachedHead = m_head.load(std::memory_order_acquire);
+    if (tail - m_cachedHead == capacity()) {
+      return false;
+    }
+  }
+
+  ::new (static_cast<void *>(element(tail))) T(std::forward<Args>(args)...);
+  m_tail.store(tail + 1, std::memory_order_release);
+  m_notEmpty.notifyAll();
+  return true;
+}
+
+template <typename T>
+void SpscQueue<T>::push(const T &value) {
+  m_notFull.await([&] { return try_emplace(value); });
+}
+
+template <typename T>
+void SpscQueue<T>::push(T &&value) {
+  // try_emplace moves from value only when it succeeds
+  m_notFull.await([&] { return try_emplace(std::move(value)); });
+}
+
+template <typename T>
+size_t SpscQueue<T>::try_push_n(std::span<const T> values) {
+  const size_t tail = m_tail.load(std::memory_order_relaxed);
+  if (capacity() - (tail - m_cachedHead) < values.size()) {
+    m_cachedHead = m_head.load(std::memory_order_acquire);
+  }
+
+  const size_t count =
+      std::min(values.size(), capacity() - (tail - m_cachedHead));
+  if (count == 0) {
+    return 0;
+  }
+
+  size_t constructed = 0;
+  try {
+    for (; constructed < count; constructed++) {
+      ::new (static_cast<void *>(element(tail + constructed)))
+          T(values[constructed]);
+    }
+  } catch (...) {
+    for (size_t i = 0; i < constructed; i++) {
+      std::destroy_at(element(tail + i));
+    }
+    throw;
+  }
+
+  m_tail.store(tail + count, std::memory_order_release);
+  m_notEmpty.notifyAll();
+  return count;
+}
+
+template <typename T>
+void SpscQueue<T>::push_n(std::span<const T> values) {
+  while (!values.empty()) {
+    size_t pushed = 0;
+    m_notFull.await([&] {
+      pushed = try_push_n(values);
+      return pushed > 0;
+    });
+    values = values.subspan(pushed);
+  }
+}
+
+template <typename T>
+std::optional<T> SpscQueue<T>::try_pop() {
+  const size_t head = m_head.load(std::memory_order_relaxed);
+  if (head == m_cachedTail) {
+    m_cachedTail = m_tail.load(std::memory_order_acquire);
+    if (head == m_cachedTail) {
+      return std::nullopt;
+    }
+  }
+
+  T *front = element(head);
+  std::optional<T> value{std::move(*front)};
+  std::destroy_at(front);
+  releaseSlots(head, 1);
+  return value;
+}
+
+template <typename T>
+T SpscQueue<T>::pop() {
+  std::optional<T> value;
+  m_notEmpty.await([&] {
+    value = try_pop();
+    return value.has_value();
+  });
+
+  return std::move(*value);
+}
+
+template <typename T>
+size_t SpscQueue<T>::try_pop_n(std::span<T> out) {
+  const size_t head = m_head.load(std::memory_order_relaxed);
+  if (m_cachedTail - head < out.size()) {
+    m_cachedTail = m_tail.load(std::memory_order_acquire);
+  }
+
+  const size_t count = std::min(out.size(), m_cachedTail - head);
+  size_t moved = 0;
+  try {
+    for (; moved < count; moved++) {
+      out[moved] = std::move(*element(head + moved));
+      std::destroy_at(element(head + moved));
+    }
+  } catch (...) {
+    // the element whose assignment threw stays in the queue
+    releaseSlots(head, moved);
+    throw;
+  }
+
+  releaseSlots(head, count);
+  return count;
+}
+
+template <typename T>
+size_t SpscQueue<T>::pop_n(std::span<T> out) {
+  if (out.empty()) {
+    return 0;
+  }
+
+  size_t popped = 0;
+  m_notEmpty.await([&] {
+    popped = try_pop_n(out);
+    return popped > 0;
+  });
+
+  return popped;
+}
+
+template <typename T>
+void SpscQueue<T>::releaseSlots(size_t head, size_t count) {
+  if (count > 0) {
+    m_head.store(head + count, std::memory_order_release);
+    m_notFull.notifyAll();
+  }
+}
+
+template <typename T>
+size_t SpscQueue<T>::size() const {
+  // head first: read the other way round, a pop and a push in between could
+  // make head pass the stale tail
+  const size_t head = m_head.load(std::memory_order_acquire);
+  const size_t tail = m_tail.load(std::memory_order_acquire);
+  return tail - head;
+}
+
+#endif
@@ -1,5 +1,14 @@
 #include "catch.hpp"
 #include "deque.h"
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <numeric>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <utility>
 
 TEST_CASE("Deque is empty and has no buffer on construction with "
           "default constructor") {
@@ -320,3 +329,274 @@ TEST_CASE("Pop front and pop back many times") {
     ++expectedFront;
   }
 }
+
+TEST_CASE("Deque of non-trivial elements grows and copies correctly") {
+  Deque<std::string> deque;
+  for (int i = 0; i < 1000; i++) {
+    deque.push_back(std::to_string(i));
+    deque.push_front(std::to_string(-i));
+  }
+
+  REQUIRE(deque.size() == 2000);
+  REQUIRE(deque.front() == "-999");
+  REQUIRE(deque.back() == "999");
+
+  Deque<std::string> deque_copy{deque};
+  REQUIRE(deque_copy == deque);
+
+  Deque<std::string> deque_equals;
+  deque_equals.push_back("will be overwritten");
+  deque_equals = deque;
+  REQUIRE(deque_equals == deque);
+}
+
+TEST_CASE("Copy of an empty deque is empty") {
+  Deque<long long> deque;
+  Deque<long long> deque_copy{deque};
+  REQUIRE(deque_copy.empty());
+
+  deque_copy.push_front(5);
+  REQUIRE(deque_copy.front() == 5);
+}
+
+TEST_CASE("Deque works with the standard algorithms and ranges") {
+  static_assert(std::random_access_iterator<DequeIterator<int>>);
+  static_assert(std::ranges::random_access_range<Deque<int>>);
+  static_assert(std::ranges::random_access_range<const Deque<int>>);
+  static_assert(std::ranges::sized_range<Deque<int>>);
+
+  Deque<int> deque;
+  for (int i = 0; i < 1000; i += 2) {
+    deque.push_back(i);
+    deque.push_front(i + 1);
+  }
+
+  std::sort(deque.begin(), deque.end());
+  REQUIRE(std::is_sorted(deque.cbegin(), deque.cend()));
+  REQUIRE(deque.front() == 0);
+  REQUIRE(deque.back() == 999);
+  REQUIRE(std::ranges::binary_search(deque, 500));
+  REQUIRE(deque.end() - deque.begin() == 1000);
+  REQUIRE(deque.begin()[10] == deque[10]);
+
+  std::ranges::reverse(deque);
+  REQUIRE(*deque.rbegin() == 0);
+  REQUIRE(std::accumulate(deque.rbegin(), deque.rend(), 0) == 999 * 1000 / 2);
+
+  const Deque<int> &constDeque = deque;
+  DequeCIterator<int> it = deque.begin();
+  REQUIRE(it == constDeque.begin());
+  int expected = 999;
+  for (const int &value : constDeque) {
+    REQUIRE(value == expected--);
+  }
+
+  Deque<int> empty;
+  REQUIRE(empty.begin() == empty.end());
+}
+
+TEST_CASE("Deque used as a queue reuses its buffer") {
+  Deque<int> deque;
+  for (int i = 0; i < 100; i++) {
+    deque.push_back(i);
+  }
+  const size_t capacity = deque.capacity();
+  REQUIRE(capacity == 128);
+
+  // the front and the back wrap around the end of the buffer many times
+  for (int i = 100; i < 100'000; i++) {
+    deque.push_back(i);
+    REQUIRE(deque.front() == i - 100);
+    deque.pop_front();
+  }
+
+  REQUIRE(deque.capacity() == capacity);
+  REQUIRE(deque.size() == 100);
+  for (int i = 0; i < 100; i++) {
+    REQUIRE(deque[i] == 99'900 + i);
+  }
+  REQUIRE(std::ranges::is_sorted(deque));
+}
+
+TEST_CASE("Deque keeps its order when it grows while wrapped around") {
+  Deque<std::string> strings;
+  Deque<long long> numbers;
+  for (int i = 0; i < 1000; i++) {
+    // half of the pushes go to the front, so the elements wrap around
+    if (i % 2 == 0) {
+      strings.push_back(std::to_string(i));
+      numbers.push_back(i);
+    } else {
+      strings.push_front(std::to_string(-i));
+      numbers.push_front(-i);
+    }
+  }
+
+  for (int i = 0; i < 500; i++) {
+    REQUIRE(strings[i] == std::to_string(-(999 - 2 * i)));
+    REQUIRE(strings[500 + i] == std::to_string(2 * i));
+    REQUIRE(numbers[i] == -(999 - 2 * i));
+    REQUIRE(numbers[500 + i] == 2 * i);
+  }
+}
+
+TEST_CASE("Deque constructs elements in place and moves them") {
+  Deque<std::unique_ptr<int>> deque;
+  for (int i = 0; i < 100; i++) {
+    deque.emplace_back(std::make_unique<int>(i));
+    deque.push_front(std::make_unique<int>(-i));
+  }
+  REQUIRE(*deque.front() == -99);
+  REQUIRE(*deque.back() == 99);
+
+  Deque<std::unique_ptr<int>> moved{std::move(deque)};
+  REQUIRE(deque.empty());
+  REQUIRE(deque.capacity() == 0);
+  REQUIRE(moved.size() == 200);
+
+  deque = std::move(moved);
+  REQUIRE(deque.size() == 200);
+  REQUIRE(*deque[100] == 0);
+
+  Deque<std::pair<int, std::string>> pairs;
+  std::pair<int, std::string> &pair = pairs.emplace_front(3, "three");
+  REQUIRE(pair.second == "three");
+  REQUIRE(pairs.emplace_back(4, "four").first == 4);
+}
+
+TEST_CASE("Deque push_back of its own element survives growth") {
+  Deque<std::string> deque;
+  deque.push_back(std::string(50, 'a'));
+  while (deque.size() < deque.capacity()) {
+    deque.push_back("x");
+  }
+
+  deque.push_back(deque.front());
+  deque.push_front(deque.back());
+  REQUIRE(deque.front() == std::string(50, 'a'));
+  REQUIRE(deque.back() == std::string(50, 'a'));
+}
+
+TEST_CASE("Deque destroys its elements") {
+  auto counter = std::make_shared<int>(0);
+  {
+    Deque<std::shared_ptr<int>> deque;
+    for (int i = 0; i < 50; i++) {
+      deque.push_back(counter);
+      deque.push_front(counter);
+    }
+    REQUIRE(counter.use_count() == 101);
+
+    deque.pop_back();
+    deque.pop_front();
+    REQUIRE(counter.use_count() == 99);
+
+    Deque<std::shared_ptr<int>> copy{deque};
+    REQUIRE(counter.use_count() == 197);
+    copy.clear();
+    REQUIRE(counter.use_count() == 99);
+  }
+  REQUIRE(counter.use_count() == 1);
+}
+
+TEST_CASE("Deque shrink_to_fit releases the unused buffer") {
+  Deque<std::string> deque;
+  for (int i = 0; i < 1000; i++) {
+    deque.push_front(std::to_string(i));
+  }
+  REQUIRE(deque.capacity() == 1024);
+
+  while (deque.size() > 10) {
+    deque.pop_back();
+  }
+  deque.shrink_to_fit();
+  REQUIRE(deque.capacity() == 16);
+  REQUIRE(deque.front() == "999");
+  REQUIRE(deque.back() == "990");
+
+  deque.clear();
+  deque.shrink_to_fit();
+  REQUIRE(deque.capacity() == 0);
+  deque.push_back("again");
+  REQUIRE(deque.front() == "again");
+}
+
+TEST_CASE("Deque size constructor value-initializes the elements") {
+  Deque<std::string> deque{5};
+  REQUIRE(deque.size() == 5);
+  REQUIRE(deque.capacity() == 8);
+  for (const std::string &s : deque) {
+    REQUIRE(s.empty());
+  }
+
+  Deque<int> numbers{3};
+  REQUIRE(numbers[2] == 0);
+}
+
+TEST_CASE("Deque move assignment across memory resources moves elements") {
+  std::pmr::monotonic_buffer_resource arena;
+  Deque<std::string> onArena{&arena};
+  for (int i = 0; i < 20; i++) {
+    onArena.push_back(std::to_string(i));
+  }
+
+  Deque<std::string> onHeap;
+  onHeap = std::move(onArena);
+  REQUIRE(onHeap.resource() == nullptr);
+  REQUIRE(onHeap.size() == 20);
+  REQUIRE(onHeap.back() == "19");
+  REQUIRE(onArena.empty());
+}
+
+namespace {
+// Move-only element whose move constructor throws once movesLeft runs out
+struct FragileMove {
+  static inline int live = 0;
+  static inline int movesLeft = -1;
+
+  explicit FragileMove(int v) : value{std::make_unique<int>(v)} { ++live; }
+  FragileMove(FragileMove &&other) : value{std::move(other.value)} {
+    if (movesLeft == 0) {
+      other.value = std::move(value);
+      throw std::runtime_error("move failed");
+    }
+    --movesLeft;
+    ++live;
+  }
+  ~FragileMove() { --live; }
+
+  std::unique_ptr<int> value;
+};
+}  // namespace
+
+TEST_CASE("Deque of move-only elements frees the new buffer when a move "
+          "throws during growth") {
+  {
+    Deque<FragileMove> deque;
+    // wrapped around, so that both runs of the buffer are moved
+    for (int i = 0; i < 4; i++) {
+      deque.emplace_back(i);
+    }
+    for (int i = 4; i < 8; i++) {
+      deque.emplace_front(i);
+    }
+    REQUIRE(deque.capacity() == 8);
+
+    FragileMove::movesLeft = 6;
+    REQUIRE_THROWS_AS(deque.emplace_back(8), std::runtime_error);
+    FragileMove::movesLeft = -1;
+
+    // Only the elements of the deque are alive, still in the old buffer.
+    // Those moved before the throw are left moved-from.
+    REQUIRE(FragileMove::live == 8);
+    REQUIRE(deque.size() == 8);
+    REQUIRE(deque.capacity() == 8);
+    REQUIRE(deque.front().value == nullptr);
+    REQUIRE(*deque.back().value == 3);
+
+    deque.emplace_back(8);
+    REQUIRE(deque.size() == 9);
+    REQUIRE(*deque.back().value == 8);
+  }
+  REQUIRE(FragileMove::live == 0);
+}
@@ -0,0 +1,182 @@
+#include "catch.hpp"
+#include "mpmc_queue.h"
+#include "spsc_queue.h"
+#include <array>
+#include <atomic>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEMPLATE_TEST_CASE("Ring queue is a bounded FIFO", "", SpscQueue<int>,
+                   MpmcQueue<int>) {
+  REQUIRE_THROWS_AS(TestType{0}, std::invalid_argument);
+
+  TestType queue{5};
+  REQUIRE(queue.capacity() == 8);
+  REQUIRE(queue.empty());
+  REQUIRE(!queue.try_pop());
+
+  // goes around the ring a few times
+  for (int lap = 0; lap < 3; lap++) {
+    for (int i = 0; i < 8; i++) {
+      REQUIRE(queue.try_push(lap * 10 + i));
+    }
+    REQUIRE(!queue.try_push(-1));
+    REQUIRE(queue.size() == 8);
+
+    for (int i = 0; i < 8; i++) {
+      REQUIRE(queue.try_pop() == lap * 10 + i);
+    }
+    REQUIRE(!queue.try_pop());
+    REQUIRE(queue.empty());
+  }
+}
+
+TEMPLATE_TEST_CASE("Ring queue moves batches as far as there is room", "",
+                   SpscQueue<int>, MpmcQueue<int>) {
+  TestType queue{8};
+  std::vector<int> values(10);
+  std::iota(values.begin(), values.end(), 0);
+
+  REQUIRE(queue.try_push(-1));
+  REQUIRE(queue.try_push_n(values) == 7);
+  REQUIRE(queue.try_push_n(values) == 0);
+
+  std::array<int, 3> out{};
+  REQUIRE(queue.try_pop_n(out) == 3);
+  REQUIRE(out == std::array{-1, 0, 1});
+
+  // wraps around the end of the ring
+  REQUIRE(queue.try_push_n(std::span{values}.subspan(7)) == 3);
+
+  std::array<int, 16> rest{};
+  REQUIRE(queue.try_pop_n(rest) == 8);
+  for (int i = 0; i < 8; i++) {
+    REQUIRE(rest[i] == i + 2);
+  }
+  REQUIRE(queue.try_pop_n(rest) == 0);
+}
+
+TEMPLATE_TEST_CASE("Ring queue destroys the elements left in it", "",
+                   SpscQueue<std::shared_ptr<std::string>>,
+                   MpmcQueue<std::shared_ptr<std::string>>) {
+  auto shared = std::make_shared<std::string>("element");
+  {
+    TestType queue{4};
+    queue.push(shared);
+    queue.push(shared);
+    const std::vector<std::shared_ptr<std::string>> batch{shared, shared};
+    queue.push_n(batch);
+    REQUIRE(shared.use_count() == 7);
+
+    REQUIRE(*queue.pop() == "element");
+    REQUIRE(shared.use_count() == 6);
+  }
+  REQUIRE(shared.use_count() == 1);
+}
+
+TEST_CASE("SPSC queue passes every element in order between two threads") {
+  const int ELEMENTS = 200'000;
+  SpscQueue<int> queue{64};
+
+  // Every other block of elements is pushed and popped in batches. The queue
+  // is small, so both threads keep waiting for each other.
+  std::thread producer{[&queue] {
+    std::array<int, 100> batch;
+    for (int i = 0; i < ELEMENTS; i += 100) {
+      if (i % 200 == 0) {
+        std::iota(batch.begin(), batch.end(), i);
+        queue.push_n(batch);
+      } else {
+        for (int j = i; j < i + 100; j++) {
+          queue.push(j);
+        }
+      }
+    }
+  }};
+
+  int expected = 0;
+  std::array<int, 37> out;
+  while (expected < ELEMENTS) {
+    if (expected % 2 == 0) {
+      REQUIRE(queue.pop() == expected++);
+    } else {
+      const size_t popped = queue.pop_n(out);
+      REQUIRE(popped > 0);
+      for (size_t i = 0; i < popped; i++) {
+        REQUIRE(out[i] == expected++);
+      }
+    }
+  }
+
+  producer.join();
+  REQUIRE(queue.empty());
+}
+
+TEST_CASE("MPMC queue hands every element to exactly one consumer") {
+  const int PRODUCERS = 3;
+  const int CONSUMERS = 3;
+  const int PER_PRODUCER = 50'000;
+  MpmcQueue<int> queue{32};
+
+  std::vector<std::thread> producers;
+  for (int p = 0; p < PRODUCERS; p++) {
+    producers.emplace_back([&queue, p] {
+      // the elements of producer p are p, p + PRODUCERS, p + 2 * PRODUCERS...
+      std::array<int, 10> batch;
+      for (int i = 0; i < PER_PRODUCER; i += 10) {
+        for (int j = 0; j < 10; j++) {
+          batch[j] = (i + j) * PRODUCERS + p;
+        }
+        if (i % 20 == 0) {
+          queue.push_n(batch);
+        } else {
+          for (int value : batch) {
+            queue.push(value);
+          }
+        }
+      }
+    });
+  }
+
+  std::vector<std::atomic<int>> taken(PRODUCERS * PER_PRODUCER);
+  std::atomic<int> remaining = PRODUCERS * PER_PRODUCER;
+  std::atomic<bool> ordered = true;
+  std::vector<std::thread> consumers;
+  for (int c = 0; c < CONSUMERS; c++) {
+    consumers.emplace_back([&] {
+      // every consumer sees the elements of each producer in push order
+      std::array<int, PRODUCERS> last;
+      last.fill(-1);
+      std::array<int, 8> out;
+      while (remaining > 0) {
+        const size_t popped = queue.try_pop_n(out);
+        for (size_t i = 0; i < popped; i++) {
+          ++taken[out[i]];
+          ordered = ordered && out[i] > last[out[i] % PRODUCERS];
+          last[out[i] % PRODUCERS] = out[i];
+        }
+        remaining -= static_cast<int>(popped);
+        if (popped == 0) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  for (std::thread &thread : producers) {
+    thread.join();
+  }
+  for (std::thread &thread : consumers) {
+    thread.join();
+  }
+
+  REQUIRE(ordered);
+  REQUIRE(queue.empty());
+  for (std::atomic<int> &count : taken) {
+    REQUIRE(count == 1);
+  }
+}
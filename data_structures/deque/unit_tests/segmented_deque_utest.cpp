@@ -0,0 +1,172 @@
+#include "catch.hpp"
+#include "segmented_deque.h"
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <numeric>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+static_assert(segmentedDequeBlockSize<char>() == 4096);
+static_assert(segmentedDequeBlockSize<double>() == 512);
+static_assert(segmentedDequeBlockSize<char[1000]>() == 16);
+
+TEST_CASE("Segmented deque pushes and pops at both ends") {
+  SegmentedDeque<int, 16> deque;
+  REQUIRE(deque.empty());
+
+  for (int i = 1; i <= 1000; i++) {
+    deque.push_front(i);
+    deque.push_back(-i);
+    REQUIRE(deque.front() == i);
+    REQUIRE(deque.back() == -i);
+  }
+  REQUIRE(deque.size() == 2000);
+
+  for (int i = 0; i < 1000; i++) {
+    REQUIRE(deque[i] == 1000 - i);
+    REQUIRE(deque.at(1000 + i) == -(i + 1));
+  }
+  REQUIRE_THROWS_AS(deque.at(2000), std::out_of_range);
+
+  for (int i = 1000; i >= 1; i--) {
+    REQUIRE(deque.front() == i);
+    deque.pop_front();
+    REQUIRE(deque.back() == -i);
+    deque.pop_back();
+  }
+  REQUIRE(deque.empty());
+
+  deque.push_back(7);
+  REQUIRE(deque.front() == 7);
+}
+
+TEST_CASE("Segmented deque keeps references valid while it grows") {
+  SegmentedDeque<std::string, 16> deque;
+  deque.push_back("first");
+  std::string *first = &deque.front();
+  std::string *last = &deque.emplace_back(3, 'x');
+
+  for (int i = 0; i < 10'000; i++) {
+    deque.push_back(std::to_string(i));
+    deque.push_front(std::to_string(-i));
+  }
+
+  REQUIRE(first == &deque[10'000]);
+  REQUIRE(*first == "first");
+  REQUIRE(last == &deque[10'001]);
+  REQUIRE(*last == "xxx");
+
+  // pushing an element of the deque itself is safe, as nothing moves
+  deque.push_back(deque.front());
+  REQUIRE(deque.back() == "-9999");
+}
+
+TEST_CASE("Segmented deque used as a queue keeps few blocks") {
+  struct CountingResource : std::pmr::memory_resource {
+    size_t outstanding = 0;
+
+    void *do_allocate(size_t bytes, size_t alignment) override {
+      ++outstanding;
+      return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void *p, size_t bytes, size_t alignment) override {
+      --outstanding;
+      std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const memory_resource &other) const noexcept override {
+      return this == &other;
+    }
+  };
+
+  CountingResource resource;
+  {
+    SegmentedDeque<int, 16> deque{&resource};
+    for (int i = 0; i < 100; i++) {
+      deque.push_back(i);
+    }
+
+    for (int i = 100; i < 100'000; i++) {
+      deque.push_back(i);
+      REQUIRE(deque.front() == i - 100);
+      deque.pop_front();
+    }
+
+    // 7 or 8 blocks, a spare block and the map
+    REQUIRE(resource.outstanding <= 10);
+    REQUIRE(deque.resource() == &resource);
+    REQUIRE(std::ranges::is_sorted(deque));
+  }
+  REQUIRE(resource.outstanding == 0);
+}
+
+TEST_CASE("Segmented deque copies, moves and destroys its elements") {
+  auto counter = std::make_shared<int>(0);
+  {
+    SegmentedDeque<std::shared_ptr<int>, 16> deque;
+    for (int i = 0; i < 50; i++) {
+      deque.push_back(counter);
+      deque.push_front(counter);
+    }
+    REQUIRE(counter.use_count() == 101);
+
+    SegmentedDeque<std::shared_ptr<int>, 16> copy{deque};
+    REQUIRE(copy == deque);
+    REQUIRE(counter.use_count() == 201);
+
+    SegmentedDeque<std::shared_ptr<int>, 16> moved{std::move(copy)};
+    REQUIRE(copy.empty());
+    REQUIRE(counter.use_count() == 201);
+
+    deque.pop_back();
+    deque = moved;
+    REQUIRE(deque.size() == 100);
+    REQUIRE(counter.use_count() == 201);
+
+    moved.clear(true);
+    REQUIRE(counter.use_count() == 101);
+
+    moved = std::move(deque);
+    REQUIRE(deque.empty());
+    REQUIRE(moved.size() == 100);
+    REQUIRE(counter.use_count() == 101);
+  }
+  REQUIRE(counter.use_count() == 1);
+}
+
+TEST_CASE("Segmented deque holds move-only elements") {
+  SegmentedDeque<std::unique_ptr<int>> deque;
+  for (int i = 0; i < 1000; i++) {
+    deque.push_back(std::make_unique<int>(i));
+  }
+  deque.emplace_front(std::make_unique<int>(-1));
+
+  REQUIRE(*deque.front() == -1);
+  REQUIRE(*deque.back() == 999);
+}
+
+TEST_CASE("Segmented deque works with the standard algorithms and ranges") {
+  static_assert(
+      std::random_access_iterator<SegmentedDequeIterator<int>>);
+  static_assert(std::ranges::random_access_range<SegmentedDeque<int>>);
+  static_assert(std::ranges::random_access_range<const SegmentedDeque<int>>);
+
+  SegmentedDeque<int, 32> deque{1000};
+  REQUIRE(deque.size() == 1000);
+  REQUIRE(std::ranges::all_of(deque, [](int value) { return value == 0; }));
+
+  std::iota(deque.begin(), deque.end(), 0);
+  std::ranges::reverse(deque);
+  REQUIRE(deque.front() == 999);
+  REQUIRE(*deque.rbegin() == 0);
+  REQUIRE(std::accumulate(deque.cbegin(), deque.cend(), 0) == 999 * 1000 / 2);
+
+  std::sort(deque.begin(), deque.end());
+  REQUIRE(std::ranges::binary_search(deque, 500));
+  REQUIRE(deque.end() - deque.begin() == 1000);
+}
@@ -0,0 +1,92 @@
+#include "catch.hpp"
+#include "work_stealing_deque.h"
+#include <atomic>
+#include <optional>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Work-stealing deque pops the newest and steals the oldest") {
+  WorkStealingDeque<int> deque;
+  REQUIRE(deque.empty());
+  REQUIRE(!deque.pop());
+  REQUIRE(!deque.steal());
+
+  for (int i = 1; i <= 5; i++) {
+    deque.push(i);
+  }
+  REQUIRE(deque.size() == 5);
+
+  REQUIRE(deque.pop() == 5);
+  REQUIRE(deque.steal() == 1);
+  REQUIRE(deque.steal() == 2);
+  REQUIRE(deque.pop() == 4);
+  REQUIRE(deque.pop() == 3);
+  REQUIRE(deque.empty());
+  REQUIRE(!deque.pop());
+  REQUIRE(!deque.steal());
+}
+
+TEST_CASE("Work-stealing deque grows and keeps the order of its elements") {
+  WorkStealingDeque<int> deque{2};
+  REQUIRE(deque.capacity() == 2);
+
+  // Moves the ring away from index 0 before it grows
+  deque.push(-1);
+  REQUIRE(deque.steal() == -1);
+
+  for (int i = 0; i < 1000; i++) {
+    deque.push(i);
+  }
+  REQUIRE(deque.size() == 1000);
+  REQUIRE(deque.capacity() == 1024);
+
+  for (int i = 0; i < 500; i++) {
+    REQUIRE(deque.steal() == i);
+  }
+  for (int i = 999; i >= 500; i--) {
+    REQUIRE(deque.pop() == i);
+  }
+  REQUIRE(deque.empty());
+}
+
+TEST_CASE("Work-stealing deque hands every element to exactly one thread") {
+  const int ELEMENTS = 100'000;
+  const int THIEVES = 3;
+
+  WorkStealingDeque<int> deque{4};
+  std::vector<std::atomic<int>> taken(ELEMENTS);
+  std::atomic<bool> ownerDone{false};
+
+  std::vector<std::thread> thieves;
+  for (int t = 0; t < THIEVES; t++) {
+    thieves.emplace_back([&] {
+      while (!ownerDone || !deque.empty()) {
+        if (std::optional<int> value = deque.steal()) {
+          ++taken[*value];
+        }
+      }
+    });
+  }
+
+  // The owner keeps the deque short, so that it often races the thieves
+  // for the last element
+  for (int i = 0; i < ELEMENTS; i++) {
+    deque.push(i);
+    if (i % 3 == 0) {
+      if (std::optional<int> value = deque.pop()) {
+        ++taken[*value];
+      }
+    }
+  }
+  while (std::optional<int> value = deque.pop()) {
+    ++taken[*value];
+  }
+  ownerDone = true;
+
+  for (std::thread &thief : thieves) {
+    thief.join();
+  }
+  for (std::atomic<int> &count : taken) {
+    REQUIRE(count == 1);
+  }
+}
@@ -0,0 +1,206 @@
+#ifndef WORK_STEALING_DEQUE_H
+#define WORK_STEALING_DEQUE_H
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * Lock-free deque of one owner thread and any number of thieves (Chase and
+ * Lev, 2005, with the memory orders of Le et al., 2013), the building block
+ * of a work-stealing scheduler.
+ *
+ * The owner pushes and pops at the bottom, in LIFO order, which keeps the
+ * task it forked last - whose data is still in its cache - for itself. Other
+ * threads steal from the top, taking the oldest tasks, which in a recursive
+ * computation are the largest ones. Owner and thieves only compete for the
+ * last element.
+ *
+ * The buffer is a ring whose capacity is a power of two; when it is full the
+ * owner copies it to one twice as large. A thief may still be reading the old
+ * buffer, so old buffers are kept until the deque is destroyed. As each one
+ * is half the size of the next, they take less memory than the current one.
+ *
+ * Elements are read by thieves while the owner may overwrite them, so they
+ * are kept in atomics: T must be trivially copyable, typically a pointer to
+ * a task.
+ */
+template <typename T>
+class WorkStealingDeque {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "Elements must be trivially copyable.");
+
+ public:
+  explicit WorkStealingDeque(size_t initialCapacity = 64);
+
+  WorkStealingDeque(const WorkStealingDeque &) = delete;
+  WorkStealingDeque &operator=(const WorkStealingDeque &) = delete;
+
+  /**
+   * Adds an element at the bottom. Only the owner may call it.
+   */
+  void push(T value);
+
+  /**
+   * Removes the element at the bottom, the one pushed last, or returns
+   * std::nullopt if the deque is empty. Only the owner may call it.
+   */
+  std::optional<T> pop();
+
+  /**
+   * Removes the element at the top, the oldest one. Returns std::nullopt if
+   * the deque is empty or another thread took the element first. Any thread
+   * may call it.
+   */
+  std::optional<T> steal();
+
+  /**
+   * Returns the number of elements at the time of the call
+   */
+  size_t size() const;
+  bool empty() const;
+
+  /**
+   * Returns the number of elements the current buffer has room for
+   */
+  size_t capacity() const;
+
+ private:
+  struct Buffer {
+    explicit Buffer(size_t capacity)
+        : mask{capacity - 1}, slots{new std::atomic<T>[capacity]} {}
+
+    size_t capacity() const { return mask + 1; }
+
+    T get(int64_t index) const {
+      return slots[index & mask].load(std::memory_order_relaxed);
+    }
+
+    void put(int64_t index, T value) {
+      slots[index & mask].store(value, std::memory_order_relaxed);
+    }
+
+    size_t mask;
+    std::unique_ptr<std::atomic<T>[]> slots;
+  };
+
+  Buffer *grow(Buffer *buffer, int64_t top, int64_t bottom);
+
+  // top is advanced by thieves, bottom only by the owner. They are kept in
+  // separate cache lines, so that pushes do not slow down steals.
+  alignas(64) std::atomic<int64_t> m_top{0};
+  alignas(64) std::atomic<int64_t> m_bottom{0};
+  std::atomic<Buffer *> m_buffer;
+
+  // All buffers, the current one last. Touched only by the owner.
+  std::vector<std::unique_ptr<Buffer>> m_buffers;
+};
+
+template <typename T>
+WorkStealingDeque<T>::WorkStealingDeque(size_t initialCapacity) {
+  m_buffers.push_back(std::make_unique<Buffer>(
+      std::bit_ceil(std::max<size_t>(initialCapacity, 2))));
+  m_buffer.store(m_buffers.back().get(), std::memory_order_relaxed);
+}
+
+template <typename T>
+void WorkStealingDeque<T>::push(T value) {
+  const int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+  const int64_t top = m_top.load(std::memory_order_acquire);
+  Buffer *buffer = m_buffer.load(std::memory_order_relaxed);
+  if (bottom - top >= static_cast<int64_t>(buffer->capacity())) {
+    buffer = grow(buffer, top, bottom);
+  }
+
+  buffer->put(bottom, value);
+  // publishes the element to the thieves which read the new bottom
+  m_bottom.store(bottom + 1, std::memory_order_release);
+}
+
+template <typename T>
+std::optional<T> WorkStealingDeque<T>::pop() {
+  const int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+  Buffer *buffer = m_buffer.load(std::memory_order_relaxed);
+  // Claims the bottom element before looking at top. Both accesses are
+  // sequentially consistent, as are the ones of steal, so a thief either
+  // sees the claim or the owner sees the thief's advanced top.
+  m_bottom.store(bottom, std::memory_order_seq_cst);
+  int64_t top = m_top.load(std::memory_order_seq_cst);
+
+  if (top > bottom) {
+    // was empty
+    m_bottom.store(bottom + 1, std::memory_order_relaxed);
+    return std::nullopt;
+  }
+
+  std::optional<T> value{buffer->get(bottom)};
+  if (top == bottom) {
+    // The last element, which a thief may be taking at the same time
+    if (!m_top.compare_exchange_strong(top, top + 1,
+                                       std::memory_order_seq_cst,
+                                       std::memory_order_relaxed)) {
+      value.reset();
+    }
+    m_bottom.store(bottom + 1, std::memory_order_relaxed);
+  }
+
+  return value;
+}
+
+template <typename T>
+std::optional<T> WorkStealingDeque<T>::steal() {
+  int64_t top = m_top.load(std::memory_order_seq_cst);
+  const int64_t bottom = m_bottom.load(std::memory_order_seq_cst);
+  if (top >= bottom) {
+    return std::nullopt;
+  }
+
+  // The element is read before it is claimed; if the claim fails, the
+  // value may have been overwritten and is dropped
+  const T value = m_buffer.load(std::memory_order_acquire)->get(top);
+  if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                     std::memory_order_relaxed)) {
+    return std::nullopt;
+  }
+
+  return value;
+}
+
+template <typename T>
+typename WorkStealingDeque<T>::Buffer *WorkStealingDeque<T>::grow(
+    Buffer *buffer, int64_t top, int64_t bottom) {
+  auto grown = std::make_unique<Buffer>(buffer->capacity() * 2);
+  for (int64_t i = top; i < bottom; i++) {
+    grown->put(i, buffer->get(i));
+  }
+
+  Buffer *result = grown.get();
+  m_buffers.push_back(std::move(grown));
+  m_buffer.store(result, std::memory_order_release);
+  return result;
+}
+
+template <typename T>
+size_t WorkStealingDeque<T>::size() const {
+  const int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+  const int64_t top = m_top.load(std::memory_order_relaxed);
+  return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+}
+
+template <typename T>
+bool WorkStealingDeque<T>::empty() const {
+  return size() == 0;
+}
+
+template <typename T>
+size_t WorkStealingDeque<T>::capacity() const {
+  return m_buffer.load(std::memory_order_relaxed)->capacity();
+}
+
+#endif
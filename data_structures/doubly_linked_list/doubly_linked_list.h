@@ -2,7 +2,14 @@
 #define DOUBLY_LINKED_LIST_H
 
 #include <cstddef>
+#include <functional>
+#include <memory_resource>
+#include <new>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "../memory/node_pool.h"
 
 template <typename T>
 struct Node {
@@ -23,13 +30,31 @@ using DoublyLinkedListIterator = DLLIterator<T, T &, Node<T>>;
 template <typename T>
 using DoublyLinkedListCIterator = DLLIterator<T, const T &, const Node<T>>;
 
+/**
+ * Every list allocates its nodes from a NodePool of its own, whose slabs are
+ * taken from the given std::pmr::memory_resource, or from the global heap if
+ * no resource (nullptr) is given. Erased nodes are reused by later
+ * insertions, and clear() and the destructor give the slabs back at once
+ * instead of freeing the nodes one by one. Copies use the global heap and
+ * assignment never changes the resource of the target.
+ *
+ * Moving a list, splicing and merging relink the nodes of the source into
+ * the target as long as both lists use equal resources. The first time two
+ * lists exchange nodes their pools are joined into one SharedNodePool, which
+ * both use from then on; while it is shared, clear() frees the nodes one by
+ * one, as the slabs may hold nodes of the other list. Between lists with
+ * different resources the elements are copied instead.
+ */
 template <typename T>
 class DoublyLinkedList {
  public:
   DoublyLinkedList() = default;
+  explicit DoublyLinkedList(std::pmr::memory_resource *resource);
   DoublyLinkedList(const DoublyLinkedList &other);             // O(n)
   DoublyLinkedList &operator=(const DoublyLinkedList &other);  // O(n)
-  ~DoublyLinkedList();                                         // O(n)
+  DoublyLinkedList(DoublyLinkedList &&other) noexcept;         // O(1)
+  DoublyLinkedList &operator=(DoublyLinkedList &&other);       // as clear()
+  ~DoublyLinkedList();                                         // as clear()
 
   /**
    * Appends the given element value to the end of the container.
@@ -97,6 +122,56 @@ class DoublyLinkedList {
   DoublyLinkedListIterator<T> erase(DoublyLinkedListIterator<T> pos);
   DoublyLinkedListCIterator<T> erase(DoublyLinkedListCIterator<T> pos);
 
+  /**
+   * Moves all elements of other before pos, leaving other empty. Iterators
+   * to the moved elements stay valid if both lists use equal resources.
+   * O(1) time complexity if both lists use equal resources, plus the number
+   * of slabs of other the first time the two lists exchange nodes; otherwise
+   * the elements are copied into this list and other is cleared.
+   */
+  void splice(DoublyLinkedListCIterator<T> pos, DoublyLinkedList &other);
+
+  /**
+   * Moves the element at it, which belongs to other, before pos.
+   * O(1) time complexity if both lists use equal resources, plus the number
+   * of slabs of other the first time the two lists exchange nodes; otherwise
+   * the element is copied into this list and erased from other.
+   */
+  void splice(DoublyLinkedListCIterator<T> pos, DoublyLinkedList &other,
+              DoublyLinkedListCIterator<T> it);
+
+  /**
+   * Moves the elements of [first, last), which belong to other, before pos,
+   * which must not be in the range.
+   * O(1) time complexity if other is this list. Otherwise the nodes are
+   * relinked in time linear in the length of the range, which is counted for
+   * the sizes of both lists, if both lists use equal resources; if not, the
+   * elements are copied into this list and erased from other.
+   */
+  void splice(DoublyLinkedListCIterator<T> pos, DoublyLinkedList &other,
+              DoublyLinkedListCIterator<T> first,
+              DoublyLinkedListCIterator<T> last);
+
+  /**
+   * Merges other, which is left empty, into this list. Both lists must be
+   * sorted with respect to comp; the result is sorted as well and of equal
+   * elements those of this list come first. The nodes are relinked, as by
+   * splice, if both lists use equal resources; otherwise the elements of
+   * other are copied first.
+   * O(n + m) time complexity
+   */
+  template <typename Compare = std::less<>>
+  void merge(DoublyLinkedList &other, Compare comp = Compare{});
+
+  /**
+   * Sorts the list with a stable bottom-up merge sort which relinks the
+   * nodes: nothing is allocated, no element is copied and all iterators stay
+   * valid. comp must not throw.
+   * O(n log n) time complexity
+   */
+  template <typename Compare = std::less<>>
+  void sort(Compare comp = Compare{});
+
   /**
    * Returns a reference to the first element in the container.
    */
@@ -124,22 +199,49 @@ class DoublyLinkedList {
   bool empty() const noexcept;
 
   /**
-   * Clears the linked list's contents
-   * Complexity: Linear in the size of the container, i.e., the number of
-   * elements.
+   * Clears the linked list's contents and gives all of its memory back.
+   * Complexity: linear in the number of slabs if T is trivially destructible
+   * and the pool of the list is not shared with another list, otherwise
+   * linear in the number of elements. A list which shared its pool gets a
+   * new one of its own.
    */
   void clear();
 
+  /**
+   * Returns the memory resource of the list, nullptr for the global heap
+   */
+  std::pmr::memory_resource *resource() const noexcept;
+
  private:
+  Node<T> *createNode(const T &value);
+  void destroyNode(Node<T> *node) noexcept;
+
+  // Whether the nodes of other may be linked into this list
+  bool sharesResourceWith(const DoublyLinkedList &other) const noexcept;
+
   template <typename IteratorType>
   IteratorType erase_help(IteratorType pos);
   template <typename IteratorType>
   IteratorType insert_before_help(IteratorType pos, const T &value);
 
+  // Links the chain of nodes from first to last before next (at the end if
+  // nullptr) or unlinks it; neither changes the size
+  void linkRange(Node<T> *first, Node<T> *last, Node<T> *next) noexcept;
+  void unlinkRange(Node<T> *first, Node<T> *last) noexcept;
+
+  // Merges two sorted chains linked by next only, preferring a on ties
+  template <typename Compare>
+  static Node<T> *mergeChains(Node<T> *a, Node<T> *b, Compare &comp);
+
+  // Makes the chain linked by next only the whole list, fixing previous
+  void adoptChain(Node<T> *first) noexcept;
+
  private:
   Node<T> *head = nullptr;
   Node<T> *tail = nullptr;
   size_t currentSize = 0;
+  std::pmr::memory_resource *memoryResource = nullptr;
+  SharedNodePool<Node<T>> nodePool;
 };
 
 template <typename T, typename ReferenceType, typename NodeType>
@@ -150,6 +252,12 @@ class DLLIterator {
   explicit DLLIterator(NodeType *pCurrentNode = nullptr)
       : m_pCurrentNode{pCurrentNode} {}
 
+  // An iterator converts to a const iterator
+  template <typename OtherReference, typename OtherNode>
+    requires std::is_const_v<NodeType> && (!std::is_const_v<OtherNode>)
+  DLLIterator(const DLLIterator<T, OtherReference, OtherNode> &other)
+      : m_pCurrentNode{other.m_pCurrentNode} {}
+
   I next() const {
     if (!isValid()) {
       return *this;
@@ -201,9 +309,16 @@ class DLLIterator {
 
  private:
   NodeType *m_pCurrentNode;
+  template <typename, typename, typename>
+  friend class DLLIterator;
   friend class DoublyLinkedList<T>;
 };
 
+template <typename T>
+DoublyLinkedList<T>::DoublyLinkedList(std::pmr::memory_resource *resource)
+    : memoryResource{resource},
+      nodePool{resource ? resource : std::pmr::new_delete_resource()} {}
+
 template <typename T>
 DoublyLinkedList<T>::DoublyLinkedList(const DoublyLinkedList &other) {
   for (const T &elem : other) {
@@ -215,6 +330,7 @@ template <typename T>
 DoublyLinkedList<T> &DoublyLinkedList<T>::operator=(
     const DoublyLinkedList &other) {
   if (this != &other) {
+    clear();
     for (const T &elem : other) {
       push_back(elem);
     }
@@ -223,9 +339,38 @@ DoublyLinkedList<T> &DoublyLinkedList<T>::operator=(
   return *this;
 }
 
+template <typename T>
+DoublyLinkedList<T>::DoublyLinkedList(DoublyLinkedList &&other) noexcept
+    : head{std::exchange(other.head, nullptr)},
+      tail{std::exchange(other.tail, nullptr)},
+      currentSize{std::exchange(other.currentSize, 0)},
+      memoryResource{other.memoryResource},
+      nodePool{std::move(other.nodePool)} {}
+
+template <typename T>
+DoublyLinkedList<T> &DoublyLinkedList<T>::operator=(DoublyLinkedList &&other) {
+  if (this == &other) {
+    return *this;
+  }
+
+  clear();
+  if (!sharesResourceWith(other)) {
+    splice(cend(), other);
+    return *this;
+  }
+
+  // clear() has let go of the old pool of this list
+  nodePool = std::move(other.nodePool);
+  head = std::exchange(other.head, nullptr);
+  tail = std::exchange(other.tail, nullptr);
+  currentSize = std::exchange(other.currentSize, 0);
+
+  return *this;
+}
+
 template <typename T>
 void DoublyLinkedList<T>::push_front(const T &value) {
-  Node<T> *node = new Node{value};
+  Node<T> *node = createNode(value);
   ++currentSize;
 
   if (!head) {
@@ -248,18 +393,18 @@ void DoublyLinkedList<T>::pop_front() {
   --currentSize;
 
   if (currentSize == 0) {  // there was only 1 element in the list
-    delete head;
+    destroyNode(head);
     head = tail = nullptr;
   } else {  // there were at least 2 elements in the list
     head = head->next;
-    delete head->previous;
+    destroyNode(head->previous);
     head->previous = nullptr;
   }
 }
 
 template <typename T>
 void DoublyLinkedList<T>::push_back(const T &value) {
-  Node<T> *node = new Node{value};
+  Node<T> *node = createNode(value);
   ++currentSize;
 
   if (!head) {
@@ -282,11 +427,11 @@ void DoublyLinkedList<T>::pop_back() {
   --currentSize;
 
   if (currentSize == 0) {  // there was only 1 element in the list
-    delete tail;
+    destroyNode(tail);
     head = tail = nullptr;
   } else {  // there were at least 2 elements in the list
     tail = tail->previous;
-    delete tail->next;
+    destroyNode(tail->next);
     tail->next = nullptr;
   }
 }
@@ -333,6 +478,10 @@ DoublyLinkedListIterator<T> DoublyLinkedList<T>::insertBefore(
     push_front(value);
     return begin();
   }
+  if (!pos.isValid()) {
+    push_back(value);
+    return DoublyLinkedListIterator<T>{tail};
+  }
 
   return insert_before_help(pos, value);
 }
@@ -344,6 +493,10 @@ DoublyLinkedListCIterator<T> DoublyLinkedList<T>::insertBefore(
     push_front(value);
     return cbegin();
   }
+  if (!pos.isValid()) {
+    push_back(value);
+    return DoublyLinkedListCIterator<T>{tail};
+  }
 
   return insert_before_help(pos, value);
 }
@@ -352,13 +505,15 @@ template <typename T>
 template <typename IteratorType>
 IteratorType DoublyLinkedList<T>::insert_before_help(IteratorType pos,
                                                      const T &value) {
-  Node<T> *node = new Node{value};
+  Node<T> *node = createNode(value);
   ++currentSize;
 
-  node->next = pos.m_pCurrentNode;
-  node->previous = pos.m_pCurrentNode->previous;
-  pos.m_pCurrentNode->previous->next = node;
-  pos.m_pCurrentNode->previous = node;
+  // a const iterator refers to a node of this list, which may be changed
+  auto *current = const_cast<Node<T> *>(pos.m_pCurrentNode);
+  node->next = current;
+  node->previous = current->previous;
+  current->previous->next = node;
+  current->previous = node;
 
   return IteratorType{node};
 }
@@ -388,14 +543,141 @@ DoublyLinkedListCIterator<T> DoublyLinkedList<T>::erase(
 template <typename T>
 template <typename IteratorType>
 IteratorType DoublyLinkedList<T>::erase_help(IteratorType pos) {
+  if (pos.m_pCurrentNode == tail) {
+    pop_back();
+    return IteratorType{nullptr};
+  }
+
   --currentSize;
-  pos.m_pCurrentNode->previous->next = pos.m_pCurrentNode->next;
-  pos.m_pCurrentNode->next->previous = pos.m_pCurrentNode->previous;
-  auto next = IteratorType{pos.m_pCurrentNode->next};
-  delete pos.m_pCurrentNode;
+  auto *current = const_cast<Node<T> *>(pos.m_pCurrentNode);
+  current->previous->next = current->next;
+  current->next->previous = current->previous;
+  auto next = IteratorType{current->next};
+  destroyNode(current);
   return next;
 }
 
+template <typename T>
+void DoublyLinkedList<T>::splice(DoublyLinkedListCIterator<T> pos,
+                                 DoublyLinkedList &other) {
+  if (&other == this || other.empty()) {
+    return;
+  }
+
+  if (!sharesResourceWith(other)) {
+    // The nodes of other cannot be taken - they belong to another resource
+    for (const T &elem : other) {
+      insertBefore(pos, elem);
+    }
+    other.clear();
+    return;
+  }
+
+  nodePool.share(other.nodePool);
+  linkRange(other.head, other.tail, const_cast<Node<T> *>(pos.m_pCurrentNode));
+  currentSize += other.currentSize;
+  other.head = other.tail = nullptr;
+  other.currentSize = 0;
+}
+
+template <typename T>
+void DoublyLinkedList<T>::splice(DoublyLinkedListCIterator<T> pos,
+                                 DoublyLinkedList &other,
+                                 DoublyLinkedListCIterator<T> it) {
+  splice(pos, other, it, it.next());
+}
+
+template <typename T>
+void DoublyLinkedList<T>::splice(DoublyLinkedListCIterator<T> pos,
+                                 DoublyLinkedList &other,
+                                 DoublyLinkedListCIterator<T> first,
+                                 DoublyLinkedListCIterator<T> last) {
+  if (first == last) {
+    return;
+  }
+
+  if (&other == this && (pos == first || pos == last)) {
+    return;
+  }
+
+  if (!sharesResourceWith(other)) {
+    // The nodes of other cannot be taken - they belong to another resource
+    while (first != last) {
+      insertBefore(pos, *first);
+      first = other.erase(first);
+    }
+    return;
+  }
+
+  nodePool.share(other.nodePool);
+  auto *firstNode = const_cast<Node<T> *>(first.m_pCurrentNode);
+  Node<T> *lastNode =
+      last.isValid() ? last.m_pCurrentNode->previous : other.tail;
+  other.unlinkRange(firstNode, lastNode);
+  linkRange(firstNode, lastNode, const_cast<Node<T> *>(pos.m_pCurrentNode));
+
+  if (&other != this) {
+    size_t count = 1;
+    for (const Node<T> *node = firstNode; node != lastNode; node = node->next) {
+      ++count;
+    }
+    other.currentSize -= count;
+    currentSize += count;
+  }
+}
+
+template <typename T>
+template <typename Compare>
+void DoublyLinkedList<T>::merge(DoublyLinkedList &other, Compare comp) {
+  if (&other == this || other.empty()) {
+    return;
+  }
+
+  Node<T> *lastOfThis = tail;
+  splice(cend(), other);
+  if (!lastOfThis) {
+    return;
+  }
+
+  Node<T> *firstOfOther = lastOfThis->next;
+  lastOfThis->next = nullptr;
+  adoptChain(mergeChains(head, firstOfOther, comp));
+}
+
+template <typename T>
+template <typename Compare>
+void DoublyLinkedList<T>::sort(Compare comp) {
+  if (currentSize < 2) {
+    return;
+  }
+
+  // runs[i] is a sorted chain of 2^i nodes or empty, like the digits of a
+  // binary counter, and the higher the run the earlier its elements
+  Node<T> *runs[64] = {};
+  Node<T> *node = head;
+  while (node) {
+    Node<T> *carry = node;
+    node = node->next;
+    carry->next = nullptr;
+
+    size_t i = 0;
+    for (; runs[i]; i++) {
+      carry = mergeChains(runs[i], carry, comp);
+      runs[i] = nullptr;
+    }
+    runs[i] = carry;
+  }
+
+  Node<T> *sorted = nullptr;
+  for (Node<T> *run : runs) {
+    if (run) {
+      sorted = sorted ? mergeChains(run, sorted, comp) : run;
+    }
+  }
+
+  adoptChain(sorted);
+}
+
 template <typename T>
 T &DoublyLinkedList<T>::front() {
   return head->data;
@@ -428,9 +710,108 @@ bool DoublyLinkedList<T>::empty() const noexcept {
 
 template <typename T>
 void DoublyLinkedList<T>::clear() {
-  while (!empty()) {
-    pop_back();
+  if (!nodePool.exclusive()) {
+    // the slabs may hold nodes of another list
+    Node<T> *node = head;
+    while (node) {
+      Node<T> *next = node->next;
+      destroyNode(node);
+      node = next;
+    }
+  } else if constexpr (!std::is_trivially_destructible_v<Node<T>>) {
+    Node<T> *node = head;
+    while (node) {
+      Node<T> *next = node->next;
+      node->~Node();
+      node = next;
+    }
+  }
+
+  // the slabs are given back with the pool, unless another list uses it
+  nodePool.reset();
+  head = tail = nullptr;
+  currentSize = 0;
+}
+
+template <typename T>
+std::pmr::memory_resource *DoublyLinkedList<T>::resource() const noexcept {
+  return memoryResource;
+}
+
+template <typename T>
+Node<T> *DoublyLinkedList<T>::createNode(const T &value) {
+  NodePool<Node<T>> &pool = nodePool.get();
+  void *memory = pool.allocate();
+  try {
+    return ::new (memory) Node<T>{value};
+  } catch (...) {
+    pool.deallocate(memory);
+    throw;
+  }
+}
+
+template <typename T>
+void DoublyLinkedList<T>::destroyNode(Node<T> *node) noexcept {
+  node->~Node();
+  nodePool.get().deallocate(node);
+}
+
+template <typename T>
+bool DoublyLinkedList<T>::sharesResourceWith(
+    const DoublyLinkedList &other) const noexcept {
+  if (!memoryResource || !other.memoryResource) {
+    return memoryResource == other.memoryResource;
+  }
+
+  return *memoryResource == *other.memoryResource;
+}
+
+template <typename T>
+void DoublyLinkedList<T>::linkRange(Node<T> *first, Node<T> *last,
+                                    Node<T> *next) noexcept {
+  Node<T> *previous = next ? next->previous : tail;
+  first->previous = previous;
+  last->next = next;
+  (previous ? previous->next : head) = first;
+  (next ? next->previous : tail) = last;
+}
+
+template <typename T>
+void DoublyLinkedList<T>::unlinkRange(Node<T> *first, Node<T> *last) noexcept {
+  (first->previous ? first->previous->next : head) = last->next;
+  (last->next ? last->next->previous : tail) = first->previous;
+}
+
+template <typename T>
+template <typename Compare>
+Node<T> *DoublyLinkedList<T>::mergeChains(Node<T> *a, Node<T> *b,
+                                          Compare &comp) {
+  Node<T> *merged = nullptr;
+  Node<T> **last = &merged;
+  while (a && b) {
+    if (comp(b->data, a->data)) {
+      *last = b;
+      b = b->next;
+    } else {
+      *last = a;
+      a = a->next;
+    }
+    last = &(*last)->next;
+  }
+
+  *last = a ? a : b;
+  return merged;
+}
+
+template <typename T>
+void DoublyLinkedList<T>::adoptChain(Node<T> *first) noexcept {
+  head = first;
+  Node<T> *previous = nullptr;
+  for (Node<T> *node = first; node; node = node->next) {
+    node->previous = previous;
+    previous = node;
   }
+  tail = previous;
 }
 
 template <typename T>
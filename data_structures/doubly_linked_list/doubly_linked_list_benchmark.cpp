@@ -0,0 +1,201 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <list>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include "doubly_linked_list.h"
+
+/*
+DoublyLinkedList, which takes its nodes from a NodePool of its own, against
+std::list on the global heap and std::pmr::list on an
+unsynchronized_pool_resource.
+
+1. Churn: a list of the given length, and handles to all of its nodes. Every
+   iteration erases the node of a random handle and inserts a new node before
+   another random one, so the list keeps its length while nodes are freed and
+   allocated all the time, at scattered places.
+
+2. clear() of a list of the given length, which the pooled list does by
+   giving back its slabs, and the others by freeing every node.
+
+3. Sorting a list of 10 x the given length of random numbers in place, against
+   copying it into a vector, sorting that and rebuilding the list.
+
+Run:
+$> ./doubly_linked_list_benchmark [iterations] [list length]
+*/
+
+namespace {
+
+struct Random {
+  std::uint64_t state = 88172645463325252ull;
+
+  size_t below(size_t bound) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return static_cast<size_t>(state % bound);
+  }
+};
+
+// Inserts before pos and returns an iterator to the new element
+template <typename T>
+auto insertBefore(DoublyLinkedList<T> &list,
+                  DoublyLinkedListIterator<T> pos, const T &value) {
+  return list.insertBefore(pos, value);
+}
+
+template <typename List>
+auto insertBefore(List &list, typename List::iterator pos,
+                  const typename List::value_type &value) {
+  return list.insert(pos, value);
+}
+
+template <typename List>
+double millionOperationsPerSecond(List &list, size_t iterations,
+                                  size_t length) {
+  using Iterator = decltype(list.begin());
+  std::vector<Iterator> handles;
+  for (size_t i = 0; i < length; i++) {
+    list.push_back(static_cast<long long>(i));
+  }
+  for (auto it = list.begin(); it != list.end(); ++it) {
+    handles.push_back(it);
+  }
+
+  Random random;
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < iterations; i++) {
+    const size_t erased = random.below(length);
+    size_t target = random.below(length);
+    if (target == erased) {
+      target = (target + 1) % length;
+    }
+
+    list.erase(handles[erased]);
+    handles[erased] =
+        insertBefore(list, handles[target], static_cast<long long>(i));
+  }
+  const auto end = std::chrono::steady_clock::now();
+
+  // an erase and an insert per iteration
+  const double seconds = std::chrono::duration<double>(end - start).count();
+  return 2 * iterations / seconds / 1e6;
+}
+
+template <typename List>
+double clearMilliseconds(List &list, size_t length) {
+  for (size_t i = 0; i < length; i++) {
+    list.push_back(static_cast<long long>(i));
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  list.clear();
+  const auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+template <typename List>
+void fillRandomly(List &list, size_t length) {
+  Random random;
+  for (size_t i = 0; i < length; i++) {
+    list.push_back(static_cast<long long>(random.below(length)));
+  }
+}
+
+template <typename Sort>
+double sortMilliseconds(Sort sort) {
+  const auto start = std::chrono::steady_clock::now();
+  sort();
+  const auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  const size_t iterations =
+      argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20'000'000;
+  const size_t length =
+      argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 100'000;
+
+  std::cout << iterations << " x erase + insert at random places, list of "
+            << length << '\n';
+  {
+    DoublyLinkedList<long long> list;
+    std::cout << "  DoublyLinkedList: "
+              << millionOperationsPerSecond(list, iterations, length)
+              << " M ops/s\n";
+  }
+  {
+    std::list<long long> list;
+    std::cout << "  std::list: "
+              << millionOperationsPerSecond(list, iterations, length)
+              << " M ops/s\n";
+  }
+  {
+    std::pmr::unsynchronized_pool_resource pool;
+    std::pmr::list<long long> list{&pool};
+    std::cout << "  std::pmr::list on a pool: "
+              << millionOperationsPerSecond(list, iterations, length)
+              << " M ops/s\n";
+  }
+
+  const size_t clearLength = 10 * length;
+  std::cout << "clear() of a list of " << clearLength << '\n';
+  {
+    DoublyLinkedList<long long> list;
+    std::cout << "  DoublyLinkedList: " << clearMilliseconds(list, clearLength)
+              << " ms\n";
+  }
+  {
+    std::list<long long> list;
+    std::cout << "  std::list: " << clearMilliseconds(list, clearLength)
+              << " ms\n";
+  }
+  {
+    std::pmr::unsynchronized_pool_resource pool;
+    std::pmr::list<long long> list{&pool};
+    std::cout << "  std::pmr::list on a pool: "
+              << clearMilliseconds(list, clearLength) << " ms\n";
+  }
+
+  std::cout << "Sorting a list of " << clearLength << " random numbers\n";
+  {
+    DoublyLinkedList<long long> list;
+    fillRandomly(list, clearLength);
+    std::cout << "  DoublyLinkedList::sort: "
+              << sortMilliseconds([&list] { list.sort(); }) << " ms\n";
+  }
+  {
+    DoublyLinkedList<long long> list;
+    fillRandomly(list, clearLength);
+    std::cout << "  copy into a vector, std::sort, rebuild: "
+              << sortMilliseconds([&list] {
+                   std::vector<long long> values;
+                   values.reserve(list.size());
+                   for (long long value : list) {
+                     values.push_back(value);
+                   }
+                   std::sort(values.begin(), values.end());
+                   list.clear();
+                   for (long long value : values) {
+                     list.push_back(value);
+                   }
+                 })
+              << " ms\n";
+  }
+  {
+    std::list<long long> list;
+    fillRandomly(list, clearLength);
+    std::cout << "  std::list::sort: "
+              << sortMilliseconds([&list] { list.sort(); }) << " ms\n";
+  }
+
+  return 0;
+}
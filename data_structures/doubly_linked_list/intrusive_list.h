@@ -0,0 +1,405 @@
+#ifndef INTRUSIVE_LIST_H
+#define INTRUSIVE_LIST_H
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+/**
+ * The links of an object on an IntrusiveList, to be made a member of the
+ * object. An object may have several hooks and so be on several lists at
+ * once, one per hook.
+ *
+ * A hook which is not on a list points to itself. Copying an object does not
+ * copy its memberships: the hook of the copy is not on any list.
+ */
+class IntrusiveListHook {
+ public:
+  IntrusiveListHook() = default;
+  IntrusiveListHook(const IntrusiveListHook &) {}
+  IntrusiveListHook &operator=(const IntrusiveListHook &) { return *this; }
+
+  bool isLinked() const noexcept { return previous != this; }
+
+ private:
+  IntrusiveListHook *previous = this;
+  IntrusiveListHook *next = this;
+
+  template <typename T, IntrusiveListHook T::*Hook>
+  friend class IntrusiveList;
+  template <typename T, IntrusiveListHook T::*Hook, typename ReferenceType>
+  friend class IntrusiveIterator;
+};
+
+namespace intrusive_list_detail {
+
+// Returns the offset of the hook within T. The member pointer is applied to
+// raw storage which is never read, so that T need not be constructible.
+template <typename T, IntrusiveListHook T::*Hook>
+std::ptrdiff_t hookOffset() {
+  alignas(T) static unsigned char storage[sizeof(T)];
+  auto *object = reinterpret_cast<T *>(storage);
+  return reinterpret_cast<unsigned char *>(&(object->*Hook)) - storage;
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+T *owner(const IntrusiveListHook *hook) {
+  auto *bytes =
+      reinterpret_cast<unsigned char *>(const_cast<IntrusiveListHook *>(hook));
+  return reinterpret_cast<T *>(bytes - hookOffset<T, Hook>());
+}
+
+}  // namespace intrusive_list_detail
+
+template <typename T, IntrusiveListHook T::*Hook, typename ReferenceType>
+class IntrusiveIterator;
+
+template <typename T, IntrusiveListHook T::*Hook>
+using IntrusiveListIterator = IntrusiveIterator<T, Hook, T &>;
+
+template <typename T, IntrusiveListHook T::*Hook>
+using IntrusiveListCIterator = IntrusiveIterator<T, Hook, const T &>;
+
+/**
+ * Doubly linked list of objects which carry their own links in a member
+ * hook, e.g.
+ *
+ *   struct Task {
+ *     IntrusiveListHook runQueueHook;
+ *     IntrusiveListHook allTasksHook;
+ *   };
+ *   IntrusiveList<Task, &Task::runQueueHook> runQueue;
+ *   IntrusiveList<Task, &Task::allTasksHook> allTasks;
+ *
+ * The list neither allocates nor copies: it links the given objects
+ * themselves, so a task is on both lists without a node or a copy for either
+ * membership, and removing an object, which the list finds from the object
+ * alone, is O(1). The objects are owned by the caller. They must outlive
+ * their membership and must not move while on a list; the destructor and
+ * clear() of the list unlink all of its objects.
+ */
+template <typename T, IntrusiveListHook T::*Hook>
+class IntrusiveList {
+ public:
+  using iterator = IntrusiveListIterator<T, Hook>;
+  using const_iterator = IntrusiveListCIterator<T, Hook>;
+
+  IntrusiveList() = default;
+  IntrusiveList(const IntrusiveList &) = delete;
+  IntrusiveList &operator=(const IntrusiveList &) = delete;
+  ~IntrusiveList() { clear(); }  // O(n)
+
+  /**
+   * Links the given object at the end of the list. Throws exception if the
+   * object is on a list of this hook already.
+   * O(1) time complexity
+   *
+   * @throw std::invalid_argument
+   */
+  void push_back(T &object);
+
+  /**
+   * Links the given object at the beginning of the list. Throws exception if
+   * the object is on a list of this hook already.
+   * O(1) time complexity
+   *
+   * @throw std::invalid_argument
+   */
+  void push_front(T &object);
+
+  /**
+   * Unlinks the last object. Calling pop_back on an empty list throws
+   * exception.
+   * O(1) time complexity
+   *
+   * @throw std::runtime_error
+   */
+  void pop_back();
+
+  /**
+   * Unlinks the first object. Calling pop_front on an empty list throws
+   * exception.
+   * O(1) time complexity
+   *
+   * @throw std::runtime_error
+   */
+  void pop_front();
+
+  iterator begin() noexcept { return iterator{head}; }
+  const_iterator begin() const noexcept { return const_iterator{head}; }
+  const_iterator cbegin() const noexcept { return const_iterator{head}; }
+
+  iterator end() noexcept { return iterator{}; }
+  const_iterator end() const noexcept { return const_iterator{}; }
+  const_iterator cend() const noexcept { return const_iterator{}; }
+
+  /**
+   * Returns an iterator to the given object, which must be on this list.
+   * O(1) time complexity
+   */
+  iterator iteratorTo(T &object) noexcept { return iterator{&(object.*Hook)}; }
+
+  /**
+   * Links object before pos, at the end if pos is end(). Throws exception if
+   * the object is on a list of this hook already.
+   * O(1) time complexity
+   *
+   * @throw std::invalid_argument
+   * @return Iterator pointing to the object
+   */
+  iterator insertBefore(const_iterator pos, T &object);
+
+  /**
+   * Unlinks the object at pos.
+   * O(1) time complexity
+   *
+   * @return Iterator following the unlinked object
+   */
+  iterator erase(const_iterator pos) noexcept;
+
+  /**
+   * Unlinks the given object, which must be on this list.
+   * O(1) time complexity
+   */
+  void erase(T &object) noexcept;
+
+  /**
+   * Moves all objects of other before pos. Nothing is copied and no
+   * iterators are invalidated.
+   * O(1) time complexity
+   */
+  void splice(const_iterator pos, IntrusiveList &other) noexcept;
+
+  /**
+   * Moves the given object, which must be on other, before pos.
+   * O(1) time complexity
+   */
+  void splice(const_iterator pos, IntrusiveList &other, T &object) noexcept;
+
+  T &front() { return *begin(); }
+  const T &front() const { return *begin(); }
+  T &back() { return *iterator{tail}; }
+  const T &back() const { return *const_iterator{tail}; }
+
+  size_t size() const noexcept { return currentSize; }
+  bool empty() const noexcept { return currentSize == 0; }
+
+  /**
+   * Unlinks all objects. O(n), as every hook is reset
+   */
+  void clear() noexcept;
+
+ private:
+  static IntrusiveListHook *hookOf(T &object) { return &(object.*Hook); }
+
+  // Links an unlinked hook before next, at the end if next is nullptr
+  void link(IntrusiveListHook *hook, IntrusiveListHook *next) noexcept;
+  void unlink(IntrusiveListHook *hook) noexcept;
+
+  IntrusiveListHook *head = nullptr;
+  IntrusiveListHook *tail = nullptr;
+  size_t currentSize = 0;
+};
+
+template <typename T, IntrusiveListHook T::*Hook, typename ReferenceType>
+class IntrusiveIterator {
+  using I = IntrusiveIterator;
+  using HookType = std::conditional_t<
+      std::is_const_v<std::remove_reference_t<ReferenceType>>,
+      const IntrusiveListHook, IntrusiveListHook>;
+
+ public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = T;
+  using difference_type = std::ptrdiff_t;
+  using pointer = std::remove_reference_t<ReferenceType> *;
+  using reference = ReferenceType;
+
+  explicit IntrusiveIterator(HookType *pCurrentHook = nullptr)
+      : m_pCurrentHook{pCurrentHook} {}
+
+  // An iterator converts to a const iterator
+  template <typename OtherReference>
+    requires std::is_const_v<HookType> &&
+             (!std::is_const_v<std::remove_reference_t<OtherReference>>)
+  IntrusiveIterator(const IntrusiveIterator<T, Hook, OtherReference> &other)
+      : m_pCurrentHook{other.m_pCurrentHook} {}
+
+  I next() const {
+    if (!isValid()) {
+      return *this;
+    }
+
+    return I{m_pCurrentHook->next};
+  }
+
+  I prev() const {
+    if (!isValid()) {
+      return *this;
+    }
+
+    return I{m_pCurrentHook->previous};
+  }
+
+  // Prefix ++ overload
+  I &operator++() { return *this = next(); }
+
+  // Postfix ++ overload
+  I operator++(int) {
+    I old = *this;
+    ++*this;
+    return old;
+  }
+
+  // Prefix -- overload
+  I &operator--() { return *this = prev(); }
+
+  // Postfix -- overload
+  I operator--(int) {
+    I old = *this;
+    --*this;
+    return old;
+  }
+
+  bool isValid() const { return m_pCurrentHook != nullptr; }
+  operator bool() const { return isValid(); }
+
+  // Calling dereference operator on invalid iterator causes undefined behavior
+  ReferenceType get() const {
+    return *intrusive_list_detail::owner<T, Hook>(m_pCurrentHook);
+  }
+  ReferenceType operator*() const { return get(); }
+  pointer operator->() const { return &get(); }
+
+  friend bool operator==(const I &lhs, const I &rhs) {
+    return lhs.m_pCurrentHook == rhs.m_pCurrentHook;
+  }
+
+  friend bool operator!=(const I &lhs, const I &rhs) { return !(lhs == rhs); }
+
+ private:
+  HookType *m_pCurrentHook;
+
+  template <typename U, IntrusiveListHook U::*, typename>
+  friend class IntrusiveIterator;
+  friend class IntrusiveList<T, Hook>;
+};
+
+template <typename T, IntrusiveListHook T::*Hook>
+void IntrusiveList<T, Hook>::push_back(T &object) {
+  insertBefore(cend(), object);
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+void IntrusiveList<T, Hook>::push_front(T &object) {
+  insertBefore(cbegin(), object);
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+void IntrusiveList<T, Hook>::pop_back() {
+  if (empty()) {
+    throw std::runtime_error{"Calling pop_back() on an empty list."};
+  }
+
+  unlink(tail);
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+void IntrusiveList<T, Hook>::pop_front() {
+  if (empty()) {
+    throw std::runtime_error{"Calling pop_front() on an empty list."};
+  }
+
+  unlink(head);
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+typename IntrusiveList<T, Hook>::iterator IntrusiveList<T, Hook>::insertBefore(
+    const_iterator pos, T &object) {
+  IntrusiveListHook *hook = hookOf(object);
+  if (hook->isLinked()) {
+    throw std::invalid_argument{"The object is on a list already."};
+  }
+
+  link(hook, const_cast<IntrusiveListHook *>(pos.m_pCurrentHook));
+  return iterator{hook};
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+typename IntrusiveList<T, Hook>::iterator IntrusiveList<T, Hook>::erase(
+    const_iterator pos) noexcept {
+  auto *hook = const_cast<IntrusiveListHook *>(pos.m_pCurrentHook);
+  IntrusiveListHook *next = hook->next;
+  unlink(hook);
+  return iterator{next};
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+void IntrusiveList<T, Hook>::erase(T &object) noexcept {
+  unlink(hookOf(object));
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+void IntrusiveList<T, Hook>::splice(const_iterator pos,
+                                    IntrusiveList &other) noexcept {
+  if (&other == this || other.empty()) {
+    return;
+  }
+
+  auto *next = const_cast<IntrusiveListHook *>(pos.m_pCurrentHook);
+  IntrusiveListHook *previous = next ? next->previous : tail;
+  other.head->previous = previous;
+  (previous ? previous->next : head) = other.head;
+  other.tail->next = next;
+  (next ? next->previous : tail) = other.tail;
+
+  currentSize += other.currentSize;
+  other.head = other.tail = nullptr;
+  other.currentSize = 0;
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+void IntrusiveList<T, Hook>::splice(const_iterator pos, IntrusiveList &other,
+                                    T &object) noexcept {
+  IntrusiveListHook *hook = hookOf(object);
+  if (hook == pos.m_pCurrentHook) {
+    return;
+  }
+
+  other.unlink(hook);
+  link(hook, const_cast<IntrusiveListHook *>(pos.m_pCurrentHook));
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+void IntrusiveList<T, Hook>::clear() noexcept {
+  while (head) {
+    IntrusiveListHook *next = head->next;
+    head->previous = head->next = head;
+    head = next;
+  }
+
+  tail = nullptr;
+  currentSize = 0;
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+void IntrusiveList<T, Hook>::link(IntrusiveListHook *hook,
+                                  IntrusiveListHook *next) noexcept {
+  IntrusiveListHook *previous = next ? next->previous : tail;
+  hook->previous = previous;
+  hook->next = next;
+  (previous ? previous->next : head) = hook;
+  (next ? next->previous : tail) = hook;
+  ++currentSize;
+}
+
+template <typename T, IntrusiveListHook T::*Hook>
+void IntrusiveList<T, Hook>::unlink(IntrusiveListHook *hook) noexcept {
+  (hook->previous ? hook->previous->next : head) = hook->next;
+  (hook->next ? hook->next->previous : tail) = hook->previous;
+  hook->previous = hook->next = hook;
+  --currentSize;
+}
+
+#endif
@@ -0,0 +1,131 @@
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "doubly_linked_list.h"
+#include "intrusive_list.h"
+
+/*
+Moving objects between lists, as a scheduler moves tasks between its queues:
+the given number of tasks is spread over QUEUES lists, and every iteration
+takes a random task off the list it is on and links it into another random
+list.
+
+- IntrusiveList relinks the task itself.
+- DoublyLinkedList<Task> holds copies, so a move erases the copy on the old
+  list and copies the task into a new node of the other list.
+- DoublyLinkedList<Task *> holds pointers, which saves the copy but not the
+  node.
+
+The DoublyLinkedList variants keep an iterator per task to erase it in O(1),
+which the intrusive list finds from the task itself.
+
+Run:
+$> ./intrusive_list_benchmark [iterations] [tasks]
+*/
+
+namespace {
+
+constexpr size_t QUEUES = 16;
+
+struct Task {
+  explicit Task(size_t i) : id{i} {}
+
+  size_t id;
+  size_t queue = 0;
+  std::array<std::uint64_t, 6> payload{};
+  IntrusiveListHook hook;
+};
+
+struct Random {
+  std::uint64_t state = 88172645463325252ull;
+
+  size_t below(size_t bound) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return static_cast<size_t>(state % bound);
+  }
+};
+
+template <typename Operation>
+double millionMovesPerSecond(size_t iterations, Operation move) {
+  Random random;
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < iterations; i++) {
+    move(random);
+  }
+  const auto end = std::chrono::steady_clock::now();
+  return iterations / std::chrono::duration<double>(end - start).count() /
+         1e6;
+}
+
+double intrusive(size_t iterations, std::vector<Task> &tasks) {
+  std::array<IntrusiveList<Task, &Task::hook>, QUEUES> queues;
+  for (Task &task : tasks) {
+    task.queue = task.id % QUEUES;
+    queues[task.queue].push_back(task);
+  }
+
+  return millionMovesPerSecond(iterations, [&](Random &random) {
+    Task &task = tasks[random.below(tasks.size())];
+    const size_t target = random.below(QUEUES);
+    queues[task.queue].erase(task);
+    queues[target].push_back(task);
+    task.queue = target;
+  });
+}
+
+template <typename Element, typename MakeElement>
+double copyIn(size_t iterations, std::vector<Task> &tasks,
+              MakeElement makeElement) {
+  std::array<DoublyLinkedList<Element>, QUEUES> queues;
+  std::vector<DoublyLinkedListIterator<Element>> handles;
+  for (Task &task : tasks) {
+    task.queue = task.id % QUEUES;
+    queues[task.queue].push_front(makeElement(task));
+    handles.push_back(queues[task.queue].begin());
+  }
+
+  return millionMovesPerSecond(iterations, [&](Random &random) {
+    Task &task = tasks[random.below(tasks.size())];
+    const size_t target = random.below(QUEUES);
+    queues[task.queue].erase(handles[task.id]);
+    // at the front, as insertBefore needs a valid position
+    queues[target].push_front(makeElement(task));
+    handles[task.id] = queues[target].begin();
+    task.queue = target;
+  });
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  const size_t iterations =
+      argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20'000'000;
+  const size_t taskCount =
+      argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 100'000;
+
+  std::vector<Task> tasks;
+  for (size_t i = 0; i < taskCount; i++) {
+    tasks.emplace_back(i);
+  }
+
+  std::cout << iterations << " moves of random tasks out of " << taskCount
+            << " between " << QUEUES << " lists\n";
+  std::cout << "  IntrusiveList: " << intrusive(iterations, tasks)
+            << " M moves/s\n";
+  std::cout << "  DoublyLinkedList<Task>: "
+            << copyIn<Task>(iterations, tasks,
+                            [](const Task &task) { return task; })
+            << " M moves/s\n";
+  std::cout << "  DoublyLinkedList<Task *>: "
+            << copyIn<Task *>(iterations, tasks,
+                              [](Task &task) { return &task; })
+            << " M moves/s\n";
+
+  return 0;
+}
@@ -1,5 +1,23 @@
 #include "catch.hpp"
 #include "doubly_linked_list.h"
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+template <typename T>
+std::vector<T> toVector(const DoublyLinkedList<T> &list) {
+  std::vector<T> result;
+  for (const T &value : list) {
+    result.push_back(value);
+  }
+  return result;
+}
+
+}  // namespace
 
 TEST_CASE(
     "Doubly linked list is empty on construction with default constructor") {
@@ -88,6 +106,38 @@ TEST_CASE("Push a lot of elements and then clear the list") {
   REQUIRE(list.empty());
 }
 
+TEST_CASE("Erased nodes are reused by later insertions") {
+  DoublyLinkedList<int> list;
+  for (int i = 0; i < 3; i++) {
+    list.push_back(i);
+  }
+
+  auto middle = ++list.begin();
+  const int *erasedAddress = &*middle;
+  auto last = list.erase(middle);
+  REQUIRE(&*list.insertBefore(last, 5) == erasedAddress);
+  REQUIRE(list.size() == 3);
+
+  list.pop_front();
+  list.push_back(6);
+  REQUIRE(*list.begin() == 5);
+  REQUIRE(list.back() == 6);
+}
+
+TEST_CASE("A cleared list of strings can be filled again") {
+  DoublyLinkedList<std::string> list;
+  for (int round = 0; round < 3; round++) {
+    for (int i = 0; i < 1000; i++) {
+      list.push_back("a string too long for the small string buffer");
+    }
+    REQUIRE(list.size() == 1000);
+
+    list.clear();
+    REQUIRE(list.empty());
+    REQUIRE(list.begin() == list.end());
+  }
+}
+
 TEST_CASE("Push a lot of elements test iterators") {
   DoublyLinkedList<int> list;
   for (int i = 0; i < 30'000; i++) {
@@ -196,6 +246,19 @@ TEST_CASE("Erase at middle") {
   REQUIRE(list.size() == 2);
 }
 
+TEST_CASE("Erase at end") {
+  DoublyLinkedList<int> list;
+  list.push_back(5);
+  list.push_back(6);
+  auto it = list.begin();
+  ++it;  // points at 6
+  REQUIRE(list.erase(it) == list.end());
+  REQUIRE(list.back() == 5);
+  REQUIRE(list.size() == 1);
+  list.push_back(7);
+  REQUIRE(list.back() == 7);
+}
+
 TEST_CASE("Erase many numbers") {
   DoublyLinkedList<int> list;
   for (int i = 1; i <= 100; i++) {
@@ -242,3 +305,242 @@ TEST_CASE("Comparator of linked lists , copy ctor and operator= work correctly")
   l4 = l2;
   REQUIRE(l4 == l2);
 }
+
+TEST_CASE("Assignment replaces the contents of the target") {
+  DoublyLinkedList<int> source;
+  source.push_back(1);
+  source.push_back(2);
+
+  DoublyLinkedList<int> target;
+  target.push_back(7);
+  target = source;
+  REQUIRE(target == source);
+  REQUIRE(target.size() == 2);
+}
+
+TEST_CASE("Insert before the end appends") {
+  DoublyLinkedList<int> list;
+  list.push_back(1);
+  auto it = list.insertBefore(list.end(), 2);
+  REQUIRE(*it == 2);
+  REQUIRE(list.back() == 2);
+  REQUIRE(list.size() == 2);
+}
+
+TEST_CASE("Moving a list takes its nodes") {
+  DoublyLinkedList<std::string> source;
+  for (int i = 0; i < 100; i++) {
+    source.push_back(std::to_string(i));
+  }
+  const std::string *first = &source.front();
+
+  DoublyLinkedList<std::string> moved{std::move(source)};
+  REQUIRE(source.empty());
+  REQUIRE(moved.size() == 100);
+  REQUIRE(&moved.front() == first);
+
+  DoublyLinkedList<std::string> assigned;
+  assigned.push_back("old");
+  assigned = std::move(moved);
+  REQUIRE(moved.empty());
+  REQUIRE(assigned.size() == 100);
+  REQUIRE(&assigned.front() == first);
+  REQUIRE(assigned.back() == "99");
+
+  // the emptied lists are still usable
+  source.push_back("again");
+  REQUIRE(source.front() == "again");
+}
+
+TEST_CASE("Splice a whole list") {
+  DoublyLinkedList<int> first;
+  DoublyLinkedList<int> second;
+  for (int i = 0; i < 3; i++) {
+    first.push_back(i);
+    second.push_back(10 + i);
+  }
+  auto it = second.begin();
+
+  first.splice(first.begin().next(), second);
+  REQUIRE(second.empty());
+  REQUIRE(first.size() == 6);
+  REQUIRE(*it == 10);
+  REQUIRE(toVector(first) == std::vector<int>{0, 10, 11, 12, 1, 2});
+
+  // the spliced nodes belong to first now
+  first.erase(it);
+  first.push_back(3);
+  REQUIRE(toVector(first) == std::vector<int>{0, 11, 12, 1, 2, 3});
+}
+
+TEST_CASE("Splice elements and ranges") {
+  DoublyLinkedList<int> list;
+  DoublyLinkedList<int> other;
+  for (int i = 0; i < 5; i++) {
+    list.push_back(i);
+    other.push_back(10 + i);
+  }
+
+  auto last = list.begin();
+  while (last.next()) {
+    ++last;
+  }
+  list.splice(list.begin(), list, last);
+  REQUIRE(toVector(list) == std::vector<int>{4, 0, 1, 2, 3});
+  REQUIRE(list.back() == 3);
+
+  auto from = list.begin().next();
+  list.splice(list.end(), list, from, from.next().next());
+  REQUIRE(toVector(list) == std::vector<int>{4, 2, 3, 0, 1});
+  REQUIRE(list.size() == 5);
+
+  list.splice(list.begin(), other, other.begin().next(), other.end());
+  REQUIRE(toVector(list) == std::vector<int>{11, 12, 13, 14, 4, 2, 3, 0, 1});
+  REQUIRE(other.size() == 1);
+  REQUIRE(other.back() == 10);
+}
+
+TEST_CASE("Splice from another list to the end") {
+  DoublyLinkedList<int> list;
+  DoublyLinkedList<int> other;
+  for (int i = 0; i < 3; i++) {
+    list.push_back(i);
+    other.push_back(10 + i);
+  }
+  const int *moved = &*other.begin().next();
+
+  list.splice(list.end(), other, other.begin().next(), other.end());
+  REQUIRE(toVector(list) == std::vector<int>{0, 1, 2, 11, 12});
+  REQUIRE(list.size() == 5);
+  REQUIRE(list.back() == 12);
+  REQUIRE(toVector(other) == std::vector<int>{10});
+  REQUIRE(other.size() == 1);
+  REQUIRE(other.back() == 10);
+  // the node was relinked, not copied
+  REQUIRE(&*list.begin().next().next().next() == moved);
+
+  list.splice(list.end(), other, other.begin());
+  REQUIRE(toVector(list) == std::vector<int>{0, 1, 2, 11, 12, 10});
+  REQUIRE(list.size() == 6);
+  REQUIRE(list.back() == 10);
+  REQUIRE(other.empty());
+  REQUIRE(other.size() == 0);
+
+  other.splice(other.end(), list, list.begin());
+  REQUIRE(toVector(other) == std::vector<int>{0});
+  REQUIRE(toVector(list) == std::vector<int>{1, 2, 11, 12, 10});
+}
+
+TEST_CASE("Lists which exchanged nodes outlive each other") {
+  DoublyLinkedList<std::string> list;
+  list.push_back("kept");
+  {
+    DoublyLinkedList<std::string> other;
+    for (int i = 0; i < 100; i++) {
+      other.push_back(std::to_string(i));
+    }
+    list.splice(list.end(), other, other.begin());
+    other.splice(other.end(), list, list.begin());
+    REQUIRE(other.back() == "kept");
+    list.splice(list.end(), other, other.begin().next());
+  }
+
+  // the nodes from the destroyed list are still in use, and reused
+  REQUIRE(toVector(list) == std::vector<std::string>{"0", "2"});
+  list.pop_front();
+  list.push_back("again");
+  REQUIRE(toVector(list) == std::vector<std::string>{"2", "again"});
+  list.clear();
+  list.push_back("cleared");
+  REQUIRE(list.front() == "cleared");
+}
+
+TEST_CASE("Merge two sorted lists") {
+  DoublyLinkedList<int> evens;
+  DoublyLinkedList<int> odds;
+  for (int i = 0; i < 20; i += 2) {
+    evens.push_back(i);
+    odds.push_back(i + 1);
+  }
+  odds.push_back(21);
+
+  evens.merge(odds);
+  REQUIRE(odds.empty());
+  REQUIRE(evens.size() == 21);
+  std::vector<int> expected;
+  for (int i = 0; i < 20; i++) {
+    expected.push_back(i);
+  }
+  expected.push_back(21);
+  REQUIRE(toVector(evens) == expected);
+  REQUIRE(evens.back() == 21);
+  REQUIRE(*evens.begin().next().next().prev() == 1);
+}
+
+TEST_CASE("Merge sorted lists descending") {
+  DoublyLinkedList<int> first;
+  DoublyLinkedList<int> second;
+  first.push_back(5);
+  first.push_back(1);
+  second.push_back(4);
+  second.push_back(2);
+
+  first.merge(second, std::greater<>{});
+  REQUIRE(toVector(first) == std::vector<int>{5, 4, 2, 1});
+}
+
+TEST_CASE("Sort relinks the nodes") {
+  DoublyLinkedList<int> list;
+  std::vector<int> values;
+  std::uint64_t state = 7;
+  for (int i = 0; i < 10'000; i++) {
+    state = state * 6364136223846793005ull + 1442695040888963407ull;
+    values.push_back(static_cast<int>(state >> 40) % 1000);
+    list.push_back(values.back());
+  }
+  const int *firstValue = &list.front();
+
+  list.sort();
+  std::sort(values.begin(), values.end());
+  REQUIRE(toVector(list) == values);
+  REQUIRE(list.size() == values.size());
+  REQUIRE(list.back() == values.back());
+
+  // the node of the first element moved with it
+  bool found = false;
+  for (const int &value : list) {
+    found = found || &value == firstValue;
+  }
+  REQUIRE(found);
+
+  // previous links are consistent
+  std::vector<int> backwards;
+  auto it = list.begin();
+  while (it.next()) {
+    ++it;
+  }
+  for (; it; --it) {
+    backwards.push_back(*it);
+  }
+  std::reverse(backwards.begin(), backwards.end());
+  REQUIRE(backwards == values);
+}
+
+TEST_CASE("Sort is stable") {
+  DoublyLinkedList<std::pair<int, int>> list;
+  for (int i = 0; i < 1000; i++) {
+    list.push_back({(i * 7) % 10, i});
+  }
+
+  list.sort([](const auto &lhs, const auto &rhs) {
+    return lhs.first < rhs.first;
+  });
+
+  auto it = list.begin();
+  for (auto next = it.next(); next; it = next, next = next.next()) {
+    REQUIRE((*it).first <= (*next).first);
+    if ((*it).first == (*next).first) {
+      REQUIRE((*it).second < (*next).second);
+    }
+  }
+}
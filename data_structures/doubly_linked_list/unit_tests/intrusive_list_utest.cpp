@@ -0,0 +1,187 @@
+#include "catch.hpp"
+#include "intrusive_list.h"
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Task {
+  explicit Task(int i) : id{i} {}
+
+  int id;
+  IntrusiveListHook runQueueHook;
+  std::string name = "task";
+  IntrusiveListHook allTasksHook;
+};
+
+using RunQueue = IntrusiveList<Task, &Task::runQueueHook>;
+using AllTasks = IntrusiveList<Task, &Task::allTasksHook>;
+
+template <typename List>
+std::vector<int> ids(const List &list) {
+  std::vector<int> result;
+  for (const Task &task : list) {
+    result.push_back(task.id);
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST_CASE("Intrusive list links the objects themselves") {
+  std::vector<Task> tasks{Task{1}, Task{2}, Task{3}};
+  RunQueue list;
+  for (Task &task : tasks) {
+    list.push_back(task);
+  }
+
+  REQUIRE(list.size() == 3);
+  REQUIRE(&list.front() == &tasks[0]);
+  REQUIRE(&list.back() == &tasks[2]);
+  REQUIRE(ids(list) == std::vector<int>{1, 2, 3});
+
+  list.begin()->id = 10;
+  REQUIRE(tasks[0].id == 10);
+}
+
+TEST_CASE("Intrusive list push and pop at both ends") {
+  std::vector<Task> tasks;
+  for (int i = 0; i < 100; i++) {
+    tasks.emplace_back(i);
+  }
+
+  RunQueue list;
+  for (Task &task : tasks) {
+    list.push_front(task);
+  }
+  REQUIRE(list.front().id == 99);
+  REQUIRE(list.back().id == 0);
+
+  for (int i = 0; i < 50; i++) {
+    list.pop_back();
+    list.pop_front();
+  }
+
+  REQUIRE(list.empty());
+  REQUIRE(!tasks[0].runQueueHook.isLinked());
+  REQUIRE_THROWS_AS(list.pop_back(), std::runtime_error);
+  REQUIRE_THROWS_AS(list.pop_front(), std::runtime_error);
+}
+
+TEST_CASE("An object is on several intrusive lists at once") {
+  std::vector<Task> tasks{Task{1}, Task{2}, Task{3}, Task{4}};
+  RunQueue runQueue;
+  AllTasks allTasks;
+  for (Task &task : tasks) {
+    allTasks.push_back(task);
+  }
+  runQueue.push_back(tasks[3]);
+  runQueue.push_back(tasks[1]);
+
+  REQUIRE(ids(allTasks) == std::vector<int>{1, 2, 3, 4});
+  REQUIRE(ids(runQueue) == std::vector<int>{4, 2});
+
+  allTasks.erase(tasks[3]);
+  REQUIRE(ids(allTasks) == std::vector<int>{1, 2, 3});
+  REQUIRE(ids(runQueue) == std::vector<int>{4, 2});
+}
+
+TEST_CASE("Linking an object twice throws exception") {
+  Task task{1};
+  RunQueue list;
+  RunQueue other;
+  list.push_back(task);
+  REQUIRE_THROWS_AS(list.push_back(task), std::invalid_argument);
+  REQUIRE_THROWS_AS(other.push_front(task), std::invalid_argument);
+  REQUIRE(list.size() == 1);
+  REQUIRE(other.empty());
+}
+
+TEST_CASE("Intrusive list erases from anywhere") {
+  std::vector<Task> tasks;
+  for (int i = 0; i < 6; i++) {
+    tasks.emplace_back(i);
+  }
+
+  RunQueue list;
+  for (Task &task : tasks) {
+    list.push_back(task);
+  }
+
+  list.erase(tasks[0]);
+  list.erase(tasks[5]);
+  list.erase(tasks[2]);
+  REQUIRE(ids(list) == std::vector<int>{1, 3, 4});
+
+  auto next = list.erase(list.iteratorTo(tasks[3]));
+  REQUIRE(next->id == 4);
+  REQUIRE(list.erase(next) == list.end());
+  REQUIRE(ids(list) == std::vector<int>{1});
+
+  list.insertBefore(list.begin(), tasks[5]);
+  list.insertBefore(list.end(), tasks[0]);
+  REQUIRE(ids(list) == std::vector<int>{5, 1, 0});
+}
+
+TEST_CASE("Intrusive list iterates backwards") {
+  std::vector<Task> tasks{Task{1}, Task{2}, Task{3}};
+  RunQueue list;
+  for (Task &task : tasks) {
+    list.push_back(task);
+  }
+
+  auto it = list.iteratorTo(tasks[2]);
+  REQUIRE((it--)->id == 3);
+  REQUIRE((it--)->id == 2);
+  REQUIRE(it->id == 1);
+  REQUIRE(!(--it).isValid());
+}
+
+TEST_CASE("Intrusive list splices whole lists and single objects") {
+  std::vector<Task> tasks;
+  for (int i = 0; i < 6; i++) {
+    tasks.emplace_back(i);
+  }
+
+  RunQueue first;
+  RunQueue second;
+  for (int i = 0; i < 3; i++) {
+    first.push_back(tasks[i]);
+    second.push_back(tasks[i + 3]);
+  }
+
+  first.splice(first.iteratorTo(tasks[1]), second);
+  REQUIRE(ids(first) == std::vector<int>{0, 3, 4, 5, 1, 2});
+  REQUIRE(second.empty());
+  REQUIRE(first.size() == 6);
+
+  second.splice(second.end(), first, tasks[4]);
+  second.splice(second.begin(), first, tasks[0]);
+  REQUIRE(ids(first) == std::vector<int>{3, 5, 1, 2});
+  REQUIRE(ids(second) == std::vector<int>{0, 4});
+
+  first.splice(first.end(), second);
+  REQUIRE(ids(first) == std::vector<int>{3, 5, 1, 2, 0, 4});
+
+  first.splice(first.begin(), first, tasks[4]);
+  REQUIRE(ids(first) == std::vector<int>{4, 3, 5, 1, 2, 0});
+}
+
+TEST_CASE("Clearing an intrusive list unlinks its objects") {
+  std::vector<Task> tasks{Task{1}, Task{2}};
+  {
+    RunQueue list;
+    list.push_back(tasks[0]);
+    list.push_back(tasks[1]);
+    list.clear();
+    REQUIRE(list.empty());
+    REQUIRE(!tasks[0].runQueueHook.isLinked());
+
+    list.push_back(tasks[1]);
+  }
+
+  REQUIRE(!tasks[1].runQueueHook.isLinked());
+
+  Task copy = tasks[0];
+  REQUIRE(!copy.runQueueHook.isLinked());
+}
@@ -0,0 +1,177 @@
+#include "catch.hpp"
+#include "unrolled_list.h"
+#include <list>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace {
+
+template <typename T, size_t K>
+std::vector<T> toVector(const UnrolledList<T, K> &list) {
+  return std::vector<T>(list.begin(), list.end());
+}
+
+}  // namespace
+
+TEST_CASE("Unrolled list is empty on construction") {
+  UnrolledList<int> list;
+  REQUIRE(list.empty());
+  REQUIRE(list.size() == 0);
+  REQUIRE(list.begin() == list.end());
+}
+
+TEST_CASE("Unrolled list push and pop at both ends") {
+  UnrolledList<int, 4> list;
+  for (int i = 1; i <= 1000; i++) {
+    list.push_back(i);
+    list.push_front(-i);
+    REQUIRE(list.back() == i);
+    REQUIRE(list.front() == -i);
+    REQUIRE(list.size() == 2 * static_cast<size_t>(i));
+  }
+
+  for (int i = 1000; i >= 1; i--) {
+    REQUIRE(list.back() == i);
+    list.pop_back();
+    REQUIRE(list.front() == -i);
+    list.pop_front();
+  }
+
+  REQUIRE(list.empty());
+  REQUIRE_THROWS_AS(list.pop_back(), std::runtime_error);
+  REQUIRE_THROWS_AS(list.pop_front(), std::runtime_error);
+}
+
+TEST_CASE("Unrolled list iterates both ways") {
+  UnrolledList<int, 4> list;
+  for (int i = 0; i < 100; i++) {
+    list.push_back(i);
+  }
+
+  int expected = 0;
+  for (auto it = list.cbegin(); it != list.cend(); ++it) {
+    REQUIRE(*it == expected++);
+  }
+  REQUIRE(expected == 100);
+
+  auto it = list.begin();
+  for (int i = 0; i < 99; i++) {
+    ++it;
+  }
+  for (int i = 99; i >= 0; i--, --it) {
+    REQUIRE(*it == i);
+  }
+  REQUIRE(!it.isValid());
+}
+
+TEST_CASE("Unrolled list inserts and erases like std::list") {
+  UnrolledList<int, 8> list;
+  std::list<int> reference;
+  uint64_t state = 12345;
+  auto random = [&state](size_t bound) {
+    state = state * 6364136223846793005ull + 1442695040888963407ull;
+    return static_cast<size_t>((state >> 33) % bound);
+  };
+
+  for (int i = 0; i < 5000; i++) {
+    const size_t position = random(reference.size() + 1);
+    auto it = list.begin();
+    auto referenceIt = reference.begin();
+    for (size_t j = 0; j < position; j++, ++it, ++referenceIt) {
+    }
+
+    if (random(3) == 0 && referenceIt != reference.end()) {
+      auto next = list.erase(it);
+      auto referenceNext = reference.erase(referenceIt);
+      REQUIRE((referenceNext == reference.end()) == (next == list.end()));
+      if (next != list.end()) {
+        REQUIRE(*next == *referenceNext);
+      }
+    } else {
+      auto inserted = list.insertBefore(it, i);
+      reference.insert(referenceIt, i);
+      REQUIRE(*inserted == i);
+    }
+
+    REQUIRE(list.size() == reference.size());
+  }
+
+  REQUIRE(toVector(list) == std::vector<int>(reference.begin(),
+                                             reference.end()));
+}
+
+TEST_CASE("Unrolled list erases every other element") {
+  UnrolledList<int, 4> list;
+  for (int i = 0; i < 100; i++) {
+    list.push_back(i);
+  }
+
+  for (auto it = list.begin(); it != list.end(); ++it) {
+    it = list.erase(it);
+    if (it == list.end()) {
+      break;
+    }
+  }
+
+  std::vector<int> odd;
+  for (int i = 1; i < 100; i += 2) {
+    odd.push_back(i);
+  }
+  REQUIRE(toVector(list) == odd);
+}
+
+TEST_CASE("Unrolled list inserting an element of itself") {
+  UnrolledList<std::string, 4> list;
+  for (int i = 0; i < 4; i++) {
+    list.push_back(std::to_string(i));
+  }
+
+  list.insertBefore(list.begin(), list.back());
+  list.insertBefore(list.end(), list.front());
+  REQUIRE(toVector(list) ==
+          std::vector<std::string>{"3", "0", "1", "2", "3", "3"});
+}
+
+TEST_CASE("A cleared unrolled list of strings can be filled again") {
+  UnrolledList<std::string> list;
+  for (int i = 0; i < 1000; i++) {
+    list.push_back("a string too long for small string optimization " +
+                   std::to_string(i));
+  }
+
+  list.clear();
+  REQUIRE(list.empty());
+  REQUIRE(list.begin() == list.end());
+
+  list.push_back("again");
+  REQUIRE(list.front() == "again");
+  REQUIRE(list.size() == 1);
+}
+
+TEST_CASE("Unrolled list copy, assignment and equality") {
+  UnrolledList<int, 4> list;
+  for (int i = 0; i < 50; i++) {
+    list.push_back(i);
+  }
+
+  UnrolledList<int, 4> copy{list};
+  REQUIRE(copy == list);
+
+  UnrolledList<int, 4> assigned;
+  assigned.push_back(-1);
+  assigned = list;
+  REQUIRE(assigned == list);
+
+  assigned.pop_front();
+  REQUIRE(assigned != list);
+}
+
+TEST_CASE("Unrolled list works with standard algorithms") {
+  UnrolledList<long long> list;
+  for (int i = 1; i <= 10000; i++) {
+    list.push_back(i);
+  }
+
+  REQUIRE(std::accumulate(list.begin(), list.end(), 0ll) == 50005000);
+}
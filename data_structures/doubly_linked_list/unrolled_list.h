@@ -0,0 +1,580 @@
+#ifndef UNROLLED_LIST_H
+#define UNROLLED_LIST_H
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "../memory/node_pool.h"
+
+/**
+ * Returns the default number of elements in a node of an UnrolledList: as
+ * many as fit in about 512 bytes, at least 4. A node then spans a few cache
+ * lines, which the hardware prefetcher streams in while the elements of the
+ * previous lines are processed.
+ */
+template <typename T>
+constexpr size_t unrolledListNodeCapacity() {
+  return std::max<size_t>(4, (512 - 3 * sizeof(void *)) / sizeof(T));
+}
+
+template <typename T, size_t K>
+struct UnrolledNode {
+  UnrolledNode *previous = nullptr;
+  UnrolledNode *next = nullptr;
+  size_t count = 0;
+  alignas(T) unsigned char storage[K * sizeof(T)];
+
+  T *elements() { return std::launder(reinterpret_cast<T *>(storage)); }
+  const T *elements() const {
+    return std::launder(reinterpret_cast<const T *>(storage));
+  }
+};
+
+template <typename T, size_t K, typename ReferenceType, typename NodeType>
+class UnrolledIterator;
+
+template <typename T, size_t K = unrolledListNodeCapacity<T>()>
+class UnrolledList;
+
+template <typename T, size_t K = unrolledListNodeCapacity<T>()>
+using UnrolledListIterator = UnrolledIterator<T, K, T &, UnrolledNode<T, K>>;
+
+template <typename T, size_t K = unrolledListNodeCapacity<T>()>
+using UnrolledListCIterator =
+    UnrolledIterator<T, K, const T &, const UnrolledNode<T, K>>;
+
+/**
+ * Doubly linked list with the interface of DoublyLinkedList whose nodes hold
+ * up to K elements each, next to each other. A traversal touches one node per
+ * K elements instead of one per element, so it runs at nearly the speed of a
+ * walk over an array, and the list needs two pointers per node instead of
+ * two per element.
+ *
+ * Inserting into a full node splits it in two halves; erasing from a node
+ * which becomes less than half full merges it with a neighbour if the two fit
+ * in one node. Either way at most K elements are moved, so insertion and
+ * erasure at an iterator are O(K). Every node but a lone one stays at least
+ * half full on average.
+ *
+ * Insertion and erasure move elements within the nodes they touch: they
+ * invalidate the iterators to the elements of those nodes (the returned
+ * iterator is valid), while iterators to elements of all other nodes stay
+ * valid.
+ *
+ * The nodes are allocated from a NodePool, whose slabs are taken from the
+ * given std::pmr::memory_resource, or from the global heap if no resource
+ * (nullptr) is given. Copies use the global heap and assignment never changes
+ * the resource of the target.
+ *
+ * @tparam K Maximum number of elements in a node
+ */
+template <typename T, size_t K>
+class UnrolledList {
+  static_assert(K >= 2, "Nodes must hold at least two elements.");
+
+  using NodeType = UnrolledNode<T, K>;
+
+ public:
+  using iterator = UnrolledListIterator<T, K>;
+  using const_iterator = UnrolledListCIterator<T, K>;
+
+  UnrolledList() = default;
+  explicit UnrolledList(std::pmr::memory_resource *resource);
+  UnrolledList(const UnrolledList &other);             // O(n)
+  UnrolledList &operator=(const UnrolledList &other);  // O(n)
+  ~UnrolledList();  // O(slabs), O(n) if T has a destructor
+
+  /**
+   * Appends the given element value to the end of the container.
+   * O(1) time complexity
+   */
+  void push_back(const T &value);
+
+  /**
+   * Removes the last element of the container.
+   * Calling pop_back on an empty container throws exception.
+   * O(K) time complexity, amortized O(1)
+   *
+   * @throw std::runtime_error
+   */
+  void pop_back();
+
+  /**
+   * Appends the given element value at the beginning of the container.
+   * O(K) time complexity
+   */
+  void push_front(const T &value);
+
+  /**
+   * Removes the first element of the container.
+   * Calling pop_front on an empty container throws exception.
+   * O(K) time complexity
+   *
+   * @throw std::runtime_error
+   */
+  void pop_front();
+
+  iterator begin() noexcept;
+  const_iterator begin() const noexcept;
+  const_iterator cbegin() const noexcept;
+
+  iterator end() noexcept;
+  const_iterator end() const noexcept;
+  const_iterator cend() const noexcept;
+
+  /**
+   * Inserts value before pos, which may be end(). O(K) time complexity
+   *
+   * @return Iterator pointing to the inserted value
+   */
+  iterator insertBefore(const_iterator pos, const T &value);
+
+  /**
+   * Removes the element at pos. O(K) time complexity
+   * If moving an element throws, the list stays valid, but the elements of
+   * the nodes which were touched may be left moved from.
+   *
+   * @return Iterator following the removed element, end() if it was the last
+   */
+  iterator erase(const_iterator pos);
+
+  /**
+   * Returns a reference to the first element in the container.
+   */
+  T &front();
+  const T &front() const;
+
+  /**
+   * Returns a reference to the last element in the container.
+   */
+  T &back();
+  const T &back() const;
+
+  size_t size() const noexcept { return currentSize; }
+  bool empty() const noexcept { return currentSize == 0; }
+
+  /**
+   * Removes all elements and gives all memory of the list back.
+   * Complexity: linear in the number of slabs if T is trivially destructible,
+   * otherwise linear in the number of elements, whose destructors are run.
+   */
+  void clear();
+
+  /**
+   * Returns the memory resource of the list, nullptr for the global heap
+   */
+  std::pmr::memory_resource *resource() const noexcept;
+
+ private:
+  // Links a new, empty node after the given one (at the front if nullptr)
+  NodeType *createNodeAfter(NodeType *previous);
+  void destroyNode(NodeType *node) noexcept;
+
+  // Moves the elements of source to the end of target and destroys source
+  void mergeInto(NodeType *target, NodeType *source);
+
+  // Moves the upper half of a full node to a new node after it
+  NodeType *split(NodeType *node);
+
+  static void insertAt(NodeType *node, size_t index, const T &value);
+  static void eraseAt(NodeType *node, size_t index);
+
+  NodeType *head = nullptr;
+  NodeType *tail = nullptr;
+  size_t currentSize = 0;
+  std::pmr::memory_resource *memoryResource = nullptr;
+  NodePool<NodeType> nodePool;
+};
+
+template <typename T, size_t K, typename ReferenceType, typename NodeType>
+class UnrolledIterator {
+  using I = UnrolledIterator;
+
+ public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = T;
+  using difference_type = std::ptrdiff_t;
+  using pointer = std::remove_reference_t<ReferenceType> *;
+  using reference = ReferenceType;
+
+  explicit UnrolledIterator(NodeType *node = nullptr, size_t index = 0)
+      : m_pNode{node}, m_index{index} {}
+
+  // An iterator converts to a const iterator
+  template <typename OtherReference, typename OtherNode>
+    requires std::is_const_v<NodeType> && (!std::is_const_v<OtherNode>)
+  UnrolledIterator(
+      const UnrolledIterator<T, K, OtherReference, OtherNode> &other)
+      : m_pNode{other.m_pNode}, m_index{other.m_index} {}
+
+  I next() const {
+    if (!isValid()) {
+      return *this;
+    }
+
+    if (m_index + 1 < m_pNode->count) {
+      return I{m_pNode, m_index + 1};
+    }
+
+    return I{m_pNode->next, 0};
+  }
+
+  I prev() const {
+    if (!isValid()) {
+      return *this;
+    }
+
+    if (m_index > 0) {
+      return I{m_pNode, m_index - 1};
+    }
+
+    NodeType *previous = m_pNode->previous;
+    return previous ? I{previous, previous->count - 1} : I{};
+  }
+
+  // Prefix ++ overload
+  I &operator++() {
+    if (++m_index == m_pNode->count) {
+      m_pNode = m_pNode->next;
+      m_index = 0;
+    }
+
+    return *this;
+  }
+
+  // Postfix ++ overload
+  I operator++(int) {
+    I old = *this;
+    ++*this;
+    return old;
+  }
+
+  // Prefix -- overload
+  I &operator--() { return *this = prev(); }
+
+  // Postfix -- overload
+  I operator--(int) {
+    I old = *this;
+    --*this;
+    return old;
+  }
+
+  bool isValid() const { return m_pNode != nullptr; }
+  operator bool() const { return isValid(); }
+
+  // Calling dereference operator on invalid iterator causes undefined behavior
+  ReferenceType get() const { return m_pNode->elements()[m_index]; }
+  ReferenceType operator*() const { return get(); }
+  pointer operator->() const { return &get(); }
+
+  friend bool operator==(const I &lhs, const I &rhs) {
+    return lhs.m_pNode == rhs.m_pNode && lhs.m_index == rhs.m_index;
+  }
+
+ private:
+  NodeType *m_pNode;
+  size_t m_index;
+
+  template <typename, size_t, typename, typename>
+  friend class UnrolledIterator;
+  friend class UnrolledList<T, K>;
+};
+
+template <typename T, size_t K>
+UnrolledList<T, K>::UnrolledList(std::pmr::memory_resource *resource)
+    : memoryResource{resource},
+      nodePool{resource ? resource : std::pmr::new_delete_resource()} {}
+
+template <typename T, size_t K>
+UnrolledList<T, K>::UnrolledList(const UnrolledList &other) {
+  for (const T &elem : other) {
+    push_back(elem);
+  }
+}
+
+template <typename T, size_t K>
+UnrolledList<T, K> &UnrolledList<T, K>::operator=(const UnrolledList &other) {
+  if (this != &other) {
+    clear();
+    for (const T &elem : other) {
+      push_back(elem);
+    }
+  }
+
+  return *this;
+}
+
+template <typename T, size_t K>
+UnrolledList<T, K>::~UnrolledList() {
+  clear();
+}
+
+template <typename T, size_t K>
+void UnrolledList<T, K>::push_back(const T &value) {
+  NodeType *node = tail;
+  if (!node || node->count == K) {
+    node = createNodeAfter(tail);
+  }
+
+  try {
+    insertAt(node, node->count, value);
+  } catch (...) {
+    if (node->count == 0) {
+      destroyNode(node);
+    }
+    throw;
+  }
+  ++currentSize;
+}
+
+template <typename T, size_t K>
+void UnrolledList<T, K>::pop_back() {
+  if (empty()) {
+    throw std::runtime_error{"Calling pop_back() on an empty list."};
+  }
+
+  erase(const_iterator{tail, tail->count - 1});
+}
+
+template <typename T, size_t K>
+void UnrolledList<T, K>::push_front(const T &value) {
+  insertBefore(cbegin(), value);
+}
+
+template <typename T, size_t K>
+void UnrolledList<T, K>::pop_front() {
+  if (empty()) {
+    throw std::runtime_error{"Calling pop_front() on an empty list."};
+  }
+
+  erase(cbegin());
+}
+
+template <typename T, size_t K>
+typename UnrolledList<T, K>::iterator UnrolledList<T, K>::begin() noexcept {
+  return iterator{head, 0};
+}
+
+template <typename T, size_t K>
+typename UnrolledList<T, K>::const_iterator UnrolledList<T, K>::begin()
+    const noexcept {
+  return const_iterator{head, 0};
+}
+
+template <typename T, size_t K>
+typename UnrolledList<T, K>::const_iterator UnrolledList<T, K>::cbegin()
+    const noexcept {
+  return const_iterator{head, 0};
+}
+
+template <typename T, size_t K>
+typename UnrolledList<T, K>::iterator UnrolledList<T, K>::end() noexcept {
+  return iterator{};
+}
+
+template <typename T, size_t K>
+typename UnrolledList<T, K>::const_iterator UnrolledList<T, K>::end()
+    const noexcept {
+  return const_iterator{};
+}
+
+template <typename T, size_t K>
+typename UnrolledList<T, K>::const_iterator UnrolledList<T, K>::cend()
+    const noexcept {
+  return const_iterator{};
+}
+
+template <typename T, size_t K>
+typename UnrolledList<T, K>::iterator UnrolledList<T, K>::insertBefore(
+    const_iterator pos, const T &value) {
+  if (!pos.isValid()) {
+    push_back(value);
+    return iterator{tail, tail->count - 1};
+  }
+
+  auto *node = const_cast<NodeType *>(pos.m_pNode);
+  size_t index = pos.m_index;
+
+  // Before the first element of a node the value may as well go to the end
+  // of the previous node, which saves shifting this one
+  if (index == 0 && node->previous && node->previous->count < K) {
+    node = node->previous;
+    index = node->count;
+  } else if (node->count == K) {
+    // value may be one of the elements which the split moves
+    const T copy(value);
+    NodeType *upper = split(node);
+    if (index > node->count) {
+      index -= node->count;
+      node = upper;
+    }
+
+    insertAt(node, index, copy);
+    ++currentSize;
+    return iterator{node, index};
+  }
+
+  insertAt(node, index, value);
+  ++currentSize;
+  return iterator{node, index};
+}
+
+template <typename T, size_t K>
+typename UnrolledList<T, K>::iterator UnrolledList<T, K>::erase(
+    const_iterator pos) {
+  auto *node = const_cast<NodeType *>(pos.m_pNode);
+  size_t index = pos.m_index;
+  eraseAt(node, index);
+  --currentSize;
+
+  if (node->count == 0) {
+    NodeType *next = node->next;
+    destroyNode(node);
+    return iterator{next, 0};
+  }
+
+  if (node->count < K / 2) {
+    if (node->next && node->count + node->next->count <= K) {
+      mergeInto(node, node->next);
+    } else if (node->previous && node->previous->count + node->count <= K) {
+      NodeType *previous = node->previous;
+      index += previous->count;
+      mergeInto(previous, node);
+      node = previous;
+    }
+  }
+
+  if (index == node->count) {
+    return iterator{node->next, 0};
+  }
+
+  return iterator{node, index};
+}
+
+template <typename T, size_t K>
+T &UnrolledList<T, K>::front() {
+  return head->elements()[0];
+}
+
+template <typename T, size_t K>
+const T &UnrolledList<T, K>::front() const {
+  return head->elements()[0];
+}
+
+template <typename T, size_t K>
+T &UnrolledList<T, K>::back() {
+  return tail->elements()[tail->count - 1];
+}
+
+template <typename T, size_t K>
+const T &UnrolledList<T, K>::back() const {
+  return tail->elements()[tail->count - 1];
+}
+
+template <typename T, size_t K>
+void UnrolledList<T, K>::clear() {
+  if constexpr (!std::is_trivially_destructible_v<T>) {
+    for (NodeType *node = head; node; node = node->next) {
+      std::destroy_n(node->elements(), node->count);
+    }
+  }
+
+  nodePool.release();
+  head = tail = nullptr;
+  currentSize = 0;
+}
+
+template <typename T, size_t K>
+std::pmr::memory_resource *UnrolledList<T, K>::resource() const noexcept {
+  return memoryResource;
+}
+
+template <typename T, size_t K>
+typename UnrolledList<T, K>::NodeType *UnrolledList<T, K>::createNodeAfter(
+    NodeType *previous) {
+  auto *node = ::new (nodePool.allocate()) NodeType;
+  node->previous = previous;
+  node->next = previous ? previous->next : head;
+  (node->next ? node->next->previous : tail) = node;
+  (previous ? previous->next : head) = node;
+  return node;
+}
+
+template <typename T, size_t K>
+void UnrolledList<T, K>::destroyNode(NodeType *node) noexcept {
+  (node->previous ? node->previous->next : head) = node->next;
+  (node->next ? node->next->previous : tail) = node->previous;
+  node->~NodeType();
+  nodePool.deallocate(node);
+}
+
+template <typename T, size_t K>
+void UnrolledList<T, K>::mergeInto(NodeType *target, NodeType *source) {
+  std::uninitialized_move_n(source->elements(), source->count,
+                            target->elements() + target->count);
+  std::destroy_n(source->elements(), source->count);
+  target->count += source->count;
+  source->count = 0;
+  destroyNode(source);
+}
+
+template <typename T, size_t K>
+typename UnrolledList<T, K>::NodeType *UnrolledList<T, K>::split(
+    NodeType *node) {
+  NodeType *upper = createNodeAfter(node);
+  const size_t keep = node->count / 2;
+  const size_t moved = node->count - keep;
+  std::uninitialized_move_n(node->elements() + keep, moved,
+                            upper->elements());
+  std::destroy_n(node->elements() + keep, moved);
+  upper->count = moved;
+  node->count = keep;
+  return upper;
+}
+
+template <typename T, size_t K>
+void UnrolledList<T, K>::insertAt(NodeType *node, size_t index,
+                                  const T &value) {
+  T *elements = node->elements();
+  if (index == node->count) {
+    ::new (static_cast<void *>(elements + index)) T(value);
+  } else {
+    // copies first, as value may be one of the elements which are shifted
+    T copy(value);
+    ::new (static_cast<void *>(elements + node->count))
+        T(std::move(elements[node->count - 1]));
+    std::move_backward(elements + index, elements + node->count - 1,
+                       elements + node->count);
+    elements[index] = std::move(copy);
+  }
+
+  ++node->count;
+}
+
+template <typename T, size_t K>
+void UnrolledList<T, K>::eraseAt(NodeType *node, size_t index) {
+  T *elements = node->elements();
+  std::move(elements + index + 1, elements + node->count, elements + index);
+  std::destroy_at(elements + node->count - 1);
+  --node->count;
+}
+
+template <typename T, size_t K>
+bool operator==(const UnrolledList<T, K> &lhs, const UnrolledList<T, K> &rhs) {
+  return lhs.size() == rhs.size() &&
+         std::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin());
+}
+
+template <typename T, size_t K>
+bool operator!=(const UnrolledList<T, K> &lhs, const UnrolledList<T, K> &rhs) {
+  return !(lhs == rhs);
+}
+
+#endif
@@ -0,0 +1,128 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+#include "doubly_linked_list.h"
+#include "unrolled_list.h"
+
+/*
+UnrolledList against DoublyLinkedList and std::vector.
+
+1. Traversal: std::accumulate over a container of the given length. The
+   DoublyLinkedList is measured twice: built by push_back, so that its nodes
+   lie in its slabs in list order, and after its order was shuffled by
+   erasing and inserting at random places, which is where a linked list
+   usually ends up.
+
+2. Insertion in the middle: a pass over the list which inserts an element
+   before every 4th element, growing the list by a quarter.
+
+Run:
+$> ./unrolled_list_benchmark [length]
+*/
+
+namespace {
+
+struct Random {
+  std::uint64_t state = 88172645463325252ull;
+
+  size_t below(size_t bound) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return static_cast<size_t>(state % bound);
+  }
+};
+
+template <typename Container>
+double millionElementsPerSecond(const Container &container) {
+  // the best of a few runs, as the first one also warms the caches up
+  double best = 0;
+  long long sum = 0;
+  for (int run = 0; run < 3; run++) {
+    const auto start = std::chrono::steady_clock::now();
+    sum += std::accumulate(container.begin(), container.end(), 0ll);
+    const auto end = std::chrono::steady_clock::now();
+    const double seconds = std::chrono::duration<double>(end - start).count();
+    best = std::max(best, container.size() / seconds / 1e6);
+  }
+
+  // keeps the sums from being optimized away
+  if (sum == 42) {
+    std::cout << "";
+  }
+  return best;
+}
+
+// Moves every element of the list to a random place
+void shuffle(DoublyLinkedList<long long> &list, size_t length) {
+  std::vector<DoublyLinkedListIterator<long long>> handles;
+  for (auto it = list.begin(); it != list.end(); ++it) {
+    handles.push_back(it);
+  }
+
+  Random random;
+  for (size_t i = 0; i < length; i++) {
+    const size_t target = random.below(length);
+    if (target == i) {
+      continue;
+    }
+
+    const long long value = *handles[i];
+    list.erase(handles[i]);
+    handles[i] = list.insertBefore(handles[target], value);
+  }
+}
+
+template <typename List>
+double insertionMilliseconds(List &list) {
+  const auto start = std::chrono::steady_clock::now();
+  size_t index = 0;
+  for (auto it = list.begin(); it != list.end(); ++it, ++index) {
+    if (index % 4 == 0) {
+      it = list.insertBefore(it, -1);
+      ++it;
+    }
+  }
+  const auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  const size_t length =
+      argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+
+  std::vector<long long> vector(length);
+  std::iota(vector.begin(), vector.end(), 0ll);
+  UnrolledList<long long> unrolled;
+  DoublyLinkedList<long long> list;
+  for (long long value : vector) {
+    unrolled.push_back(value);
+    list.push_back(value);
+  }
+
+  std::cout << "std::accumulate over " << length << " elements\n";
+  std::cout << "  std::vector: " << millionElementsPerSecond(vector)
+            << " M elements/s\n";
+  std::cout << "  UnrolledList: " << millionElementsPerSecond(unrolled)
+            << " M elements/s\n";
+  std::cout << "  DoublyLinkedList, in order: "
+            << millionElementsPerSecond(list) << " M elements/s\n";
+  shuffle(list, length);
+  std::cout << "  DoublyLinkedList, shuffled: "
+            << millionElementsPerSecond(list) << " M elements/s\n";
+
+  std::cout << "Insertion before every 4th element\n";
+  std::cout << "  UnrolledList: " << insertionMilliseconds(unrolled)
+            << " ms\n";
+  std::cout << "  DoublyLinkedList, shuffled: " << insertionMilliseconds(list)
+            << " ms\n";
+
+  return 0;
+}
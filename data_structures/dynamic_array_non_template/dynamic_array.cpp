@@ -1,8 +1,9 @@
 #include "dynamic_array.h"
+#include <new>
 #include <stdexcept>
 
 DynamicArray::DynamicArray(size_t initialSize) {
-  m_arr = new double[initialSize];
+  m_arr = allocate(initialSize);
 
   // initialize all values with zero
   for (int i = 0; i < initialSize; i++) {
@@ -14,7 +15,7 @@ DynamicArray::DynamicArray(size_t initialSize) {
 }
 
 DynamicArray::DynamicArray(const DynamicArray &other) {
-  m_arr = new double[other.m_currentCapacity];
+  m_arr = allocate(other.m_currentCapacity);
   for (int i = 0; i < other.m_currentSize; i++) {
     m_arr[i] = other.m_arr[i];
   }
@@ -25,12 +26,12 @@ DynamicArray::DynamicArray(const DynamicArray &other) {
 
 DynamicArray &DynamicArray::operator=(const DynamicArray &other) {
   if (this != &other) {
-    double *newArr = new double[other.m_currentCapacity];
+    double *newArr = allocate(other.m_currentCapacity);
     for (int i = 0; i < other.m_currentSize; i++) {
       newArr[i] = other.m_arr[i];
     }
 
-    delete[] m_arr;
+    deallocate(m_arr);
     m_arr = newArr;
     m_currentSize = other.m_currentSize;
     m_currentCapacity = other.m_currentCapacity;
@@ -42,7 +43,7 @@ DynamicArray &DynamicArray::operator=(const DynamicArray &other) {
 void DynamicArray::push_back(double value) {
   // 1st case: Buffer has no capacity yet
   if (m_currentCapacity == 0) {
-    m_arr = new double[1];
+    m_arr = allocate(1);
     m_arr[0] = value;
     m_currentSize = 1;
     m_currentCapacity = 1;
@@ -59,7 +60,7 @@ void DynamicArray::push_back(double value) {
   static const int RESIZE_CONSTANT = 2;
 
   const size_t newCapacity = m_currentCapacity * RESIZE_CONSTANT;
-  double *newArr = new double[newCapacity];
+  double *newArr = allocate(newCapacity);
 
   // copy old values into new buffer
   int i = 0;
@@ -70,7 +71,7 @@ void DynamicArray::push_back(double value) {
   newArr[i] = value;
   ++m_currentSize;
 
-  delete[] m_arr;
+  deallocate(m_arr);
   m_arr = newArr;
   m_currentCapacity = newCapacity;
 }
@@ -93,7 +94,7 @@ void DynamicArray::shrink_to_fit() {
   }
 
   if (m_currentSize == 0 && m_currentCapacity > 0) {
-    delete[] m_arr;
+    deallocate(m_arr);
     m_arr = nullptr;
     m_currentCapacity = 0;
     return;
@@ -101,14 +102,14 @@ void DynamicArray::shrink_to_fit() {
 
   // at this point we know that m_currentSize < m_currentCapacity
 
-  double *newArr = new double[m_currentSize];
+  double *newArr = allocate(m_currentSize);
   m_currentCapacity = m_currentSize;
 
   for (int i = 0; i < m_currentSize; i++) {
     newArr[i] = m_arr[i];
   }
 
-  delete[] m_arr;
+  deallocate(m_arr);
   m_arr = newArr;
 }
 
@@ -132,7 +133,70 @@ const double &DynamicArray::operator[](size_t index) const {
 
 double *DynamicArray::data() noexcept { return m_arr; }
 
-DynamicArray::~DynamicArray() { delete[] m_arr; }
+const double *DynamicArray::data() const noexcept { return m_arr; }
+
+DynamicArray::~DynamicArray() { deallocate(m_arr); }
+
+double DynamicArray::sum(Summation mode) const {
+  return simd::sum(m_arr, m_currentSize, mode);
+}
+
+double DynamicArray::dot(const DynamicArray &other, Summation mode) const {
+  checkSameSize(other);
+  return simd::dot(m_arr, other.m_arr, m_currentSize, mode);
+}
+
+double DynamicArray::min() const { return m_arr[argmin()]; }
+
+double DynamicArray::max() const { return m_arr[argmax()]; }
+
+size_t DynamicArray::argmin() const {
+  if (empty()) {
+    throw std::runtime_error("Calling argmin() on an empty container.");
+  }
+
+  return simd::argmin(m_arr, m_currentSize);
+}
+
+size_t DynamicArray::argmax() const {
+  if (empty()) {
+    throw std::runtime_error("Calling argmax() on an empty container.");
+  }
+
+  return simd::argmax(m_arr, m_currentSize);
+}
+
+void DynamicArray::axpy(double a, const DynamicArray &x) {
+  checkSameSize(x);
+  simd::axpy(a, x.m_arr, m_arr, m_currentSize);
+}
+
+void DynamicArray::scale(double a) { simd::scale(a, m_arr, m_currentSize); }
+
+void DynamicArray::add(const DynamicArray &other) {
+  checkSameSize(other);
+  simd::add(other.m_arr, m_arr, m_currentSize);
+}
+
+void DynamicArray::multiply(const DynamicArray &other) {
+  checkSameSize(other);
+  simd::multiply(other.m_arr, m_arr, m_currentSize);
+}
+
+void DynamicArray::checkSameSize(const DynamicArray &other) const {
+  if (m_currentSize != other.m_currentSize) {
+    throw std::invalid_argument{"Arrays have different sizes."};
+  }
+}
+
+double *DynamicArray::allocate(size_t capacity) {
+  return static_cast<double *>(::operator new[](
+      capacity * sizeof(double), std::align_val_t{BUFFER_ALIGNMENT}));
+}
+
+void DynamicArray::deallocate(double *buffer) {
+  ::operator delete[](buffer, std::align_val_t{BUFFER_ALIGNMENT});
+}
 
 bool operator==(const DynamicArray &lhs, const DynamicArray &rhs) {
   if (lhs.size() != rhs.size()) {
@@ -3,6 +3,14 @@
 
 #include <cstddef>
 
+#include "simd_kernels.h"
+
+/**
+ * Dynamic array of doubles. The buffer is aligned to 64 bytes (a cache line),
+ * which lets the numeric operations below run vectorized kernels with aligned
+ * loads. The kernels are picked at runtime for the best instruction set the
+ * CPU supports (see simd_kernels.h).
+ */
 class DynamicArray {
  public:
   DynamicArray() = default;
@@ -69,8 +77,66 @@ class DynamicArray {
    * array to store its owned elements.
    */
   double *data() noexcept;
+  const double *data() const noexcept;
+
+  /**
+   * Returns the sum of the elements. The default mode is the fastest one;
+   * Summation::Pairwise and Summation::Kahan trade speed for accuracy.
+   */
+  double sum(Summation mode = Summation::Fast) const;
+
+  /**
+   * Returns the dot product of the array and other.
+   * Throws exception if the arrays have different sizes.
+   * @throw std::invalid_argument
+   */
+  double dot(const DynamicArray &other,
+             Summation mode = Summation::Fast) const;
+
+  /**
+   * Return the smallest/largest element. NaN elements are skipped, unless all
+   * elements are NaN. Calling them on an empty container throws exception.
+   * @throw std::runtime_error
+   */
+  double min() const;
+  double max() const;
+
+  /**
+   * Return the index of the first smallest/largest element, with the same
+   * rules as min() and max()
+   * @throw std::runtime_error
+   */
+  size_t argmin() const;
+  size_t argmax() const;
+
+  /**
+   * Adds a * x[i] to every element i of the array.
+   * Throws exception if the arrays have different sizes.
+   * @throw std::invalid_argument
+   */
+  void axpy(double a, const DynamicArray &x);
+
+  /**
+   * Multiplies every element by a
+   */
+  void scale(double a);
+
+  /**
+   * Add/multiply every element by the element of other with the same index.
+   * Throw exception if the arrays have different sizes.
+   * @throw std::invalid_argument
+   */
+  void add(const DynamicArray &other);
+  void multiply(const DynamicArray &other);
 
  private:
+  static const size_t BUFFER_ALIGNMENT = 64;
+
+  static double *allocate(size_t capacity);
+  static void deallocate(double *buffer);
+
+  void checkSameSize(const DynamicArray &other) const;
+
   double *m_arr = nullptr;
   size_t m_currentSize = 0;
   size_t m_currentCapacity = 0;
@@ -0,0 +1,33 @@
+#ifndef SIMD_KERNEL_TABLE_H
+#define SIMD_KERNEL_TABLE_H
+
+#include <cstddef>
+
+namespace simd {
+
+/**
+ * The kernels compiled for one instruction set. simd_kernels.cpp picks one
+ * table at runtime and forwards every call through it.
+ */
+struct KernelTable {
+  double (*sum)(const double *x, size_t n);
+  double (*sumKahan)(const double *x, size_t n);
+  double (*dot)(const double *x, const double *y, size_t n);
+  double (*dotKahan)(const double *x, const double *y, size_t n);
+  double (*minValue)(const double *x, size_t n);
+  double (*maxValue)(const double *x, size_t n);
+  void (*axpy)(double a, const double *x, double *y, size_t n);
+  void (*scale)(double a, double *x, size_t n);
+  void (*add)(const double *x, double *y, size_t n);
+  void (*multiply)(const double *x, double *y, size_t n);
+};
+
+// Defined in simd_kernels_<isa>.cpp, which are compiled with the matching
+// instruction set enabled (x86 only)
+extern const KernelTable SSE2_KERNELS;
+extern const KernelTable AVX2_KERNELS;
+extern const KernelTable AVX512_KERNELS;
+
+}  // namespace simd
+
+#endif
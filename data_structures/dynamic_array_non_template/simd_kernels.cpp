@@ -0,0 +1,182 @@
+#include "simd_kernels.h"
+
+#include <atomic>
+
+#include "simd_kernels_impl.h"
+
+namespace simd {
+namespace {
+
+/**
+ * One double per register - the fallback for CPUs (or compilers) without any
+ * of the supported instruction sets
+ */
+struct Scalar {
+  using Reg = double;
+  static constexpr size_t WIDTH = 1;
+
+  static Reg load(const double *p) { return *p; }
+  static void store(double *p, Reg r) { *p = r; }
+  static Reg broadcast(double value) { return value; }
+  static Reg add(Reg a, Reg b) { return a + b; }
+  static Reg sub(Reg a, Reg b) { return a - b; }
+  static Reg mul(Reg a, Reg b) { return a * b; }
+  static Reg fmadd(Reg a, Reg b, Reg c) { return a * b + c; }
+  static Reg min(Reg a, Reg b) { return a < b ? a : b; }
+  static Reg max(Reg a, Reg b) { return a > b ? a : b; }
+};
+
+const KernelTable SCALAR_KERNELS = makeKernelTable<Scalar>();
+
+// Pairwise summation adds blocks of this many elements with the fast kernel
+const size_t PAIRWISE_BLOCK = 256;
+
+// Blocks are split on multiples of 64 bytes to keep the loads aligned
+const size_t ALIGNMENT_IN_ELEMENTS = 64 / sizeof(double);
+
+Level detectLevel() {
+#ifdef SIMD_KERNELS_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    return Level::AVX512;
+  }
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+    return Level::AVX2;
+  }
+  if (__builtin_cpu_supports("sse2")) {
+    return Level::SSE2;
+  }
+#endif
+  return Level::Scalar;
+}
+
+const KernelTable &tableFor(Level level) {
+  switch (level) {
+#ifdef SIMD_KERNELS_X86
+    case Level::AVX512:
+      return AVX512_KERNELS;
+    case Level::AVX2:
+      return AVX2_KERNELS;
+    case Level::SSE2:
+      return SSE2_KERNELS;
+#endif
+    default:
+      return SCALAR_KERNELS;
+  }
+}
+
+std::atomic<Level> &activeLevelStorage() {
+  static std::atomic<Level> level{detectedLevel()};
+  return level;
+}
+
+const KernelTable &active() {
+  return tableFor(activeLevelStorage().load(std::memory_order_relaxed));
+}
+
+/**
+ * Sums x (or x * y if y is not null) by splitting it in halves until the
+ * halves are short enough for the fast kernel
+ */
+double pairwise(const KernelTable &kernels, const double *x, const double *y,
+                size_t n) {
+  if (n <= PAIRWISE_BLOCK) {
+    return y ? kernels.dot(x, y, n) : kernels.sum(x, n);
+  }
+
+  const size_t half = n / 2 / ALIGNMENT_IN_ELEMENTS * ALIGNMENT_IN_ELEMENTS;
+  return pairwise(kernels, x, y, half) +
+         pairwise(kernels, x + half, y ? y + half : nullptr, n - half);
+}
+
+/**
+ * Returns the index of the first element equal to value, or 0 if there is no
+ * such element (all elements are NaN)
+ */
+size_t find(const double *x, size_t n, double value) {
+  for (size_t i = 0; i < n; i++) {
+    if (x[i] == value) {
+      return i;
+    }
+  }
+
+  return 0;
+}
+
+}  // namespace
+
+Level detectedLevel() {
+  static const Level level = detectLevel();
+  return level;
+}
+
+Level activeLevel() {
+  return activeLevelStorage().load(std::memory_order_relaxed);
+}
+
+void setLevel(Level level) {
+  if (level > detectedLevel()) {
+    level = detectedLevel();
+  }
+
+  activeLevelStorage().store(level, std::memory_order_relaxed);
+}
+
+const char *levelName(Level level) {
+  switch (level) {
+    case Level::SSE2:
+      return "SSE2";
+    case Level::AVX2:
+      return "AVX2";
+    case Level::AVX512:
+      return "AVX-512";
+    default:
+      return "scalar";
+  }
+}
+
+double sum(const double *x, size_t n, Summation mode) {
+  const KernelTable &kernels = active();
+  switch (mode) {
+    case Summation::Pairwise:
+      return pairwise(kernels, x, nullptr, n);
+    case Summation::Kahan:
+      return kernels.sumKahan(x, n);
+    default:
+      return kernels.sum(x, n);
+  }
+}
+
+double dot(const double *x, const double *y, size_t n, Summation mode) {
+  const KernelTable &kernels = active();
+  switch (mode) {
+    case Summation::Pairwise:
+      return pairwise(kernels, x, y, n);
+    case Summation::Kahan:
+      return kernels.dotKahan(x, y, n);
+    default:
+      return kernels.dot(x, y, n);
+  }
+}
+
+size_t argmin(const double *x, size_t n) {
+  return find(x, n, active().minValue(x, n));
+}
+
+size_t argmax(const double *x, size_t n) {
+  return find(x, n, active().maxValue(x, n));
+}
+
+void axpy(double a, const double *x, double *y, size_t n) {
+  active().axpy(a, x, y, n);
+}
+
+void scale(double a, double *x, size_t n) { active().scale(a, x, n); }
+
+void add(const double *x, double *y, size_t n) { active().add(x, y, n); }
+
+void multiply(const double *x, double *y, size_t n) {
+  active().multiply(x, y, n);
+}
+
+}  // namespace simd
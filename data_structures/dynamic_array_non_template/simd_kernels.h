@@ -0,0 +1,83 @@
+#ifndef SIMD_KERNELS_H
+#define SIMD_KERNELS_H
+
+#include <cstddef>
+
+/**
+ * How the elements of a sum (or dot product) are accumulated.
+ *
+ * Fast uses several independent accumulators per vector lane - it is the
+ * fastest and already more accurate than a plain loop, but its result depends
+ * on the instruction set in use.
+ * Pairwise sums blocks of the array and adds the block sums as a balanced
+ * tree, so the rounding error grows with log(n) instead of n.
+ * Kahan carries a compensation term for every lane, which makes the error
+ * practically independent of n, at about half the speed of Fast.
+ */
+enum class Summation { Fast, Pairwise, Kahan };
+
+namespace simd {
+
+/**
+ * The instruction sets the kernels are compiled for, from slowest to fastest
+ */
+enum class Level { Scalar, SSE2, AVX2, AVX512 };
+
+/**
+ * Returns the fastest level supported by the CPU and the compiler
+ */
+Level detectedLevel();
+
+/**
+ * Returns the level the kernels currently dispatch to. It is the detected
+ * level unless it was lowered with setLevel().
+ */
+Level activeLevel();
+
+/**
+ * Makes the kernels dispatch to the given level, or to the detected one if
+ * the CPU does not support the given level. Meant for tests and benchmarks.
+ */
+void setLevel(Level level);
+
+const char *levelName(Level level);
+
+/*
+The kernels below work on arrays of n doubles. The arrays must start on a 64
+byte boundary (as the buffer of DynamicArray does), so every instruction set
+can use aligned loads. Empty arrays may be null.
+*/
+
+double sum(const double *x, size_t n, Summation mode);
+double dot(const double *x, const double *y, size_t n, Summation mode);
+
+/**
+ * Return the index of the first smallest/largest element; n must be above 0.
+ * NaN elements are ignored unless all elements are NaN.
+ */
+size_t argmin(const double *x, size_t n);
+size_t argmax(const double *x, size_t n);
+
+/**
+ * y[i] += a * x[i]
+ */
+void axpy(double a, const double *x, double *y, size_t n);
+
+/**
+ * x[i] *= a
+ */
+void scale(double a, double *x, size_t n);
+
+/**
+ * y[i] += x[i]
+ */
+void add(const double *x, double *y, size_t n);
+
+/**
+ * y[i] *= x[i]
+ */
+void multiply(const double *x, double *y, size_t n);
+
+}  // namespace simd
+
+#endif
@@ -0,0 +1,29 @@
+#include <immintrin.h>
+
+#include "simd_kernels_impl.h"
+
+// Compiled with -mavx2 -mfma
+
+namespace simd {
+namespace {
+
+struct Avx2 {
+  using Reg = __m256d;
+  static constexpr size_t WIDTH = 4;
+
+  static Reg load(const double *p) { return _mm256_load_pd(p); }
+  static void store(double *p, Reg r) { _mm256_store_pd(p, r); }
+  static Reg broadcast(double value) { return _mm256_set1_pd(value); }
+  static Reg add(Reg a, Reg b) { return _mm256_add_pd(a, b); }
+  static Reg sub(Reg a, Reg b) { return _mm256_sub_pd(a, b); }
+  static Reg mul(Reg a, Reg b) { return _mm256_mul_pd(a, b); }
+  static Reg fmadd(Reg a, Reg b, Reg c) { return _mm256_fmadd_pd(a, b, c); }
+  static Reg min(Reg a, Reg b) { return _mm256_min_pd(a, b); }
+  static Reg max(Reg a, Reg b) { return _mm256_max_pd(a, b); }
+};
+
+}  // namespace
+
+const KernelTable AVX2_KERNELS = makeKernelTable<Avx2>();
+
+}  // namespace simd
@@ -0,0 +1,29 @@
+#include <immintrin.h>
+
+#include "simd_kernels_impl.h"
+
+// Compiled with -mavx512f
+
+namespace simd {
+namespace {
+
+struct Avx512 {
+  using Reg = __m512d;
+  static constexpr size_t WIDTH = 8;
+
+  static Reg load(const double *p) { return _mm512_load_pd(p); }
+  static void store(double *p, Reg r) { _mm512_store_pd(p, r); }
+  static Reg broadcast(double value) { return _mm512_set1_pd(value); }
+  static Reg add(Reg a, Reg b) { return _mm512_add_pd(a, b); }
+  static Reg sub(Reg a, Reg b) { return _mm512_sub_pd(a, b); }
+  static Reg mul(Reg a, Reg b) { return _mm512_mul_pd(a, b); }
+  static Reg fmadd(Reg a, Reg b, Reg c) { return _mm512_fmadd_pd(a, b, c); }
+  static Reg min(Reg a, Reg b) { return _mm512_min_pd(a, b); }
+  static Reg max(Reg a, Reg b) { return _mm512_max_pd(a, b); }
+};
+
+}  // namespace
+
+const KernelTable AVX512_KERNELS = makeKernelTable<Avx512>();
+
+}  // namespace simd
@@ -0,0 +1,109 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "dynamic_array.h"
+
+/*
+Measures the memory bandwidth reached by the numeric operations of
+DynamicArray with the kernels of every instruction set the CPU supports,
+next to the plain loops they replace.
+
+The default arrays (2 x 16M doubles, 256 MB) do not fit in any cache, so the
+numbers are limited by the memory bandwidth. Pass a smaller number of elements
+(e.g. 4096) to measure the kernels on data in the L1 cache.
+
+Run:
+$> ./simd_kernels_benchmark [number of elements]
+*/
+
+namespace {
+
+template <typename Operation>
+double gigabytesPerSecond(size_t bytes, Operation operation) {
+  const int REPEATS = 10;
+  operation();  // warm up
+
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < REPEATS; i++) {
+    operation();
+  }
+  const auto end = std::chrono::steady_clock::now();
+
+  const double seconds = std::chrono::duration<double>(end - start).count();
+  return bytes * REPEATS / seconds / 1e9;
+}
+
+void report(const std::string &name, double gbs) {
+  std::cout << "  " << name << ": " << gbs << " GB/s\n";
+}
+
+// keeps the compiler from dropping the computations
+volatile double sink;
+
+void measureLoops(const DynamicArray &x, DynamicArray &y) {
+  const size_t n = x.size();
+  const size_t bytes = n * sizeof(double);
+
+  std::cout << "plain loops\n";
+  report("sum", gigabytesPerSecond(bytes, [&] {
+           double sum = 0;
+           for (size_t i = 0; i < n; i++) {
+             sum += x[i];
+           }
+           sink = sum;
+         }));
+  report("dot", gigabytesPerSecond(2 * bytes, [&] {
+           double dot = 0;
+           for (size_t i = 0; i < n; i++) {
+             dot += x[i] * y[i];
+           }
+           sink = dot;
+         }));
+  report("axpy", gigabytesPerSecond(3 * bytes, [&] {
+           for (size_t i = 0; i < n; i++) {
+             y[i] += 1e-9 * x[i];
+           }
+         }));
+}
+
+void measureKernels(const DynamicArray &x, DynamicArray &y) {
+  const size_t bytes = x.size() * sizeof(double);
+
+  std::cout << simd::levelName(simd::activeLevel()) << " kernels\n";
+  report("sum", gigabytesPerSecond(bytes, [&] { sink = x.sum(); }));
+  report("sum (pairwise)", gigabytesPerSecond(bytes, [&] {
+           sink = x.sum(Summation::Pairwise);
+         }));
+  report("sum (Kahan)", gigabytesPerSecond(
+                            bytes, [&] { sink = x.sum(Summation::Kahan); }));
+  report("dot", gigabytesPerSecond(2 * bytes, [&] { sink = x.dot(y); }));
+  report("argmin", gigabytesPerSecond(bytes, [&] { sink = x.argmin(); }));
+  report("axpy", gigabytesPerSecond(3 * bytes, [&] { y.axpy(1e-9, x); }));
+  report("scale", gigabytesPerSecond(2 * bytes, [&] { y.scale(1.0); }));
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  const size_t count =
+      argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 16'000'000;
+
+  DynamicArray x{count};
+  DynamicArray y{count};
+  for (size_t i = 0; i < count; i++) {
+    x[i] = static_cast<double>(i % 1000) / 7;
+    y[i] = static_cast<double>(i % 333) / 3;
+  }
+
+  measureLoops(x, y);
+
+  const int detected = static_cast<int>(simd::detectedLevel());
+  for (int level = 0; level <= detected; level++) {
+    simd::setLevel(static_cast<simd::Level>(level));
+    measureKernels(x, y);
+  }
+
+  return 0;
+}
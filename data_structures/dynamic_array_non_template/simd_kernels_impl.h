@@ -0,0 +1,265 @@
+#ifndef SIMD_KERNELS_IMPL_H
+#define SIMD_KERNELS_IMPL_H
+
+#include <cmath>
+#include <cstddef>
+
+#include "simd_kernel_table.h"
+
+/*
+The kernels written once for any vector type. Every simd_kernels_<isa>.cpp
+defines a struct V describing its registers:
+
+  using Reg = ...;                       // vector of WIDTH doubles
+  static constexpr size_t WIDTH = ...;
+  static Reg load(const double *p);      // p is WIDTH * 8 bytes aligned
+  static void store(double *p, Reg r);   // same
+  static Reg broadcast(double value);
+  static Reg add(Reg a, Reg b);
+  static Reg sub(Reg a, Reg b);
+  static Reg mul(Reg a, Reg b);
+  static Reg fmadd(Reg a, Reg b, Reg c); // a * b + c
+  static Reg min(Reg a, Reg b);          // b if either is NaN
+  static Reg max(Reg a, Reg b);          // b if either is NaN
+
+and includes this header to build its KernelTable with makeKernelTable<V>().
+
+Everything here has internal linkage on purpose: the same templates are
+compiled with different instruction sets in different translation units and
+must not be merged by the linker. For the same reason this header only relies
+on macros from the standard library, never on its inline functions.
+*/
+
+namespace simd {
+namespace {
+
+/**
+ * Compensated (Kahan-Babuska) running sum of scalars
+ */
+struct CompensatedSum {
+  double sum = 0;
+  double compensation = 0;
+
+  void add(double value) {
+    const double total = sum + value;
+    if (magnitude(sum) >= magnitude(value)) {
+      compensation += (sum - total) + value;
+    } else {
+      compensation += (value - total) + sum;
+    }
+    sum = total;
+  }
+
+  double result() const { return sum + compensation; }
+
+  static double magnitude(double value) { return value < 0 ? -value : value; }
+};
+
+template <typename V>
+struct Kernels {
+  using Reg = typename V::Reg;
+  static constexpr size_t W = V::WIDTH;
+
+  static double lanesSum(Reg r) {
+    alignas(64) double lanes[W];
+    V::store(lanes, r);
+    double total = 0;
+    for (size_t i = 0; i < W; i++) {
+      total += lanes[i];
+    }
+
+    return total;
+  }
+
+  static double sum(const double *x, size_t n) {
+    Reg acc0 = V::broadcast(0), acc1 = acc0, acc2 = acc0, acc3 = acc0;
+    size_t i = 0;
+    // four independent chains hide the latency of the additions
+    for (; i + 4 * W <= n; i += 4 * W) {
+      acc0 = V::add(acc0, V::load(x + i));
+      acc1 = V::add(acc1, V::load(x + i + W));
+      acc2 = V::add(acc2, V::load(x + i + 2 * W));
+      acc3 = V::add(acc3, V::load(x + i + 3 * W));
+    }
+    for (; i + W <= n; i += W) {
+      acc0 = V::add(acc0, V::load(x + i));
+    }
+
+    double total = lanesSum(V::add(V::add(acc0, acc1), V::add(acc2, acc3)));
+    for (; i < n; i++) {
+      total += x[i];
+    }
+
+    return total;
+  }
+
+  static double dot(const double *x, const double *y, size_t n) {
+    Reg acc0 = V::broadcast(0), acc1 = acc0, acc2 = acc0, acc3 = acc0;
+    size_t i = 0;
+    for (; i + 4 * W <= n; i += 4 * W) {
+      acc0 = V::fmadd(V::load(x + i), V::load(y + i), acc0);
+      acc1 = V::fmadd(V::load(x + i + W), V::load(y + i + W), acc1);
+      acc2 = V::fmadd(V::load(x + i + 2 * W), V::load(y + i + 2 * W), acc2);
+      acc3 = V::fmadd(V::load(x + i + 3 * W), V::load(y + i + 3 * W), acc3);
+    }
+    for (; i + W <= n; i += W) {
+      acc0 = V::fmadd(V::load(x + i), V::load(y + i), acc0);
+    }
+
+    double total = lanesSum(V::add(V::add(acc0, acc1), V::add(acc2, acc3)));
+    for (; i < n; i++) {
+      total += x[i] * y[i];
+    }
+
+    return total;
+  }
+
+  /**
+   * Kahan summation in every lane, the lanes and the tail are then combined
+   * with a scalar compensated sum
+   */
+  template <typename Term, typename ScalarTerm>
+  static double kahan(size_t n, Term term, ScalarTerm scalarTerm) {
+    Reg sum = V::broadcast(0);
+    Reg compensation = sum;
+    size_t i = 0;
+    for (; i + W <= n; i += W) {
+      const Reg y = V::sub(term(i), compensation);
+      const Reg total = V::add(sum, y);
+      compensation = V::sub(V::sub(total, sum), y);
+      sum = total;
+    }
+
+    alignas(64) double sums[W];
+    alignas(64) double compensations[W];
+    V::store(sums, sum);
+    V::store(compensations, compensation);
+
+    CompensatedSum result;
+    for (size_t lane = 0; lane < W; lane++) {
+      result.add(sums[lane]);
+      result.add(-compensations[lane]);
+    }
+    for (; i < n; i++) {
+      result.add(scalarTerm(i));
+    }
+
+    return result.result();
+  }
+
+  static double sumKahan(const double *x, size_t n) {
+    return kahan(
+        n, [x](size_t i) { return V::load(x + i); },
+        [x](size_t i) { return x[i]; });
+  }
+
+  static double dotKahan(const double *x, const double *y, size_t n) {
+    return kahan(
+        n, [x, y](size_t i) { return V::mul(V::load(x + i), V::load(y + i)); },
+        [x, y](size_t i) { return x[i] * y[i]; });
+  }
+
+  static double minValue(const double *x, size_t n) {
+    // NaN elements are dropped: min() returns its second argument (the
+    // accumulator) when either argument is NaN
+    Reg acc0 = V::broadcast(HUGE_VAL), acc1 = acc0;
+    size_t i = 0;
+    for (; i + 2 * W <= n; i += 2 * W) {
+      acc0 = V::min(V::load(x + i), acc0);
+      acc1 = V::min(V::load(x + i + W), acc1);
+    }
+    for (; i + W <= n; i += W) {
+      acc0 = V::min(V::load(x + i), acc0);
+    }
+
+    alignas(64) double lanes[W];
+    V::store(lanes, V::min(acc0, acc1));
+    double result = HUGE_VAL;
+    for (size_t lane = 0; lane < W; lane++) {
+      result = lanes[lane] < result ? lanes[lane] : result;
+    }
+    for (; i < n; i++) {
+      result = x[i] < result ? x[i] : result;
+    }
+
+    return result;
+  }
+
+  static double maxValue(const double *x, size_t n) {
+    Reg acc0 = V::broadcast(-HUGE_VAL), acc1 = acc0;
+    size_t i = 0;
+    for (; i + 2 * W <= n; i += 2 * W) {
+      acc0 = V::max(V::load(x + i), acc0);
+      acc1 = V::max(V::load(x + i + W), acc1);
+    }
+    for (; i + W <= n; i += W) {
+      acc0 = V::max(V::load(x + i), acc0);
+    }
+
+    alignas(64) double lanes[W];
+    V::store(lanes, V::max(acc0, acc1));
+    double result = -HUGE_VAL;
+    for (size_t lane = 0; lane < W; lane++) {
+      result = lanes[lane] > result ? lanes[lane] : result;
+    }
+    for (; i < n; i++) {
+      result = x[i] > result ? x[i] : result;
+    }
+
+    return result;
+  }
+
+  static void axpy(double a, const double *x, double *y, size_t n) {
+    const Reg factor = V::broadcast(a);
+    size_t i = 0;
+    for (; i + W <= n; i += W) {
+      V::store(y + i, V::fmadd(factor, V::load(x + i), V::load(y + i)));
+    }
+    for (; i < n; i++) {
+      y[i] += a * x[i];
+    }
+  }
+
+  static void scale(double a, double *x, size_t n) {
+    const Reg factor = V::broadcast(a);
+    size_t i = 0;
+    for (; i + W <= n; i += W) {
+      V::store(x + i, V::mul(factor, V::load(x + i)));
+    }
+    for (; i < n; i++) {
+      x[i] *= a;
+    }
+  }
+
+  static void add(const double *x, double *y, size_t n) {
+    size_t i = 0;
+    for (; i + W <= n; i += W) {
+      V::store(y + i, V::add(V::load(y + i), V::load(x + i)));
+    }
+    for (; i < n; i++) {
+      y[i] += x[i];
+    }
+  }
+
+  static void multiply(const double *x, double *y, size_t n) {
+    size_t i = 0;
+    for (; i + W <= n; i += W) {
+      V::store(y + i, V::mul(V::load(y + i), V::load(x + i)));
+    }
+    for (; i < n; i++) {
+      y[i] *= x[i];
+    }
+  }
+};
+
+template <typename V>
+constexpr KernelTable makeKernelTable() {
+  using K = Kernels<V>;
+  return {K::sum,      K::sumKahan, K::dot,   K::dotKahan, K::minValue,
+          K::maxValue, K::axpy,     K::scale, K::add,      K::multiply};
+}
+
+}  // namespace
+}  // namespace simd
+
+#endif
@@ -0,0 +1,29 @@
+#include <immintrin.h>
+
+#include "simd_kernels_impl.h"
+
+// Compiled with -msse2
+
+namespace simd {
+namespace {
+
+struct Sse2 {
+  using Reg = __m128d;
+  static constexpr size_t WIDTH = 2;
+
+  static Reg load(const double *p) { return _mm_load_pd(p); }
+  static void store(double *p, Reg r) { _mm_store_pd(p, r); }
+  static Reg broadcast(double value) { return _mm_set1_pd(value); }
+  static Reg add(Reg a, Reg b) { return _mm_add_pd(a, b); }
+  static Reg sub(Reg a, Reg b) { return _mm_sub_pd(a, b); }
+  static Reg mul(Reg a, Reg b) { return _mm_mul_pd(a, b); }
+  static Reg fmadd(Reg a, Reg b, Reg c) { return add(mul(a, b), c); }
+  static Reg min(Reg a, Reg b) { return _mm_min_pd(a, b); }
+  static Reg max(Reg a, Reg b) { return _mm_max_pd(a, b); }
+};
+
+}  // namespace
+
+const KernelTable SSE2_KERNELS = makeKernelTable<Sse2>();
+
+}  // namespace simd
@@ -1,5 +1,11 @@
 #include "catch.hpp"
 #include "dynamic_array.h"
+#include "../parallel/parallel_algorithms.h"
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <vector>
 
 TEST_CASE("Dynamic array is empty and has no buffer on construction with "
           "default constructor") {
@@ -195,3 +201,184 @@ TEST_CASE("shrink_to_fit works correctly") {
   REQUIRE(arr.size() == 5);
   REQUIRE(arr.data());
 }
+
+namespace {
+
+DynamicArray makeArray(size_t size, double offset) {
+  DynamicArray arr;
+  for (size_t i = 0; i < size; i++) {
+    // mix signs and magnitudes so the order of the operations matters
+    arr.push_back((i % 7 == 0 ? -1.0 : 1.0) * (i % 13 + offset) / 3.0);
+  }
+
+  return arr;
+}
+
+/**
+ * Runs the given checks with the kernels of every instruction set the CPU
+ * supports
+ */
+template <typename Checks>
+void forEveryLevel(Checks checks) {
+  const int detected = static_cast<int>(simd::detectedLevel());
+  for (int level = 0; level <= detected; level++) {
+    simd::setLevel(static_cast<simd::Level>(level));
+    INFO("Kernels: " << simd::levelName(simd::activeLevel()));
+    checks();
+  }
+
+  simd::setLevel(simd::detectedLevel());
+}
+
+// sizes around the vector widths and the unrolled loops, plus a long array
+const std::vector<size_t> SIZES{0, 1, 2, 3, 5, 8, 15, 16, 31, 33, 64, 1001};
+
+}  // namespace
+
+TEST_CASE("Dynamic array keeps its buffer aligned to 64 bytes") {
+  DynamicArray arr{3};
+  REQUIRE(reinterpret_cast<std::uintptr_t>(arr.data()) % 64 == 0);
+
+  for (int i = 0; i < 100; i++) {
+    arr.push_back(i);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(arr.data()) % 64 == 0);
+  }
+
+  arr.shrink_to_fit();
+  REQUIRE(reinterpret_cast<std::uintptr_t>(arr.data()) % 64 == 0);
+}
+
+TEST_CASE("Dynamic array kernels cannot be set above the detected level") {
+  simd::setLevel(simd::Level::AVX512);
+  REQUIRE(simd::activeLevel() == simd::detectedLevel());
+}
+
+TEST_CASE("Dynamic array sums and dot products match a scalar loop") {
+  forEveryLevel([] {
+    for (size_t size : SIZES) {
+      const DynamicArray x = makeArray(size, 1.0);
+      const DynamicArray y = makeArray(size, 2.5);
+
+      double sum = 0;
+      double dot = 0;
+      for (size_t i = 0; i < size; i++) {
+        sum += x[i];
+        dot += x[i] * y[i];
+      }
+
+      for (Summation mode :
+           {Summation::Fast, Summation::Pairwise, Summation::Kahan}) {
+        REQUIRE(x.sum(mode) == Approx(sum).margin(1e-12));
+        REQUIRE(x.dot(y, mode) == Approx(dot).margin(1e-12));
+      }
+    }
+  });
+}
+
+TEST_CASE("Dynamic array compensated sums are accurate") {
+  DynamicArray arr;
+  for (int i = 0; i < 1'000'000; i++) {
+    arr.push_back(0.1);
+  }
+
+  // the exact sum of the stored values is 100000.0000000000055...
+  forEveryLevel([&arr] {
+    REQUIRE(std::abs(arr.sum(Summation::Kahan) - 100'000.0) < 1e-10);
+    REQUIRE(std::abs(arr.sum(Summation::Pairwise) - 100'000.0) < 1e-8);
+    REQUIRE(std::abs(arr.dot(arr, Summation::Kahan) - 10'000.0) < 1e-10);
+  });
+}
+
+TEST_CASE("Dynamic array finds the smallest and the largest element") {
+  forEveryLevel([] {
+    for (size_t size : SIZES) {
+      if (size == 0) {
+        continue;
+      }
+
+      const DynamicArray arr = makeArray(size, 1.0);
+      size_t argmin = 0;
+      size_t argmax = 0;
+      for (size_t i = 1; i < size; i++) {
+        argmin = arr[i] < arr[argmin] ? i : argmin;
+        argmax = arr[i] > arr[argmax] ? i : argmax;
+      }
+
+      REQUIRE(arr.argmin() == argmin);
+      REQUIRE(arr.argmax() == argmax);
+      REQUIRE(arr.min() == arr[argmin]);
+      REQUIRE(arr.max() == arr[argmax]);
+    }
+  });
+}
+
+TEST_CASE("Dynamic array skips NaN when looking for the smallest element") {
+  forEveryLevel([] {
+    DynamicArray arr{40};
+    for (size_t i = 0; i < arr.size(); i++) {
+      arr[i] = NAN;
+    }
+
+    REQUIRE(arr.argmin() == 0);
+    REQUIRE(std::isnan(arr.min()));
+
+    arr[37] = 5;
+    arr[21] = -5;
+    REQUIRE(arr.argmin() == 21);
+    REQUIRE(arr.argmax() == 37);
+  });
+}
+
+TEST_CASE("Dynamic array throws on min() and max() when empty") {
+  DynamicArray arr;
+  REQUIRE_THROWS_AS(arr.min(), std::runtime_error);
+  REQUIRE_THROWS_AS(arr.max(), std::runtime_error);
+  REQUIRE(arr.sum() == 0);
+}
+
+TEST_CASE("Dynamic array elementwise operations match a scalar loop") {
+  forEveryLevel([] {
+    for (size_t size : SIZES) {
+      const DynamicArray x = makeArray(size, 1.0);
+      DynamicArray y = makeArray(size, 2.5);
+
+      DynamicArray expected = y;
+      for (size_t i = 0; i < size; i++) {
+        expected[i] = ((expected[i] + 0.5 * x[i]) * 3.0 + x[i]) * x[i];
+      }
+
+      y.axpy(0.5, x);
+      y.scale(3.0);
+      y.add(x);
+      y.multiply(x);
+
+      for (size_t i = 0; i < size; i++) {
+        REQUIRE(y[i] == Approx(expected[i]).margin(1e-12));
+      }
+    }
+  });
+}
+
+TEST_CASE("Dynamic array operations on two arrays require equal sizes") {
+  DynamicArray x{3};
+  DynamicArray y{4};
+  REQUIRE_THROWS_AS(x.dot(y), std::invalid_argument);
+  REQUIRE_THROWS_AS(x.axpy(1.0, y), std::invalid_argument);
+  REQUIRE_THROWS_AS(x.add(y), std::invalid_argument);
+  REQUIRE_THROWS_AS(x.multiply(y), std::invalid_argument);
+}
+
+TEST_CASE("Dynamic array is reduced in parallel with the SIMD kernels") {
+  ThreadPool pool{4};
+  DynamicArray arr{1'000'000};
+  parallel_fill(arr, 0.5, pool);
+
+  const double sum = parallel_reduce_chunks(
+      arr, 0.0,
+      [](const double *data, size_t count) {
+        return simd::sum(data, count, Summation::Fast);
+      },
+      std::plus<>{}, pool);
+  REQUIRE(sum == 500'000.0);
+  REQUIRE(parallel_reduce(arr, 0.0, std::plus<>{}, pool) == 500'000.0);
+}
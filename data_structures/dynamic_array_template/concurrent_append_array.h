@@ -0,0 +1,297 @@
+#ifndef CONCURRENT_APPEND_ARRAY_H
+#define CONCURRENT_APPEND_ARRAY_H
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+/**
+ * Array which many threads can append to and read from at the same time,
+ * without locks.
+ *
+ * The elements live in buckets that are never moved or freed while the array
+ * exists: bucket b holds FirstBucketSize << b elements, so the bucket and the
+ * offset of an index are found with a couple of bit operations, and the
+ * buckets double in size like the buffer of DynamicArray.
+ *
+ * push_back claims an index with a single fetch_add, constructs the element
+ * in its slot and marks the slot as constructed. A bucket is allocated by the
+ * first thread that needs it; threads racing for the same bucket agree on one
+ * with a compare-exchange.
+ *
+ * Indexes below size() are claimed, but an element may still be under
+ * construction by another thread - readers which do not know that the
+ * element is complete (e.g. because they appended it themselves) check
+ * isConstructed() first.
+ *
+ * clear() and the destructor must not run concurrently with other calls.
+ *
+ * @tparam FirstBucketSize Number of elements in the first bucket, a power of
+ * two
+ */
+template <typename T, size_t FirstBucketSize = 32>
+class ConcurrentAppendArray {
+  static_assert(std::has_single_bit(FirstBucketSize),
+                "The first bucket size must be a power of two.");
+
+ public:
+  ConcurrentAppendArray() = default;
+  ConcurrentAppendArray(const ConcurrentAppendArray &) = delete;
+  ConcurrentAppendArray &operator=(const ConcurrentAppendArray &) = delete;
+  ~ConcurrentAppendArray();
+
+  /**
+   * Appends the given element value to the end of the container.
+   * Thread safe.
+   */
+  void push_back(const T &value);
+  void push_back(T &&value);
+
+  /**
+   * Constructs a new element in place at the end of the container from the
+   * given arguments. Thread safe.
+   * If the constructor throws, the claimed slot stays unconstructed.
+   *
+   * @return Reference to the constructed element, which never moves
+   */
+  template <typename... Args>
+  T &emplace_back(Args &&...args);
+
+  /**
+   * Access element without checking if index is out of bounds or if the
+   * element is constructed
+   */
+  T &operator[](size_t index);
+  const T &operator[](size_t index) const;
+
+  /**
+   * Checks if the element at index exists and is constructed and throws
+   * exception if it is not
+   * @throw std::out_of_range
+   */
+  T &at(size_t index);
+  const T &at(size_t index) const;
+
+  /**
+   * Returns whether the element at index is constructed and visible to the
+   * calling thread
+   */
+  bool isConstructed(size_t index) const;
+
+  /**
+   * Returns the number of appended elements, including the ones which are
+   * still being constructed
+   */
+  size_t size() const;
+
+  /**
+   * Returns whether the array is empty of elements or not
+   */
+  bool empty() const;
+
+  /**
+   * Allocates the buckets for the first newCapacity elements, so appending
+   * them does not allocate. Thread safe.
+   */
+  void reserve(size_t newCapacity);
+
+  /**
+   * Destroys all elements and frees the buckets. Not thread safe.
+   */
+  void clear();
+
+ private:
+  // The bucket of a 64 bit index is at most 64 - log2(FirstBucketSize),
+  // reached by the largest ones, so the buckets are numbered up to that
+  static constexpr size_t BUCKET_COUNT =
+      64 - std::countr_zero(FirstBucketSize) + 1;
+
+  // A bucket holds its elements first, then one "constructed" flag for each
+  static size_t bucketOf(size_t index) {
+    return std::bit_width(index / FirstBucketSize + 1) - 1;
+  }
+
+  static size_t bucketSize(size_t bucket) { return FirstBucketSize << bucket; }
+
+  static size_t bucketStart(size_t bucket) {
+    return FirstBucketSize * ((size_t{1} << bucket) - 1);
+  }
+
+  static constexpr std::align_val_t bucketAlignment() {
+    return std::align_val_t{std::max(alignof(T), size_t{64})};
+  }
+
+  // Returns bucket, allocating it if no thread did so yet
+  unsigned char *bucketMemory(size_t bucket);
+  unsigned char *loadBucket(size_t bucket) const {
+    return m_buckets[bucket].load(std::memory_order_acquire);
+  }
+
+  T *slot(size_t index) const;
+  std::atomic<bool> &flag(size_t index) const;
+
+  std::atomic<size_t> m_size{0};
+  std::atomic<unsigned char *> m_buckets[BUCKET_COUNT]{};
+};
+
+template <typename T, size_t FirstBucketSize>
+ConcurrentAppendArray<T, FirstBucketSize>::~ConcurrentAppendArray() {
+  clear();
+}
+
+template <typename T, size_t FirstBucketSize>
+void ConcurrentAppendArray<T, FirstBucketSize>::push_back(const T &value) {
+  emplace_back(value);
+}
+
+template <typename T, size_t FirstBucketSize>
+void ConcurrentAppendArray<T, FirstBucketSize>::push_back(T &&value) {
+  emplace_back(std::move(value));
+}
+
+template <typename T, size_t FirstBucketSize>
+template <typename... Args>
+T &ConcurrentAppendArray<T, FirstBucketSize>::emplace_back(Args &&...args) {
+  const size_t index = m_size.fetch_add(1, std::memory_order_relaxed);
+  bucketMemory(bucketOf(index));
+
+  T *element = ::new (slot(index)) T(std::forward<Args>(args)...);
+  flag(index).store(true, std::memory_order_release);
+  return *element;
+}
+
+template <typename T, size_t FirstBucketSize>
+T &ConcurrentAppendArray<T, FirstBucketSize>::operator[](size_t index) {
+  return *slot(index);
+}
+
+template <typename T, size_t FirstBucketSize>
+const T &ConcurrentAppendArray<T, FirstBucketSize>::operator[](
+    size_t index) const {
+  return *slot(index);
+}
+
+template <typename T, size_t FirstBucketSize>
+T &ConcurrentAppendArray<T, FirstBucketSize>::at(size_t index) {
+  if (!isConstructed(index)) {
+    throw std::out_of_range{"Index out of range."};
+  }
+
+  return *slot(index);
+}
+
+template <typename T, size_t FirstBucketSize>
+const T &ConcurrentAppendArray<T, FirstBucketSize>::at(size_t index) const {
+  if (!isConstructed(index)) {
+    throw std::out_of_range{"Index out of range."};
+  }
+
+  return *slot(index);
+}
+
+template <typename T, size_t FirstBucketSize>
+bool ConcurrentAppendArray<T, FirstBucketSize>::isConstructed(
+    size_t index) const {
+  return index < size() && loadBucket(bucketOf(index)) &&
+         flag(index).load(std::memory_order_acquire);
+}
+
+template <typename T, size_t FirstBucketSize>
+size_t ConcurrentAppendArray<T, FirstBucketSize>::size() const {
+  return m_size.load(std::memory_order_relaxed);
+}
+
+template <typename T, size_t FirstBucketSize>
+bool ConcurrentAppendArray<T, FirstBucketSize>::empty() const {
+  return size() == 0;
+}
+
+template <typename T, size_t FirstBucketSize>
+void ConcurrentAppendArray<T, FirstBucketSize>::reserve(size_t newCapacity) {
+  if (newCapacity == 0) {
+    return;
+  }
+
+  const size_t lastBucket = bucketOf(newCapacity - 1);
+  for (size_t bucket = 0; bucket <= lastBucket; bucket++) {
+    bucketMemory(bucket);
+  }
+}
+
+template <typename T, size_t FirstBucketSize>
+void ConcurrentAppendArray<T, FirstBucketSize>::clear() {
+  for (size_t bucket = 0; bucket < BUCKET_COUNT; bucket++) {
+    unsigned char *memory = loadBucket(bucket);
+    if (!memory) {
+      continue;
+    }
+
+    const size_t count = bucketSize(bucket);
+    auto *values = reinterpret_cast<T *>(memory);
+    auto *flags = reinterpret_cast<std::atomic<bool> *>(memory + count *
+                                                                    sizeof(T));
+    for (size_t i = 0; i < count; i++) {
+      if (flags[i].load(std::memory_order_relaxed)) {
+        values[i].~T();
+      }
+    }
+
+    std::destroy_n(flags, count);
+    ::operator delete(memory, bucketAlignment());
+    m_buckets[bucket].store(nullptr, std::memory_order_relaxed);
+  }
+
+  m_size.store(0, std::memory_order_relaxed);
+}
+
+template <typename T, size_t FirstBucketSize>
+unsigned char *ConcurrentAppendArray<T, FirstBucketSize>::bucketMemory(
+    size_t bucket) {
+  unsigned char *memory = loadBucket(bucket);
+  if (memory) {
+    return memory;
+  }
+
+  const size_t count = bucketSize(bucket);
+  auto *allocated = static_cast<unsigned char *>(
+      ::operator new(count * (sizeof(T) + sizeof(std::atomic<bool>)),
+                     bucketAlignment()));
+  std::uninitialized_fill_n(
+      reinterpret_cast<std::atomic<bool> *>(allocated + count * sizeof(T)),
+      count, false);
+
+  if (m_buckets[bucket].compare_exchange_strong(memory, allocated,
+                                                std::memory_order_acq_rel)) {
+    return allocated;
+  }
+
+  // another thread installed the bucket first, memory now points to it
+  std::destroy_n(
+      reinterpret_cast<std::atomic<bool> *>(allocated + count * sizeof(T)),
+      count);
+  ::operator delete(allocated, bucketAlignment());
+  return memory;
+}
+
+template <typename T, size_t FirstBucketSize>
+T *ConcurrentAppendArray<T, FirstBucketSize>::slot(size_t index) const {
+  const size_t bucket = bucketOf(index);
+  return reinterpret_cast<T *>(loadBucket(bucket)) +
+         (index - bucketStart(bucket));
+}
+
+template <typename T, size_t FirstBucketSize>
+std::atomic<bool> &ConcurrentAppendArray<T, FirstBucketSize>::flag(
+    size_t index) const {
+  const size_t bucket = bucketOf(index);
+  auto *flags = reinterpret_cast<std::atomic<bool> *>(
+      loadBucket(bucket) + bucketSize(bucket) * sizeof(T));
+  return flags[index - bucketStart(bucket)];
+}
+
+#endif
@@ -0,0 +1,101 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "concurrent_append_array.h"
+#include "dynamic_array.h"
+
+/*
+Contention when many threads append to one array at the same time:
+- DynamicArray with push_back under a std::mutex
+- ConcurrentAppendArray, where push_back is one fetch_add and a construction
+
+The total number of appended elements stays the same, it is split between 1,
+2, 4, ... up to the given number of threads (64 by default). With the mutex
+every append waits for the lock and the reallocations of DynamicArray happen
+while the lock is held; ConcurrentAppendArray only contends on the cache line
+of its size counter and never copies an element.
+
+With fewer hardware threads than benchmark threads the mutex suffers most,
+because a thread can be descheduled while it holds the lock.
+
+Run:
+$> ./concurrent_append_array_benchmark [number of elements] [maximum threads]
+*/
+
+namespace {
+
+struct Event {
+  long long timestamp;
+  int source;
+  int kind;
+};
+
+class LockedDynamicArray {
+ public:
+  void push_back(const Event &event) {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_arr.push_back(event);
+  }
+
+  size_t size() const { return m_arr.size(); }
+
+ private:
+  std::mutex m_mutex;
+  DynamicArray<Event> m_arr;
+};
+
+// Millions of appends per second from threads appending count events in total
+template <typename Array>
+double appendsPerSecond(size_t count, size_t threadCount) {
+  Array arr;
+  std::vector<std::thread> threads;
+
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t t = 0; t < threadCount; t++) {
+    threads.emplace_back([&arr, t, count, threadCount] {
+      const size_t perThread =
+          count / threadCount + (t < count % threadCount ? 1 : 0);
+      for (size_t i = 0; i < perThread; i++) {
+        arr.push_back({static_cast<long long>(i), static_cast<int>(t), 1});
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  const auto end = std::chrono::steady_clock::now();
+
+  if (arr.size() != count) {
+    std::cerr << "lost appends: " << arr.size() << " of " << count << "\n";
+    std::exit(1);
+  }
+
+  const double seconds = std::chrono::duration<double>(end - start).count();
+  return count / seconds / 1e6;
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  const size_t count =
+      argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+  const size_t maxThreads =
+      argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 64;
+
+  for (size_t threads = 1; threads <= maxThreads; threads *= 2) {
+    std::cout << threads << " threads\n"
+              << "  DynamicArray + mutex: "
+              << appendsPerSecond<LockedDynamicArray>(count, threads)
+              << " M appends/s\n"
+              << "  ConcurrentAppendArray: "
+              << appendsPerSecond<ConcurrentAppendArray<Event>>(count,
+                                                                threads)
+              << " M appends/s\n";
+  }
+
+  return 0;
+}
@@ -1,21 +1,69 @@
 #ifndef DYNAMIC_ARRAY_H
 #define DYNAMIC_ARRAY_H
 
+#include <cstddef>
+#include <cstdlib>
+#include <algorithm>
+#include <cstring>
+#include <istream>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <new>
 #include <stdexcept>
-
-template <typename T>
+#include <type_traits>
+#include <utility>
+
+#include "growth_policy.h"
+
+/**
+ * The buffer is taken from the given std::pmr::memory_resource, or from the
+ * global heap if no resource (nullptr) is given. As with the std::pmr
+ * containers, the resource stays with the array for its whole lifetime:
+ * copies use the global heap unless a resource is given to the copy
+ * constructor, and assignment never changes the resource of the target.
+ *
+ * @tparam GrowthPolicy Decides how much the buffer grows when it is full. See
+ * growth_policy.h
+ */
+template <typename T, typename GrowthPolicy = DoublingGrowth>
 class DynamicArray {
  public:
+  // The elements are contiguous, so plain pointers are the iterators
+  using value_type = T;
+  using iterator = T *;
+  using const_iterator = const T *;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
   DynamicArray() = default;
-  DynamicArray(size_t initialSize);
+  explicit DynamicArray(std::pmr::memory_resource *resource);
+  DynamicArray(size_t initialSize,
+               std::pmr::memory_resource *resource = nullptr);
+  template <std::input_iterator InputIt>
+  DynamicArray(InputIt first, InputIt last,
+               std::pmr::memory_resource *resource = nullptr);
   DynamicArray(const DynamicArray &);
+  DynamicArray(const DynamicArray &, std::pmr::memory_resource *resource);
+  DynamicArray(DynamicArray &&) noexcept;
   DynamicArray &operator=(const DynamicArray &);
+  DynamicArray &operator=(DynamicArray &&);
   ~DynamicArray();
 
   /**
    * Appends the given element value to the end of the container.
    */
   void push_back(const T &value);
+  void push_back(T &&value);
+
+  /**
+   * Constructs a new element in place at the end of the container from the
+   * given arguments.
+   *
+   * @return Reference to the constructed element
+   */
+  template <typename... Args>
+  T &emplace_back(Args &&...args);
 
   /**
    * Removes the last element of the container.
@@ -24,6 +72,69 @@ class DynamicArray {
    */
   void pop_back();
 
+  /**
+   * Appends copies of the elements in [first, last) to the end of the
+   * container. For forward iterators the buffer grows at most once.
+   * The range must not refer to elements of the container.
+   */
+  template <std::input_iterator InputIt>
+  void append(InputIt first, InputIt last);
+
+  /**
+   * Inserts value before pos. Elements after pos are shifted with memmove if
+   * they are trivially copyable.
+   *
+   * @return Iterator to the inserted element
+   */
+  iterator insert(const_iterator pos, const T &value);
+  iterator insert(const_iterator pos, T &&value);
+
+  /**
+   * Inserts count copies of value before pos.
+   *
+   * @return Iterator to the first inserted element, or pos if count is 0
+   */
+  iterator insert(const_iterator pos, size_t count, const T &value);
+
+  /**
+   * Inserts copies of the elements in [first, last) before pos.
+   * The range must not refer to elements of the container.
+   *
+   * @return Iterator to the first inserted element, or pos if the range is
+   * empty
+   */
+  template <std::input_iterator InputIt>
+  iterator insert(const_iterator pos, InputIt first, InputIt last);
+
+  /**
+   * Constructs a new element in place before pos from the given arguments.
+   *
+   * @return Iterator to the constructed element
+   */
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args &&...args);
+
+  /**
+   * Removes the element at pos, or the elements in [first, last).
+   *
+   * @return Iterator following the last removed element
+   */
+  iterator erase(const_iterator pos);
+  iterator erase(const_iterator first, const_iterator last);
+
+  /**
+   * Replaces the contents of the array with binary records read from the
+   * stream - count of them, or all of them until the end of the stream. The
+   * bytes are read straight into the buffer.
+   *
+   * @throw std::runtime_error If the stream ends in the middle of a record,
+   * before count records are read, or fails to read
+   */
+  void assign_from_stream(std::istream &in)
+    requires std::is_trivially_copyable_v<T>;
+  void assign_from_stream(std::istream &in, size_t count)
+    requires std::is_trivially_copyable_v<T>;
+
   /**
    * Checks if index is out of bounds and throws exception if it is
    * @throw std::out_of_range
@@ -54,6 +165,19 @@ class DynamicArray {
 
   size_t capacity() const;
 
+  /**
+   * Increases the capacity to at least newCapacity. Does nothing if the
+   * capacity is already large enough.
+   */
+  void reserve(size_t newCapacity);
+
+  /**
+   * Resizes the container to contain count elements. Additional elements are
+   * value-initialized (or copies of value), surplus elements are destroyed.
+   */
+  void resize(size_t count);
+  void resize(size_t count, const T &value);
+
   /**
    * Requests the container to reduce its capacity to fit its size.
    */
@@ -76,148 +200,510 @@ class DynamicArray {
    * array to store its owned elements.
    */
   T *data() noexcept;
+  const T *data() const noexcept;
+
+  /**
+   * @return an iterator to the first element
+   */
+  iterator begin() noexcept;
+  const_iterator begin() const noexcept;
+  const_iterator cbegin() const noexcept;
+
+  /**
+   * @return an iterator past the last element
+   */
+  iterator end() noexcept;
+  const_iterator end() const noexcept;
+  const_iterator cend() const noexcept;
+
+  /**
+   * @return reverse iterators to the last element and before the first one
+   */
+  reverse_iterator rbegin() noexcept;
+  const_reverse_iterator rbegin() const noexcept;
+  reverse_iterator rend() noexcept;
+  const_reverse_iterator rend() const noexcept;
+
+  /**
+   * Exchanges the contents (and memory resources) of the array with those of
+   * other. O(1)
+   */
+  void swap(DynamicArray &other) noexcept;
+
+  /**
+   * Returns the memory resource of the array, nullptr for the global heap
+   */
+  std::pmr::memory_resource *resource() const noexcept;
+
+ private:
+  // Trivially copyable elements are copied and relocated with memcpy. On the
+  // global heap their buffer is managed with malloc/realloc, so growing can
+  // happen in place when the allocator has room after the current block.
+  static constexpr bool IS_TRIVIALLY_COPYABLE =
+      std::is_trivially_copyable_v<T>;
+  static constexpr bool USE_REALLOC =
+      IS_TRIVIALLY_COPYABLE && alignof(T) <= alignof(std::max_align_t);
+
+  // The internal buffer is raw memory - only the first m_currentSize slots
+  // hold constructed elements.
+  T *allocate(size_t capacity) const;
+  void deallocate(T *buffer, size_t capacity) const noexcept;
+
+  // Moves the elements to a buffer with the given capacity. Elements are
+  // copied instead if moving them could throw, so that a failed reallocation
+  // leaves the array untouched.
+  void reallocate(size_t newCapacity);
+
+  // Constructs [src, src + count) into the raw memory at dst. On exception
+  // the already constructed elements are destroyed.
+  static void relocate(T *src, size_t count, T *dst);
+
+  // Capacity to grow to, so that at least requiredCapacity elements fit
+  size_t nextCapacity(size_t requiredCapacity = 0) const;
+
+  // Grows the buffer if requiredCapacity elements do not fit in it
+  void growFor(size_t requiredCapacity);
+
+  // Moves [index, size) count slots to the right with memmove. The gap is
+  // left as raw memory - only for trivially copyable elements.
+  void openGap(size_t index, size_t count);
+  void destroyElements() noexcept;
 
  private:
   T *m_arr = nullptr;
   size_t m_currentSize = 0;
   size_t m_currentCapacity = 0;
+  std::pmr::memory_resource *m_resource = nullptr;
 };
 
-template <typename T>
-DynamicArray<T>::DynamicArray(size_t initialSize) {
-  m_arr = new T[initialSize];
-
-  // initialize all values with zero
-  for (int i = 0; i < initialSize; i++) {
-    m_arr[i] = 0;
+template <typename T, typename GrowthPolicy>
+DynamicArray<T, GrowthPolicy>::DynamicArray(
+    std::pmr::memory_resource *resource)
+    : m_resource{resource} {}
+
+template <typename T, typename GrowthPolicy>
+DynamicArray<T, GrowthPolicy>::DynamicArray(
+    size_t initialSize, std::pmr::memory_resource *resource)
+    : m_resource{resource} {
+  m_arr = allocate(initialSize);
+
+  // value-initialize all elements (zero for arithmetic types)
+  try {
+    std::uninitialized_value_construct_n(m_arr, initialSize);
+  } catch (...) {
+    deallocate(m_arr, initialSize);
+    throw;
   }
 
   m_currentSize = initialSize;
   m_currentCapacity = initialSize;
 }
 
-template <typename T>
-DynamicArray<T>::DynamicArray(const DynamicArray &other) {
-  m_arr = new T[other.m_currentCapacity];
-  for (int i = 0; i < other.m_currentSize; i++) {
-    m_arr[i] = other.m_arr[i];
+template <typename T, typename GrowthPolicy>
+template <std::input_iterator InputIt>
+DynamicArray<T, GrowthPolicy>::DynamicArray(
+    InputIt first, InputIt last, std::pmr::memory_resource *resource)
+    : m_resource{resource} {
+  try {
+    append(first, last);
+  } catch (...) {
+    destroyElements();
+    deallocate(m_arr, m_currentCapacity);
+    throw;
+  }
+}
+
+template <typename T, typename GrowthPolicy>
+DynamicArray<T, GrowthPolicy>::DynamicArray(const DynamicArray &other)
+    : DynamicArray{other, nullptr} {}
+
+template <typename T, typename GrowthPolicy>
+DynamicArray<T, GrowthPolicy>::DynamicArray(
+    const DynamicArray &other, std::pmr::memory_resource *resource)
+    : m_resource{resource} {
+  m_arr = allocate(other.m_currentCapacity);
+
+  if constexpr (IS_TRIVIALLY_COPYABLE) {
+    if (other.m_currentSize > 0) {
+      std::memcpy(m_arr, other.m_arr, other.m_currentSize * sizeof(T));
+    }
+  } else {
+    try {
+      std::uninitialized_copy_n(other.m_arr, other.m_currentSize, m_arr);
+    } catch (...) {
+      deallocate(m_arr, other.m_currentCapacity);
+      throw;
+    }
   }
 
   m_currentSize = other.m_currentSize;
   m_currentCapacity = other.m_currentCapacity;
 }
 
-template <typename T>
-DynamicArray<T> &DynamicArray<T>::operator=(const DynamicArray &other) {
-  if (this != &other) {
-    T *newArr = new T[other.m_currentCapacity];
-    for (int i = 0; i < other.m_currentSize; i++) {
-      newArr[i] = other.m_arr[i];
-    }
+template <typename T, typename GrowthPolicy>
+DynamicArray<T, GrowthPolicy>::DynamicArray(DynamicArray &&other) noexcept
+    : m_arr{other.m_arr},
+      m_currentSize{other.m_currentSize},
+      m_currentCapacity{other.m_currentCapacity},
+      m_resource{other.m_resource} {
+  // 'steal'
+  other.m_arr = nullptr;
+  other.m_currentSize = 0;
+  other.m_currentCapacity = 0;
+}
 
-    delete[] m_arr;
-    m_arr = newArr;
-    m_currentSize = other.m_currentSize;
-    m_currentCapacity = other.m_currentCapacity;
+template <typename T, typename GrowthPolicy>
+DynamicArray<T, GrowthPolicy> &DynamicArray<T, GrowthPolicy>::operator=(
+    const DynamicArray &other) {
+  if (this != &other) {
+    DynamicArray copy{other, m_resource};
+    swap(copy);
   }
 
   return *this;
 }
 
-template <typename T>
-void DynamicArray<T>::push_back(const T &value) {
-  // 1st case: Buffer has no capacity yet
-  if (m_currentCapacity == 0) {
-    m_arr = new T[1];
-    m_arr[0] = value;
-    m_currentSize = 1;
-    m_currentCapacity = 1;
-    return;
+template <typename T, typename GrowthPolicy>
+DynamicArray<T, GrowthPolicy> &DynamicArray<T, GrowthPolicy>::operator=(
+    DynamicArray &&other) {
+  if (this == &other) {
+    return *this;
   }
 
-  // 2nd case: We have space for more elements in the buffer
+  if (m_resource != other.m_resource) {
+    // The buffer of other cannot be taken - it belongs to another resource
+    DynamicArray moved{m_resource};
+    moved.m_arr = moved.allocate(other.m_currentSize);
+    moved.m_currentCapacity = other.m_currentSize;
+    relocate(other.m_arr, other.m_currentSize, moved.m_arr);
+    moved.m_currentSize = other.m_currentSize;
+    swap(moved);
+    other.clear();
+    return *this;
+  }
+
+  destroyElements();
+  deallocate(m_arr, m_currentCapacity);
+
+  m_arr = other.m_arr;
+  m_currentSize = other.m_currentSize;
+  m_currentCapacity = other.m_currentCapacity;
+
+  other.m_arr = nullptr;
+  other.m_currentSize = 0;
+  other.m_currentCapacity = 0;
+
+  return *this;
+}
+
+template <typename T, typename GrowthPolicy>
+void DynamicArray<T, GrowthPolicy>::push_back(const T &value) {
+  emplace_back(value);
+}
+
+template <typename T, typename GrowthPolicy>
+void DynamicArray<T, GrowthPolicy>::push_back(T &&value) {
+  emplace_back(std::move(value));
+}
+
+template <typename T, typename GrowthPolicy>
+template <typename... Args>
+T &DynamicArray<T, GrowthPolicy>::emplace_back(Args &&...args) {
+  // 1st case: We have space for more elements in the buffer
   if (m_currentSize < m_currentCapacity) {
-    m_arr[m_currentSize++] = value;
-    return;
+    T *elem = ::new (static_cast<void *>(m_arr + m_currentSize))
+        T(std::forward<Args>(args)...);
+    ++m_currentSize;
+    return *elem;
   }
 
-  // 3rd case: We have reached full buffer capacity, time to resize
-  static const int RESIZE_CONSTANT = 2;
+  // 2nd case: Buffer is full (or has no capacity yet), time to resize.
+  // The new element is constructed first, because args may refer to an
+  // element of the old buffer.
+  if constexpr (USE_REALLOC) {
+    const T value(std::forward<Args>(args)...);
+    reallocate(nextCapacity());
+    ::new (static_cast<void *>(m_arr + m_currentSize)) T(value);
+    return m_arr[m_currentSize++];
+  }
 
-  const size_t newCapacity = m_currentCapacity * RESIZE_CONSTANT;
-  T *newArr = new T[newCapacity];
+  const size_t newCapacity = nextCapacity();
+  T *newArr = allocate(newCapacity);
 
-  // copy old values into new buffer
-  int i = 0;
-  for (; i < m_currentSize; i++) {
-    newArr[i] = m_arr[i];
+  try {
+    ::new (static_cast<void *>(newArr + m_currentSize))
+        T(std::forward<Args>(args)...);
+  } catch (...) {
+    deallocate(newArr, newCapacity);
+    throw;
   }
 
-  newArr[i] = value;
-  ++m_currentSize;
+  try {
+    relocate(m_arr, m_currentSize, newArr);
+  } catch (...) {
+    newArr[m_currentSize].~T();
+    deallocate(newArr, newCapacity);
+    throw;
+  }
 
-  delete[] m_arr;
+  destroyElements();
+  deallocate(m_arr, m_currentCapacity);
   m_arr = newArr;
   m_currentCapacity = newCapacity;
+  return m_arr[m_currentSize++];
 }
 
-template <typename T>
-void DynamicArray<T>::pop_back() {
+template <typename T, typename GrowthPolicy>
+void DynamicArray<T, GrowthPolicy>::pop_back() {
   if (empty()) {
     throw std::runtime_error("Calling pop_back() on an empty container.");
   }
 
   --m_currentSize;
+  m_arr[m_currentSize].~T();
+}
+
+template <typename T, typename GrowthPolicy>
+template <std::input_iterator InputIt>
+void DynamicArray<T, GrowthPolicy>::append(InputIt first, InputIt last) {
+  if constexpr (std::forward_iterator<InputIt>) {
+    const size_t count = std::distance(first, last);
+    growFor(m_currentSize + count);
+    std::uninitialized_copy(first, last, m_arr + m_currentSize);
+    m_currentSize += count;
+  } else {
+    for (; first != last; ++first) {
+      emplace_back(*first);
+    }
+  }
+}
+
+template <typename T, typename GrowthPolicy>
+auto DynamicArray<T, GrowthPolicy>::insert(const_iterator pos,
+                                           const T &value) -> iterator {
+  return emplace(pos, value);
+}
+
+template <typename T, typename GrowthPolicy>
+auto DynamicArray<T, GrowthPolicy>::insert(const_iterator pos, T &&value)
+    -> iterator {
+  return emplace(pos, std::move(value));
+}
+
+template <typename T, typename GrowthPolicy>
+auto DynamicArray<T, GrowthPolicy>::insert(const_iterator pos, size_t count,
+                                           const T &value) -> iterator {
+  const size_t index = pos - cbegin();
+  if constexpr (IS_TRIVIALLY_COPYABLE) {
+    // value may refer to an element that is about to be shifted
+    const T copy{value};
+    openGap(index, count);
+    std::uninitialized_fill_n(m_arr + index, count, copy);
+  } else {
+    // Elements which are not trivially copyable are appended and rotated
+    // into place, so that an exception leaves every slot constructed
+    const size_t oldSize = m_currentSize;
+    resize(oldSize + count, value);
+    std::rotate(m_arr + index, m_arr + oldSize, m_arr + m_currentSize);
+  }
+
+  return m_arr + index;
 }
 
-template <typename T>
-size_t DynamicArray<T>::size() const {
+template <typename T, typename GrowthPolicy>
+template <std::input_iterator InputIt>
+auto DynamicArray<T, GrowthPolicy>::insert(const_iterator pos, InputIt first,
+                                           InputIt last) -> iterator {
+  const size_t index = pos - cbegin();
+  if constexpr (IS_TRIVIALLY_COPYABLE && std::forward_iterator<InputIt>) {
+    openGap(index, std::distance(first, last));
+    std::uninitialized_copy(first, last, m_arr + index);
+  } else {
+    const size_t oldSize = m_currentSize;
+    append(first, last);
+    std::rotate(m_arr + index, m_arr + oldSize, m_arr + m_currentSize);
+  }
+
+  return m_arr + index;
+}
+
+template <typename T, typename GrowthPolicy>
+template <typename... Args>
+auto DynamicArray<T, GrowthPolicy>::emplace(const_iterator pos,
+                                            Args &&...args) -> iterator {
+  const size_t index = pos - cbegin();
+  if constexpr (IS_TRIVIALLY_COPYABLE) {
+    // args may refer to an element that is about to be shifted
+    const T value(std::forward<Args>(args)...);
+    openGap(index, 1);
+    ::new (static_cast<void *>(m_arr + index)) T(value);
+  } else {
+    emplace_back(std::forward<Args>(args)...);
+    std::rotate(m_arr + index, m_arr + m_currentSize - 1,
+                m_arr + m_currentSize);
+  }
+
+  return m_arr + index;
+}
+
+template <typename T, typename GrowthPolicy>
+auto DynamicArray<T, GrowthPolicy>::erase(const_iterator pos) -> iterator {
+  return erase(pos, pos + 1);
+}
+
+template <typename T, typename GrowthPolicy>
+auto DynamicArray<T, GrowthPolicy>::erase(const_iterator first,
+                                          const_iterator last) -> iterator {
+  const size_t index = first - cbegin();
+  const size_t count = last - first;
+  if (count == 0) {
+    return m_arr + index;
+  }
+
+  if constexpr (IS_TRIVIALLY_COPYABLE) {
+    std::memmove(m_arr + index, m_arr + index + count,
+                 (m_currentSize - index - count) * sizeof(T));
+  } else {
+    std::move(m_arr + index + count, m_arr + m_currentSize, m_arr + index);
+    std::destroy(m_arr + m_currentSize - count, m_arr + m_currentSize);
+  }
+
+  m_currentSize -= count;
+  return m_arr + index;
+}
+
+template <typename T, typename GrowthPolicy>
+void DynamicArray<T, GrowthPolicy>::assign_from_stream(std::istream &in)
+  requires std::is_trivially_copyable_v<T>
+{
+  clear();
+
+  // Read into the free capacity until the stream ends, growing the buffer
+  // like push_back would
+  while (in) {
+    if (m_currentSize == m_currentCapacity) {
+      if (in.peek() == std::istream::traits_type::eof()) {
+        break;
+      }
+
+      reallocate(nextCapacity());
+    }
+
+    const size_t freeBytes = (m_currentCapacity - m_currentSize) * sizeof(T);
+    in.read(reinterpret_cast<char *>(m_arr + m_currentSize), freeBytes);
+    const size_t bytesRead = in.gcount();
+    m_currentSize += bytesRead / sizeof(T);
+
+    if (bytesRead % sizeof(T) != 0) {
+      throw std::runtime_error{"Stream ended in the middle of a record."};
+    }
+  }
+
+  if (in.bad()) {
+    throw std::runtime_error{"Reading the records from the stream failed."};
+  }
+}
+
+template <typename T, typename GrowthPolicy>
+void DynamicArray<T, GrowthPolicy>::assign_from_stream(std::istream &in,
+                                                       size_t count)
+  requires std::is_trivially_copyable_v<T>
+{
+  clear();
+  reserve(count);
+
+  in.read(reinterpret_cast<char *>(m_arr), count * sizeof(T));
+  const size_t bytesRead = in.gcount();
+  m_currentSize = bytesRead / sizeof(T);
+
+  if (bytesRead != count * sizeof(T)) {
+    throw std::runtime_error{"Stream ended before all records were read."};
+  }
+}
+
+template <typename T, typename GrowthPolicy>
+size_t DynamicArray<T, GrowthPolicy>::size() const {
   return m_currentSize;
 }
 
-template <typename T>
-size_t DynamicArray<T>::capacity() const {
+template <typename T, typename GrowthPolicy>
+size_t DynamicArray<T, GrowthPolicy>::capacity() const {
   return m_currentCapacity;
 }
 
-template <typename T>
-void DynamicArray<T>::shrink_to_fit() {
+template <typename T, typename GrowthPolicy>
+void DynamicArray<T, GrowthPolicy>::reserve(size_t newCapacity) {
+  if (newCapacity > m_currentCapacity) {
+    reallocate(newCapacity);
+  }
+}
+
+template <typename T, typename GrowthPolicy>
+void DynamicArray<T, GrowthPolicy>::resize(size_t count) {
+  if (count <= m_currentSize) {
+    std::destroy(m_arr + count, m_arr + m_currentSize);
+    m_currentSize = count;
+    return;
+  }
+
+  if (count > m_currentCapacity) {
+    reallocate(nextCapacity(count));
+  }
+
+  std::uninitialized_value_construct(m_arr + m_currentSize, m_arr + count);
+  m_currentSize = count;
+}
+
+template <typename T, typename GrowthPolicy>
+void DynamicArray<T, GrowthPolicy>::resize(size_t count, const T &value) {
+  if (count <= m_currentSize) {
+    std::destroy(m_arr + count, m_arr + m_currentSize);
+    m_currentSize = count;
+    return;
+  }
+
+  if (count > m_currentCapacity) {
+    // value may refer to an element that is about to be relocated
+    const T copy{value};
+    reallocate(nextCapacity(count));
+    std::uninitialized_fill(m_arr + m_currentSize, m_arr + count, copy);
+  } else {
+    std::uninitialized_fill(m_arr + m_currentSize, m_arr + count, value);
+  }
+
+  m_currentSize = count;
+}
+
+template <typename T, typename GrowthPolicy>
+void DynamicArray<T, GrowthPolicy>::shrink_to_fit() {
   if (m_currentSize == m_currentCapacity) {
     return;
   }
 
   if (m_currentSize == 0 && m_currentCapacity > 0) {
-    delete[] m_arr;
+    deallocate(m_arr, m_currentCapacity);
     m_arr = nullptr;
     m_currentCapacity = 0;
     return;
   }
 
   // at this point we know that m_currentSize < m_currentCapacity
-
-  T *newArr = new T[m_currentSize];
-  m_currentCapacity = m_currentSize;
-
-  for (int i = 0; i < m_currentSize; i++) {
-    newArr[i] = m_arr[i];
-  }
-
-  delete[] m_arr;
-  m_arr = newArr;
+  reallocate(m_currentSize);
 }
 
-template <typename T>
-bool DynamicArray<T>::empty() const {
+template <typename T, typename GrowthPolicy>
+bool DynamicArray<T, GrowthPolicy>::empty() const {
   return m_currentSize == 0;
 }
 
-template <typename T>
-void DynamicArray<T>::clear() {
+template <typename T, typename GrowthPolicy>
+void DynamicArray<T, GrowthPolicy>::clear() {
+  destroyElements();
   m_currentSize = 0;
 }
 
-template <typename T>
-T &DynamicArray<T>::at(size_t index) {
+template <typename T, typename GrowthPolicy>
+T &DynamicArray<T, GrowthPolicy>::at(size_t index) {
   if (index < 0 || index >= m_currentSize) {
     throw std::out_of_range{"Index out of range."};
   }
@@ -225,38 +711,231 @@ T &DynamicArray<T>::at(size_t index) {
   return m_arr[index];
 }
 
-template <typename T>
-T &DynamicArray<T>::operator[](size_t index) {
+template <typename T, typename GrowthPolicy>
+T &DynamicArray<T, GrowthPolicy>::operator[](size_t index) {
   return m_arr[index];
 }
 
-template <typename T>
-const T &DynamicArray<T>::operator[](size_t index) const {
+template <typename T, typename GrowthPolicy>
+const T &DynamicArray<T, GrowthPolicy>::operator[](size_t index) const {
   return m_arr[index];
 }
 
-template <typename T>
-T &DynamicArray<T>::back() {
+template <typename T, typename GrowthPolicy>
+T &DynamicArray<T, GrowthPolicy>::back() {
   return m_arr[size() - 1];
 }
 
-template <typename T>
-const T &DynamicArray<T>::back() const {
+template <typename T, typename GrowthPolicy>
+const T &DynamicArray<T, GrowthPolicy>::back() const {
   return m_arr[size() - 1];
 }
 
-template <typename T>
-T *DynamicArray<T>::data() noexcept {
+template <typename T, typename GrowthPolicy>
+T *DynamicArray<T, GrowthPolicy>::data() noexcept {
   return m_arr;
 }
 
-template <typename T>
-DynamicArray<T>::~DynamicArray() {
-  delete[] m_arr;
+template <typename T, typename GrowthPolicy>
+const T *DynamicArray<T, GrowthPolicy>::data() const noexcept {
+  return m_arr;
+}
+
+template <typename T, typename GrowthPolicy>
+auto DynamicArray<T, GrowthPolicy>::begin() noexcept -> iterator {
+  return m_arr;
+}
+
+template <typename T, typename GrowthPolicy>
+auto DynamicArray<T, GrowthPolicy>::begin() const noexcept -> const_iterator {
+  return m_arr;
+}
+
+template <typename T, typename GrowthPolicy>
+auto DynamicArray<T, GrowthPolicy>::cbegin() const noexcept
+    -> const_iterator {
+  return m_arr;
+}
+
+template <typename T, typename GrowthPolicy>
+auto DynamicArray<T, GrowthPolicy>::end() noexcept -> iterator {
+  return m_arr + m_currentSize;
+}
+
+template <typename T, typename GrowthPolicy>
+auto DynamicArray<T, GrowthPolicy>::end() const noexcept -> const_iterator {
+  return m_arr + m_currentSize;
+}
+
+template <typename T, typename GrowthPolicy>
+auto DynamicArray<T, GrowthPolicy>::cend() const noexcept -> const_iterator {
+  return m_arr + m_currentSize;
+}
+
+template <typename T, typename GrowthPolicy>
+auto DynamicArray<T, GrowthPolicy>::rbegin() noexcept -> reverse_iterator {
+  return reverse_iterator{end()};
+}
+
+template <typename T, typename GrowthPolicy>
+auto DynamicArray<T, GrowthPolicy>::rbegin() const noexcept
+    -> const_reverse_iterator {
+  return const_reverse_iterator{end()};
+}
+
+template <typename T, typename GrowthPolicy>
+auto DynamicArray<T, GrowthPolicy>::rend() noexcept -> reverse_iterator {
+  return reverse_iterator{begin()};
+}
+
+template <typename T, typename GrowthPolicy>
+auto DynamicArray<T, GrowthPolicy>::rend() const noexcept
+    -> const_reverse_iterator {
+  return const_reverse_iterator{begin()};
+}
+
+template <typename T, typename GrowthPolicy>
+void DynamicArray<T, GrowthPolicy>::swap(DynamicArray &other) noexcept {
+  std::swap(m_arr, other.m_arr);
+  std::swap(m_currentSize, other.m_currentSize);
+  std::swap(m_currentCapacity, other.m_currentCapacity);
+  std::swap(m_resource, other.m_resource);
+}
+
+template <typename T, typename GrowthPolicy>
+std::pmr::memory_resource *DynamicArray<T, GrowthPolicy>::resource()
+    const noexcept {
+  return m_resource;
+}
+
+template <typename T, typename GrowthPolicy>
+T *DynamicArray<T, GrowthPolicy>::allocate(size_t capacity) const {
+  if (capacity == 0) {
+    return nullptr;
+  }
+
+  if (m_resource) {
+    return static_cast<T *>(
+        m_resource->allocate(capacity * sizeof(T), alignof(T)));
+  }
+
+  if constexpr (USE_REALLOC) {
+    void *buffer = std::malloc(capacity * sizeof(T));
+    if (!buffer) {
+      throw std::bad_alloc{};
+    }
+
+    return static_cast<T *>(buffer);
+  } else {
+    return static_cast<T *>(::operator new(capacity * sizeof(T),
+                                           std::align_val_t{alignof(T)}));
+  }
+}
+
+template <typename T, typename GrowthPolicy>
+void DynamicArray<T, GrowthPolicy>::deallocate(
+    T *buffer, size_t capacity) const noexcept {
+  if (!buffer) {
+    return;
+  }
+
+  if (m_resource) {
+    m_resource->deallocate(buffer, capacity * sizeof(T), alignof(T));
+    return;
+  }
+
+  if constexpr (USE_REALLOC) {
+    std::free(buffer);
+  } else {
+    ::operator delete(buffer, std::align_val_t{alignof(T)});
+  }
+}
+
+template <typename T, typename GrowthPolicy>
+void DynamicArray<T, GrowthPolicy>::reallocate(size_t newCapacity) {
+  if constexpr (USE_REALLOC) {
+    if (!m_resource && m_arr && newCapacity > 0) {
+      void *newArr = std::realloc(m_arr, newCapacity * sizeof(T));
+      if (!newArr) {
+        throw std::bad_alloc{};
+      }
+
+      m_arr = static_cast<T *>(newArr);
+      m_currentCapacity = newCapacity;
+      return;
+    }
+  }
+
+  T *newArr = allocate(newCapacity);
+
+  try {
+    relocate(m_arr, m_currentSize, newArr);
+  } catch (...) {
+    deallocate(newArr, newCapacity);
+    throw;
+  }
+
+  destroyElements();
+  deallocate(m_arr, m_currentCapacity);
+  m_arr = newArr;
+  m_currentCapacity = newCapacity;
+}
+
+template <typename T, typename GrowthPolicy>
+void DynamicArray<T, GrowthPolicy>::relocate(T *src, size_t count, T *dst) {
+  if constexpr (IS_TRIVIALLY_COPYABLE) {
+    if (count > 0) {
+      std::memcpy(dst, src, count * sizeof(T));
+    }
+  } else if constexpr (std::is_nothrow_move_constructible_v<T> ||
+                       !std::is_copy_constructible_v<T>) {
+    std::uninitialized_move_n(src, count, dst);
+  } else {
+    std::uninitialized_copy_n(src, count, dst);
+  }
+}
+
+template <typename T, typename GrowthPolicy>
+size_t DynamicArray<T, GrowthPolicy>::nextCapacity(
+    size_t requiredCapacity) const {
+  const size_t grown =
+      GrowthPolicy::nextCapacity(m_currentCapacity, sizeof(T));
+  return grown < requiredCapacity ? requiredCapacity : grown;
+}
+
+template <typename T, typename GrowthPolicy>
+void DynamicArray<T, GrowthPolicy>::growFor(size_t requiredCapacity) {
+  if (requiredCapacity > m_currentCapacity) {
+    reallocate(nextCapacity(requiredCapacity));
+  }
+}
+
+template <typename T, typename GrowthPolicy>
+void DynamicArray<T, GrowthPolicy>::openGap(size_t index, size_t count) {
+  if (count == 0) {
+    return;
+  }
+
+  growFor(m_currentSize + count);
+  std::memmove(m_arr + index + count, m_arr + index,
+               (m_currentSize - index) * sizeof(T));
+  m_currentSize += count;
+}
+
+template <typename T, typename GrowthPolicy>
+void DynamicArray<T, GrowthPolicy>::destroyElements() noexcept {
+  std::destroy_n(m_arr, m_currentSize);
+}
+
+template <typename T, typename GrowthPolicy>
+DynamicArray<T, GrowthPolicy>::~DynamicArray() {
+  destroyElements();
+  deallocate(m_arr, m_currentCapacity);
 }
 
-template <typename T>
-bool operator==(const DynamicArray<T> &lhs, const DynamicArray<T> &rhs) {
+template <typename T, typename GrowthPolicy>
+bool operator==(const DynamicArray<T, GrowthPolicy> &lhs,
+                const DynamicArray<T, GrowthPolicy> &rhs) {
   if (lhs.size() != rhs.size()) {
     return false;
   }
@@ -270,8 +949,9 @@ bool operator==(const DynamicArray<T> &lhs, const DynamicArray<T> &rhs) {
   return true;
 }
 
-template <typename T>
-bool operator!=(const DynamicArray<T> &lhs, const DynamicArray<T> &rhs) {
+template <typename T, typename GrowthPolicy>
+bool operator!=(const DynamicArray<T, GrowthPolicy> &lhs,
+                const DynamicArray<T, GrowthPolicy> &rhs) {
   return !(lhs == rhs);
 }
 
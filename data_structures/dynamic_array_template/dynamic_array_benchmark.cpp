@@ -0,0 +1,175 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "dynamic_array.h"
+
+/*
+Benchmark of DynamicArray's push_back for heavy value types.
+
+DynamicArray keeps its buffer as raw memory and moves the elements when it has
+to grow (trivially copyable elements are relocated with memcpy/realloc).
+CopyGrowthArray below is the previous implementation: the buffer is
+allocated with 'new T[n]', so every slot of capacity is default constructed,
+and growing copy-assigns every element into the new buffer.
+
+It then compares ways of loading rows of records into a DynamicArray:
+- push_back of every row, which checks the capacity and regrows on the way
+- the range constructor, which sizes the buffer once
+- assign_from_stream, which reads the binary rows straight into the buffer,
+  against push_back of every row read from the same stream
+
+Run:
+$> ./dynamic_array_benchmark [number of elements]
+*/
+
+namespace {
+
+template <typename T>
+class CopyGrowthArray {
+ public:
+  CopyGrowthArray() = default;
+  CopyGrowthArray(const CopyGrowthArray &) = delete;
+  CopyGrowthArray &operator=(const CopyGrowthArray &) = delete;
+  ~CopyGrowthArray() { delete[] m_arr; }
+
+  void push_back(const T &value) {
+    if (m_currentSize == m_currentCapacity) {
+      const size_t newCapacity =
+          m_currentCapacity == 0 ? 1 : m_currentCapacity * 2;
+      T *newArr = new T[newCapacity];
+      for (size_t i = 0; i < m_currentSize; i++) {
+        newArr[i] = m_arr[i];
+      }
+
+      delete[] m_arr;
+      m_arr = newArr;
+      m_currentCapacity = newCapacity;
+    }
+
+    m_arr[m_currentSize++] = value;
+  }
+
+  size_t size() const { return m_currentSize; }
+
+ private:
+  T *m_arr = nullptr;
+  size_t m_currentSize = 0;
+  size_t m_currentCapacity = 0;
+};
+
+// Long enough to not fit in the small string buffer
+const std::string STRING_VALUE(64, 'x');
+
+std::string makeString() { return STRING_VALUE; }
+
+DynamicArray<int> makeNestedArray() {
+  DynamicArray<int> arr;
+  for (int i = 0; i < 16; i++) {
+    arr.push_back(i);
+  }
+
+  return arr;
+}
+
+template <typename Array, typename MakeValue>
+double measure(size_t count, MakeValue makeValue) {
+  const auto value = makeValue();
+  const auto start = std::chrono::steady_clock::now();
+
+  Array arr;
+  for (size_t i = 0; i < count; i++) {
+    arr.push_back(value);
+  }
+
+  const auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+template <typename T, typename MakeValue>
+void compare(const std::string &name, size_t count, MakeValue makeValue) {
+  const double copyGrowth = measure<CopyGrowthArray<T>>(count, makeValue);
+  const double moveGrowth = measure<DynamicArray<T>>(count, makeValue);
+
+  std::cout << name << " x " << count << '\n'
+            << "  copy growth (new T[]): " << copyGrowth << " ms\n"
+            << "  move growth (DynamicArray): " << moveGrowth << " ms\n"
+            << "  speedup: " << copyGrowth / moveGrowth << "x\n";
+}
+
+struct Row {
+  long long id;
+  double price;
+  int quantity;
+};
+
+double millisecondsSince(std::chrono::steady_clock::time_point start) {
+  const auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+void compareBulkLoad(size_t count) {
+  std::vector<Row> rows(count);
+  for (size_t i = 0; i < count; i++) {
+    rows[i] = {static_cast<long long>(i), i * 0.25, static_cast<int>(i % 7)};
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  DynamicArray<Row> pushed;
+  for (const Row &row : rows) {
+    pushed.push_back(row);
+  }
+  const double pushBack = millisecondsSince(start);
+
+  start = std::chrono::steady_clock::now();
+  DynamicArray<Row> ranged{rows.begin(), rows.end()};
+  const double range = millisecondsSince(start);
+
+  const std::string bytes(reinterpret_cast<const char *>(rows.data()),
+                          count * sizeof(Row));
+
+  std::istringstream pushStream{bytes};
+  start = std::chrono::steady_clock::now();
+  DynamicArray<Row> streamPushed;
+  Row row;
+  while (pushStream.read(reinterpret_cast<char *>(&row), sizeof(row))) {
+    streamPushed.push_back(row);
+  }
+  const double streamPushBack = millisecondsSince(start);
+
+  std::istringstream assignStream{bytes};
+  start = std::chrono::steady_clock::now();
+  DynamicArray<Row> streamAssigned;
+  streamAssigned.assign_from_stream(assignStream);
+  const double streamAssign = millisecondsSince(start);
+
+  if (pushed.size() != count || ranged.size() != count ||
+      streamPushed.size() != count || streamAssigned.size() != count) {
+    std::cerr << "wrong number of loaded rows\n";
+    std::exit(1);
+  }
+
+  std::cout << "loading " << count << " rows\n"
+            << "  push_back: " << pushBack << " ms\n"
+            << "  range constructor: " << range << " ms\n"
+            << "  push_back from stream: " << streamPushBack << " ms\n"
+            << "  assign_from_stream: " << streamAssign << " ms\n";
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  const size_t count =
+      argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+
+  compare<long long>("long long", count, [] { return 42LL; });
+  compare<double>("double", count, [] { return 4.2; });
+  compare<std::string>("std::string", count, makeString);
+  compare<DynamicArray<int>>("DynamicArray<int>", count, makeNestedArray);
+  compareBulkLoad(count);
+
+  return 0;
+}
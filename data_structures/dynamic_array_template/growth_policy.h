@@ -0,0 +1,61 @@
+#ifndef GROWTH_POLICY_H
+#define GROWTH_POLICY_H
+
+#include <cstddef>
+
+/*
+Growth policies decide the capacity of the new buffer when a DynamicArray runs
+out of space. A policy is a type with the static member function
+
+  static size_t nextCapacity(size_t currentCapacity, size_t elementSize);
+
+which returns a capacity strictly larger than currentCapacity.
+*/
+
+/**
+ * Multiplies the capacity by Numerator / Denominator. Starts from capacity 1.
+ */
+template <size_t Numerator, size_t Denominator = 1>
+struct GeometricGrowth {
+  static_assert(Numerator > Denominator, "Growth factor must be above 1.");
+
+  static size_t nextCapacity(size_t currentCapacity, size_t /*elementSize*/) {
+    // split the multiplication so large capacities do not overflow
+    const size_t grown =
+        currentCapacity / Denominator * Numerator +
+        currentCapacity % Denominator * Numerator / Denominator;
+    return grown > currentCapacity ? grown : currentCapacity + 1;
+  }
+};
+
+using DoublingGrowth = GeometricGrowth<2>;
+using OneAndHalfGrowth = GeometricGrowth<3, 2>;
+using GoldenRatioGrowth = GeometricGrowth<1618, 1000>;
+
+/**
+ * Grows with SmallGrowth while the buffer is below PageSize bytes. Past that
+ * the buffer grows by a factor of 1.5 rounded up to a whole number of pages,
+ * so very large arrays are always a multiple of the (huge) page size and
+ * waste less memory at their peak than with doubling.
+ */
+template <size_t PageSize = 2 * 1024 * 1024,
+          typename SmallGrowth = DoublingGrowth>
+struct PageChunkedGrowth {
+  static size_t nextCapacity(size_t currentCapacity, size_t elementSize) {
+    const size_t currentBytes = currentCapacity * elementSize;
+    if (currentBytes < PageSize) {
+      const size_t grown =
+          SmallGrowth::nextCapacity(currentCapacity, elementSize);
+      if (grown * elementSize <= PageSize) {
+        return grown;
+      }
+    }
+
+    const size_t wantedBytes = currentBytes + currentBytes / 2;
+    const size_t pages = (wantedBytes + PageSize - 1) / PageSize;
+    const size_t grown = pages * PageSize / elementSize;
+    return grown > currentCapacity ? grown : currentCapacity + 1;
+  }
+};
+
+#endif
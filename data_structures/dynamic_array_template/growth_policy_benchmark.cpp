@@ -0,0 +1,112 @@
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "dynamic_array.h"
+
+/*
+Compares the growth policies of DynamicArray by pushing back the given number
+of elements one by one.
+
+For every policy it reports:
+- the number of reallocations of the internal buffer
+- the wasted capacity at the end
+- the peak resident set size of the process
+- the push_back throughput
+
+Every policy runs in its own child process, so that the peak RSS of one run
+does not hide the peak RSS of the next.
+
+The policies are run for a trivially copyable element, whose buffer grows with
+realloc (large blocks are moved with mremap and the untouched capacity never
+becomes resident), and for an element with a user-provided copy constructor,
+for which the old and the new buffer are both resident while growing.
+
+Run:
+$> ./growth_policy_benchmark [number of elements]
+*/
+
+namespace {
+
+struct Record {
+  long long value;
+
+  Record(long long v) : value{v} {}
+  Record(const Record &other) noexcept : value{other.value} {}
+};
+
+template <typename Element, typename GrowthPolicy>
+void run(const std::string &name, size_t count) {
+  DynamicArray<Element, GrowthPolicy> arr;
+  size_t reallocations = 0;
+
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < count; i++) {
+    const size_t capacity = arr.capacity();
+    arr.push_back(static_cast<Element>(i));
+    if (arr.capacity() != capacity) {
+      ++reallocations;
+    }
+  }
+  const auto end = std::chrono::steady_clock::now();
+
+  const double seconds = std::chrono::duration<double>(end - start).count();
+
+  rusage usage{};
+  getrusage(RUSAGE_SELF, &usage);
+
+  std::cout << name << '\n'
+            << "  reallocations: " << reallocations << '\n'
+            << "  unused capacity: "
+            << 100.0 * (arr.capacity() - arr.size()) / arr.capacity()
+            << " %\n"
+            << "  peak RSS: " << usage.ru_maxrss / 1024 << " MB\n"
+            << "  throughput: " << count / seconds / 1e6 << " M push/s\n";
+}
+
+template <typename Element, typename GrowthPolicy>
+void runInChild(const std::string &name, size_t count) {
+  std::cout.flush();
+  const pid_t pid = fork();
+  if (pid == 0) {
+    run<Element, GrowthPolicy>(name, count);
+    std::cout.flush();
+    std::_Exit(0);
+  }
+
+  if (pid < 0) {
+    std::cerr << "fork() failed, running " << name << " in place.\n";
+    run<Element, GrowthPolicy>(name, count);
+    return;
+  }
+
+  waitpid(pid, nullptr, 0);
+}
+
+template <typename Element>
+void runPolicies(const std::string &elementName, size_t count) {
+  std::cout << "Pushing " << count << " elements of type " << elementName
+            << '\n';
+
+  runInChild<Element, DoublingGrowth>("2x", count);
+  runInChild<Element, GoldenRatioGrowth>("golden ratio", count);
+  runInChild<Element, OneAndHalfGrowth>("1.5x", count);
+  runInChild<Element, PageChunkedGrowth<>>("2 MB page chunked", count);
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  const size_t count =
+      argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100'000'000;
+
+  runPolicies<long long>("long long", count);
+  runPolicies<Record>("Record (not trivially copyable)", count);
+
+  return 0;
+}
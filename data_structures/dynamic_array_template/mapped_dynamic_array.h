@@ -0,0 +1,564 @@
+#ifndef MAPPED_DYNAMIC_ARRAY_H
+#define MAPPED_DYNAMIC_ARRAY_H
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include "growth_policy.h"
+
+/**
+ * Dynamic array of trivially copyable elements stored in a memory mapped
+ * file. Supports the element access, back insertion and removal, and
+ * capacity functions of DynamicArray, but has no iterators, insert or erase.
+ * The elements are saved in the file as they are written: reopening the file
+ * maps it back in O(1), without reading or parsing it.
+ *
+ * The file starts with a 64 byte header (magic, format version, element size
+ * and number of elements) followed by the elements. The capacity is whatever
+ * fits in the rest of the file, which always has a whole number of pages.
+ * Growing extends the file with ftruncate and the mapping with mremap, which
+ * moves no data.
+ *
+ * Elements are written through the page cache; sync() flushes them to the
+ * disk. The array is Linux specific (mremap).
+ *
+ * @tparam GrowthPolicy Decides how much the file grows when it is full. See
+ * growth_policy.h
+ */
+template <typename T, typename GrowthPolicy = DoublingGrowth>
+class MappedDynamicArray {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "Only trivially copyable elements can be stored in a file.");
+  static_assert(alignof(T) <= 64, "Elements are aligned to 64 bytes at most.");
+
+ public:
+  /**
+   * The expected access pattern, passed to madvise
+   */
+  enum class Access { Normal, Sequential, Random, WillNeed };
+
+  /**
+   * Opens the array stored in the file at path, or creates an empty array
+   * there if the file does not exist or is empty.
+   * Throws exception if the file holds something else, or an array of
+   * elements of a different size.
+   * @throw std::runtime_error
+   * @throw std::system_error if a system call fails
+   */
+  explicit MappedDynamicArray(const std::string &path);
+
+  MappedDynamicArray(const MappedDynamicArray &) = delete;
+  MappedDynamicArray &operator=(const MappedDynamicArray &) = delete;
+
+  /**
+   * The moved from array is closed and may only be destroyed or assigned to
+   */
+  MappedDynamicArray(MappedDynamicArray &&other) noexcept;
+  MappedDynamicArray &operator=(MappedDynamicArray &&other) noexcept;
+
+  /**
+   * Unmaps and closes the file. The elements stay in the file.
+   */
+  ~MappedDynamicArray();
+
+  /**
+   * Appends the given element value to the end of the container.
+   */
+  void push_back(const T &value);
+
+  /**
+   * Constructs a new element in place at the end of the container from the
+   * given arguments.
+   *
+   * @return Reference to the constructed element
+   */
+  template <typename... Args>
+  T &emplace_back(Args &&...args);
+
+  /**
+   * Removes the last element of the container.
+   * Calling pop_back on an empty container throws exception.
+   * @throw std::runtime_error
+   */
+  void pop_back();
+
+  /**
+   * Checks if index is out of bounds and throws exception if it is
+   * @throw std::out_of_range
+   */
+  T &at(size_t index);
+
+  /**
+   * Access element without checking if index is out of bounds
+   */
+  T &operator[](size_t index);
+  const T &operator[](size_t index) const;
+
+  /**
+   * Returns a reference to the last element in the array.
+   */
+  T &back();
+  const T &back() const;
+
+  /**
+   * Returns number of elements in the array
+   */
+  size_t size() const;
+
+  /**
+   * Returns the number of elements that fit in the file without growing it
+   */
+  size_t capacity() const;
+
+  /**
+   * Grows the file so that at least newCapacity elements fit. Does nothing if
+   * the capacity is already large enough.
+   */
+  void reserve(size_t newCapacity);
+
+  /**
+   * Resizes the container to contain count elements. Additional elements are
+   * value-initialized (or copies of value).
+   */
+  void resize(size_t count);
+  void resize(size_t count, const T &value);
+
+  /**
+   * Shrinks the file to the smallest number of pages holding the elements.
+   */
+  void shrink_to_fit();
+
+  /**
+   * Returns whether the array is empty of elements or not
+   */
+  bool empty() const;
+
+  /**
+   * Removes all elements without shrinking the file
+   */
+  void clear();
+
+  /**
+   * Returns a direct pointer to the mapped elements
+   */
+  T *data() noexcept;
+  const T *data() const noexcept;
+
+  /**
+   * Exchanges the files of the two arrays. O(1)
+   */
+  void swap(MappedDynamicArray &other) noexcept;
+
+  /**
+   * Writes the modified pages of the file to the disk and waits for it.
+   * @throw std::system_error
+   */
+  void sync();
+
+  /**
+   * Tells the kernel how the elements are going to be accessed: Sequential
+   * makes it read ahead aggressively, Random turns read ahead off and
+   * WillNeed starts reading the whole file in the background.
+   * @throw std::system_error
+   */
+  void advise(Access access);
+
+ private:
+  struct Header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t elementSize;
+    std::uint64_t size;
+    unsigned char reserved[40];
+  };
+  static_assert(sizeof(Header) == 64);
+
+  static constexpr char MAGIC[8] = {'D', 'Y', 'N', 'A', 'R', 'R', 'A', 'Y'};
+  static constexpr std::uint32_t VERSION = 1;
+
+  [[noreturn]] static void throwSystemError(const char *what);
+  static size_t pageSize();
+
+  void open(const std::string &path);
+  void close() noexcept;
+
+  // Maps the first bytes of the file, which must already have that size
+  void map(size_t bytes);
+
+  // Resizes the file and its mapping to hold at least elementCapacity
+  // elements, rounded up to whole pages
+  void remap(size_t elementCapacity);
+
+  size_t nextCapacity(size_t requiredCapacity = 0) const;
+  T *elements() const noexcept;
+
+  int m_fd = -1;
+  void *m_mapping = nullptr;
+  size_t m_mappedBytes = 0;
+  Header *m_header = nullptr;
+  size_t m_currentCapacity = 0;
+  Access m_access = Access::Normal;
+};
+
+template <typename T, typename GrowthPolicy>
+MappedDynamicArray<T, GrowthPolicy>::MappedDynamicArray(
+    const std::string &path) {
+  try {
+    open(path);
+  } catch (...) {
+    close();
+    throw;
+  }
+}
+
+template <typename T, typename GrowthPolicy>
+MappedDynamicArray<T, GrowthPolicy>::MappedDynamicArray(
+    MappedDynamicArray &&other) noexcept
+    : m_fd{std::exchange(other.m_fd, -1)},
+      m_mapping{std::exchange(other.m_mapping, nullptr)},
+      m_mappedBytes{std::exchange(other.m_mappedBytes, 0)},
+      m_header{std::exchange(other.m_header, nullptr)},
+      m_currentCapacity{std::exchange(other.m_currentCapacity, 0)},
+      m_access{other.m_access} {}
+
+template <typename T, typename GrowthPolicy>
+MappedDynamicArray<T, GrowthPolicy> &
+MappedDynamicArray<T, GrowthPolicy>::operator=(
+    MappedDynamicArray &&other) noexcept {
+  if (this != &other) {
+    close();
+    swap(other);
+  }
+
+  return *this;
+}
+
+template <typename T, typename GrowthPolicy>
+MappedDynamicArray<T, GrowthPolicy>::~MappedDynamicArray() {
+  close();
+}
+
+template <typename T, typename GrowthPolicy>
+void MappedDynamicArray<T, GrowthPolicy>::push_back(const T &value) {
+  emplace_back(value);
+}
+
+template <typename T, typename GrowthPolicy>
+template <typename... Args>
+T &MappedDynamicArray<T, GrowthPolicy>::emplace_back(Args &&...args) {
+  // args may refer to an element, which moves if the mapping moves
+  const T value(std::forward<Args>(args)...);
+  if (size() == m_currentCapacity) {
+    remap(nextCapacity());
+  }
+
+  T *slot = elements() + m_header->size;
+  std::memcpy(static_cast<void *>(slot), &value, sizeof(T));
+  ++m_header->size;
+  return *slot;
+}
+
+template <typename T, typename GrowthPolicy>
+void MappedDynamicArray<T, GrowthPolicy>::pop_back() {
+  if (empty()) {
+    throw std::runtime_error("Calling pop_back() on an empty container.");
+  }
+
+  --m_header->size;
+}
+
+template <typename T, typename GrowthPolicy>
+T &MappedDynamicArray<T, GrowthPolicy>::at(size_t index) {
+  if (index >= size()) {
+    throw std::out_of_range{"Index out of range."};
+  }
+
+  return elements()[index];
+}
+
+template <typename T, typename GrowthPolicy>
+T &MappedDynamicArray<T, GrowthPolicy>::operator[](size_t index) {
+  return elements()[index];
+}
+
+template <typename T, typename GrowthPolicy>
+const T &MappedDynamicArray<T, GrowthPolicy>::operator[](size_t index) const {
+  return elements()[index];
+}
+
+template <typename T, typename GrowthPolicy>
+T &MappedDynamicArray<T, GrowthPolicy>::back() {
+  return elements()[size() - 1];
+}
+
+template <typename T, typename GrowthPolicy>
+const T &MappedDynamicArray<T, GrowthPolicy>::back() const {
+  return elements()[size() - 1];
+}
+
+template <typename T, typename GrowthPolicy>
+size_t MappedDynamicArray<T, GrowthPolicy>::size() const {
+  return m_header ? m_header->size : 0;
+}
+
+template <typename T, typename GrowthPolicy>
+size_t MappedDynamicArray<T, GrowthPolicy>::capacity() const {
+  return m_currentCapacity;
+}
+
+template <typename T, typename GrowthPolicy>
+void MappedDynamicArray<T, GrowthPolicy>::reserve(size_t newCapacity) {
+  if (newCapacity > m_currentCapacity) {
+    remap(newCapacity);
+  }
+}
+
+template <typename T, typename GrowthPolicy>
+void MappedDynamicArray<T, GrowthPolicy>::resize(size_t count) {
+  resize(count, T{});
+}
+
+template <typename T, typename GrowthPolicy>
+void MappedDynamicArray<T, GrowthPolicy>::resize(size_t count,
+                                                 const T &value) {
+  if (count <= size()) {
+    m_header->size = count;
+    return;
+  }
+
+  // value may refer to an element, which moves if the mapping moves
+  const T copy{value};
+  if (count > m_currentCapacity) {
+    remap(nextCapacity(count));
+  }
+
+  std::uninitialized_fill(elements() + size(), elements() + count, copy);
+  m_header->size = count;
+}
+
+template <typename T, typename GrowthPolicy>
+void MappedDynamicArray<T, GrowthPolicy>::shrink_to_fit() {
+  remap(size());
+}
+
+template <typename T, typename GrowthPolicy>
+bool MappedDynamicArray<T, GrowthPolicy>::empty() const {
+  return size() == 0;
+}
+
+template <typename T, typename GrowthPolicy>
+void MappedDynamicArray<T, GrowthPolicy>::clear() {
+  m_header->size = 0;
+}
+
+template <typename T, typename GrowthPolicy>
+T *MappedDynamicArray<T, GrowthPolicy>::data() noexcept {
+  return elements();
+}
+
+template <typename T, typename GrowthPolicy>
+const T *MappedDynamicArray<T, GrowthPolicy>::data() const noexcept {
+  return elements();
+}
+
+template <typename T, typename GrowthPolicy>
+void MappedDynamicArray<T, GrowthPolicy>::swap(
+    MappedDynamicArray &other) noexcept {
+  std::swap(m_fd, other.m_fd);
+  std::swap(m_mapping, other.m_mapping);
+  std::swap(m_mappedBytes, other.m_mappedBytes);
+  std::swap(m_header, other.m_header);
+  std::swap(m_currentCapacity, other.m_currentCapacity);
+  std::swap(m_access, other.m_access);
+}
+
+template <typename T, typename GrowthPolicy>
+void MappedDynamicArray<T, GrowthPolicy>::sync() {
+  if (::msync(m_mapping, m_mappedBytes, MS_SYNC) != 0) {
+    throwSystemError("msync");
+  }
+}
+
+template <typename T, typename GrowthPolicy>
+void MappedDynamicArray<T, GrowthPolicy>::advise(Access access) {
+  int advice = MADV_NORMAL;
+  switch (access) {
+    case Access::Sequential:
+      advice = MADV_SEQUENTIAL;
+      break;
+    case Access::Random:
+      advice = MADV_RANDOM;
+      break;
+    case Access::WillNeed:
+      advice = MADV_WILLNEED;
+      break;
+    default:
+      break;
+  }
+
+  if (::madvise(m_mapping, m_mappedBytes, advice) != 0) {
+    throwSystemError("madvise");
+  }
+
+  // WillNeed is a one time request, the others describe the mapping and are
+  // applied again when it grows
+  if (access != Access::WillNeed) {
+    m_access = access;
+  }
+}
+
+template <typename T, typename GrowthPolicy>
+void MappedDynamicArray<T, GrowthPolicy>::throwSystemError(const char *what) {
+  throw std::system_error{errno, std::generic_category(), what};
+}
+
+template <typename T, typename GrowthPolicy>
+size_t MappedDynamicArray<T, GrowthPolicy>::pageSize() {
+  static const size_t size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+  return size;
+}
+
+template <typename T, typename GrowthPolicy>
+void MappedDynamicArray<T, GrowthPolicy>::open(const std::string &path) {
+  m_fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+  if (m_fd < 0) {
+    throwSystemError("open");
+  }
+
+  struct stat status {};
+  if (::fstat(m_fd, &status) != 0) {
+    throwSystemError("fstat");
+  }
+
+  const auto fileBytes = static_cast<size_t>(status.st_size);
+  if (fileBytes == 0) {
+    // new array: one page with the header and the first elements
+    if (::ftruncate(m_fd, static_cast<off_t>(pageSize())) != 0) {
+      throwSystemError("ftruncate");
+    }
+
+    map(pageSize());
+    std::memcpy(m_header->magic, MAGIC, sizeof(MAGIC));
+    m_header->version = VERSION;
+    m_header->elementSize = sizeof(T);
+    m_header->size = 0;
+    return;
+  }
+
+  if (fileBytes < sizeof(Header)) {
+    throw std::runtime_error{path + " does not hold a mapped array."};
+  }
+
+  map(fileBytes);
+  if (std::memcmp(m_header->magic, MAGIC, sizeof(MAGIC)) != 0) {
+    throw std::runtime_error{path + " does not hold a mapped array."};
+  }
+  if (m_header->version != VERSION) {
+    throw std::runtime_error{path + " has an unsupported format version."};
+  }
+  if (m_header->elementSize != sizeof(T)) {
+    throw std::runtime_error{path + " holds elements of a different size."};
+  }
+  if (m_header->size > m_currentCapacity) {
+    throw std::runtime_error{path + " is truncated."};
+  }
+}
+
+template <typename T, typename GrowthPolicy>
+void MappedDynamicArray<T, GrowthPolicy>::close() noexcept {
+  if (m_mapping) {
+    ::munmap(m_mapping, m_mappedBytes);
+  }
+  if (m_fd >= 0) {
+    ::close(m_fd);
+  }
+
+  m_fd = -1;
+  m_mapping = nullptr;
+  m_mappedBytes = 0;
+  m_header = nullptr;
+  m_currentCapacity = 0;
+}
+
+template <typename T, typename GrowthPolicy>
+void MappedDynamicArray<T, GrowthPolicy>::map(size_t bytes) {
+  void *mapping =
+      ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+  if (mapping == MAP_FAILED) {
+    throwSystemError("mmap");
+  }
+
+  m_mapping = mapping;
+  m_mappedBytes = bytes;
+  m_header = static_cast<Header *>(mapping);
+  m_currentCapacity = (bytes - sizeof(Header)) / sizeof(T);
+}
+
+template <typename T, typename GrowthPolicy>
+void MappedDynamicArray<T, GrowthPolicy>::remap(size_t elementCapacity) {
+  const size_t page = pageSize();
+  const size_t bytes =
+      (sizeof(Header) + elementCapacity * sizeof(T) + page - 1) / page * page;
+  const size_t oldBytes = m_mappedBytes;
+  if (bytes == oldBytes) {
+    return;
+  }
+
+  // The file must not be shorter than the mapping while it is in use, so it
+  // grows before the mapping and shrinks after it
+  if (bytes > oldBytes &&
+      ::ftruncate(m_fd, static_cast<off_t>(bytes)) != 0) {
+    throwSystemError("ftruncate");
+  }
+
+  void *mapping = ::mremap(m_mapping, oldBytes, bytes, MREMAP_MAYMOVE);
+  if (mapping == MAP_FAILED) {
+    throwSystemError("mremap");
+  }
+
+  m_mapping = mapping;
+  m_mappedBytes = bytes;
+  m_header = static_cast<Header *>(mapping);
+  m_currentCapacity = (bytes - sizeof(Header)) / sizeof(T);
+
+  if (bytes < oldBytes &&
+      ::ftruncate(m_fd, static_cast<off_t>(bytes)) != 0) {
+    throwSystemError("ftruncate");
+  }
+
+  if (m_access != Access::Normal) {
+    advise(m_access);
+  }
+}
+
+template <typename T, typename GrowthPolicy>
+size_t MappedDynamicArray<T, GrowthPolicy>::nextCapacity(
+    size_t requiredCapacity) const {
+  size_t capacity = m_currentCapacity;
+  do {
+    capacity = GrowthPolicy::nextCapacity(capacity, sizeof(T));
+  } while (capacity < requiredCapacity);
+
+  return capacity;
+}
+
+template <typename T, typename GrowthPolicy>
+T *MappedDynamicArray<T, GrowthPolicy>::elements() const noexcept {
+  return reinterpret_cast<T *>(static_cast<unsigned char *>(m_mapping) +
+                               sizeof(Header));
+}
+
+#endif
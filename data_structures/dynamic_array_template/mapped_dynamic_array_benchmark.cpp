@@ -0,0 +1,95 @@
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "dynamic_array.h"
+#include "mapped_dynamic_array.h"
+
+/*
+Compares restarting a process which needs a large array of records:
+- rebuilding a DynamicArray by pushing back every record again
+- reopening a MappedDynamicArray written by an earlier run
+
+Reopening only maps the file, so its time does not depend on the number of
+elements. The pages are read when they are touched for the first time; the
+sequential scan after the reopen shows that cost with MADV_SEQUENTIAL. Here
+the file is still in the page cache - after a reboot the scan runs at the
+read speed of the disk.
+
+Run:
+$> ./mapped_dynamic_array_benchmark [number of elements] [file]
+*/
+
+namespace {
+
+struct Record {
+  long long id;
+  double value;
+};
+
+double millisecondsSince(std::chrono::steady_clock::time_point start) {
+  const auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+template <typename Array>
+double sumValues(const Array &arr) {
+  double sum = 0;
+  for (size_t i = 0; i < arr.size(); i++) {
+    sum += arr[i].value;
+  }
+
+  return sum;
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  const size_t count =
+      argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 50'000'000;
+  const std::string path =
+      argc > 2 ? argv[2]
+               : "/tmp/mapped_dynamic_array_benchmark_" +
+                     std::to_string(::getpid());
+  std::remove(path.c_str());
+
+  auto start = std::chrono::steady_clock::now();
+  {
+    MappedDynamicArray<Record> arr{path};
+    for (size_t i = 0; i < count; i++) {
+      arr.push_back({static_cast<long long>(i), i * 0.5});
+    }
+  }
+  const double write = millisecondsSince(start);
+
+  start = std::chrono::steady_clock::now();
+  DynamicArray<Record> rebuilt;
+  for (size_t i = 0; i < count; i++) {
+    rebuilt.push_back({static_cast<long long>(i), i * 0.5});
+  }
+  const double rebuild = millisecondsSince(start);
+
+  start = std::chrono::steady_clock::now();
+  MappedDynamicArray<Record> reopened{path};
+  const double reopen = millisecondsSince(start);
+
+  start = std::chrono::steady_clock::now();
+  reopened.advise(MappedDynamicArray<Record>::Access::Sequential);
+  const double sum = sumValues(reopened);
+  const double scan = millisecondsSince(start);
+
+  std::cout << count << " records of " << sizeof(Record) << " bytes\n"
+            << "  first write to the file: " << write << " ms\n"
+            << "  rebuild with DynamicArray::push_back: " << rebuild
+            << " ms\n"
+            << "  reopen the mapped file: " << reopen << " ms\n"
+            << "  first sequential scan after reopen: " << scan << " ms\n"
+            << "  (checksum " << sum - sumValues(rebuilt) << ")\n";
+
+  std::remove(path.c_str());
+  return 0;
+}
@@ -0,0 +1,290 @@
+#ifndef SHARED_DYNAMIC_ARRAY_H
+#define SHARED_DYNAMIC_ARRAY_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+
+#include "dynamic_array.h"
+
+/**
+ * Dynamic array whose copies share their elements until one of them is
+ * written to (copy-on-write).
+ *
+ * The elements are kept in chunks of ChunkSize elements. The array holds a
+ * reference counted table of reference counted chunks, so copying it, or
+ * taking a snapshot(), only increments one reference count. A write copies
+ * the table (one pointer per chunk) and the chunk it goes to if they are
+ * shared, and leaves all other chunks shared. A ChunkSize larger than the
+ * array turns this into copying the whole array on the first write.
+ *
+ * A snapshot never changes: it can be handed to other threads and read there
+ * while the original keeps being written to. As with the other containers, a
+ * single SharedDynamicArray object must not be used from several threads at
+ * once if one of them writes to it.
+ *
+ * @tparam ChunkSize Number of elements copied by a write to a shared chunk
+ */
+template <typename T, size_t ChunkSize = 4096>
+class SharedDynamicArray {
+  static_assert(ChunkSize > 0, "Chunks must hold at least one element.");
+
+ public:
+  SharedDynamicArray() = default;
+
+  /**
+   * Copies the elements of arr into the chunks of the shared array. O(n)
+   */
+  explicit SharedDynamicArray(const DynamicArray<T> &arr);
+
+  /**
+   * Copies share the elements. O(1)
+   */
+  SharedDynamicArray(const SharedDynamicArray &) = default;
+  SharedDynamicArray(SharedDynamicArray &&) noexcept;
+  SharedDynamicArray &operator=(const SharedDynamicArray &) = default;
+  SharedDynamicArray &operator=(SharedDynamicArray &&) noexcept;
+
+  /**
+   * Returns a copy which keeps the current elements, whatever is written to
+   * the array afterwards. O(1)
+   */
+  SharedDynamicArray snapshot() const;
+
+  /**
+   * Appends the given element value to the end of the container.
+   * Copies the last chunk if it is shared.
+   */
+  void push_back(const T &value);
+
+  /**
+   * Removes the last element of the container.
+   * Calling pop_back on an empty container throws exception.
+   * @throw std::runtime_error
+   */
+  void pop_back();
+
+  /**
+   * Replaces the element at index. Copies its chunk if it is shared.
+   */
+  void set(size_t index, const T &value);
+
+  /**
+   * Returns a writable reference to the element at index, copying its chunk
+   * if it is shared. The reference is valid until the array is copied.
+   */
+  T &edit(size_t index);
+
+  /**
+   * Access element without checking if index is out of bounds
+   */
+  const T &operator[](size_t index) const;
+
+  /**
+   * Checks if index is out of bounds and throws exception if it is
+   * @throw std::out_of_range
+   */
+  const T &at(size_t index) const;
+
+  /**
+   * Returns a reference to the last element in the array.
+   */
+  const T &back() const;
+
+  /**
+   * Returns number of elements in the array
+   */
+  size_t size() const;
+
+  /**
+   * Returns whether the array is empty of elements or not
+   */
+  bool empty() const;
+
+  /**
+   * Removes all elements. The chunks are freed once no other copy shares
+   * them.
+   */
+  void clear();
+
+  /**
+   * Returns whether the array shares its chunk table with other
+   */
+  bool sharesWith(const SharedDynamicArray &other) const;
+
+ private:
+  using Chunk = DynamicArray<T>;
+  using ChunkTable = DynamicArray<std::shared_ptr<Chunk>>;
+
+  // True if no other copy refers to the object, so it can be written to
+  template <typename U>
+  static bool isUnique(const std::shared_ptr<U> &pointer);
+
+  ChunkTable &writableTable();
+  Chunk &writableChunk(size_t chunkIndex);
+
+ private:
+  std::shared_ptr<ChunkTable> m_chunks;
+  size_t m_size = 0;
+};
+
+template <typename T, size_t ChunkSize>
+SharedDynamicArray<T, ChunkSize>::SharedDynamicArray(
+    const DynamicArray<T> &arr) {
+  for (size_t i = 0; i < arr.size(); i++) {
+    push_back(arr[i]);
+  }
+}
+
+template <typename T, size_t ChunkSize>
+SharedDynamicArray<T, ChunkSize>::SharedDynamicArray(
+    SharedDynamicArray &&other) noexcept
+    : m_chunks{std::move(other.m_chunks)}, m_size{other.m_size} {
+  other.m_size = 0;
+}
+
+template <typename T, size_t ChunkSize>
+SharedDynamicArray<T, ChunkSize> &SharedDynamicArray<T, ChunkSize>::operator=(
+    SharedDynamicArray &&other) noexcept {
+  if (this != &other) {
+    m_chunks = std::move(other.m_chunks);
+    m_size = other.m_size;
+    other.m_size = 0;
+  }
+
+  return *this;
+}
+
+template <typename T, size_t ChunkSize>
+SharedDynamicArray<T, ChunkSize> SharedDynamicArray<T, ChunkSize>::snapshot()
+    const {
+  return *this;
+}
+
+template <typename T, size_t ChunkSize>
+void SharedDynamicArray<T, ChunkSize>::push_back(const T &value) {
+  if (m_size % ChunkSize == 0) {
+    // The chunks never grow past ChunkSize, so their elements never move
+    // and value stays valid even if it refers to one of them
+    auto chunk = std::make_shared<Chunk>();
+    chunk->reserve(ChunkSize);
+    chunk->push_back(value);
+    writableTable().push_back(std::move(chunk));
+  } else {
+    writableChunk(m_size / ChunkSize).push_back(value);
+  }
+
+  ++m_size;
+}
+
+template <typename T, size_t ChunkSize>
+void SharedDynamicArray<T, ChunkSize>::pop_back() {
+  if (empty()) {
+    throw std::runtime_error("Calling pop_back() on an empty container.");
+  }
+
+  const size_t lastChunk = (m_size - 1) / ChunkSize;
+  if ((m_size - 1) % ChunkSize == 0) {
+    // the last element is alone in its chunk - drop the whole chunk
+    writableTable().pop_back();
+  } else {
+    writableChunk(lastChunk).pop_back();
+  }
+
+  --m_size;
+}
+
+template <typename T, size_t ChunkSize>
+void SharedDynamicArray<T, ChunkSize>::set(size_t index, const T &value) {
+  // value may refer to an element of a chunk which is about to be copied,
+  // the old chunk is kept alive by the copy that shares it
+  edit(index) = value;
+}
+
+template <typename T, size_t ChunkSize>
+T &SharedDynamicArray<T, ChunkSize>::edit(size_t index) {
+  return writableChunk(index / ChunkSize)[index % ChunkSize];
+}
+
+template <typename T, size_t ChunkSize>
+const T &SharedDynamicArray<T, ChunkSize>::operator[](size_t index) const {
+  return (*(*m_chunks)[index / ChunkSize])[index % ChunkSize];
+}
+
+template <typename T, size_t ChunkSize>
+const T &SharedDynamicArray<T, ChunkSize>::at(size_t index) const {
+  if (index >= m_size) {
+    throw std::out_of_range{"Index out of range."};
+  }
+
+  return (*this)[index];
+}
+
+template <typename T, size_t ChunkSize>
+const T &SharedDynamicArray<T, ChunkSize>::back() const {
+  return (*this)[m_size - 1];
+}
+
+template <typename T, size_t ChunkSize>
+size_t SharedDynamicArray<T, ChunkSize>::size() const {
+  return m_size;
+}
+
+template <typename T, size_t ChunkSize>
+bool SharedDynamicArray<T, ChunkSize>::empty() const {
+  return m_size == 0;
+}
+
+template <typename T, size_t ChunkSize>
+void SharedDynamicArray<T, ChunkSize>::clear() {
+  m_chunks.reset();
+  m_size = 0;
+}
+
+template <typename T, size_t ChunkSize>
+bool SharedDynamicArray<T, ChunkSize>::sharesWith(
+    const SharedDynamicArray &other) const {
+  return m_chunks && m_chunks == other.m_chunks;
+}
+
+template <typename T, size_t ChunkSize>
+template <typename U>
+bool SharedDynamicArray<T, ChunkSize>::isUnique(
+    const std::shared_ptr<U> &pointer) {
+  if (pointer.use_count() != 1) {
+    return false;
+  }
+
+  // Another thread may just have released its copy. The release decrements
+  // the count with release ordering; this fence makes that thread's reads of
+  // the object happen before the writes that follow.
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return true;
+}
+
+template <typename T, size_t ChunkSize>
+auto SharedDynamicArray<T, ChunkSize>::writableTable() -> ChunkTable & {
+  if (!m_chunks) {
+    m_chunks = std::make_shared<ChunkTable>();
+  } else if (!isUnique(m_chunks)) {
+    // copies the pointers only, the chunks stay shared
+    m_chunks = std::make_shared<ChunkTable>(*m_chunks);
+  }
+
+  return *m_chunks;
+}
+
+template <typename T, size_t ChunkSize>
+auto SharedDynamicArray<T, ChunkSize>::writableChunk(size_t chunkIndex)
+    -> Chunk & {
+  std::shared_ptr<Chunk> &chunk = writableTable()[chunkIndex];
+  if (!isUnique(chunk)) {
+    // keeps the capacity of ChunkSize, so the copy does not move either
+    chunk = std::make_shared<Chunk>(*chunk);
+  }
+
+  return *chunk;
+}
+
+#endif
@@ -0,0 +1,74 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+#include "dynamic_array.h"
+#include "shared_dynamic_array.h"
+
+/*
+Cost of handing copies of a large array to many readers:
+- copying a DynamicArray, which duplicates every element
+- taking a snapshot of a SharedDynamicArray, which increments a reference
+  count
+
+and of the writes that follow a snapshot: the first write to a chunk copies
+that chunk (4096 elements), the next ones to the same chunk do not copy
+anything. A write after a snapshot also copies the chunk table once - one
+pointer per chunk.
+
+Run:
+$> ./shared_dynamic_array_benchmark [number of elements] [number of copies]
+*/
+
+namespace {
+
+double millisecondsSince(std::chrono::steady_clock::time_point start) {
+  const auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// keeps the compiler from dropping the copies
+volatile double sink;
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  const size_t count =
+      argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 16'000'000;
+  const size_t copies = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 32;
+
+  DynamicArray<double> arr{count};
+  const SharedDynamicArray<double> shared{arr};
+
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < copies; i++) {
+    const DynamicArray<double> copy{arr};
+    sink = copy[i % count];
+  }
+  const double deepCopy = millisecondsSince(start) / copies;
+
+  start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < copies; i++) {
+    const SharedDynamicArray<double> snapshot = shared.snapshot();
+    sink = snapshot[i % count];
+  }
+  const double snapshot = millisecondsSince(start) / copies;
+
+  SharedDynamicArray<double> writer = shared.snapshot();
+  start = std::chrono::steady_clock::now();
+  writer.set(0, 1.0);
+  const double firstWrite = millisecondsSince(start);
+
+  start = std::chrono::steady_clock::now();
+  writer.set(1, 1.0);
+  const double secondWrite = millisecondsSince(start);
+
+  std::cout << count << " doubles\n"
+            << "  DynamicArray copy: " << deepCopy << " ms\n"
+            << "  SharedDynamicArray snapshot: " << snapshot << " ms\n"
+            << "  first write after the snapshot: " << firstWrite << " ms\n"
+            << "  second write to the same chunk: " << secondWrite
+            << " ms\n";
+
+  return 0;
+}
@@ -0,0 +1,559 @@
+#ifndef SMALL_DYNAMIC_ARRAY_H
+#define SMALL_DYNAMIC_ARRAY_H
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "growth_policy.h"
+
+/**
+ * Dynamic array which keeps up to N elements inside the object itself and
+ * only allocates a buffer on the heap when it grows past N elements.
+ * Supports the element access, back insertion and removal, and capacity
+ * functions of DynamicArray, but has no iterators, insert or erase. The heap
+ * buffer is taken from the given std::pmr::memory_resource, or from the
+ * global heap if none is given.
+ *
+ * @tparam N Number of elements stored inline
+ * @tparam GrowthPolicy Decides how much the buffer grows when it is full. See
+ * growth_policy.h
+ */
+template <typename T, size_t N, typename GrowthPolicy = DoublingGrowth>
+class SmallDynamicArray {
+  static_assert(N > 0, "Inline capacity must be positive.");
+
+ public:
+  SmallDynamicArray() = default;
+  explicit SmallDynamicArray(std::pmr::memory_resource *resource);
+  SmallDynamicArray(size_t initialSize,
+                    std::pmr::memory_resource *resource = nullptr);
+  SmallDynamicArray(const SmallDynamicArray &);
+  SmallDynamicArray(const SmallDynamicArray &,
+                    std::pmr::memory_resource *resource);
+  SmallDynamicArray(SmallDynamicArray &&) noexcept(
+      std::is_nothrow_move_constructible_v<T>);
+  SmallDynamicArray &operator=(const SmallDynamicArray &);
+  SmallDynamicArray &operator=(SmallDynamicArray &&);
+  ~SmallDynamicArray();
+
+  /**
+   * Appends the given element value to the end of the container.
+   */
+  void push_back(const T &value);
+  void push_back(T &&value);
+
+  /**
+   * Constructs a new element in place at the end of the container from the
+   * given arguments.
+   *
+   * @return Reference to the constructed element
+   */
+  template <typename... Args>
+  T &emplace_back(Args &&...args);
+
+  /**
+   * Removes the last element of the container.
+   * Calling pop_back on an empty container throws exception.
+   * @throw std::runtime_error
+   */
+  void pop_back();
+
+  /**
+   * Checks if index is out of bounds and throws exception if it is
+   * @throw std::out_of_range
+   */
+  T &at(size_t index);
+
+  /**
+   * Access element without checking if index is out of bounds
+   */
+  T &operator[](size_t index);
+  const T &operator[](size_t index) const;
+
+  /**
+   * Returns a reference to the last element in the array.
+   */
+  T &back();
+  const T &back() const;
+
+  /**
+   * Returns number of elements in the array
+   */
+  size_t size() const;
+
+  /**
+   * Returns the size of the internal buffer. It is never less than N.
+   */
+  size_t capacity() const;
+
+  /**
+   * Increases the capacity to at least newCapacity. Does nothing if the
+   * capacity is already large enough.
+   */
+  void reserve(size_t newCapacity);
+
+  /**
+   * Resizes the container to contain count elements. Additional elements are
+   * value-initialized (or copies of value), surplus elements are destroyed.
+   */
+  void resize(size_t count);
+  void resize(size_t count, const T &value);
+
+  /**
+   * Requests the container to reduce its capacity to fit its size. If the
+   * elements fit in the inline buffer, the heap buffer is released.
+   */
+  void shrink_to_fit();
+
+  /**
+   * Returns whether the array is empty of elements or not
+   */
+  bool empty() const;
+
+  /**
+   * Clears the array's content without modifying the internal buffer
+   */
+  void clear();
+
+  /**
+   * Returns a direct pointer to the memory array used internally to store the
+   * elements - either the inline buffer or the heap buffer.
+   */
+  T *data() noexcept;
+  const T *data() const noexcept;
+
+  /**
+   * Returns whether the elements are stored in the inline buffer
+   */
+  bool isInline() const noexcept;
+
+  /**
+   * Exchanges the contents of the array with those of other.
+   */
+  void swap(SmallDynamicArray &other);
+
+  /**
+   * Returns the memory resource of the array, nullptr for the global heap
+   */
+  std::pmr::memory_resource *resource() const noexcept;
+
+ private:
+  static constexpr bool IS_TRIVIALLY_COPYABLE =
+      std::is_trivially_copyable_v<T>;
+
+  T *inlineBuffer() noexcept;
+  const T *inlineBuffer() const noexcept;
+
+  T *allocate(size_t capacity) const;
+  void deallocate(T *buffer, size_t capacity) const noexcept;
+
+  // Moves the elements to a buffer with the given capacity, which is the
+  // inline buffer if newCapacity is N.
+  void reallocate(size_t newCapacity);
+  static void relocate(T *src, size_t count, T *dst);
+
+  // Takes the elements of other, which is left empty. *this must be empty
+  // and use its inline buffer. The heap buffer of other is only taken if
+  // both arrays use the same memory resource.
+  void moveFrom(SmallDynamicArray &&other);
+
+  // Destroys the elements and releases the heap buffer, if any
+  void release() noexcept;
+
+  size_t nextCapacity(size_t requiredCapacity = 0) const;
+
+ private:
+  T *m_arr = inlineBuffer();
+  size_t m_currentSize = 0;
+  size_t m_currentCapacity = N;
+  std::pmr::memory_resource *m_resource = nullptr;
+  alignas(T) unsigned char m_inline[N * sizeof(T)];
+};
+
+template <typename T, size_t N, typename GrowthPolicy>
+SmallDynamicArray<T, N, GrowthPolicy>::SmallDynamicArray(
+    std::pmr::memory_resource *resource)
+    : m_resource{resource} {}
+
+template <typename T, size_t N, typename GrowthPolicy>
+SmallDynamicArray<T, N, GrowthPolicy>::SmallDynamicArray(
+    size_t initialSize, std::pmr::memory_resource *resource)
+    : m_resource{resource} {
+  resize(initialSize);
+}
+
+template <typename T, size_t N, typename GrowthPolicy>
+SmallDynamicArray<T, N, GrowthPolicy>::SmallDynamicArray(
+    const SmallDynamicArray &other)
+    : SmallDynamicArray{other, nullptr} {}
+
+template <typename T, size_t N, typename GrowthPolicy>
+SmallDynamicArray<T, N, GrowthPolicy>::SmallDynamicArray(
+    const SmallDynamicArray &other, std::pmr::memory_resource *resource)
+    : m_resource{resource} {
+  reserve(other.m_currentSize);
+
+  if constexpr (IS_TRIVIALLY_COPYABLE) {
+    if (other.m_currentSize > 0) {
+      std::memcpy(m_arr, other.m_arr, other.m_currentSize * sizeof(T));
+    }
+  } else {
+    try {
+      std::uninitialized_copy_n(other.m_arr, other.m_currentSize, m_arr);
+    } catch (...) {
+      release();
+      throw;
+    }
+  }
+
+  m_currentSize = other.m_currentSize;
+}
+
+template <typename T, size_t N, typename GrowthPolicy>
+SmallDynamicArray<T, N, GrowthPolicy>::SmallDynamicArray(
+    SmallDynamicArray &&other) noexcept(
+    std::is_nothrow_move_constructible_v<T>)
+    : m_resource{other.m_resource} {
+  moveFrom(std::move(other));
+}
+
+template <typename T, size_t N, typename GrowthPolicy>
+SmallDynamicArray<T, N, GrowthPolicy> &
+SmallDynamicArray<T, N, GrowthPolicy>::operator=(
+    const SmallDynamicArray &other) {
+  if (this != &other) {
+    SmallDynamicArray copy{other, m_resource};
+    swap(copy);
+  }
+
+  return *this;
+}
+
+template <typename T, size_t N, typename GrowthPolicy>
+SmallDynamicArray<T, N, GrowthPolicy> &
+SmallDynamicArray<T, N, GrowthPolicy>::operator=(SmallDynamicArray &&other) {
+  if (this != &other) {
+    release();
+    moveFrom(std::move(other));
+  }
+
+  return *this;
+}
+
+template <typename T, size_t N, typename GrowthPolicy>
+void SmallDynamicArray<T, N, GrowthPolicy>::moveFrom(
+    SmallDynamicArray &&other) {
+  if (!other.isInline() && m_resource == other.m_resource) {
+    // 'steal' the heap buffer
+    m_arr = other.m_arr;
+    m_currentSize = other.m_currentSize;
+    m_currentCapacity = other.m_currentCapacity;
+
+    other.m_arr = other.inlineBuffer();
+    other.m_currentSize = 0;
+    other.m_currentCapacity = N;
+    return;
+  }
+
+  reserve(other.m_currentSize);
+  relocate(other.m_arr, other.m_currentSize, m_arr);
+  m_currentSize = other.m_currentSize;
+  other.release();
+}
+
+template <typename T, size_t N, typename GrowthPolicy>
+void SmallDynamicArray<T, N, GrowthPolicy>::push_back(const T &value) {
+  emplace_back(value);
+}
+
+template <typename T, size_t N, typename GrowthPolicy>
+void SmallDynamicArray<T, N, GrowthPolicy>::push_back(T &&value) {
+  emplace_back(std::move(value));
+}
+
+template <typename T, size_t N, typename GrowthPolicy>
+template <typename... Args>
+T &SmallDynamicArray<T, N, GrowthPolicy>::emplace_back(Args &&...args) {
+  if (m_currentSize == m_currentCapacity) {
+    // args may refer to an element that is about to be relocated
+    T value(std::forward<Args>(args)...);
+    reallocate(nextCapacity());
+    ::new (static_cast<void *>(m_arr + m_currentSize)) T(std::move(value));
+    return m_arr[m_currentSize++];
+  }
+
+  T *elem = ::new (static_cast<void *>(m_arr + m_currentSize))
+      T(std::forward<Args>(args)...);
+  ++m_currentSize;
+  return *elem;
+}
+
+template <typename T, size_t N, typename GrowthPolicy>
+void SmallDynamicArray<T, N, GrowthPolicy>::pop_back() {
+  if (empty()) {
+    throw std::runtime_error("Calling pop_back() on an empty container.");
+  }
+
+  --m_currentSize;
+  m_arr[m_currentSize].~T();
+}
+
+template <typename T, size_t N, typename GrowthPolicy>
+T &SmallDynamicArray<T, N, GrowthPolicy>::at(size_t index) {
+  if (index >= m_currentSize) {
+    throw std::out_of_range{"Index out of range."};
+  }
+
+  return m_arr[index];
+}
+
+template <typename T, size_t N, typename GrowthPolicy>
+T &SmallDynamicArray<T, N, GrowthPolicy>::operator[](size_t index) {
+  return m_arr[index];
+}
+
+template <typename T, size_t N, typename GrowthPolicy>
+const T &SmallDynamicArray<T, N, GrowthPolicy>::operator[](
+    size_t index) const {
+  return m_arr[index];
+}
+
+template <typename T, size_t N, typename GrowthPolicy>
+T &SmallDynamicArray<T, N, GrowthPolicy>::back() {
+  return m_arr[m_currentSize - 1];
+}
+
+template <typename T, size_t N, typename GrowthPolicy>
+const T &SmallDynamicArray<T, N, GrowthPolicy>::back() const {
+  return m_arr[m_currentSize - 1];
+}
+
+template <typename T, size_t N, typename GrowthPolicy>
+size_t SmallDynamicArray<T, N, GrowthPolicy>::size() const {
+  return m_currentSize;
+}
+
+template <typename T, size_t N, typename GrowthPolicy>
+size_t SmallDynamicArray<T, N, GrowthPolicy>::capacity() const {
+  return m_currentCapacity;
+}
+
+template <typename T, size_t N, typename GrowthPolicy>
+void SmallDynamicArray<T, N, GrowthPolicy>::reserve(size_t newCapacity) {
+  if (newCapacity > m_currentCapacity) {
+    reallocate(newCapacity);
+  }
+}
+
+template <typename T, size_t N, typename GrowthPolicy>
+void SmallDynamicArray<T, N, GrowthPolicy>::resize(size_t count) {
+  if (count <= m_currentSize) {
+    std::destroy(m_arr + count, m_arr + m_currentSize);
+    m_currentSize = count;
+    return;
+  }
+
+  if (count > m_currentCapacity) {
+    reallocate(nextCapacity(count));
+  }
+
+  std::uninitialized_value_construct(m_arr + m_currentSize, m_arr + count);
+  m_currentSize = count;
+}
+
+template <typename T, size_t N, typename GrowthPolicy>
+void SmallDynamicArray<T, N, GrowthPolicy>::resize(size_t count,
+                                                   const T &value) {
+  if (count <= m_currentSize) {
+    std::destroy(m_arr + count, m_arr + m_currentSize);
+    m_currentSize = count;
+    return;
+  }
+
+  if (count > m_currentCapacity) {
+    // value may refer to an element that is about to be relocated
+    const T copy{value};
+    reallocate(nextCapacity(count));
+    std::uninitialized_fill(m_arr + m_currentSize, m_arr + count, copy);
+  } else {
+    std::uninitialized_fill(m_arr + m_currentSize, m_arr + count, value);
+  }
+
+  m_currentSize = count;
+}
+
+template <typename T, size_t N, typename GrowthPolicy>
+void SmallDynamicArray<T, N, GrowthPolicy>::shrink_to_fit() {
+  if (isInline() || m_currentSize == m_currentCapacity) {
+    return;
+  }
+
+  reallocate(m_currentSize > N ? m_currentSize : N);
+}
+
+template <typename T, size_t N, typename GrowthPolicy>
+bool SmallDynamicArray<T, N, GrowthPolicy>::empty() const {
+  return m_currentSize == 0;
+}
+
+template <typename T, size_t N, typename GrowthPolicy>
+void SmallDynamicArray<T, N, GrowthPolicy>::clear() {
+  std::destroy_n(m_arr, m_currentSize);
+  m_currentSize = 0;
+}
+
+template <typename T, size_t N, typename GrowthPolicy>
+T *SmallDynamicArray<T, N, GrowthPolicy>::data() noexcept {
+  return m_arr;
+}
+
+template <typename T, size_t N, typename GrowthPolicy>
+const T *SmallDynamicArray<T, N, GrowthPolicy>::data() const noexcept {
+  return m_arr;
+}
+
+template <typename T, size_t N, typename GrowthPolicy>
+bool SmallDynamicArray<T, N, GrowthPolicy>::isInline() const noexcept {
+  return m_arr == inlineBuffer();
+}
+
+template <typename T, size_t N, typename GrowthPolicy>
+void SmallDynamicArray<T, N, GrowthPolicy>::swap(SmallDynamicArray &other) {
+  if (this == &other) {
+    return;
+  }
+
+  SmallDynamicArray tmp{std::move(other)};
+  other = std::move(*this);
+  *this = std::move(tmp);
+}
+
+template <typename T, size_t N, typename GrowthPolicy>
+std::pmr::memory_resource *SmallDynamicArray<T, N, GrowthPolicy>::resource()
+    const noexcept {
+  return m_resource;
+}
+
+template <typename T, size_t N, typename GrowthPolicy>
+T *SmallDynamicArray<T, N, GrowthPolicy>::inlineBuffer() noexcept {
+  return reinterpret_cast<T *>(m_inline);
+}
+
+template <typename T, size_t N, typename GrowthPolicy>
+const T *SmallDynamicArray<T, N, GrowthPolicy>::inlineBuffer() const noexcept {
+  return reinterpret_cast<const T *>(m_inline);
+}
+
+template <typename T, size_t N, typename GrowthPolicy>
+T *SmallDynamicArray<T, N, GrowthPolicy>::allocate(size_t capacity) const {
+  if (m_resource) {
+    return static_cast<T *>(
+        m_resource->allocate(capacity * sizeof(T), alignof(T)));
+  }
+
+  return static_cast<T *>(::operator new(capacity * sizeof(T),
+                                         std::align_val_t{alignof(T)}));
+}
+
+template <typename T, size_t N, typename GrowthPolicy>
+void SmallDynamicArray<T, N, GrowthPolicy>::deallocate(
+    T *buffer, size_t capacity) const noexcept {
+  if (m_resource) {
+    m_resource->deallocate(buffer, capacity * sizeof(T), alignof(T));
+    return;
+  }
+
+  ::operator delete(buffer, std::align_val_t{alignof(T)});
+}
+
+template <typename T, size_t N, typename GrowthPolicy>
+void SmallDynamicArray<T, N, GrowthPolicy>::reallocate(size_t newCapacity) {
+  T *newArr = newCapacity == N ? inlineBuffer() : allocate(newCapacity);
+
+  try {
+    relocate(m_arr, m_currentSize, newArr);
+  } catch (...) {
+    if (newArr != inlineBuffer()) {
+      deallocate(newArr, newCapacity);
+    }
+    throw;
+  }
+
+  std::destroy_n(m_arr, m_currentSize);
+  if (!isInline()) {
+    deallocate(m_arr, m_currentCapacity);
+  }
+
+  m_arr = newArr;
+  m_currentCapacity = newCapacity;
+}
+
+template <typename T, size_t N, typename GrowthPolicy>
+void SmallDynamicArray<T, N, GrowthPolicy>::relocate(T *src, size_t count,
+                                                     T *dst) {
+  if constexpr (IS_TRIVIALLY_COPYABLE) {
+    if (count > 0) {
+      std::memcpy(dst, src, count * sizeof(T));
+    }
+  } else if constexpr (std::is_nothrow_move_constructible_v<T> ||
+                       !std::is_copy_constructible_v<T>) {
+    std::uninitialized_move_n(src, count, dst);
+  } else {
+    std::uninitialized_copy_n(src, count, dst);
+  }
+}
+
+template <typename T, size_t N, typename GrowthPolicy>
+void SmallDynamicArray<T, N, GrowthPolicy>::release() noexcept {
+  std::destroy_n(m_arr, m_currentSize);
+  if (!isInline()) {
+    deallocate(m_arr, m_currentCapacity);
+  }
+
+  m_arr = inlineBuffer();
+  m_currentSize = 0;
+  m_currentCapacity = N;
+}
+
+template <typename T, size_t N, typename GrowthPolicy>
+size_t SmallDynamicArray<T, N, GrowthPolicy>::nextCapacity(
+    size_t requiredCapacity) const {
+  const size_t grown =
+      GrowthPolicy::nextCapacity(m_currentCapacity, sizeof(T));
+  return grown < requiredCapacity ? requiredCapacity : grown;
+}
+
+template <typename T, size_t N, typename GrowthPolicy>
+SmallDynamicArray<T, N, GrowthPolicy>::~SmallDynamicArray() {
+  release();
+}
+
+template <typename T, size_t N, typename GrowthPolicy>
+bool operator==(const SmallDynamicArray<T, N, GrowthPolicy> &lhs,
+                const SmallDynamicArray<T, N, GrowthPolicy> &rhs) {
+  if (lhs.size() != rhs.size()) {
+    return false;
+  }
+
+  for (size_t i = 0; i < lhs.size(); i++) {
+    if (lhs[i] != rhs[i]) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+template <typename T, size_t N, typename GrowthPolicy>
+bool operator!=(const SmallDynamicArray<T, N, GrowthPolicy> &lhs,
+                const SmallDynamicArray<T, N, GrowthPolicy> &rhs) {
+  return !(lhs == rhs);
+}
+
+#endif
@@ -0,0 +1,138 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+
+#include "dynamic_array.h"
+#include "small_dynamic_array.h"
+
+/*
+Counts the heap allocations made by DynamicArray and SmallDynamicArray when
+building many short arrays, most of which hold fewer than 16 elements.
+
+DynamicArray keeps trivially copyable elements in malloc/realloc memory and
+everything else in operator new memory, so both are counted: malloc, realloc
+and free are wrapped through the linker (-Wl,--wrap) and the global operator
+new/delete are replaced.
+
+Run:
+$> ./small_dynamic_array_benchmark [number of arrays]
+*/
+
+namespace {
+size_t g_allocations = 0;
+size_t g_allocatedBytes = 0;
+}  // namespace
+
+extern "C" {
+void *__real_malloc(size_t size);
+void *__real_realloc(void *ptr, size_t size);
+void __real_free(void *ptr);
+
+void *__wrap_malloc(size_t size) {
+  ++g_allocations;
+  g_allocatedBytes += size;
+  return __real_malloc(size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size) {
+  ++g_allocations;
+  g_allocatedBytes += size;
+  return __real_realloc(ptr, size);
+}
+
+void __wrap_free(void *ptr) { __real_free(ptr); }
+}
+
+void *operator new(size_t size) {
+  void *ptr = __wrap_malloc(size);
+  if (!ptr) {
+    throw std::bad_alloc{};
+  }
+
+  return ptr;
+}
+
+void *operator new(size_t size, std::align_val_t alignment) {
+  ++g_allocations;
+  g_allocatedBytes += size;
+  void *ptr = std::aligned_alloc(static_cast<size_t>(alignment),
+                                 (size + static_cast<size_t>(alignment) - 1) /
+                                     static_cast<size_t>(alignment) *
+                                     static_cast<size_t>(alignment));
+  if (!ptr) {
+    throw std::bad_alloc{};
+  }
+
+  return ptr;
+}
+
+void operator delete(void *ptr) noexcept { __wrap_free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { __wrap_free(ptr); }
+void operator delete(void *ptr, std::align_val_t) noexcept {
+  __wrap_free(ptr);
+}
+void operator delete(void *ptr, size_t, std::align_val_t) noexcept {
+  __wrap_free(ptr);
+}
+
+namespace {
+
+template <typename Array, typename T>
+void measure(const std::string &name, const DynamicArray<size_t> &sizes,
+             const T &value) {
+  g_allocations = g_allocatedBytes = 0;
+  size_t checksum = 0;
+
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < sizes.size(); i++) {
+    Array arr;
+    for (size_t j = 0; j < sizes[i]; j++) {
+      arr.push_back(value);
+    }
+
+    checksum += arr.size();
+  }
+  const auto end = std::chrono::steady_clock::now();
+
+  std::cout << "  " << name << ": " << g_allocations << " allocations, "
+            << g_allocatedBytes / 1024 << " KB, "
+            << std::chrono::duration<double, std::milli>(end - start).count()
+            << " ms (checksum " << checksum << ")\n";
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  const size_t count =
+      argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+
+  // 90% of the arrays have less than 16 elements, the rest up to 64
+  std::mt19937 generator{42};
+  std::uniform_int_distribution<size_t> smallSize{0, 15};
+  std::uniform_int_distribution<size_t> largeSize{16, 64};
+  std::bernoulli_distribution isSmall{0.9};
+
+  DynamicArray<size_t> sizes;
+  sizes.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    sizes.push_back(isSmall(generator) ? smallSize(generator)
+                                       : largeSize(generator));
+  }
+
+  std::cout << "Building " << count << " arrays of int\n";
+  measure<DynamicArray<int>>("DynamicArray<int>", sizes, 42);
+  measure<SmallDynamicArray<int, 16>>("SmallDynamicArray<int, 16>", sizes,
+                                      42);
+
+  // short enough for the small string buffer, so only the arrays allocate
+  const std::string str(8, 'x');
+  std::cout << "Building " << count << " arrays of std::string\n";
+  measure<DynamicArray<std::string>>("DynamicArray<std::string>", sizes, str);
+  measure<SmallDynamicArray<std::string, 16>>(
+      "SmallDynamicArray<std::string, 16>", sizes, str);
+
+  return 0;
+}
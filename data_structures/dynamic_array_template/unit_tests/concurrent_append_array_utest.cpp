@@ -0,0 +1,153 @@
+#include "catch.hpp"
+#include "concurrent_append_array.h"
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Concurrent append array is empty when created") {
+  ConcurrentAppendArray<int> arr;
+  REQUIRE(arr.empty());
+  REQUIRE(arr.size() == 0);
+  REQUIRE_FALSE(arr.isConstructed(0));
+  REQUIRE_THROWS_AS(arr.at(0), std::out_of_range);
+}
+
+TEST_CASE("Concurrent append array keeps the order of a single thread") {
+  ConcurrentAppendArray<std::string, 4> arr;
+  for (int i = 0; i < 10'000; i++) {
+    arr.push_back(std::to_string(i));
+  }
+
+  REQUIRE(arr.size() == 10'000);
+  for (int i = 0; i < 10'000; i++) {
+    REQUIRE(arr[i] == std::to_string(i));
+    REQUIRE(arr.at(i) == std::to_string(i));
+  }
+  REQUIRE_THROWS_AS(arr.at(10'000), std::out_of_range);
+}
+
+TEST_CASE("Concurrent append array elements never move") {
+  ConcurrentAppendArray<int, 2> arr;
+  int &first = arr.emplace_back(1);
+  const int *address = &first;
+
+  for (int i = 0; i < 100'000; i++) {
+    arr.push_back(i);
+  }
+
+  REQUIRE(&arr[0] == address);
+  REQUIRE(first == 1);
+}
+
+TEST_CASE("Concurrent append array takes appends from many threads") {
+  const int THREADS = 8;
+  const int PER_THREAD = 50'000;
+  ConcurrentAppendArray<long long> arr;
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < THREADS; t++) {
+    threads.emplace_back([&arr, t] {
+      for (int i = 0; i < PER_THREAD; i++) {
+        // a thread may read back what it appended itself
+        long long &value = arr.emplace_back(t * 1'000'000LL + i);
+        if (value != t * 1'000'000LL + i) {
+          throw std::logic_error{"element changed"};
+        }
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  REQUIRE(arr.size() == THREADS * PER_THREAD);
+
+  // every value is there exactly once and each thread's values are in order
+  std::vector<int> next(THREADS, 0);
+  for (size_t i = 0; i < arr.size(); i++) {
+    REQUIRE(arr.isConstructed(i));
+    const int thread = static_cast<int>(arr[i] / 1'000'000);
+    REQUIRE(arr[i] % 1'000'000 == next[thread]);
+    next[thread]++;
+  }
+  for (int count : next) {
+    REQUIRE(count == PER_THREAD);
+  }
+}
+
+TEST_CASE("Concurrent append array can be read while it is appended to") {
+  ConcurrentAppendArray<int> arr;
+  std::atomic<bool> done = false;
+
+  std::thread writer{[&] {
+    for (int i = 0; i < 200'000; i++) {
+      arr.push_back(i);
+    }
+    done = true;
+  }};
+
+  bool consistent = true;
+  while (!done) {
+    const size_t size = arr.size();
+    for (size_t i = size > 100 ? size - 100 : 0; i < size; i++) {
+      if (arr.isConstructed(i)) {
+        consistent = consistent && arr[i] == static_cast<int>(i);
+      }
+    }
+  }
+  writer.join();
+
+  REQUIRE(consistent);
+  REQUIRE(arr.size() == 200'000);
+}
+
+TEST_CASE("Concurrent append array reserve allocates the buckets ahead") {
+  ConcurrentAppendArray<int, 8> arr;
+  arr.reserve(1000);
+  REQUIRE(arr.empty());
+
+  for (int i = 0; i < 1000; i++) {
+    arr.push_back(i);
+  }
+  REQUIRE(arr.at(999) == 999);
+}
+
+TEST_CASE("Concurrent append array clear destroys the elements") {
+  auto counter = std::make_shared<int>(0);
+  ConcurrentAppendArray<std::shared_ptr<int>> arr;
+  for (int i = 0; i < 100; i++) {
+    arr.push_back(counter);
+  }
+  REQUIRE(counter.use_count() == 101);
+
+  arr.clear();
+  REQUIRE(arr.empty());
+  REQUIRE(counter.use_count() == 1);
+
+  arr.push_back(counter);
+  REQUIRE(arr.at(0) == counter);
+}
+
+TEST_CASE("Concurrent append array skips elements whose constructor threw") {
+  struct Throwing {
+    explicit Throwing(bool fail) {
+      if (fail) {
+        throw std::runtime_error{"constructor failed"};
+      }
+    }
+  };
+
+  ConcurrentAppendArray<Throwing> arr;
+  arr.emplace_back(false);
+  REQUIRE_THROWS_AS(arr.emplace_back(true), std::runtime_error);
+  arr.emplace_back(false);
+
+  REQUIRE(arr.size() == 3);
+  REQUIRE(arr.isConstructed(0));
+  REQUIRE_FALSE(arr.isConstructed(1));
+  REQUIRE_THROWS_AS(arr.at(1), std::out_of_range);
+  REQUIRE(arr.isConstructed(2));
+}
@@ -1,5 +1,13 @@
 #include "catch.hpp"
 #include "dynamic_array.h"
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <ranges>
+#include <sstream>
+#include <string>
+#include <vector>
 
 TEST_CASE("Dynamic array is empty and has no buffer on construction with "
           "default constructor") {
@@ -196,3 +204,462 @@ TEST_CASE("shrink_to_fit works correctly") {
   REQUIRE(arr.size() == 5);
   REQUIRE(arr.data());
 }
+
+namespace {
+// Counts how many times instances were copied, moved and destroyed
+struct Tracked {
+  static inline int copies = 0;
+  static inline int moves = 0;
+  static inline int alive = 0;
+
+  static void reset() { copies = moves = alive = 0; }
+
+  int value;
+
+  Tracked(int v) : value{v} { ++alive; }
+  Tracked(const Tracked &other) : value{other.value} {
+    ++copies;
+    ++alive;
+  }
+  Tracked(Tracked &&other) noexcept : value{other.value} {
+    ++moves;
+    ++alive;
+  }
+  Tracked &operator=(const Tracked &) = default;
+  ~Tracked() { --alive; }
+};
+
+// Not default constructible and its move constructor may throw
+struct ThrowingMove {
+  static inline int copies = 0;
+
+  int value;
+
+  ThrowingMove(int v) : value{v} {}
+  ThrowingMove(const ThrowingMove &other) : value{other.value} { ++copies; }
+  ThrowingMove(ThrowingMove &&other) : value{other.value} {}
+};
+}  // namespace
+
+TEST_CASE("Dynamic array does not construct elements for unused capacity") {
+  Tracked::reset();
+  {
+    DynamicArray<Tracked> arr;
+    for (int i = 0; i < 5; i++) {
+      arr.emplace_back(i);
+    }
+
+    REQUIRE(arr.size() == 5);
+    REQUIRE(arr.capacity() == 8);
+    REQUIRE(Tracked::alive == 5);
+
+    arr.pop_back();
+    REQUIRE(Tracked::alive == 4);
+
+    arr.clear();
+    REQUIRE(Tracked::alive == 0);
+    REQUIRE(arr.capacity() == 8);
+  }
+
+  REQUIRE(Tracked::alive == 0);
+}
+
+TEST_CASE("Dynamic array moves elements on regrowth when move cannot throw") {
+  Tracked::reset();
+  {
+    DynamicArray<Tracked> arr;
+    for (int i = 0; i < 100; i++) {
+      arr.emplace_back(i);
+    }
+
+    REQUIRE(Tracked::copies == 0);
+    REQUIRE(Tracked::moves > 0);
+
+    for (int i = 0; i < 100; i++) {
+      REQUIRE(arr[i].value == i);
+    }
+  }
+
+  REQUIRE(Tracked::alive == 0);
+}
+
+TEST_CASE("Dynamic array copies elements on regrowth when move may throw") {
+  ThrowingMove::copies = 0;
+  DynamicArray<ThrowingMove> arr;
+  arr.emplace_back(1);
+  arr.emplace_back(2);
+
+  REQUIRE(ThrowingMove::copies == 1);
+  REQUIRE(arr[0].value == 1);
+  REQUIRE(arr[1].value == 2);
+}
+
+TEST_CASE("Dynamic array supports move only types") {
+  DynamicArray<std::unique_ptr<int>> arr;
+  for (int i = 0; i < 20; i++) {
+    arr.push_back(std::make_unique<int>(i));
+  }
+
+  for (int i = 0; i < 20; i++) {
+    REQUIRE(*arr[i] == i);
+  }
+
+  arr.shrink_to_fit();
+  REQUIRE(arr.capacity() == 20);
+  REQUIRE(*arr.back() == 19);
+}
+
+TEST_CASE("emplace_back constructs the element in place") {
+  DynamicArray<std::string> arr;
+  std::string &str = arr.emplace_back(3, 'a');
+  REQUIRE(str == "aaa");
+  REQUIRE(&str == &arr.back());
+
+  // the argument refers to an element of the buffer that is being regrown
+  arr.emplace_back(arr[0]);
+  REQUIRE(arr.size() == 2);
+  REQUIRE(arr[0] == "aaa");
+  REQUIRE(arr[1] == "aaa");
+}
+
+TEST_CASE("Dynamic array's move constructor and move assignment steal the "
+          "buffer") {
+  DynamicArray<std::string> arr;
+  for (int i = 0; i < 155; i++) {
+    arr.push_back(std::to_string(i));
+  }
+
+  const std::string *buffer = arr.data();
+
+  DynamicArray<std::string> moved{std::move(arr)};
+  REQUIRE(moved.data() == buffer);
+  REQUIRE(moved.size() == 155);
+  REQUIRE(arr.empty());
+  REQUIRE(arr.capacity() == 0);
+  REQUIRE(!arr.data());
+
+  DynamicArray<std::string> moveAssigned;
+  moveAssigned.push_back("will be released");
+  moveAssigned = std::move(moved);
+  REQUIRE(moveAssigned.data() == buffer);
+  REQUIRE(moveAssigned.size() == 155);
+  REQUIRE(moveAssigned[154] == "154");
+  REQUIRE(moved.empty());
+
+  // moved-from array is still usable
+  moved.push_back("again");
+  REQUIRE(moved.size() == 1);
+  REQUIRE(moved.back() == "again");
+}
+
+namespace {
+#pragma pack(push, 1)
+struct PackedRecord {
+  char tag;
+  long long id;
+  double value;
+};
+#pragma pack(pop)
+}  // namespace
+
+TEST_CASE("Dynamic array of trivially copyable elements grows, copies and "
+          "shrinks correctly") {
+  DynamicArray<PackedRecord> arr;
+  for (int i = 0; i < 1000; i++) {
+    arr.push_back(PackedRecord{'r', i, i / 2.0});
+  }
+
+  // the argument refers to an element of the buffer that is being regrown
+  REQUIRE(arr.size() == arr.capacity() - 24);
+  while (arr.size() < arr.capacity()) {
+    arr.push_back(arr[0]);
+  }
+  arr.push_back(arr[1]);
+  REQUIRE(arr.back().id == 1);
+  REQUIRE(arr.size() == 1025);
+
+  DynamicArray<PackedRecord> arr_copy{arr};
+  REQUIRE(arr_copy.data() != arr.data());
+  REQUIRE(arr_copy.size() == arr.size());
+  for (size_t i = 0; i < 1000; i++) {
+    REQUIRE(arr_copy[i].tag == 'r');
+    REQUIRE(arr_copy[i].id == static_cast<long long>(i));
+    REQUIRE(arr_copy[i].value == i / 2.0);
+  }
+
+  arr_copy.shrink_to_fit();
+  REQUIRE(arr_copy.capacity() == 1025);
+  REQUIRE(arr_copy[999].id == 999);
+  REQUIRE(arr_copy.back().id == 1);
+}
+
+TEST_CASE("reserve increases only the capacity") {
+  DynamicArray<std::string> arr;
+  arr.push_back("first");
+
+  arr.reserve(100);
+  REQUIRE(arr.capacity() == 100);
+  REQUIRE(arr.size() == 1);
+  REQUIRE(arr[0] == "first");
+
+  const std::string *buffer = arr.data();
+  for (int i = 1; i < 100; i++) {
+    arr.push_back(std::to_string(i));
+  }
+  REQUIRE(arr.data() == buffer);
+
+  // reserving less than the capacity does nothing
+  arr.reserve(10);
+  REQUIRE(arr.capacity() == 100);
+  REQUIRE(arr.size() == 100);
+}
+
+TEST_CASE("resize adds value-initialized elements or removes surplus ones") {
+  Tracked::reset();
+  {
+    DynamicArray<Tracked> arr;
+    arr.emplace_back(1);
+    arr.emplace_back(2);
+    arr.emplace_back(3);
+
+    arr.resize(1, Tracked{0});
+    REQUIRE(arr.size() == 1);
+    REQUIRE(arr[0].value == 1);
+    REQUIRE(Tracked::alive == 1);
+  }
+  REQUIRE(Tracked::alive == 0);
+
+  DynamicArray<double> arr;
+  arr.push_back(5.0);
+  arr.resize(20);
+  REQUIRE(arr.size() == 20);
+  REQUIRE(arr.capacity() >= 20);
+  REQUIRE(arr[0] == 5.0);
+  for (int i = 1; i < 20; i++) {
+    REQUIRE(arr[i] == 0.0);
+  }
+}
+
+TEST_CASE("resize with value fills the new elements with copies of value") {
+  DynamicArray<std::string> arr;
+  arr.push_back("a");
+  arr.resize(3, "b");
+  REQUIRE(arr.size() == 3);
+  REQUIRE(arr[0] == "a");
+  REQUIRE(arr[1] == "b");
+  REQUIRE(arr[2] == "b");
+
+  // the value refers to an element of the buffer that is being regrown
+  arr.resize(200, arr[0]);
+  REQUIRE(arr.size() == 200);
+  for (int i = 3; i < 200; i++) {
+    REQUIRE(arr[i] == "a");
+  }
+
+  arr.resize(2, "c");
+  REQUIRE(arr.size() == 2);
+  REQUIRE(arr.back() == "b");
+}
+
+TEST_CASE("Dynamic array grows according to its growth policy") {
+  DynamicArray<double, OneAndHalfGrowth> arr;
+  const size_t expectedCapacities[] = {1, 2, 3, 4, 6, 6, 9, 9, 9, 13};
+  for (size_t expected : expectedCapacities) {
+    arr.push_back(1.0);
+    REQUIRE(arr.capacity() == expected);
+  }
+
+  // grows by doubling until a 64 bytes page is filled, then by whole pages
+  DynamicArray<double, PageChunkedGrowth<64>> chunked;
+  const size_t expectedChunkedCapacities[] = {1, 2, 4, 8, 16, 24, 40};
+  for (size_t expected : expectedChunkedCapacities) {
+    while (chunked.size() < chunked.capacity()) {
+      chunked.push_back(1.0);
+    }
+    chunked.push_back(1.0);
+    REQUIRE(chunked.capacity() == expected);
+  }
+
+  REQUIRE(GoldenRatioGrowth::nextCapacity(1000, sizeof(double)) == 1618);
+}
+
+TEST_CASE("Dynamic array works with the standard algorithms and ranges") {
+  static_assert(std::ranges::contiguous_range<DynamicArray<int>>);
+  static_assert(std::ranges::sized_range<const DynamicArray<int>>);
+
+  DynamicArray<int> arr;
+  for (int i = 0; i < 1000; i++) {
+    arr.push_back((i * 7919) % 1000);
+  }
+
+  std::sort(arr.begin(), arr.end());
+  REQUIRE(std::is_sorted(arr.cbegin(), arr.cend()));
+  REQUIRE(std::ranges::binary_search(arr, 500));
+
+  std::ranges::reverse(arr);
+  REQUIRE(arr[0] == 999);
+  REQUIRE(*arr.rbegin() == 0);
+  REQUIRE(std::accumulate(arr.rbegin(), arr.rend(), 0) == 999 * 1000 / 2);
+
+  const DynamicArray<int> &constArr = arr;
+  int expected = 999;
+  for (const int &value : constArr) {
+    REQUIRE(value == expected--);
+  }
+
+  DynamicArray<int> empty;
+  REQUIRE(empty.begin() == empty.end());
+}
+
+TEST_CASE("Dynamic array is constructed from and appends ranges") {
+  const std::vector<std::string> source{"a", "b", "c", "d"};
+  DynamicArray<std::string> arr{source.begin(), source.end()};
+  REQUIRE(arr.size() == 4);
+  REQUIRE(arr.capacity() == 4);
+  REQUIRE(arr[3] == "d");
+
+  arr.append(source.begin(), source.begin() + 2);
+  REQUIRE(arr.size() == 6);
+  REQUIRE(arr.back() == "b");
+
+  // a single pass range is appended element by element
+  std::istringstream words{"x y z"};
+  arr.append(std::istream_iterator<std::string>{words},
+             std::istream_iterator<std::string>{});
+  REQUIRE(arr.size() == 9);
+  REQUIRE(arr.back() == "z");
+
+  const int numbers[] = {1, 2, 3};
+  DynamicArray<long long> converted{std::begin(numbers), std::end(numbers)};
+  REQUIRE(converted.size() == 3);
+  REQUIRE(converted[2] == 3);
+}
+
+TEST_CASE("Dynamic array inserts elements at any position") {
+  DynamicArray<int> trivial;
+  DynamicArray<std::string> nonTrivial;
+  for (int i = 0; i < 10; i++) {
+    trivial.push_back(i);
+    nonTrivial.push_back(std::to_string(i));
+  }
+
+  REQUIRE(*trivial.insert(trivial.begin(), -1) == -1);
+  REQUIRE(*nonTrivial.insert(nonTrivial.begin(), "-1") == "-1");
+  REQUIRE(*trivial.insert(trivial.end(), 10) == 10);
+  REQUIRE(*nonTrivial.emplace(nonTrivial.end(), 2, '1') == "11");
+
+  trivial.insert(trivial.begin() + 5, 3, 100);
+  nonTrivial.insert(nonTrivial.begin() + 5, 3, "100");
+
+  const int extra[] = {7, 8};
+  trivial.insert(trivial.begin() + 1, std::begin(extra), std::end(extra));
+  const std::string extraStrings[] = {"7", "8"};
+  nonTrivial.insert(nonTrivial.begin() + 1, std::begin(extraStrings),
+                    std::end(extraStrings));
+
+  const int expected[] = {-1, 7, 8, 0, 1, 2, 3, 100, 100, 100,
+                          4,  5, 6, 7, 8, 9, 10};
+  REQUIRE(trivial.size() == std::size(expected));
+  REQUIRE(nonTrivial.size() == std::size(expected));
+  for (size_t i = 0; i < std::size(expected); i++) {
+    REQUIRE(trivial[i] == expected[i]);
+  }
+  REQUIRE(nonTrivial[0] == "-1");
+  REQUIRE(nonTrivial[7] == "100");
+  REQUIRE(nonTrivial[15] == "9");
+  REQUIRE(nonTrivial.back() == "11");
+}
+
+TEST_CASE("Dynamic array inserts copies of its own elements") {
+  DynamicArray<int> arr;
+  arr.push_back(1);
+  arr.push_back(2);
+  arr.push_back(3);
+  while (arr.size() < arr.capacity()) {
+    arr.push_back(3);
+  }
+
+  // the buffer is full, so it is regrown while value refers into it
+  arr.insert(arr.begin(), arr.back());
+  REQUIRE(arr[0] == 3);
+  arr.insert(arr.begin(), 2, arr[2]);
+  REQUIRE(arr[0] == 2);
+  REQUIRE(arr[1] == 2);
+
+  DynamicArray<std::string> strings;
+  strings.push_back("a");
+  strings.insert(strings.begin(), strings[0]);
+  strings.insert(strings.begin(), 3, strings[1]);
+  REQUIRE(strings.size() == 5);
+  for (const std::string &value : strings) {
+    REQUIRE(value == "a");
+  }
+}
+
+TEST_CASE("Dynamic array erases elements and ranges") {
+  DynamicArray<int> trivial;
+  DynamicArray<std::string> nonTrivial;
+  for (int i = 0; i < 10; i++) {
+    trivial.push_back(i);
+    nonTrivial.push_back(std::to_string(i));
+  }
+
+  REQUIRE(*trivial.erase(trivial.begin()) == 1);
+  REQUIRE(*nonTrivial.erase(nonTrivial.begin()) == "1");
+  REQUIRE(*trivial.erase(trivial.begin() + 2, trivial.begin() + 5) == 6);
+  REQUIRE(*nonTrivial.erase(nonTrivial.begin() + 2,
+                            nonTrivial.begin() + 5) == "6");
+  auto afterLast = trivial.erase(trivial.end() - 1);
+  REQUIRE(afterLast == trivial.end());
+  nonTrivial.erase(nonTrivial.end() - 1);
+  REQUIRE(trivial.erase(trivial.begin(), trivial.begin()) == trivial.begin());
+
+  const int expected[] = {1, 2, 6, 7, 8};
+  REQUIRE(trivial.size() == 5);
+  REQUIRE(nonTrivial.size() == 5);
+  for (size_t i = 0; i < 5; i++) {
+    REQUIRE(trivial[i] == expected[i]);
+    REQUIRE(nonTrivial[i] == std::to_string(expected[i]));
+  }
+
+  trivial.erase(trivial.begin(), trivial.end());
+  REQUIRE(trivial.empty());
+}
+
+TEST_CASE("Dynamic array reads binary records from a stream") {
+  struct Record {
+    long long id;
+    double value;
+  };
+
+  std::stringstream stream;
+  for (long long i = 0; i < 10'000; i++) {
+    const Record record{i, i * 0.5};
+    stream.write(reinterpret_cast<const char *>(&record), sizeof(record));
+  }
+
+  DynamicArray<Record> all;
+  all.push_back({-1, -1});
+  all.assign_from_stream(stream);
+  REQUIRE(all.size() == 10'000);
+  REQUIRE(all[0].id == 0);
+  REQUIRE(all[9'999].value == 9'999 * 0.5);
+
+  stream.clear();
+  stream.seekg(0);
+  DynamicArray<Record> some;
+  some.assign_from_stream(stream, 100);
+  REQUIRE(some.size() == 100);
+  REQUIRE(some.capacity() == 100);
+  REQUIRE(some[99].id == 99);
+
+  // 200 more records do not fit in the rest of a 150 record stream
+  std::istringstream shortStream{stream.str().substr(0, 150 * sizeof(Record))};
+  REQUIRE_THROWS_AS(some.assign_from_stream(shortStream, 200),
+                    std::runtime_error);
+  REQUIRE(some.size() == 150);
+
+  std::istringstream partial{stream.str().substr(0, sizeof(Record) + 3)};
+  REQUIRE_THROWS_AS(some.assign_from_stream(partial), std::runtime_error);
+  REQUIRE(some.size() == 1);
+}
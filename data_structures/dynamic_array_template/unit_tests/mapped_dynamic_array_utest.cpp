@@ -0,0 +1,193 @@
+#include "catch.hpp"
+#include "mapped_dynamic_array.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+
+namespace {
+
+/**
+ * Path of a file in the temporary directory, removed at the end of the test
+ */
+class TemporaryFile {
+ public:
+  TemporaryFile() {
+    static int counter = 0;
+    m_path = std::filesystem::temp_directory_path() /
+             ("mapped_dynamic_array_utest_" + std::to_string(::getpid()) +
+              "_" + std::to_string(counter++));
+    std::filesystem::remove(m_path);
+  }
+
+  ~TemporaryFile() { std::filesystem::remove(m_path); }
+
+  std::string path() const { return m_path.string(); }
+  size_t size() const { return std::filesystem::file_size(m_path); }
+
+ private:
+  std::filesystem::path m_path;
+};
+
+struct Record {
+  long long id;
+  double value;
+};
+
+}  // namespace
+
+TEST_CASE("Mapped dynamic array is empty when created") {
+  TemporaryFile file;
+  MappedDynamicArray<int> arr{file.path()};
+  REQUIRE(arr.empty());
+  REQUIRE(arr.size() == 0);
+  REQUIRE(arr.capacity() > 0);
+  REQUIRE(file.size() == static_cast<size_t>(::sysconf(_SC_PAGESIZE)));
+}
+
+TEST_CASE("Mapped dynamic array keeps its elements after reopening") {
+  TemporaryFile file;
+  {
+    MappedDynamicArray<Record> arr{file.path()};
+    for (long long i = 0; i < 100'000; i++) {
+      arr.push_back({i, i / 2.0});
+    }
+  }
+
+  MappedDynamicArray<Record> arr{file.path()};
+  REQUIRE(arr.size() == 100'000);
+  for (long long i = 0; i < 100'000; i++) {
+    REQUIRE(arr[i].id == i);
+    REQUIRE(arr[i].value == i / 2.0);
+  }
+
+  arr.push_back({-1, -1.0});
+  REQUIRE(arr.back().id == -1);
+}
+
+TEST_CASE("Mapped dynamic array grows the file in whole pages") {
+  TemporaryFile file;
+  MappedDynamicArray<long long> arr{file.path()};
+  const size_t page = ::sysconf(_SC_PAGESIZE);
+
+  for (long long i = 0; i < 10'000; i++) {
+    arr.push_back(i);
+    REQUIRE(arr[i] == i);
+  }
+
+  REQUIRE(file.size() % page == 0);
+  REQUIRE(arr.capacity() >= arr.size());
+  REQUIRE(arr.capacity() == (file.size() - 64) / sizeof(long long));
+}
+
+TEST_CASE("Mapped dynamic array copes with an element of its own") {
+  TemporaryFile file;
+  MappedDynamicArray<long long> arr{file.path()};
+  arr.push_back(42);
+  while (arr.size() < arr.capacity()) {
+    arr.push_back(arr[0]);
+  }
+
+  // the mapping moves while the argument refers into it
+  arr.push_back(arr[0]);
+  REQUIRE(arr.back() == 42);
+
+  arr.resize(arr.capacity() + 1, arr[0]);
+  REQUIRE(arr.back() == 42);
+}
+
+TEST_CASE("Mapped dynamic array reserve, resize and shrink_to_fit") {
+  TemporaryFile file;
+  MappedDynamicArray<int> arr{file.path()};
+
+  arr.reserve(100'000);
+  REQUIRE(arr.capacity() >= 100'000);
+  REQUIRE(arr.empty());
+
+  arr.resize(50'000);
+  REQUIRE(arr.size() == 50'000);
+  REQUIRE(arr[49'999] == 0);
+
+  arr.resize(60'000, 7);
+  REQUIRE(arr[50'000] == 7);
+  REQUIRE(arr[59'999] == 7);
+
+  arr.resize(10);
+  arr.shrink_to_fit();
+  REQUIRE(arr.size() == 10);
+  REQUIRE(arr.capacity() >= 10);
+  REQUIRE(file.size() == static_cast<size_t>(::sysconf(_SC_PAGESIZE)));
+
+  // elements past the size are value-initialized again after growing
+  arr.resize(60'000);
+  REQUIRE(arr[59'999] == 0);
+}
+
+TEST_CASE("Mapped dynamic array throws on invalid accesses") {
+  TemporaryFile file;
+  MappedDynamicArray<int> arr{file.path()};
+  REQUIRE_THROWS_AS(arr.pop_back(), std::runtime_error);
+  REQUIRE_THROWS_AS(arr.at(0), std::out_of_range);
+
+  arr.push_back(1);
+  REQUIRE(arr.at(0) == 1);
+  arr.pop_back();
+  REQUIRE(arr.empty());
+}
+
+TEST_CASE("Mapped dynamic array refuses files it did not write") {
+  TemporaryFile file;
+  {
+    std::ofstream out{file.path()};
+    out << "this is not a mapped array, but it is long enough to have a "
+           "header of sixty four bytes";
+  }
+
+  REQUIRE_THROWS_AS(MappedDynamicArray<int>{file.path()}, std::runtime_error);
+}
+
+TEST_CASE("Mapped dynamic array refuses elements of a different size") {
+  TemporaryFile file;
+  {
+    MappedDynamicArray<int> arr{file.path()};
+    arr.push_back(1);
+  }
+
+  REQUIRE_THROWS_AS(MappedDynamicArray<long long>{file.path()},
+                    std::runtime_error);
+}
+
+TEST_CASE("Mapped dynamic array can be moved and swapped") {
+  TemporaryFile first;
+  TemporaryFile second;
+  MappedDynamicArray<int> a{first.path()};
+  MappedDynamicArray<int> b{second.path()};
+  a.push_back(1);
+  b.push_back(2);
+  b.push_back(3);
+
+  a.swap(b);
+  REQUIRE(a.size() == 2);
+  REQUIRE(b[0] == 1);
+
+  MappedDynamicArray<int> moved{std::move(a)};
+  REQUIRE(moved.size() == 2);
+  REQUIRE(a.size() == 0);
+
+  b = std::move(moved);
+  REQUIRE(b.back() == 3);
+}
+
+TEST_CASE("Mapped dynamic array accepts access hints and syncs") {
+  TemporaryFile file;
+  MappedDynamicArray<int> arr{file.path()};
+  arr.advise(MappedDynamicArray<int>::Access::Sequential);
+  for (int i = 0; i < 5000; i++) {
+    arr.push_back(i);
+  }
+
+  arr.advise(MappedDynamicArray<int>::Access::Random);
+  arr.advise(MappedDynamicArray<int>::Access::WillNeed);
+  arr.sync();
+  REQUIRE(arr[4999] == 4999);
+}
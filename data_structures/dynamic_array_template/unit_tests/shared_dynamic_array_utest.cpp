@@ -0,0 +1,191 @@
+#include "catch.hpp"
+#include "shared_dynamic_array.h"
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Counts how many times elements are copied
+struct Counted {
+  static inline int copies = 0;
+
+  int value = 0;
+
+  Counted(int v) : value{v} {}
+  Counted(const Counted &other) : value{other.value} { ++copies; }
+  Counted &operator=(const Counted &other) {
+    value = other.value;
+    ++copies;
+    return *this;
+  }
+};
+
+}  // namespace
+
+TEST_CASE("Shared dynamic array is empty when created") {
+  SharedDynamicArray<int> arr;
+  REQUIRE(arr.empty());
+  REQUIRE(arr.size() == 0);
+  REQUIRE_THROWS_AS(arr.at(0), std::out_of_range);
+  REQUIRE_THROWS_AS(arr.pop_back(), std::runtime_error);
+}
+
+TEST_CASE("Shared dynamic array stores elements across chunks") {
+  SharedDynamicArray<std::string, 3> arr;
+  for (int i = 0; i < 100; i++) {
+    arr.push_back(std::to_string(i));
+    REQUIRE(arr.back() == std::to_string(i));
+  }
+
+  REQUIRE(arr.size() == 100);
+  for (int i = 0; i < 100; i++) {
+    REQUIRE(arr[i] == std::to_string(i));
+    REQUIRE(arr.at(i) == std::to_string(i));
+  }
+  REQUIRE_THROWS_AS(arr.at(100), std::out_of_range);
+
+  arr.set(50, "fifty");
+  arr.edit(51) += "!";
+  REQUIRE(arr[50] == "fifty");
+  REQUIRE(arr[51] == "51!");
+
+  for (int i = 0; i < 40; i++) {
+    arr.pop_back();
+  }
+  REQUIRE(arr.size() == 60);
+  REQUIRE(arr.back() == "59");
+
+  arr.clear();
+  REQUIRE(arr.empty());
+  arr.push_back("again");
+  REQUIRE(arr[0] == "again");
+}
+
+TEST_CASE("Shared dynamic array copies and snapshots share the elements") {
+  DynamicArray<Counted> source;
+  for (int i = 0; i < 1000; i++) {
+    source.push_back(i);
+  }
+
+  SharedDynamicArray<Counted, 100> arr{source};
+  Counted::copies = 0;
+
+  SharedDynamicArray<Counted, 100> copy{arr};
+  SharedDynamicArray<Counted, 100> snapshot = arr.snapshot();
+  REQUIRE(Counted::copies == 0);
+  REQUIRE(copy.sharesWith(arr));
+  REQUIRE(snapshot.sharesWith(arr));
+  REQUIRE(snapshot[999].value == 999);
+}
+
+TEST_CASE("Shared dynamic array write copies only the chunk it goes to") {
+  SharedDynamicArray<Counted, 100> arr;
+  for (int i = 0; i < 1000; i++) {
+    arr.push_back(i);
+  }
+
+  const SharedDynamicArray<Counted, 100> snapshot = arr.snapshot();
+  Counted::copies = 0;
+
+  // the chunk of 100 elements is copied, then one element is assigned
+  arr.set(150, -1);
+  REQUIRE(Counted::copies == 101);
+  REQUIRE_FALSE(arr.sharesWith(snapshot));
+
+  // the chunk belongs to arr alone now
+  arr.set(160, -2);
+  REQUIRE(Counted::copies == 102);
+
+  REQUIRE(arr[150].value == -1);
+  REQUIRE(arr[160].value == -2);
+  REQUIRE(snapshot[150].value == 150);
+  REQUIRE(snapshot[160].value == 160);
+  REQUIRE(&arr[0] == &snapshot[0]);
+
+  arr.push_back(1000);
+  arr.pop_back();
+  arr.pop_back();
+  REQUIRE(arr.size() == 999);
+  REQUIRE(snapshot.size() == 1000);
+  REQUIRE(snapshot.back().value == 999);
+}
+
+TEST_CASE("Shared dynamic array with a large chunk copies everything once") {
+  SharedDynamicArray<Counted, 1 << 20> arr;
+  for (int i = 0; i < 1000; i++) {
+    arr.push_back(i);
+  }
+
+  SharedDynamicArray<Counted, 1 << 20> copy = arr;
+  Counted::copies = 0;
+  copy.set(0, -1);
+  copy.set(999, -1);
+  REQUIRE(Counted::copies == 1002);
+  REQUIRE(arr[0].value == 0);
+}
+
+TEST_CASE("Shared dynamic array accepts its own elements as values") {
+  SharedDynamicArray<std::string, 2> arr;
+  arr.push_back("a");
+  arr.push_back("b");
+  arr.push_back("c");
+
+  SharedDynamicArray<std::string, 2> copy = arr;
+  arr.push_back(arr[2]);
+  arr.set(2, arr[0]);
+  copy.set(0, copy[1]);
+
+  REQUIRE(arr[2] == "a");
+  REQUIRE(arr[3] == "c");
+  REQUIRE(copy[0] == "b");
+  REQUIRE(copy[2] == "c");
+}
+
+TEST_CASE("Shared dynamic array can be moved") {
+  SharedDynamicArray<int> arr;
+  arr.push_back(1);
+
+  SharedDynamicArray<int> moved{std::move(arr)};
+  REQUIRE(moved.size() == 1);
+  REQUIRE(arr.empty());
+
+  arr = std::move(moved);
+  REQUIRE(arr[0] == 1);
+  REQUIRE(moved.empty());
+}
+
+TEST_CASE("Shared dynamic array snapshots stay consistent for readers") {
+  SharedDynamicArray<long long, 64> arr;
+  for (long long i = 0; i < 10'000; i++) {
+    arr.push_back(0);
+  }
+
+  std::atomic<bool> consistent = true;
+  std::vector<std::thread> readers;
+
+  // In every snapshot all elements have the same value: the writer changes
+  // all of them between two snapshots
+  for (long long round = 1; round <= 20; round++) {
+    const SharedDynamicArray<long long, 64> snapshot = arr.snapshot();
+    readers.emplace_back([snapshot, &consistent] {
+      for (size_t i = 0; i < snapshot.size(); i++) {
+        if (snapshot[i] != snapshot[0]) {
+          consistent = false;
+        }
+      }
+    });
+
+    for (size_t i = 0; i < arr.size(); i++) {
+      arr.set(i, round);
+    }
+  }
+
+  for (std::thread &reader : readers) {
+    reader.join();
+  }
+  REQUIRE(consistent);
+  REQUIRE(arr[9'999] == 20);
+}
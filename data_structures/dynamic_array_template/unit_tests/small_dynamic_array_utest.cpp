@@ -0,0 +1,158 @@
+#include "catch.hpp"
+#include "small_dynamic_array.h"
+#include <memory>
+#include <memory_resource>
+#include <string>
+
+TEST_CASE("Small dynamic array is empty and inline on construction") {
+  SmallDynamicArray<double, 4> arr;
+  REQUIRE(arr.empty());
+  REQUIRE(arr.isInline());
+  REQUIRE(arr.capacity() == 4);
+  REQUIRE(arr.data());
+}
+
+TEST_CASE("Small dynamic array stays inline up to N elements") {
+  SmallDynamicArray<std::string, 4> arr;
+  for (int i = 0; i < 4; i++) {
+    arr.push_back(std::to_string(i));
+    REQUIRE(arr.isInline());
+    REQUIRE(arr.capacity() == 4);
+  }
+
+  arr.push_back("4");
+  REQUIRE(!arr.isInline());
+  REQUIRE(arr.capacity() == 8);
+  REQUIRE(arr.size() == 5);
+
+  for (int i = 0; i < 5; i++) {
+    REQUIRE(arr[i] == std::to_string(i));
+    REQUIRE(arr.at(i) == std::to_string(i));
+  }
+
+  REQUIRE_THROWS_AS(arr.at(5), std::out_of_range);
+}
+
+TEST_CASE("Small dynamic array's shrink_to_fit goes back to the inline "
+          "buffer") {
+  SmallDynamicArray<std::string, 4> arr;
+  for (int i = 0; i < 20; i++) {
+    arr.emplace_back(10, 'a' + i);
+  }
+
+  while (arr.size() > 6) {
+    arr.pop_back();
+  }
+
+  arr.shrink_to_fit();
+  REQUIRE(!arr.isInline());
+  REQUIRE(arr.capacity() == 6);
+
+  arr.pop_back();
+  arr.pop_back();
+  arr.pop_back();
+  arr.shrink_to_fit();
+  REQUIRE(arr.isInline());
+  REQUIRE(arr.capacity() == 4);
+  REQUIRE(arr.size() == 3);
+  REQUIRE(arr.back() == std::string(10, 'c'));
+}
+
+TEST_CASE("Small dynamic array's copy and move work for inline and heap "
+          "buffers") {
+  SmallDynamicArray<std::string, 4> small;
+  small.push_back("a");
+  small.push_back("b");
+
+  SmallDynamicArray<std::string, 4> large;
+  for (int i = 0; i < 100; i++) {
+    large.push_back(std::to_string(i));
+  }
+
+  SmallDynamicArray<std::string, 4> smallCopy{small};
+  REQUIRE(smallCopy.isInline());
+  REQUIRE(smallCopy == small);
+
+  SmallDynamicArray<std::string, 4> largeCopy{large};
+  REQUIRE(!largeCopy.isInline());
+  REQUIRE(largeCopy == large);
+  REQUIRE(largeCopy.data() != large.data());
+
+  const std::string *largeBuffer = large.data();
+  SmallDynamicArray<std::string, 4> largeMoved{std::move(large)};
+  REQUIRE(largeMoved.data() == largeBuffer);
+  REQUIRE(largeMoved == largeCopy);
+  REQUIRE(large.empty());
+  REQUIRE(large.isInline());
+
+  SmallDynamicArray<std::string, 4> smallMoved{std::move(small)};
+  REQUIRE(smallMoved.isInline());
+  REQUIRE(smallMoved == smallCopy);
+  REQUIRE(small.empty());
+
+  smallMoved = largeMoved;
+  REQUIRE(smallMoved == largeCopy);
+  largeMoved = std::move(smallCopy);
+  REQUIRE(largeMoved.isInline());
+  REQUIRE(largeMoved.size() == 2);
+  REQUIRE(largeMoved[1] == "b");
+
+  smallMoved.swap(largeMoved);
+  REQUIRE(smallMoved.size() == 2);
+  REQUIRE(largeMoved == largeCopy);
+}
+
+TEST_CASE("Small dynamic array supports move only types") {
+  SmallDynamicArray<std::unique_ptr<int>, 2> arr;
+  for (int i = 0; i < 10; i++) {
+    arr.push_back(std::make_unique<int>(i));
+  }
+
+  SmallDynamicArray<std::unique_ptr<int>, 2> moved{std::move(arr)};
+  for (int i = 0; i < 10; i++) {
+    REQUIRE(*moved[i] == i);
+  }
+}
+
+TEST_CASE("Small dynamic array's resize and reserve work correctly") {
+  SmallDynamicArray<int, 8> arr{3};
+  REQUIRE(arr.size() == 3);
+  REQUIRE(arr.isInline());
+  REQUIRE(arr[2] == 0);
+
+  arr.resize(5, 7);
+  REQUIRE(arr.size() == 5);
+  REQUIRE(arr[4] == 7);
+  REQUIRE(arr.isInline());
+
+  // the value refers to an element that is about to be relocated
+  arr.resize(30, arr[4]);
+  REQUIRE(!arr.isInline());
+  REQUIRE(arr[29] == 7);
+
+  arr.clear();
+  arr.reserve(100);
+  REQUIRE(arr.capacity() == 100);
+  REQUIRE(arr.empty());
+}
+
+TEST_CASE("Small dynamic array takes only its heap buffer from the given "
+          "resource") {
+  alignas(std::max_align_t) unsigned char buffer[1024];
+  std::pmr::monotonic_buffer_resource resource{
+      buffer, sizeof(buffer), std::pmr::null_memory_resource()};
+
+  SmallDynamicArray<int, 4> arr{&resource};
+  for (int i = 0; i < 4; i++) {
+    arr.push_back(i);
+  }
+  REQUIRE(arr.isInline());
+
+  arr.push_back(4);
+  REQUIRE(!arr.isInline());
+  REQUIRE(arr.resource() == &resource);
+
+  const auto *element = reinterpret_cast<const unsigned char *>(&arr[0]);
+  REQUIRE(element >= buffer);
+  REQUIRE(element < buffer + sizeof(buffer));
+}
@@ -3,6 +3,7 @@
 
 #include <algorithm>
 #include <iostream>
+#include <memory_resource>
 #include <set>
 #include <stdexcept>
 #include <unordered_map>
@@ -16,6 +17,13 @@ class GraphAdjList {
  public:
   GraphAdjList() = default;
 
+  /**
+   * Creates an empty graph whose vertex map and adjacency lists take their
+   * memory from the given resource (the default resource if nullptr)
+   */
+  explicit GraphAdjList(std::pmr::memory_resource* resource)
+      : adjList{resource ? resource : std::pmr::get_default_resource()} {}
+
   /**
    * Returns whether the graph is empty or not
    *
@@ -26,7 +34,7 @@ class GraphAdjList {
   /**
    * Adds a vertex to the graph if it is not there
    */
-  void addVertex(const V& vertex) { adjList.insert({vertex, {}}); }
+  void addVertex(const V& vertex) { adjList.try_emplace(vertex); }
 
   /**
    * Removes a vertex from the graph if it is there
@@ -44,13 +52,13 @@ class GraphAdjList {
 
   void addEdge(const V& from, const V& to) {
     if (!contains(from)) {  // 'from' is in the graph
-      adjList.insert({from, std::vector{to}});
+      adjList.try_emplace(from).first->second.push_back(to);
       if (!contains(to)) {
-        adjList.insert({to, {}});
+        adjList.try_emplace(to);
       }
     } else {  // 'from' is not in the graph
       // check to see if there is already such an edge
-      std::vector<V>& fromAdjacents = adjList.find(from)->second;
+      auto& fromAdjacents = adjList.find(from)->second;
       for (const auto& adj : fromAdjacents) {
         if (adj == to) return;
       }
@@ -150,6 +158,13 @@ class GraphAdjList {
    */
   void clear() { adjList.clear(); }
 
+  /**
+   * Returns the memory resource the graph takes its memory from
+   */
+  std::pmr::memory_resource* resource() const {
+    return adjList.get_allocator().resource();
+  }
+
   /**
    * Prints the graph in DOT format
    */
@@ -164,7 +179,7 @@ class GraphAdjList {
   }
 
  private:
-  std::unordered_map<V, std::vector<V>> adjList;
+  std::pmr::unordered_map<V, std::pmr::vector<V>> adjList;
 };
 
 #endif
@@ -4,10 +4,13 @@
 #include <deque>
 #include <optional>
 #include <queue>
+#include <set>
 #include <stack>
 #include <unordered_set>
 #include <utility>
 
+#include "../stack/fixed_stack.h"
+#include "../stack/stack.h"
 #include "adjacency_list_graph.h"
 
 template <typename V>  // V <-> type of vertex in graph
@@ -111,20 +114,46 @@ class GraphAlgorithms {
 
     Traversal<V> traversal;
     std::unordered_set<V> visited;
-    DFS_traversal_rec(graph, start, traversal, visited);
+    // The depth of the search is at most the number of vertices, so small
+    // graphs fit a stack of fixed capacity, which never grows. Its entries
+    // still allocate: each is a std::set returned by neighbors().
+    if (graph.verticesCount() <= SMALL_GRAPH_VERTICES) {
+      FixedStack<std::set<V>, SMALL_GRAPH_VERTICES> pending;
+      DFS_traversal_iter(graph, start, traversal, visited, pending);
+    } else {
+      Stack<std::set<V>> pending;
+      DFS_traversal_iter(graph, start, traversal, visited, pending);
+    }
     return traversal;
   }
 
  private:
-  template <typename V>
-  static void DFS_traversal_rec(const GraphAdjList<V>& graph,
-                                const V& currentVertex, Traversal<V>& traversal,
-                                std::unordered_set<V>& visited) {
-    visited.insert(currentVertex);
-    traversal.push_back(currentVertex);
-    for (const auto& neighbor : graph.neighbors(currentVertex)) {
+  static constexpr size_t SMALL_GRAPH_VERTICES = 64;
+
+  // Visits the vertices in the order of the recursive DFS. Each entry of
+  // the stack holds the neighbors of a vertex on the current path which are
+  // not explored yet.
+  template <typename V, typename PendingStack>
+  static void DFS_traversal_iter(const GraphAdjList<V>& graph, const V& start,
+                                 Traversal<V>& traversal,
+                                 std::unordered_set<V>& visited,
+                                 PendingStack& pending) {
+    visited.insert(start);
+    traversal.push_back(start);
+    pending.push(graph.neighbors(start));
+
+    while (!pending.empty()) {
+      std::set<V>& neighbors = pending.top();
+      if (neighbors.empty()) {
+        pending.pop();
+        continue;
+      }
+
+      V neighbor = std::move(neighbors.extract(neighbors.begin()).value());
       if (!visited.contains(neighbor)) {
-        DFS_traversal_rec(graph, neighbor, traversal, visited);
+        visited.insert(neighbor);
+        traversal.push_back(neighbor);
+        pending.push(graph.neighbors(neighbor));
       }
     }
   }
@@ -1,5 +1,6 @@
 #include "catch.hpp"
 #include "graph_algorithms.h"
+#include <numeric>
 
 TEST_CASE("Test various algorithms on same test graph") {
   // generate test graph
@@ -60,3 +61,18 @@ TEST_CASE("Test various algorithms on same test graph") {
     REQUIRE(dfsTraversalFrom2 == Traversal<int>{2, 4, 8, 5});
   }
 }
+
+TEST_CASE("DFS traverses graphs deeper than its fixed size stack") {
+  // a long path 0 -> 1 -> ... with a shortcut from every vertex to the end,
+  // which DFS reaches only after the whole path
+  constexpr int VERTICES = 10'000;
+  GraphAdjList<int> graph;
+  for (int v = 0; v + 1 < VERTICES; v++) {
+    graph.addEdge(v, v + 1);
+    graph.addEdge(v, VERTICES - 1);
+  }
+
+  Traversal<int> expected(VERTICES);
+  std::iota(expected.begin(), expected.end(), 0);
+  REQUIRE(GraphAlgorithms::DFS_traversal(graph, 0) == expected);
+}
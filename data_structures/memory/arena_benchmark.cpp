@@ -0,0 +1,117 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "../binary_search_tree/binary_search_tree.hpp"
+#include "../deque/deque.h"
+#include "../doubly_linked_list/doubly_linked_list.h"
+#include "../dynamic_array_template/dynamic_array.h"
+#include "../graph/adjacency_list_graph.h"
+#include "monotonic_arena.h"
+#include "size_class_pool.h"
+
+/*
+Compares the global heap with MonotonicArena and SizeClassPool on
+build-then-discard workloads: every round builds a container with the given
+number of elements and throws it away, as a request handler would do with its
+temporary data.
+
+With the arena the destructors of the containers still walk their nodes, but
+every deallocation is a no-op and the whole round is given back with a single
+release(). With the pool the blocks freed by one round are reused by the next.
+
+Buffer based containers gain little: a growing DynamicArray of trivially
+copyable elements uses realloc on the global heap, which a memory resource
+cannot offer, so there the global heap is expected to win.
+
+Run:
+$> ./arena_benchmark [number of elements] [number of rounds]
+*/
+
+namespace {
+
+void buildArray(std::pmr::memory_resource *resource, size_t count) {
+  DynamicArray<long long> arr{resource};
+  for (size_t i = 0; i < count; i++) {
+    arr.push_back(i);
+  }
+}
+
+void buildDeque(std::pmr::memory_resource *resource, size_t count) {
+  Deque<long long> deque{resource};
+  for (size_t i = 0; i < count; i++) {
+    deque.push_front(i);
+  }
+}
+
+void buildList(std::pmr::memory_resource *resource, size_t count) {
+  DoublyLinkedList<long long> list{resource};
+  for (size_t i = 0; i < count; i++) {
+    list.push_back(i);
+  }
+}
+
+void buildTree(std::pmr::memory_resource *resource, size_t count) {
+  BinarySearchTree<long long> tree{resource};
+  for (size_t i = 0; i < count; i++) {
+    // scatter the keys to keep the tree shallow
+    tree.insert(static_cast<long long>((i * 2654435761u) % count));
+  }
+}
+
+void buildGraph(std::pmr::memory_resource *resource, size_t count) {
+  GraphAdjList<long long> graph{resource};
+  for (size_t i = 0; i < count; i++) {
+    graph.addEdge(i, (i + 1) % count);
+  }
+}
+
+template <typename Build, typename AfterRound>
+double measure(size_t count, size_t rounds, std::pmr::memory_resource *resource,
+               Build build, AfterRound afterRound) {
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t round = 0; round < rounds; round++) {
+    build(resource, count);
+    afterRound();
+  }
+
+  const auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+template <typename Build>
+void compare(const std::string &name, size_t count, size_t rounds,
+             Build build) {
+  const double heap = measure(count, rounds, nullptr, build, [] {});
+
+  MonotonicArena arena;
+  const double arenaTime =
+      measure(count, rounds, &arena, build, [&arena] { arena.release(); });
+
+  SizeClassPool pool;
+  const double poolTime = measure(count, rounds, &pool, build, [] {});
+
+  std::cout << name << ": " << rounds << " rounds x " << count
+            << " elements\n"
+            << "  global heap: " << heap << " ms\n"
+            << "  monotonic arena: " << arenaTime << " ms ("
+            << heap / arenaTime << "x)\n"
+            << "  size class pool: " << poolTime << " ms ("
+            << heap / poolTime << "x)\n";
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  const size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000;
+  const size_t rounds = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 100;
+
+  compare("DynamicArray", count, rounds, buildArray);
+  compare("Deque", count, rounds, buildDeque);
+  compare("DoublyLinkedList", count, rounds, buildList);
+  compare("BinarySearchTree", count, rounds, buildTree);
+  compare("GraphAdjList", count, rounds, buildGraph);
+
+  return 0;
+}
@@ -0,0 +1,187 @@
+#ifndef HUGE_PAGE_RESOURCE_H
+#define HUGE_PAGE_RESOURCE_H
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+
+/**
+ * Memory resource for large buffers, which maps them on 2 MB huge pages and
+ * can place them on chosen NUMA nodes. One huge page covers what 512 regular
+ * pages do, so a scan through a large buffer needs far fewer TLB entries.
+ *
+ * Allocations of at least minimumBytes are mapped with mmap; smaller ones are
+ * passed to the upstream resource, where huge pages would only waste memory.
+ *
+ * Pages:
+ * - Transparent: a 2 MB aligned anonymous mapping with MADV_HUGEPAGE; the
+ *   kernel backs it with huge pages when it has them, regular pages otherwise
+ * - Explicit: MAP_HUGETLB, from the pool reserved in
+ *   /proc/sys/vm/nr_hugepages; falls back to Transparent if the pool is empty
+ *
+ * NUMA placement is applied with mbind before the pages are touched. If the
+ * kernel refuses it (no NUMA support, nodes outside the cpuset, seccomp) the
+ * pages are placed as by default and numaFailures() counts it.
+ *
+ * The resource is thread safe and Linux specific. Use it as the resource of
+ * DynamicArray or Deque:
+ *
+ *   HugePageResource hugePages;
+ *   DynamicArray<double> arr{n, &hugePages};
+ */
+class HugePageResource : public std::pmr::memory_resource {
+ public:
+  enum class Pages { Transparent, Explicit };
+  enum class Numa { Default, Bind, Interleave };
+
+  static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+  /**
+   * @param nodeMask Bit i selects NUMA node i for Numa::Bind and
+   * Numa::Interleave. Nodes without memory are ignored by the kernel.
+   */
+  explicit HugePageResource(
+      Pages pages = Pages::Transparent, Numa numa = Numa::Default,
+      unsigned long nodeMask = ~0UL, size_t minimumBytes = HUGE_PAGE_SIZE,
+      std::pmr::memory_resource *upstream = std::pmr::new_delete_resource())
+      : m_pages{pages},
+        m_numa{numa},
+        m_nodeMask{nodeMask},
+        m_minimumBytes{minimumBytes},
+        m_upstream{upstream} {}
+
+  HugePageResource(const HugePageResource &) = delete;
+  HugePageResource &operator=(const HugePageResource &) = delete;
+
+  /**
+   * Returns the number of allocations mapped from the reserved huge page
+   * pool (Pages::Explicit)
+   */
+  size_t explicitMappings() const noexcept { return m_explicitMappings; }
+
+  /**
+   * Returns the number of allocations mapped with MADV_HUGEPAGE, including
+   * the fallbacks from Pages::Explicit
+   */
+  size_t transparentMappings() const noexcept { return m_transparentMappings; }
+
+  /**
+   * Returns the number of mappings whose NUMA placement the kernel refused
+   */
+  size_t numaFailures() const noexcept { return m_numaFailures; }
+
+  std::pmr::memory_resource *upstream() const noexcept { return m_upstream; }
+
+ protected:
+  void *do_allocate(size_t bytes, size_t alignment) override {
+    if (bytes < m_minimumBytes || alignment > HUGE_PAGE_SIZE) {
+      return m_upstream->allocate(bytes, alignment);
+    }
+
+    const size_t length = roundToHugePages(bytes);
+    void *memory = nullptr;
+    if (m_pages == Pages::Explicit) {
+      memory = mapExplicit(length);
+    }
+
+    if (!memory) {
+      memory = mapTransparent(length);
+    }
+
+    applyNumaPolicy(memory, length);
+    return memory;
+  }
+
+  void do_deallocate(void *memory, size_t bytes, size_t alignment) override {
+    if (bytes < m_minimumBytes || alignment > HUGE_PAGE_SIZE) {
+      m_upstream->deallocate(memory, bytes, alignment);
+      return;
+    }
+
+    ::munmap(memory, roundToHugePages(bytes));
+  }
+
+  bool do_is_equal(
+      const std::pmr::memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+
+ private:
+  static size_t roundToHugePages(size_t bytes) {
+    return (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+  }
+
+  void *mapExplicit(size_t length) {
+    void *memory = ::mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (memory == MAP_FAILED) {
+      return nullptr;
+    }
+
+    ++m_explicitMappings;
+    return memory;
+  }
+
+  // mmap only aligns to regular pages, so one huge page more is mapped and
+  // the unaligned ends are unmapped again
+  void *mapTransparent(size_t length) {
+    const size_t mappedLength = length + HUGE_PAGE_SIZE;
+    void *mapped = ::mmap(nullptr, mappedLength, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapped == MAP_FAILED) {
+      throw std::bad_alloc{};
+    }
+
+    const auto start = reinterpret_cast<std::uintptr_t>(mapped);
+    const auto aligned =
+        (start + HUGE_PAGE_SIZE - 1) & ~(std::uintptr_t{HUGE_PAGE_SIZE} - 1);
+    const size_t head = aligned - start;
+    if (head > 0) {
+      ::munmap(mapped, head);
+    }
+    ::munmap(reinterpret_cast<void *>(aligned + length),
+             mappedLength - head - length);
+
+    auto *memory = reinterpret_cast<void *>(aligned);
+    // without THP support the mapping simply keeps its regular pages
+    ::madvise(memory, length, MADV_HUGEPAGE);
+    ++m_transparentMappings;
+    return memory;
+  }
+
+  void applyNumaPolicy(void *memory, size_t length) {
+    if (m_numa == Numa::Default) {
+      return;
+    }
+
+    // Called through syscall, so that libnuma is not needed
+    const int mode = m_numa == Numa::Bind ? MPOL_BIND : MPOL_INTERLEAVE;
+    const unsigned long maxNode = sizeof(m_nodeMask) * 8;
+    if (::syscall(SYS_mbind, memory, length, mode, &m_nodeMask, maxNode, 0) !=
+        0) {
+      ++m_numaFailures;
+    }
+  }
+
+  // Memory policies of the kernel, as in <numaif.h>
+  static constexpr int MPOL_BIND = 2;
+  static constexpr int MPOL_INTERLEAVE = 3;
+
+  Pages m_pages;
+  Numa m_numa;
+  unsigned long m_nodeMask;
+  size_t m_minimumBytes;
+  std::pmr::memory_resource *m_upstream;
+
+  std::atomic<size_t> m_explicitMappings = 0;
+  std::atomic<size_t> m_transparentMappings = 0;
+  std::atomic<size_t> m_numaFailures = 0;
+};
+
+#endif
@@ -0,0 +1,136 @@
+#ifndef MONOTONIC_ARENA_H
+#define MONOTONIC_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+/**
+ * Memory resource which hands out memory by bumping a pointer through chunks
+ * taken from an upstream resource. Deallocation does nothing - the memory of
+ * everything allocated from the arena is given back at once by release() or
+ * by the destructor, no matter how many objects were allocated.
+ *
+ * Every new chunk is twice as large as the previous one, so the number of
+ * upstream allocations is logarithmic in the total allocated size.
+ *
+ * Containers built on an arena only need to be destroyed if their elements
+ * own resources outside the arena; otherwise the arena can simply be released
+ * while they are no longer used.
+ *
+ * The arena is not thread safe.
+ */
+class MonotonicArena : public std::pmr::memory_resource {
+ public:
+  explicit MonotonicArena(
+      size_t initialChunkSize = 4096,
+      std::pmr::memory_resource *upstream = std::pmr::new_delete_resource())
+      : m_initialChunkSize{initialChunkSize > MIN_CHUNK_SIZE
+                               ? initialChunkSize
+                               : MIN_CHUNK_SIZE},
+        m_nextChunkSize{m_initialChunkSize},
+        m_upstream{upstream} {}
+
+  MonotonicArena(const MonotonicArena &) = delete;
+  MonotonicArena &operator=(const MonotonicArena &) = delete;
+
+  ~MonotonicArena() { release(); }
+
+  /**
+   * Gives all chunks back to the upstream resource. Everything allocated from
+   * the arena becomes invalid.
+   */
+  void release() noexcept {
+    while (m_chunks) {
+      Chunk *next = m_chunks->next;
+      m_upstream->deallocate(m_chunks, m_chunks->size, alignof(Chunk));
+      m_chunks = next;
+    }
+
+    m_current = nullptr;
+    m_end = nullptr;
+    m_nextChunkSize = m_initialChunkSize;
+  }
+
+  /**
+   * Returns the number of bytes currently taken from the upstream resource
+   */
+  size_t upstreamBytes() const noexcept {
+    size_t bytes = 0;
+    for (const Chunk *chunk = m_chunks; chunk; chunk = chunk->next) {
+      bytes += chunk->size;
+    }
+
+    return bytes;
+  }
+
+  std::pmr::memory_resource *upstream() const noexcept { return m_upstream; }
+
+ protected:
+  void *do_allocate(size_t bytes, size_t alignment) override {
+    void *memory = bump(bytes, alignment);
+    if (!memory) {
+      addChunk(bytes + alignment);
+      memory = bump(bytes, alignment);
+    }
+
+    return memory;
+  }
+
+  void do_deallocate(void *, size_t, size_t) override {}
+
+  bool do_is_equal(
+      const std::pmr::memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+
+ private:
+  struct Chunk {
+    Chunk *next;
+    size_t size;
+  };
+
+  static constexpr size_t MIN_CHUNK_SIZE = 2 * sizeof(Chunk);
+
+  void *bump(size_t bytes, size_t alignment) noexcept {
+    if (!m_current) {
+      return nullptr;
+    }
+
+    const auto current = reinterpret_cast<std::uintptr_t>(m_current);
+    const auto aligned = (current + alignment - 1) & ~(alignment - 1);
+    const auto end = reinterpret_cast<std::uintptr_t>(m_end);
+    if (aligned > end || end - aligned < bytes) {
+      return nullptr;
+    }
+
+    m_current = reinterpret_cast<std::byte *>(aligned + bytes);
+    return reinterpret_cast<void *>(aligned);
+  }
+
+  void addChunk(size_t minimumBytes) {
+    size_t size = m_nextChunkSize;
+    while (size - sizeof(Chunk) < minimumBytes) {
+      size *= 2;
+    }
+
+    auto *chunk =
+        static_cast<Chunk *>(m_upstream->allocate(size, alignof(Chunk)));
+    chunk->next = m_chunks;
+    chunk->size = size;
+    m_chunks = chunk;
+
+    m_current = reinterpret_cast<std::byte *>(chunk + 1);
+    m_end = reinterpret_cast<std::byte *>(chunk) + size;
+    m_nextChunkSize = size * 2;
+  }
+
+  Chunk *m_chunks = nullptr;
+  std::byte *m_current = nullptr;
+  std::byte *m_end = nullptr;
+  size_t m_initialChunkSize;
+  size_t m_nextChunkSize;
+  std::pmr::memory_resource *m_upstream;
+};
+
+#endif
@@ -0,0 +1,351 @@
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+
+/**
+ * Allocator of the nodes of one container: uninitialized blocks of
+ * sizeof(NodeType) bytes, carved out of slabs taken from an upstream
+ * resource.
+ *
+ * Freed blocks go to a free list and are handed out again before the newest
+ * slab is cut further, so a container which keeps inserting and erasing
+ * reuses the same few slabs and does not call the upstream resource at all.
+ * Slabs start at MIN_SLAB_NODES blocks and double up to about MAX_SLAB_BYTES,
+ * so small containers waste little and large ones need few slabs.
+ *
+ * release() gives all slabs back at once, in O(number of slabs), without
+ * looking at the blocks in them. adopt() takes over the slabs of another pool
+ * with the same upstream resource, blocks in use included, so that nodes
+ * allocated by one pool can be given back to the other. The pool is not
+ * thread safe.
+ */
+template <typename NodeType>
+class NodePool {
+ public:
+  static constexpr size_t MIN_SLAB_NODES = 16;
+  static constexpr size_t MAX_SLAB_BYTES = 64 * 1024;
+
+  explicit NodePool(
+      std::pmr::memory_resource *upstream = std::pmr::new_delete_resource())
+      : m_upstream{upstream} {}
+
+  NodePool(const NodePool &) = delete;
+  NodePool &operator=(const NodePool &) = delete;
+
+  ~NodePool() { release(); }
+
+  /**
+   * Returns memory for one node. Throws whatever the upstream resource
+   * throws when a new slab is needed.
+   */
+  void *allocate();
+
+  /**
+   * Takes back a block returned by allocate(). The node in it must already
+   * be destroyed.
+   */
+  void deallocate(void *block) noexcept;
+
+  /**
+   * Gives all slabs back to the upstream resource. Every block allocated so
+   * far becomes invalid; the nodes in them are not destroyed.
+   */
+  void release() noexcept;
+
+  /**
+   * Takes over all slabs of other, together with its free blocks and the
+   * blocks still to be cut from its slabs, which are handed out before a new
+   * slab is taken. The blocks which other allocated stay valid and are given
+   * back to this pool. other is left empty. Both pools must have the same
+   * upstream resource.
+   * Complexity: linear in the number of slabs of other
+   */
+  void adopt(NodePool &other) noexcept;
+
+  /**
+   * Returns the number of slabs currently taken from the upstream resource
+   */
+  size_t slabCount() const noexcept;
+
+  std::pmr::memory_resource *upstream() const noexcept { return m_upstream; }
+
+ private:
+  union Block {
+    Block *next;
+    // the first block of an uncut range which waits for the newest slab to
+    // be used up
+    struct {
+      Block *next;
+      std::byte *end;
+    } range;
+    alignas(NodeType) std::byte node[sizeof(NodeType)];
+  };
+
+  struct Slab {
+    Slab *next;
+    size_t bytes;
+  };
+
+  static constexpr size_t MAX_SLAB_NODES =
+      std::max(MIN_SLAB_NODES, MAX_SLAB_BYTES / sizeof(Block));
+
+  // The blocks of a slab start after its header, aligned for a Block
+  static constexpr size_t HEADER_BYTES =
+      (sizeof(Slab) + alignof(Block) - 1) / alignof(Block) * alignof(Block);
+  static constexpr size_t SLAB_ALIGNMENT =
+      std::max(alignof(Slab), alignof(Block));
+
+  void addSlab();
+
+  Block *m_freeList = nullptr;
+  Block *m_freeTail = nullptr;  // valid while m_freeList is not empty
+  std::byte *m_bump = nullptr;  // the uncut blocks of the newest slab
+  std::byte *m_bumpEnd = nullptr;
+  Block *m_ranges = nullptr;  // uncut blocks of adopted slabs
+  Slab *m_slabs = nullptr;
+  size_t m_nextSlabNodes = MIN_SLAB_NODES;
+  std::pmr::memory_resource *m_upstream;
+};
+
+/**
+ * Handle to a NodePool which the containers holding it share.
+ *
+ * Every handle starts with a pool of its own, created at the first get().
+ * share() lets two handles use one pool from then on, so that nodes can move
+ * between their containers without being copied: the pool of one adopts the
+ * slabs of the other. Handles which still refer to the adopted pool are
+ * forwarded to the adopting one by get(). The pools are reference counted,
+ * so the slabs live as long as any container which may hold one of their
+ * nodes.
+ *
+ * Containers which share a pool must not be used from different threads at
+ * the same time.
+ */
+template <typename NodeType>
+class SharedNodePool {
+ public:
+  explicit SharedNodePool(
+      std::pmr::memory_resource *upstream = std::pmr::new_delete_resource())
+      : m_upstream{upstream} {}
+
+  SharedNodePool(const SharedNodePool &) = delete;
+  SharedNodePool &operator=(const SharedNodePool &) = delete;
+
+  /**
+   * Takes over the pool of other, which gets a new pool of its own at its
+   * next get()
+   */
+  SharedNodePool(SharedNodePool &&other) noexcept
+      : m_shared{std::move(other.m_shared)}, m_upstream{other.m_upstream} {}
+  SharedNodePool &operator=(SharedNodePool &&other) noexcept {
+    m_shared = std::move(other.m_shared);
+    return *this;
+  }
+
+  /**
+   * Returns the pool of this handle
+   */
+  NodePool<NodeType> &get();
+
+  /**
+   * Makes this handle and other use the same pool. Both must have the same
+   * upstream resource.
+   * Complexity: linear in the number of slabs of the pool of other, O(1) if
+   * the two already share a pool
+   */
+  void share(SharedNodePool &other);
+
+  /**
+   * Returns whether no other handle uses the pool of this one, in which case
+   * all blocks allocated from it belong to the owner of this handle
+   */
+  bool exclusive();
+
+  /**
+   * Lets go of the pool, whose slabs are given back if no other handle uses
+   * it. The handle gets a new pool at its next get().
+   */
+  void reset() noexcept { m_shared.reset(); }
+
+ private:
+  struct Shared {
+    explicit Shared(std::pmr::memory_resource *upstream) : pool{upstream} {}
+
+    NodePool<NodeType> pool;
+    std::shared_ptr<Shared> adoptedBy;  // the pool which took the slabs
+  };
+
+  // Forwards m_shared to the pool which holds the slabs, if it was adopted
+  void resolve() noexcept;
+
+  std::shared_ptr<Shared> m_shared;
+  std::pmr::memory_resource *m_upstream;
+};
+
+template <typename NodeType>
+void *NodePool<NodeType>::allocate() {
+  if (m_freeList) {
+    Block *block = m_freeList;
+    m_freeList = block->next;
+    return block;
+  }
+
+  if (m_bump == m_bumpEnd) {
+    if (m_ranges) {
+      Block *range = m_ranges;
+      m_ranges = range->range.next;
+      m_bump = reinterpret_cast<std::byte *>(range);
+      m_bumpEnd = range->range.end;
+    } else {
+      addSlab();
+    }
+  }
+
+  void *block = m_bump;
+  m_bump += sizeof(Block);
+  return block;
+}
+
+template <typename NodeType>
+void NodePool<NodeType>::deallocate(void *block) noexcept {
+  Block *freed = ::new (block) Block{m_freeList};
+  if (!m_freeList) {
+    m_freeTail = freed;
+  }
+  m_freeList = freed;
+}
+
+template <typename NodeType>
+void NodePool<NodeType>::release() noexcept {
+  while (m_slabs) {
+    Slab *next = m_slabs->next;
+    m_upstream->deallocate(m_slabs, m_slabs->bytes, SLAB_ALIGNMENT);
+    m_slabs = next;
+  }
+
+  m_freeList = m_freeTail = nullptr;
+  m_bump = m_bumpEnd = nullptr;
+  m_ranges = nullptr;
+  m_nextSlabNodes = MIN_SLAB_NODES;
+}
+
+template <typename NodeType>
+void NodePool<NodeType>::adopt(NodePool &other) noexcept {
+  if (!other.m_slabs || &other == this) {
+    return;
+  }
+
+  Slab *lastSlab = other.m_slabs;
+  while (lastSlab->next) {
+    lastSlab = lastSlab->next;
+  }
+  lastSlab->next = m_slabs;
+  m_slabs = other.m_slabs;
+
+  if (other.m_freeList) {
+    other.m_freeTail->next = m_freeList;
+    if (!m_freeList) {
+      m_freeTail = other.m_freeTail;
+    }
+    m_freeList = other.m_freeList;
+  }
+
+  // The uncut blocks of other wait until this pool has cut its own; every
+  // slab has at most one uncut range, so there are no more ranges than slabs
+  if (other.m_bump != other.m_bumpEnd) {
+    auto *range = reinterpret_cast<Block *>(other.m_bump);
+    range->range.next = other.m_ranges;
+    range->range.end = other.m_bumpEnd;
+    other.m_ranges = range;
+  }
+  if (other.m_ranges) {
+    Block *lastRange = other.m_ranges;
+    while (lastRange->range.next) {
+      lastRange = lastRange->range.next;
+    }
+    lastRange->range.next = m_ranges;
+    m_ranges = other.m_ranges;
+  }
+  m_nextSlabNodes = std::max(m_nextSlabNodes, other.m_nextSlabNodes);
+
+  other.m_slabs = nullptr;
+  other.m_freeList = other.m_freeTail = nullptr;
+  other.m_bump = other.m_bumpEnd = nullptr;
+  other.m_ranges = nullptr;
+  other.m_nextSlabNodes = MIN_SLAB_NODES;
+}
+
+template <typename NodeType>
+size_t NodePool<NodeType>::slabCount() const noexcept {
+  size_t count = 0;
+  for (const Slab *slab = m_slabs; slab; slab = slab->next) {
+    ++count;
+  }
+
+  return count;
+}
+
+template <typename NodeType>
+void NodePool<NodeType>::addSlab() {
+  const size_t bytes = HEADER_BYTES + m_nextSlabNodes * sizeof(Block);
+  auto *memory =
+      static_cast<std::byte *>(m_upstream->allocate(bytes, SLAB_ALIGNMENT));
+  m_slabs = ::new (memory) Slab{m_slabs, bytes};
+
+  m_bump = memory + HEADER_BYTES;
+  m_bumpEnd = m_bump + m_nextSlabNodes * sizeof(Block);
+  m_nextSlabNodes = std::min(m_nextSlabNodes * 2, MAX_SLAB_NODES);
+}
+
+template <typename NodeType>
+NodePool<NodeType> &SharedNodePool<NodeType>::get() {
+  if (!m_shared) {
+    m_shared = std::make_shared<Shared>(m_upstream);
+  }
+
+  resolve();
+  return m_shared->pool;
+}
+
+template <typename NodeType>
+void SharedNodePool<NodeType>::share(SharedNodePool &other) {
+  if (!other.m_shared) {
+    // other has allocated nothing yet
+    other.m_shared = m_shared;
+    return;
+  }
+
+  other.resolve();
+  if (!m_shared) {
+    m_shared = other.m_shared;
+    return;
+  }
+
+  resolve();
+  if (m_shared != other.m_shared) {
+    m_shared->pool.adopt(other.m_shared->pool);
+    other.m_shared->adoptedBy = m_shared;
+    other.m_shared = m_shared;
+  }
+}
+
+template <typename NodeType>
+bool SharedNodePool<NodeType>::exclusive() {
+  resolve();
+  return m_shared.use_count() <= 1;
+}
+
+template <typename NodeType>
+void SharedNodePool<NodeType>::resolve() noexcept {
+  while (m_shared && m_shared->adoptedBy) {
+    // copies the pointer before the adopted pool may be freed
+    m_shared = std::shared_ptr<Shared>{m_shared->adoptedBy};
+  }
+}
+
+#endif
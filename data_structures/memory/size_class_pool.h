@@ -0,0 +1,155 @@
+#ifndef SIZE_CLASS_POOL_H
+#define SIZE_CLASS_POOL_H
+
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+
+/**
+ * Memory resource which serves small blocks from per size class free lists.
+ *
+ * Requests of up to MAX_BLOCK_SIZE bytes are rounded up to a power of two
+ * (at least MIN_BLOCK_SIZE) and served from the free list of that size class.
+ * An empty free list is refilled by cutting a SLAB_SIZE slab from the upstream
+ * resource into blocks. Deallocated blocks go back to their free list, so
+ * node based containers which insert and erase all the time reuse the same
+ * memory instead of going to the global heap for every node.
+ *
+ * Larger requests are passed directly to the upstream resource.
+ *
+ * release() or the destructor give all slabs back to the upstream resource.
+ * The pool is not thread safe.
+ */
+class SizeClassPool : public std::pmr::memory_resource {
+ public:
+  static constexpr size_t MIN_BLOCK_SIZE = 8;
+  static constexpr size_t MAX_BLOCK_SIZE = 4096;
+  static constexpr size_t SLAB_SIZE = 64 * 1024;
+
+  explicit SizeClassPool(
+      std::pmr::memory_resource *upstream = std::pmr::new_delete_resource())
+      : m_upstream{upstream} {}
+
+  SizeClassPool(const SizeClassPool &) = delete;
+  SizeClassPool &operator=(const SizeClassPool &) = delete;
+
+  ~SizeClassPool() { release(); }
+
+  /**
+   * Gives all slabs back to the upstream resource. Every block served from
+   * a slab becomes invalid; large blocks must still be deallocated one by one.
+   */
+  void release() noexcept {
+    while (m_slabs) {
+      Slab *next = m_slabs->next;
+      m_upstream->deallocate(m_slabs, SLAB_SIZE, m_slabs->alignment);
+      m_slabs = next;
+    }
+
+    m_freeLists.fill(nullptr);
+  }
+
+  /**
+   * Returns the number of slabs currently taken from the upstream resource
+   */
+  size_t slabCount() const noexcept {
+    size_t count = 0;
+    for (const Slab *slab = m_slabs; slab; slab = slab->next) {
+      ++count;
+    }
+
+    return count;
+  }
+
+  std::pmr::memory_resource *upstream() const noexcept { return m_upstream; }
+
+ protected:
+  void *do_allocate(size_t bytes, size_t alignment) override {
+    const size_t blockSize = blockSizeFor(bytes, alignment);
+    if (blockSize > MAX_BLOCK_SIZE) {
+      return m_upstream->allocate(bytes, alignment);
+    }
+
+    FreeBlock *&freeList = m_freeLists[classIndex(blockSize)];
+    if (!freeList) {
+      refill(freeList, blockSize);
+    }
+
+    FreeBlock *block = freeList;
+    freeList = block->next;
+    return block;
+  }
+
+  void do_deallocate(void *memory, size_t bytes, size_t alignment) override {
+    const size_t blockSize = blockSizeFor(bytes, alignment);
+    if (blockSize > MAX_BLOCK_SIZE) {
+      m_upstream->deallocate(memory, bytes, alignment);
+      return;
+    }
+
+    FreeBlock *&freeList = m_freeLists[classIndex(blockSize)];
+    freeList = ::new (memory) FreeBlock{freeList};
+  }
+
+  bool do_is_equal(
+      const std::pmr::memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+
+ private:
+  struct FreeBlock {
+    FreeBlock *next;
+  };
+
+  struct Slab {
+    Slab *next;
+    size_t alignment;
+  };
+
+  static constexpr size_t CLASS_COUNT = 10;  // 8, 16, ..., 4096
+  static_assert(MIN_BLOCK_SIZE << (CLASS_COUNT - 1) == MAX_BLOCK_SIZE);
+
+  static size_t blockSizeFor(size_t bytes, size_t alignment) noexcept {
+    size_t size = MIN_BLOCK_SIZE;
+    while (size < bytes || size < alignment) {
+      size *= 2;
+    }
+
+    return size;
+  }
+
+  static size_t classIndex(size_t blockSize) noexcept {
+    size_t index = 0;
+    while ((MIN_BLOCK_SIZE << index) < blockSize) {
+      ++index;
+    }
+
+    return index;
+  }
+
+  void refill(FreeBlock *&freeList, size_t blockSize) {
+    // The slab is aligned to the block size, so every block in it is aligned
+    // to its own size. The first blocks hold the slab header.
+    const size_t alignment =
+        blockSize > alignof(Slab) ? blockSize : alignof(Slab);
+    auto *slab =
+        static_cast<Slab *>(m_upstream->allocate(SLAB_SIZE, alignment));
+    slab->next = m_slabs;
+    slab->alignment = alignment;
+    m_slabs = slab;
+
+    auto *begin = reinterpret_cast<std::byte *>(slab);
+    const size_t headerBlocks = (sizeof(Slab) + blockSize - 1) / blockSize;
+    for (size_t offset = SLAB_SIZE - blockSize;
+         offset >= headerBlocks * blockSize; offset -= blockSize) {
+      freeList = ::new (begin + offset) FreeBlock{freeList};
+    }
+  }
+
+  std::array<FreeBlock *, CLASS_COUNT> m_freeLists{};
+  Slab *m_slabs = nullptr;
+  std::pmr::memory_resource *m_upstream;
+};
+
+#endif
@@ -0,0 +1,532 @@
+#include "catch.hpp"
+#include "huge_page_resource.h"
+#include "monotonic_arena.h"
+#include "node_pool.h"
+#include "size_class_pool.h"
+#include "../binary_search_tree/binary_search_tree.hpp"
+#include "../deque/deque.h"
+#include "../doubly_linked_list/doubly_linked_list.h"
+#include "../dynamic_array_template/dynamic_array.h"
+#include "../graph/adjacency_list_graph.h"
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+/**
+ * Forwards to the global heap and counts what is currently allocated
+ */
+class CountingResource : public std::pmr::memory_resource {
+ public:
+  size_t allocations = 0;
+  size_t outstandingBlocks = 0;
+  size_t outstandingBytes = 0;
+
+ protected:
+  void *do_allocate(size_t bytes, size_t alignment) override {
+    ++allocations;
+    ++outstandingBlocks;
+    outstandingBytes += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void *memory, size_t bytes, size_t alignment) override {
+    --outstandingBlocks;
+    outstandingBytes -= bytes;
+    std::pmr::new_delete_resource()->deallocate(memory, bytes, alignment);
+  }
+
+  bool do_is_equal(
+      const std::pmr::memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+};
+
+bool isAligned(const void *memory, size_t alignment) {
+  return reinterpret_cast<std::uintptr_t>(memory) % alignment == 0;
+}
+
+}  // namespace
+
+TEST_CASE("Arena takes no memory until the first allocation") {
+  CountingResource upstream;
+  MonotonicArena arena{1024, &upstream};
+  REQUIRE(upstream.allocations == 0);
+  REQUIRE(arena.upstreamBytes() == 0);
+}
+
+TEST_CASE("Arena returns aligned, non overlapping memory") {
+  MonotonicArena arena{256};
+
+  auto *first = static_cast<char *>(arena.allocate(3, 1));
+  auto *second = static_cast<char *>(arena.allocate(16, 16));
+  auto *third = static_cast<char *>(arena.allocate(64, 64));
+
+  REQUIRE(isAligned(second, 16));
+  REQUIRE(isAligned(third, 64));
+  REQUIRE(second >= first + 3);
+  REQUIRE(third >= second + 16);
+}
+
+TEST_CASE("Arena grows its chunks geometrically") {
+  CountingResource upstream;
+  MonotonicArena arena{1024, &upstream};
+
+  for (int i = 0; i < 1000; i++) {
+    REQUIRE(arena.allocate(64, 8) != nullptr);
+  }
+
+  // 64000 bytes in chunks of 1, 2, 4, ... KB
+  REQUIRE(upstream.allocations <= 7);
+  REQUIRE(arena.upstreamBytes() == upstream.outstandingBytes);
+}
+
+TEST_CASE("Arena serves allocations larger than a chunk") {
+  CountingResource upstream;
+  MonotonicArena arena{1024, &upstream};
+
+  void *memory = arena.allocate(100'000, 8);
+  REQUIRE(memory != nullptr);
+  REQUIRE(upstream.outstandingBytes >= 100'000);
+}
+
+TEST_CASE("Arena gives all memory back on release") {
+  CountingResource upstream;
+  MonotonicArena arena{1024, &upstream};
+
+  for (int i = 0; i < 100; i++) {
+    void *memory = arena.allocate(256, 8);
+    arena.deallocate(memory, 256, 8);
+  }
+
+  REQUIRE(upstream.outstandingBlocks > 0);
+  arena.release();
+  REQUIRE(upstream.outstandingBlocks == 0);
+  REQUIRE(arena.upstreamBytes() == 0);
+
+  // the arena can be used again after release
+  REQUIRE(arena.allocate(8, 8) != nullptr);
+}
+
+TEST_CASE("Arena gives all memory back on destruction") {
+  CountingResource upstream;
+  {
+    MonotonicArena arena{1024, &upstream};
+    REQUIRE(arena.allocate(5000, 8) != nullptr);
+  }
+  REQUIRE(upstream.outstandingBlocks == 0);
+}
+
+TEST_CASE("Pool reuses deallocated blocks of the same size class") {
+  SizeClassPool pool;
+
+  void *first = pool.allocate(24, 8);
+  pool.deallocate(first, 24, 8);
+
+  // 24 and 32 bytes are both in the 32 bytes size class
+  void *second = pool.allocate(32, 8);
+  REQUIRE(second == first);
+}
+
+TEST_CASE("Pool keeps size classes apart") {
+  SizeClassPool pool;
+
+  void *small = pool.allocate(8, 8);
+  pool.deallocate(small, 8, 8);
+
+  void *large = pool.allocate(64, 8);
+  REQUIRE(large != small);
+}
+
+TEST_CASE("Pool aligns blocks to their size class") {
+  SizeClassPool pool;
+
+  for (size_t size = 8; size <= SizeClassPool::MAX_BLOCK_SIZE; size *= 2) {
+    REQUIRE(isAligned(pool.allocate(size, 8), size));
+  }
+
+  REQUIRE(isAligned(pool.allocate(8, 64), 64));
+}
+
+TEST_CASE("Pool takes one slab for many small blocks") {
+  CountingResource upstream;
+  SizeClassPool pool{&upstream};
+
+  for (int i = 0; i < 1000; i++) {
+    REQUIRE(pool.allocate(16, 8) != nullptr);
+  }
+
+  REQUIRE(pool.slabCount() == 1);
+  REQUIRE(upstream.allocations == 1);
+}
+
+TEST_CASE("Pool passes large blocks to the upstream resource") {
+  CountingResource upstream;
+  SizeClassPool pool{&upstream};
+
+  void *memory = pool.allocate(SizeClassPool::MAX_BLOCK_SIZE + 1, 8);
+  REQUIRE(pool.slabCount() == 0);
+  REQUIRE(upstream.outstandingBlocks == 1);
+
+  pool.deallocate(memory, SizeClassPool::MAX_BLOCK_SIZE + 1, 8);
+  REQUIRE(upstream.outstandingBlocks == 0);
+}
+
+TEST_CASE("Pool gives all slabs back on release") {
+  CountingResource upstream;
+  SizeClassPool pool{&upstream};
+
+  for (size_t size = 8; size <= SizeClassPool::MAX_BLOCK_SIZE; size *= 2) {
+    REQUIRE(pool.allocate(size, 8) != nullptr);
+  }
+
+  REQUIRE(upstream.outstandingBlocks == 10);
+  pool.release();
+  REQUIRE(upstream.outstandingBlocks == 0);
+  REQUIRE(pool.slabCount() == 0);
+}
+
+TEST_CASE("Containers built on an arena take all their memory from it") {
+  CountingResource upstream;
+  MonotonicArena arena{1024, &upstream};
+
+  DynamicArray<int> arr{&arena};
+  Deque<int> deque{&arena};
+  DoublyLinkedList<int> list{&arena};
+  BinarySearchTree<int> tree{&arena};
+  GraphAdjList<int> graph{&arena};
+
+  for (int i = 0; i < 1000; i++) {
+    arr.push_back(i);
+    deque.push_front(i);
+    list.push_back(i);
+    tree.insert((i * 7919) % 1000);
+    graph.addEdge(i, (i + 1) % 1000);
+  }
+
+  REQUIRE(arr.resource() == &arena);
+  REQUIRE(deque.resource() == &arena);
+  REQUIRE(list.resource() == &arena);
+  REQUIRE(tree.resource() == &arena);
+  REQUIRE(graph.resource() == &arena);
+
+  REQUIRE(arr[999] == 999);
+  REQUIRE(deque[0] == 999);
+  REQUIRE(list.back() == 999);
+  REQUIRE(tree.size() == 1000);
+  REQUIRE(graph.contains(999));
+
+  REQUIRE(arena.upstreamBytes() == upstream.outstandingBytes);
+}
+
+TEST_CASE("Containers built on a pool give their nodes back to it") {
+  CountingResource upstream;
+  SizeClassPool pool{&upstream};
+
+  {
+    DoublyLinkedList<std::string> list{&pool};
+    BinarySearchTree<int> tree{&pool};
+    for (int i = 0; i < 1000; i++) {
+      list.push_back("node");
+      tree.insert(i);
+    }
+  }
+  const size_t slabs = pool.slabCount();
+
+  // the second round reuses the blocks freed by the first one
+  {
+    DoublyLinkedList<std::string> list{&pool};
+    BinarySearchTree<int> tree{&pool};
+    for (int i = 0; i < 1000; i++) {
+      list.push_back("node");
+      tree.insert(i);
+    }
+  }
+  REQUIRE(pool.slabCount() == slabs);
+}
+
+TEST_CASE("Node pool reuses freed blocks before cutting new ones") {
+  CountingResource upstream;
+  NodePool<long long> pool{&upstream};
+
+  std::vector<void *> blocks;
+  for (size_t i = 0; i < NodePool<long long>::MIN_SLAB_NODES; i++) {
+    blocks.push_back(pool.allocate());
+  }
+  REQUIRE(upstream.allocations == 1);
+
+  pool.deallocate(blocks[3]);
+  REQUIRE(pool.allocate() == blocks[3]);
+  REQUIRE(upstream.allocations == 1);
+
+  // the second slab is twice as large
+  for (size_t i = 0; i < 2 * NodePool<long long>::MIN_SLAB_NODES; i++) {
+    pool.allocate();
+  }
+  REQUIRE(pool.slabCount() == 2);
+  REQUIRE(upstream.allocations == 2);
+
+  pool.release();
+  REQUIRE(pool.slabCount() == 0);
+  REQUIRE(upstream.outstandingBlocks == 0);
+}
+
+TEST_CASE("List recycles its nodes and frees them in slabs") {
+  CountingResource upstream;
+  DoublyLinkedList<long long> list{&upstream};
+  for (int i = 0; i < 10'000; i++) {
+    list.push_back(i);
+  }
+  const size_t allocations = upstream.allocations;
+  REQUIRE(allocations < 20);
+
+  // erase and insert in the middle, over and over
+  auto it = list.begin();
+  for (int i = 0; i < 5000; i++) {
+    ++it;
+  }
+  for (int i = 0; i < 100'000; i++) {
+    it = list.erase(it);
+    it = list.insertBefore(it, i);
+  }
+  REQUIRE(list.size() == 10'000);
+  REQUIRE(upstream.allocations == allocations);
+
+  list.clear();
+  REQUIRE(upstream.outstandingBlocks == 0);
+
+  list.push_back(1);
+  REQUIRE(list.front() == 1);
+}
+
+TEST_CASE("Node pool adopts the slabs of another pool") {
+  CountingResource upstream;
+  NodePool<long long> pool{&upstream};
+  NodePool<long long> other{&upstream};
+  void *kept = pool.allocate();
+  void *freed = other.allocate();
+  void *adopted = other.allocate();
+  other.deallocate(freed);
+
+  pool.adopt(other);
+  REQUIRE(pool.slabCount() == 2);
+  REQUIRE(other.slabCount() == 0);
+  REQUIRE(pool.allocate() == freed);
+
+  // the uncut blocks of both slabs are used before a new slab is taken
+  for (size_t i = 0; i < 2 * NodePool<long long>::MIN_SLAB_NODES - 3; i++) {
+    pool.allocate();
+  }
+  REQUIRE(upstream.allocations == 2);
+  pool.allocate();
+  REQUIRE(upstream.allocations == 3);
+
+  pool.deallocate(adopted);
+  pool.deallocate(kept);
+  pool.release();
+  REQUIRE(upstream.outstandingBlocks == 0);
+}
+
+TEST_CASE("Shared node pools give their slabs back with the last user") {
+  CountingResource upstream;
+  SharedNodePool<long long> first{&upstream};
+  SharedNodePool<long long> second{&upstream};
+  SharedNodePool<long long> third{&upstream};
+  first.get().allocate();
+  second.get().allocate();
+  third.get().allocate();
+  REQUIRE(first.exclusive());
+
+  // second adopts the slab of third, then first adopts both
+  second.share(third);
+  first.share(third);
+  REQUIRE(!first.exclusive());
+  REQUIRE(&first.get() == &second.get());
+  REQUIRE(&third.get() == &first.get());
+  REQUIRE(first.get().slabCount() == 3);
+
+  second.reset();
+  third.reset();
+  REQUIRE(first.exclusive());
+  REQUIRE(upstream.outstandingBlocks == 3);
+  first.reset();
+  REQUIRE(upstream.outstandingBlocks == 0);
+}
+
+TEST_CASE("List on a size class pool recycles its nodes") {
+  CountingResource upstream;
+  SizeClassPool pool{&upstream};
+  DoublyLinkedList<long long> list{&pool};
+  for (int i = 0; i < 10'000; i++) {
+    list.push_back(i);
+  }
+  const size_t allocations = upstream.allocations;
+  REQUIRE(allocations < 20);
+
+  // erase and insert in the middle, over and over
+  auto it = list.begin();
+  for (int i = 0; i < 5000; i++) {
+    ++it;
+  }
+  for (int i = 0; i < 100'000; i++) {
+    it = list.erase(it);
+    it = list.insertBefore(it, i);
+  }
+  REQUIRE(list.size() == 10'000);
+  REQUIRE(upstream.allocations == allocations);
+
+  list.clear();
+  list.push_back(1);
+  REQUIRE(list.front() == 1);
+}
+
+TEST_CASE("Splicing between lists on different resources copies the "
+          "elements into the resource of the target") {
+  CountingResource first;
+  CountingResource second;
+  DoublyLinkedList<std::string> source{&first};
+  source.push_back("value");
+  DoublyLinkedList<std::string> target{&second};
+
+  target.splice(target.end(), source);
+  REQUIRE(source.empty());
+  REQUIRE(first.outstandingBlocks == 0);
+  REQUIRE(target.front() == "value");
+  REQUIRE(target.resource() == &second);
+
+  source.push_back("element");
+  target.splice(target.end(), source, source.begin());
+  REQUIRE(source.empty());
+  REQUIRE(target.back() == "element");
+  REQUIRE(second.allocations == 1);
+
+  // on the same resource the nodes are relinked, and the two lists share
+  // the slab of target until both let go of it
+  {
+    DoublyLinkedList<std::string> sameResource{&second};
+    const std::string *spliced = &target.back();
+    sameResource.splice(sameResource.end(), target, target.begin().next());
+    REQUIRE(&sameResource.front() == spliced);
+    sameResource.splice(sameResource.end(), target);
+    REQUIRE(target.empty());
+    REQUIRE(sameResource.size() == 2);
+    REQUIRE(second.allocations == 1);
+    sameResource.clear();
+    REQUIRE(second.outstandingBlocks == 1);
+  }
+  target.clear();
+  REQUIRE(second.outstandingBlocks == 0);
+}
+
+TEST_CASE("Copies of containers built on an arena use the global heap") {
+  MonotonicArena arena;
+  DynamicArray<int> arr{&arena};
+  arr.push_back(1);
+  DoublyLinkedList<int> list{&arena};
+  list.push_back(1);
+
+  DynamicArray<int> arrCopy{arr};
+  DoublyLinkedList<int> listCopy{list};
+  REQUIRE(arrCopy.resource() == nullptr);
+  REQUIRE(listCopy.resource() == nullptr);
+  REQUIRE(arrCopy[0] == 1);
+  REQUIRE(listCopy.front() == 1);
+}
+
+TEST_CASE("Moving between arrays with different resources copies the "
+          "elements into the resource of the target") {
+  MonotonicArena first;
+  MonotonicArena second;
+  DynamicArray<std::string> source{&first};
+  source.push_back("value");
+
+  DynamicArray<std::string> target{&second};
+  target = std::move(source);
+
+  REQUIRE(target.resource() == &second);
+  REQUIRE(target.size() == 1);
+  REQUIRE(target[0] == "value");
+}
+
+TEST_CASE("Huge page resource maps large buffers aligned to huge pages") {
+  CountingResource upstream;
+  HugePageResource hugePages{HugePageResource::Pages::Transparent,
+                             HugePageResource::Numa::Default, ~0UL,
+                             HugePageResource::HUGE_PAGE_SIZE, &upstream};
+
+  const size_t bytes = 3 * HugePageResource::HUGE_PAGE_SIZE + 100;
+  auto *memory = static_cast<char *>(hugePages.allocate(bytes, 64));
+  REQUIRE(isAligned(memory, HugePageResource::HUGE_PAGE_SIZE));
+  REQUIRE(hugePages.transparentMappings() == 1);
+  REQUIRE(upstream.allocations == 0);
+
+  std::memset(memory, 7, bytes);
+  REQUIRE(memory[bytes - 1] == 7);
+  hugePages.deallocate(memory, bytes, 64);
+}
+
+TEST_CASE("Huge page resource passes small buffers to the upstream resource") {
+  CountingResource upstream;
+  HugePageResource hugePages{HugePageResource::Pages::Transparent,
+                             HugePageResource::Numa::Default, ~0UL,
+                             HugePageResource::HUGE_PAGE_SIZE, &upstream};
+
+  void *memory = hugePages.allocate(4096, 8);
+  REQUIRE(upstream.outstandingBlocks == 1);
+  REQUIRE(hugePages.transparentMappings() == 0);
+
+  hugePages.deallocate(memory, 4096, 8);
+  REQUIRE(upstream.outstandingBlocks == 0);
+}
+
+TEST_CASE("Huge page resource falls back when no huge pages are reserved") {
+  HugePageResource hugePages{HugePageResource::Pages::Explicit};
+
+  const size_t bytes = HugePageResource::HUGE_PAGE_SIZE;
+  auto *memory = static_cast<char *>(hugePages.allocate(bytes, 64));
+  REQUIRE(hugePages.explicitMappings() + hugePages.transparentMappings() == 1);
+
+  memory[0] = 1;
+  memory[bytes - 1] = 2;
+  hugePages.deallocate(memory, bytes, 64);
+}
+
+TEST_CASE("Huge page resource keeps working if NUMA placement is refused") {
+  // no machine has memory on node 63 only
+  HugePageResource hugePages{HugePageResource::Pages::Transparent,
+                             HugePageResource::Numa::Bind, 1UL << 63};
+
+  const size_t bytes = 2 * HugePageResource::HUGE_PAGE_SIZE;
+  auto *memory = static_cast<char *>(hugePages.allocate(bytes, 64));
+  REQUIRE(hugePages.numaFailures() == 1);
+
+  std::memset(memory, 1, bytes);
+  hugePages.deallocate(memory, bytes, 64);
+
+  // interleaving over all nodes works wherever mbind does
+  HugePageResource interleaved{HugePageResource::Pages::Transparent,
+                               HugePageResource::Numa::Interleave};
+  memory = static_cast<char *>(interleaved.allocate(bytes, 64));
+  std::memset(memory, 1, bytes);
+  interleaved.deallocate(memory, bytes, 64);
+}
+
+TEST_CASE("Large arrays and deques can live on huge pages") {
+  HugePageResource hugePages;
+
+  DynamicArray<double> arr{1'000'000, &hugePages};
+  REQUIRE(isAligned(arr.data(), HugePageResource::HUGE_PAGE_SIZE));
+  for (int i = 0; i < 1000; i++) {
+    arr.push_back(i);
+  }
+  REQUIRE(arr.back() == 999);
+
+  Deque<int> deque{&hugePages};
+  for (int i = 0; i < 1'000'000; i++) {
+    deque.push_back(i);
+  }
+  REQUIRE(deque[999'999] == 999'999);
+  REQUIRE(hugePages.transparentMappings() > 2);
+}
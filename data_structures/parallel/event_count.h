@@ -0,0 +1,124 @@
+#ifndef EVENT_COUNT_H
+#define EVENT_COUNT_H
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+/**
+ * Lets threads sleep until a lock-free data structure changes, without a
+ * mutex on its fast path (the "eventcount" of D. Vyukov).
+ *
+ * A thread which found nothing to do announces itself, checks its condition
+ * once more and only then sleeps:
+ *
+ *   while (!(item = queue.try_pop())) {
+ *     const uint32_t key = event.prepareWait();
+ *     if ((item = queue.try_pop())) {
+ *       event.cancelWait(key);
+ *       break;
+ *     }
+ *     event.wait(key);
+ *   }
+ *
+ * which await() does after spinning for a while. A thread which changed the
+ * condition calls notifyAll(), which costs one atomic read-modify-write
+ * unless somebody sleeps. notifyAll() wakes all the registered waiters at
+ * once and unregisters them, so a burst of changes makes one system call,
+ * not one per change. The sleep is std::atomic::wait,
+ * a futex wait on Linux.
+ */
+class EventCount {
+ public:
+  /**
+   * Registers the calling thread as a waiter. It must then either check its
+   * condition and call cancelWait(), or call wait() with the returned key.
+   */
+  uint32_t prepareWait() {
+    return epoch(m_state.fetch_add(1, std::memory_order_seq_cst));
+  }
+
+  void cancelWait(uint32_t key) {
+    uint64_t state = m_state.load(std::memory_order_relaxed);
+    // a notifyAll() since prepareWait has unregistered the waiter already
+    while (epoch(state) == key &&
+           !m_state.compare_exchange_weak(state, state - 1,
+                                          std::memory_order_relaxed)) {
+    }
+  }
+
+  /**
+   * Sleeps until notifyAll() is called after the prepareWait() which returned
+   * key, returning at once if it already was
+   */
+  void wait(uint32_t key) {
+    uint64_t state = m_state.load(std::memory_order_acquire);
+    while (epoch(state) == key) {
+      // wakes up also when another waiter registers
+      m_state.wait(state, std::memory_order_acquire);
+      state = m_state.load(std::memory_order_acquire);
+    }
+  }
+
+  /**
+   * Calls tryOperation until it returns true. It is retried with a yield in
+   * between SPINS_BEFORE_SLEEP times first, since the other side is often
+   * only a moment away and going to sleep and being woken up costs two system
+   * calls; after that the thread sleeps between attempts.
+   */
+  template <typename TryOperation>
+  void await(TryOperation tryOperation) {
+    for (int i = 0; i < SPINS_BEFORE_SLEEP; i++) {
+      if (tryOperation()) {
+        return;
+      }
+      std::this_thread::yield();
+    }
+
+    while (!tryOperation()) {
+      const uint32_t key = prepareWait();
+      if (tryOperation()) {
+        cancelWait(key);
+        return;
+      }
+      wait(key);
+    }
+  }
+
+  static constexpr int SPINS_BEFORE_SLEEP = 64;
+
+  /**
+   * Wakes all threads which sleep or are about to. Call it after making the
+   * change they wait for visible.
+   */
+  void notifyAll() {
+    // A read-modify-write rather than a load: if it comes before the
+    // increment of prepareWait, that increment reads its value and so the
+    // waiter's check sees the change. A fence would do as well, but is not
+    // understood by ThreadSanitizer.
+    uint64_t state = m_state.fetch_add(0, std::memory_order_seq_cst);
+    while (waiters(state) > 0) {
+      const uint64_t next = static_cast<uint64_t>(epoch(state) + 1) << 32;
+      if (m_state.compare_exchange_weak(state, next,
+                                        std::memory_order_seq_cst)) {
+        m_state.notify_all();
+        return;
+      }
+    }
+  }
+
+ private:
+  static uint32_t epoch(uint64_t state) {
+    return static_cast<uint32_t>(state >> 32);
+  }
+
+  static uint32_t waiters(uint64_t state) {
+    return static_cast<uint32_t>(state);
+  }
+
+  // The epoch, advanced by every notifyAll() which finds waiters, in the
+  // upper half and the number of registered waiters in the lower half
+  std::atomic<uint64_t> m_state{0};
+};
+
+#endif
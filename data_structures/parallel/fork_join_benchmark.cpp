@@ -0,0 +1,105 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "fork_join_pool.h"
+#include "parallel_sort.h"
+
+/*
+Scaling of ForkJoinPool from one thread up to the given number of threads
+(all hardware threads by default).
+
+For every thread count it reports:
+- the throughput of tiny tasks: a recursive fibonacci which joins at every
+  level, so nearly all of the time is the cost of forking and joining
+- the steal rate of that run: which part of the forked tasks were taken by
+  another thread, and how many steal attempts found nothing
+- the time of parallel_quicksort and parallel_merge_sort of random integers,
+  as a speedup over std::sort and std::stable_sort on one thread
+
+Run:
+$> ./fork_join_benchmark [fibonacci n] [number of elements] [maximum threads]
+*/
+
+namespace {
+
+long long fibonacci(int n) {
+  if (n < 2) {
+    return n;
+  }
+
+  long long a, b;
+  ForkJoinPool::join([&] { a = fibonacci(n - 1); },
+                     [&] { b = fibonacci(n - 2); });
+  return a + b;
+}
+
+template <typename Operation>
+double seconds(Operation operation) {
+  const auto start = std::chrono::steady_clock::now();
+  operation();
+  const auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(end - start).count();
+}
+
+// keeps the compiler from dropping the computations
+volatile long long sink;
+
+void measure(size_t threads, int n, const std::vector<int> &input,
+             double sortSeconds, double stableSortSeconds) {
+  ForkJoinPool pool{threads};
+
+  const double fibSeconds =
+      seconds([&] { sink = pool.invoke([n] { return fibonacci(n); }); });
+  const ForkJoinPool::Stats stats = pool.stats();
+
+  std::vector<int> arr = input;
+  const double quick =
+      seconds([&] { parallel_quicksort(arr, std::less<>{}, pool); });
+  arr = input;
+  const double merge =
+      seconds([&] { parallel_merge_sort(arr, std::less<>{}, pool); });
+
+  std::cout << threads << " threads\n"
+            << "  fibonacci(" << n << "): " << stats.tasksRun / fibSeconds / 1e6
+            << " M tasks/s\n"
+            << "  stolen: " << 100.0 * stats.steals / stats.tasksRun
+            << "% of tasks, failed steals: " << stats.failedSteals << '\n'
+            << "  quicksort: " << quick * 1e3 << " ms, speedup "
+            << sortSeconds / quick << '\n'
+            << "  merge sort: " << merge * 1e3 << " ms, speedup "
+            << stableSortSeconds / merge << '\n';
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  const int n = argc > 1 ? std::atoi(argv[1]) : 30;
+  const size_t count =
+      argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 10'000'000;
+  const size_t maxThreads = argc > 3 ? std::strtoull(argv[3], nullptr, 10)
+                                     : ForkJoinPool::defaultThreadCount();
+
+  std::mt19937 random{42};
+  std::vector<int> input(count);
+  for (int &value : input) {
+    value = static_cast<int>(random());
+  }
+
+  std::vector<int> arr = input;
+  const double sortSeconds =
+      seconds([&] { std::sort(arr.begin(), arr.end()); });
+  arr = input;
+  const double stableSortSeconds =
+      seconds([&] { std::stable_sort(arr.begin(), arr.end()); });
+
+  for (size_t threads = 1; threads < maxThreads; threads *= 2) {
+    measure(threads, n, input, sortSeconds, stableSortSeconds);
+  }
+  measure(maxThreads, n, input, sortSeconds, stableSortSeconds);
+
+  return 0;
+}
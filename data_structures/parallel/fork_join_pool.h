@@ -0,0 +1,347 @@
+#ifndef FORK_JOIN_POOL_H
+#define FORK_JOIN_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../deque/work_stealing_deque.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+/**
+ * Work-stealing pool for recursive, divide and conquer parallelism.
+ *
+ * invoke(f) runs f on the calling thread, which becomes a worker of the pool
+ * until f returns. Inside f - and inside everything it calls - join(a, b)
+ * runs a and b, possibly in parallel, and returns when both are done:
+ *
+ *   void sum(const int *data, size_t n, long long &result) {
+ *     if (n < 1000) { result = std::accumulate(data, data + n, 0LL); return; }
+ *     long long left, right;
+ *     ForkJoinPool::join([&] { sum(data, n / 2, left); },
+ *                        [&] { sum(data + n / 2, n - n / 2, right); });
+ *     result = left + right;
+ *   }
+ *
+ * join pushes b to the WorkStealingDeque of the current worker and runs a.
+ * Then it pops b back and runs it too, unless an idle worker stole it in the
+ * meantime; in that case it runs other tasks until b is done. A pool of
+ * size() N has N - 1 worker threads, like ThreadPool.
+ *
+ * Called outside of invoke, join runs a and then b on the calling thread.
+ * Calls of invoke from different threads run one at a time; invoke from
+ * inside a task calls f directly.
+ */
+class ForkJoinPool {
+ public:
+  struct Stats {
+    size_t tasksRun = 0;     // tasks forked by join, run by any thread
+    size_t steals = 0;       // of which taken from another worker
+    size_t failedSteals = 0; // steal attempts which found nothing
+  };
+
+  explicit ForkJoinPool(size_t threadCount = defaultThreadCount());
+
+  ForkJoinPool(const ForkJoinPool &) = delete;
+  ForkJoinPool &operator=(const ForkJoinPool &) = delete;
+
+  ~ForkJoinPool();
+
+  /**
+   * Returns the number of threads running the tasks, including the thread
+   * that calls invoke()
+   */
+  size_t size() const noexcept { return m_workers.size(); }
+
+  /**
+   * Runs f on the calling thread with the pool's workers available to the
+   * joins inside it, and returns its result.
+   */
+  template <typename F>
+  decltype(auto) invoke(F &&f);
+
+  /**
+   * Runs a and b, in parallel if a worker of the pool is free, and returns
+   * when both are done. If either throws, the exception is rethrown once both
+   * are done (that of a, if both throw).
+   */
+  template <typename A, typename B>
+  static void join(A &&a, B &&b);
+
+  /**
+   * Returns the counters summed over all workers since the pool was created
+   */
+  Stats stats() const;
+
+  /**
+   * Returns the number of hardware threads, at least 1
+   */
+  static size_t defaultThreadCount() {
+    return std::max<size_t>(1, std::thread::hardware_concurrency());
+  }
+
+ private:
+  // The second half of a join, living on the stack of the joining thread
+  struct Task {
+    void (*run)(Task *task);
+    std::exception_ptr error;
+    std::atomic<bool> done{false};
+  };
+
+  template <typename F>
+  struct TaskOf : Task {
+    explicit TaskOf(F &f) : function{f} {
+      this->run = [](Task *task) { static_cast<TaskOf *>(task)->function(); };
+    }
+
+    F &function;
+  };
+
+  struct alignas(64) Worker {
+    ForkJoinPool *pool;
+    size_t index;
+    WorkStealingDeque<Task *> deque;
+    std::uint32_t random;
+    std::atomic<size_t> tasksRun{0};
+    std::atomic<size_t> steals{0};
+    std::atomic<size_t> failedSteals{0};
+  };
+
+  void workerLoop(Worker &self);
+
+  // Runs a task of the own deque or a stolen one; false if there was none
+  bool runOneTask(Worker &self);
+  Task *trySteal(Worker &self);
+  static void execute(Worker &self, Task &task);
+
+  void wakeSleepers();
+  void sleep();
+
+  static Worker *&currentWorker() {
+    static thread_local Worker *current = nullptr;
+    return current;
+  }
+
+  static constexpr int IDLE_SPINS = 64;
+
+  std::vector<std::unique_ptr<Worker>> m_workers;  // the invoker's is first
+  std::vector<std::thread> m_threads;
+  std::mutex m_invokeMutex;  // lets only one invoke run at a time
+
+  std::mutex m_sleepMutex;
+  std::condition_variable m_wakeUp;
+  std::atomic<size_t> m_sleeping{0};
+  std::atomic<bool> m_stop{false};
+};
+
+/**
+ * Returns the pool shared by the parallel sorts, with one thread per hardware
+ * thread
+ */
+inline ForkJoinPool &defaultForkJoinPool() {
+  static ForkJoinPool pool;
+  return pool;
+}
+
+inline ForkJoinPool::ForkJoinPool(size_t threadCount) {
+  threadCount = std::max<size_t>(1, threadCount);
+  for (size_t i = 0; i < threadCount; i++) {
+    auto worker = std::make_unique<Worker>();
+    worker->pool = this;
+    worker->index = i;
+    worker->random = static_cast<std::uint32_t>(i * 2654435761u) | 1;
+    m_workers.push_back(std::move(worker));
+  }
+
+  for (size_t i = 1; i < threadCount; i++) {
+    m_threads.emplace_back([this, i] { workerLoop(*m_workers[i]); });
+  }
+}
+
+inline ForkJoinPool::~ForkJoinPool() {
+  m_stop.store(true);
+  {
+    std::lock_guard lock{m_sleepMutex};
+  }
+  m_wakeUp.notify_all();
+
+  for (std::thread &thread : m_threads) {
+    thread.join();
+  }
+}
+
+template <typename F>
+decltype(auto) ForkJoinPool::invoke(F &&f) {
+  if (currentWorker()) {
+    return std::forward<F>(f)();
+  }
+
+  std::lock_guard lock{m_invokeMutex};
+  Worker &self = *m_workers[0];
+  currentWorker() = &self;
+  struct Reset {
+    ~Reset() { currentWorker() = nullptr; }
+  } reset;
+
+  return std::forward<F>(f)();
+}
+
+template <typename A, typename B>
+void ForkJoinPool::join(A &&a, B &&b) {
+  Worker *self = currentWorker();
+  if (!self) {
+    a();
+    b();
+    return;
+  }
+
+  TaskOf<std::remove_reference_t<B>> task{b};
+  self->deque.push(&task);
+  self->pool->wakeSleepers();
+
+  std::exception_ptr error;
+  try {
+    a();
+  } catch (...) {
+    error = std::current_exception();
+  }
+
+  // Every join inside a has taken its own task back, so b is at the bottom
+  // of the deque - unless it was stolen, and then so was everything above.
+  if (std::optional<Task *> popped = self->deque.pop()) {
+    assert(*popped == &task);
+    execute(*self, task);
+  } else {
+    while (!task.done.load(std::memory_order_acquire)) {
+      if (!self->pool->runOneTask(*self)) {
+#if defined(__x86_64__) || defined(__i386__)
+        _mm_pause();
+#endif
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+  if (task.error) {
+    std::rethrow_exception(task.error);
+  }
+}
+
+inline ForkJoinPool::Stats ForkJoinPool::stats() const {
+  Stats result;
+  for (const auto &worker : m_workers) {
+    result.tasksRun += worker->tasksRun.load(std::memory_order_relaxed);
+    result.steals += worker->steals.load(std::memory_order_relaxed);
+    result.failedSteals +=
+        worker->failedSteals.load(std::memory_order_relaxed);
+  }
+
+  return result;
+}
+
+inline void ForkJoinPool::workerLoop(Worker &self) {
+  currentWorker() = &self;
+  int idle = 0;
+  while (!m_stop.load(std::memory_order_relaxed)) {
+    if (runOneTask(self)) {
+      idle = 0;
+    } else if (++idle < IDLE_SPINS) {
+      std::this_thread::yield();
+    } else {
+      sleep();
+      idle = 0;
+    }
+  }
+}
+
+inline bool ForkJoinPool::runOneTask(Worker &self) {
+  std::optional<Task *> own = self.deque.pop();
+  Task *task = own ? *own : trySteal(self);
+  if (!task) {
+    return false;
+  }
+
+  execute(self, *task);
+  return true;
+}
+
+inline ForkJoinPool::Task *ForkJoinPool::trySteal(Worker &self) {
+  if (m_workers.size() == 1) {
+    return nullptr;
+  }
+
+  // Visits every other worker once, starting from a random one
+  self.random ^= self.random << 13;
+  self.random ^= self.random >> 17;
+  self.random ^= self.random << 5;
+  const size_t start = self.random % m_workers.size();
+  for (size_t i = 0; i < m_workers.size(); i++) {
+    Worker &victim = *m_workers[(start + i) % m_workers.size()];
+    if (&victim == &self) {
+      continue;
+    }
+
+    if (std::optional<Task *> stolen = victim.deque.steal()) {
+      self.steals.fetch_add(1, std::memory_order_relaxed);
+      return *stolen;
+    }
+  }
+
+  self.failedSteals.fetch_add(1, std::memory_order_relaxed);
+  return nullptr;
+}
+
+inline void ForkJoinPool::execute(Worker &self, Task &task) {
+  try {
+    task.run(&task);
+  } catch (...) {
+    task.error = std::current_exception();
+  }
+
+  self.tasksRun.fetch_add(1, std::memory_order_relaxed);
+  // The joining thread may destroy the task right after this
+  task.done.store(true, std::memory_order_release);
+}
+
+inline void ForkJoinPool::wakeSleepers() {
+  if (m_sleeping.load(std::memory_order_seq_cst) > 0) {
+    m_wakeUp.notify_one();
+  }
+}
+
+inline void ForkJoinPool::sleep() {
+  std::unique_lock lock{m_sleepMutex};
+  m_sleeping.fetch_add(1, std::memory_order_seq_cst);
+
+  // A push which did not see the sleeper yet is found here. The timeout
+  // covers one which raced with this check.
+  bool workAvailable = false;
+  for (const auto &worker : m_workers) {
+    workAvailable = workAvailable || !worker->deque.empty();
+  }
+  if (!workAvailable && !m_stop.load()) {
+    m_wakeUp.wait_for(lock, std::chrono::milliseconds{1});
+  }
+
+  m_sleeping.fetch_sub(1, std::memory_order_relaxed);
+}
+
+#endif
@@ -0,0 +1,196 @@
+#ifndef HAZARD_POINTERS_H
+#define HAZARD_POINTERS_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+/**
+ * Safe memory reclamation for lock-free data structures with hazard
+ * pointers (M. Michael, 2004).
+ *
+ * A thread which is about to dereference a shared node publishes its address
+ * in one of its hazard slots with set(), then checks that the node is still
+ * reachable. A thread which unlinks a node passes it to retire() instead of
+ * deleting it; retired nodes are deleted in batches, skipping every node
+ * which some thread has published.
+ *
+ * Every thread gets SLOTS_PER_THREAD slots the first time it uses hazard
+ * pointers. When the thread exits, its slots are reused by later threads and
+ * the nodes it could not delete yet are handed over to the next scan.
+ */
+class HazardPointers {
+ public:
+  static constexpr size_t SLOTS_PER_THREAD = 2;
+
+  /**
+   * Publishes pointer in the given slot of the calling thread. The caller
+   * must then check that the pointer is still reachable before using it.
+   */
+  static void set(size_t slot, const void *pointer) {
+    threadState().record->hazards[slot].store(pointer,
+                                              std::memory_order_seq_cst);
+  }
+
+  /**
+   * Clears the given slot of the calling thread
+   */
+  static void clear(size_t slot) {
+    threadState().record->hazards[slot].store(nullptr,
+                                              std::memory_order_release);
+  }
+
+  /**
+   * Deletes pointer once no thread has it published. The pointer must
+   * already be unreachable for threads which did not publish it.
+   */
+  template <typename T>
+  static void retire(T *pointer) {
+    retire(pointer, [](void *p) { delete static_cast<T *>(p); });
+  }
+
+  static void retire(void *pointer, void (*deleter)(void *)) {
+    ThreadState &state = threadState();
+    state.retired.push_back({pointer, deleter});
+    if (state.retired.size() >= scanThreshold()) {
+      scan(state.retired);
+    }
+  }
+
+  /**
+   * Deletes the retired pointers of the calling thread which are not
+   * published by any thread
+   */
+  static void reclaim() { scan(threadState().retired); }
+
+ private:
+  struct alignas(64) Record {
+    std::atomic<const void *> hazards[SLOTS_PER_THREAD] = {};
+    std::atomic<bool> active{true};
+    Record *next = nullptr;
+  };
+
+  struct Retired {
+    void *pointer;
+    void (*deleter)(void *);
+  };
+
+  // Records are never freed, so scans can walk the list without locks
+  struct Domain {
+    std::atomic<Record *> records{nullptr};
+    std::atomic<size_t> recordCount{0};
+
+    std::mutex orphanMutex;
+    std::vector<Retired> orphans;
+    std::atomic<bool> hasOrphans{false};
+
+    ~Domain() {
+      // no thread uses hazard pointers any more
+      for (const Retired &retired : orphans) {
+        retired.deleter(retired.pointer);
+      }
+
+      Record *record = records.load();
+      while (record) {
+        delete std::exchange(record, record->next);
+      }
+    }
+  };
+
+  struct ThreadState {
+    Record *record = acquireRecord();
+    std::vector<Retired> retired;
+
+    ~ThreadState() {
+      for (auto &hazard : record->hazards) {
+        hazard.store(nullptr, std::memory_order_release);
+      }
+
+      scan(retired);
+      if (!retired.empty()) {
+        Domain &d = domain();
+        std::lock_guard<std::mutex> lock{d.orphanMutex};
+        d.orphans.insert(d.orphans.end(), retired.begin(), retired.end());
+        d.hasOrphans.store(true, std::memory_order_release);
+      }
+
+      record->active.store(false, std::memory_order_release);
+    }
+  };
+
+  static Domain &domain() {
+    static Domain instance;
+    return instance;
+  }
+
+  static ThreadState &threadState() {
+    static thread_local ThreadState state;
+    return state;
+  }
+
+  static Record *acquireRecord() {
+    Domain &d = domain();
+    for (Record *record = d.records.load(std::memory_order_acquire); record;
+         record = record->next) {
+      bool active = false;
+      if (!record->active.load(std::memory_order_relaxed) &&
+          record->active.compare_exchange_strong(active, true,
+                                                 std::memory_order_acquire)) {
+        return record;
+      }
+    }
+
+    auto *record = new Record;
+    record->next = d.records.load(std::memory_order_relaxed);
+    while (!d.records.compare_exchange_weak(record->next, record,
+                                            std::memory_order_release,
+                                            std::memory_order_relaxed)) {
+    }
+    d.recordCount.fetch_add(1, std::memory_order_relaxed);
+    return record;
+  }
+
+  // Scanning costs O(number of hazards), so it is done once the retired list
+  // is larger than that, which amortizes it to O(1) per retired pointer
+  static size_t scanThreshold() {
+    return 2 * SLOTS_PER_THREAD *
+               domain().recordCount.load(std::memory_order_relaxed) +
+           64;
+  }
+
+  static void scan(std::vector<Retired> &retired) {
+    Domain &d = domain();
+    if (d.hasOrphans.load(std::memory_order_acquire)) {
+      std::lock_guard<std::mutex> lock{d.orphanMutex};
+      retired.insert(retired.end(), d.orphans.begin(), d.orphans.end());
+      d.orphans.clear();
+      d.hasOrphans.store(false, std::memory_order_relaxed);
+    }
+
+    std::vector<const void *> hazards;
+    for (Record *record = d.records.load(std::memory_order_acquire); record;
+         record = record->next) {
+      for (const auto &hazard : record->hazards) {
+        if (const void *pointer = hazard.load(std::memory_order_seq_cst)) {
+          hazards.push_back(pointer);
+        }
+      }
+    }
+    std::sort(hazards.begin(), hazards.end());
+
+    auto stillHazardous = std::partition(
+        retired.begin(), retired.end(), [&hazards](const Retired &r) {
+          return std::binary_search(hazards.begin(), hazards.end(),
+                                    static_cast<const void *>(r.pointer));
+        });
+    for (auto it = stillHazardous; it != retired.end(); ++it) {
+      it->deleter(it->pointer);
+    }
+    retired.erase(stillHazardous, retired.end());
+  }
+};
+
+#endif
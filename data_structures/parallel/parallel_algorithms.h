@@ -0,0 +1,191 @@
+#ifndef PARALLEL_ALGORITHMS_H
+#define PARALLEL_ALGORITHMS_H
+
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "thread_pool.h"
+
+#if defined(__unix__)
+#include <unistd.h>
+#endif
+
+/*
+Data parallel algorithms over contiguous arrays - anything with size() and
+data(), such as DynamicArray<T>, SmallDynamicArray<T, N> and the double
+DynamicArray.
+
+The array is cut into chunks of about half the L2 cache, which are handed out
+to the threads of the pool one by one. Arrays of a single chunk are processed
+on the calling thread only. Chunks always start at a multiple of 64 elements,
+so for an array whose buffer is 64 byte aligned every chunk is as well.
+*/
+
+namespace parallel_detail {
+
+template <typename Array>
+using Element =
+    std::remove_reference_t<decltype(*std::declval<Array &>().data())>;
+
+/**
+ * Returns the size of the L2 cache of the CPU, or 1 MB if it is not known
+ */
+inline size_t l2CacheSize() {
+  static const size_t size = [] {
+#if defined(_SC_LEVEL2_CACHE_SIZE)
+    const long detected = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    if (detected > 0) {
+      return static_cast<size_t>(detected);
+    }
+#endif
+    return size_t{1024 * 1024};
+  }();
+
+  return size;
+}
+
+/**
+ * Returns the number of elements in a chunk when every element touches the
+ * given number of bytes
+ */
+inline size_t chunkSize(size_t bytesPerElement) {
+  const size_t CHUNK_ALIGNMENT = 64;
+  const size_t elements = l2CacheSize() / 2 / bytesPerElement;
+  return elements > CHUNK_ALIGNMENT
+             ? elements / CHUNK_ALIGNMENT * CHUNK_ALIGNMENT
+             : CHUNK_ALIGNMENT;
+}
+
+inline size_t chunkCount(size_t size, size_t bytesPerElement) {
+  const size_t chunk = chunkSize(bytesPerElement);
+  return (size + chunk - 1) / chunk;
+}
+
+/**
+ * Calls function(chunk, begin, end) for every chunk of [0, size) on the pool
+ */
+template <typename Function>
+void forEachChunk(size_t size, size_t bytesPerElement, ThreadPool &pool,
+                  Function &&function) {
+  const size_t chunk = chunkSize(bytesPerElement);
+  pool.run(chunkCount(size, bytesPerElement), [&](size_t index) {
+    const size_t begin = index * chunk;
+    const size_t end = begin + chunk < size ? begin + chunk : size;
+    function(index, begin, end);
+  });
+}
+
+}  // namespace parallel_detail
+
+/**
+ * Calls function(element) for every element of the array
+ */
+template <typename Array, typename Function>
+void parallel_for_each(Array &arr, Function function,
+                       ThreadPool &pool = defaultThreadPool()) {
+  using T = parallel_detail::Element<Array>;
+  auto *data = arr.data();
+  parallel_detail::forEachChunk(
+      arr.size(), sizeof(T), pool, [&](size_t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+          function(data[i]);
+        }
+      });
+}
+
+/**
+ * Sets out[i] = function(in[i]) for every element. in and out may be the same
+ * array. Throws exception if the arrays have different sizes.
+ * @throw std::invalid_argument
+ */
+template <typename InArray, typename OutArray, typename Function>
+void parallel_transform(const InArray &in, OutArray &out, Function function,
+                        ThreadPool &pool = defaultThreadPool()) {
+  if (in.size() != out.size()) {
+    throw std::invalid_argument{"Arrays have different sizes."};
+  }
+
+  using In = parallel_detail::Element<const InArray>;
+  using Out = parallel_detail::Element<OutArray>;
+  const auto *source = in.data();
+  auto *destination = out.data();
+  parallel_detail::forEachChunk(
+      in.size(), sizeof(In) + sizeof(Out), pool,
+      [&](size_t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+          destination[i] = function(source[i]);
+        }
+      });
+}
+
+/**
+ * Assigns value to every element of the array
+ */
+template <typename Array, typename T>
+void parallel_fill(Array &arr, const T &value,
+                   ThreadPool &pool = defaultThreadPool()) {
+  using Element = parallel_detail::Element<Array>;
+  auto *data = arr.data();
+  parallel_detail::forEachChunk(arr.size(), sizeof(Element), pool,
+                                [&](size_t, size_t begin, size_t end) {
+                                  for (size_t i = begin; i < end; i++) {
+                                    data[i] = value;
+                                  }
+                                });
+}
+
+/**
+ * Folds the elements of every chunk with reduceChunk(pointer, count) and then
+ * the results of the chunks, in order, with combine(accumulated, result),
+ * starting from init. Lets a chunk be reduced by a vectorized kernel, e.g.
+ * simd::sum for the double DynamicArray.
+ */
+template <typename Array, typename T, typename ReduceChunk, typename Combine>
+T parallel_reduce_chunks(const Array &arr, T init, ReduceChunk reduceChunk,
+                         Combine combine,
+                         ThreadPool &pool = defaultThreadPool()) {
+  using Element = parallel_detail::Element<const Array>;
+  using Result = std::invoke_result_t<ReduceChunk &, const Element *, size_t>;
+
+  std::vector<std::optional<Result>> results(
+      parallel_detail::chunkCount(arr.size(), sizeof(Element)));
+  const auto *data = arr.data();
+  parallel_detail::forEachChunk(
+      arr.size(), sizeof(Element), pool,
+      [&](size_t chunk, size_t begin, size_t end) {
+        results[chunk].emplace(reduceChunk(data + begin, end - begin));
+      });
+
+  for (std::optional<Result> &result : results) {
+    init = combine(std::move(init), std::move(*result));
+  }
+
+  return init;
+}
+
+/**
+ * Returns init combined with all elements of the array by op, which must be
+ * associative: the elements are folded per chunk and the chunk results are
+ * folded in order.
+ */
+template <typename Array, typename T, typename BinaryOp>
+T parallel_reduce(const Array &arr, T init, BinaryOp op,
+                  ThreadPool &pool = defaultThreadPool()) {
+  using Element = parallel_detail::Element<const Array>;
+  return parallel_reduce_chunks(
+      arr, std::move(init),
+      [&op](const Element *data, size_t count) {
+        T result = data[0];
+        for (size_t i = 1; i < count; i++) {
+          result = op(std::move(result), data[i]);
+        }
+        return result;
+      },
+      op, pool);
+}
+
+#endif
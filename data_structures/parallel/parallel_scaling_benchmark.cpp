@@ -0,0 +1,93 @@
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <string>
+
+#include "dynamic_array.h"
+#include "parallel_algorithms.h"
+
+/*
+Scaling of the parallel algorithms over the double DynamicArray from one
+thread up to the given number of threads (all hardware threads by default).
+
+For every thread count it reports the memory bandwidth of:
+- parallel_fill
+- parallel_reduce_chunks with the vectorized simd::sum per chunk
+- parallel_reduce with std::plus (a scalar loop per chunk)
+- parallel_transform from one array into another
+
+The default arrays (2 x 64M doubles, 1 GB) are far larger than the caches, so
+once enough threads are used the numbers level off at the memory bandwidth of
+the machine.
+
+Run:
+$> ./parallel_scaling_benchmark [number of elements] [maximum threads]
+*/
+
+namespace {
+
+template <typename Operation>
+double gigabytesPerSecond(size_t bytes, Operation operation) {
+  const int REPEATS = 5;
+  operation();  // warm up
+
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < REPEATS; i++) {
+    operation();
+  }
+  const auto end = std::chrono::steady_clock::now();
+
+  const double seconds = std::chrono::duration<double>(end - start).count();
+  return bytes * REPEATS / seconds / 1e9;
+}
+
+// keeps the compiler from dropping the reductions
+volatile double sink;
+
+void measure(size_t threads, DynamicArray &x, DynamicArray &y) {
+  ThreadPool pool{threads};
+  const size_t bytes = x.size() * sizeof(double);
+
+  const double fill =
+      gigabytesPerSecond(bytes, [&] { parallel_fill(x, 1.5, pool); });
+  const double simdSum = gigabytesPerSecond(bytes, [&] {
+    sink = parallel_reduce_chunks(
+        x, 0.0,
+        [](const double *data, size_t count) {
+          return simd::sum(data, count, Summation::Fast);
+        },
+        std::plus<>{}, pool);
+  });
+  const double scalarSum = gigabytesPerSecond(
+      bytes, [&] { sink = parallel_reduce(x, 0.0, std::plus<>{}, pool); });
+  const double transform = gigabytesPerSecond(2 * bytes, [&] {
+    parallel_transform(
+        x, y, [](double value) { return 2 * value + 1; }, pool);
+  });
+
+  std::cout << threads << " threads\n"
+            << "  fill: " << fill << " GB/s\n"
+            << "  sum (SIMD chunks): " << simdSum << " GB/s\n"
+            << "  sum (std::plus): " << scalarSum << " GB/s\n"
+            << "  transform: " << transform << " GB/s\n";
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  const size_t count =
+      argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 64'000'000;
+  const size_t maxThreads = argc > 2 ? std::strtoull(argv[2], nullptr, 10)
+                                     : ThreadPool::defaultThreadCount();
+
+  DynamicArray x{count};
+  DynamicArray y{count};
+
+  for (size_t threads = 1; threads < maxThreads; threads *= 2) {
+    measure(threads, x, y);
+  }
+  measure(maxThreads, x, y);
+
+  return 0;
+}
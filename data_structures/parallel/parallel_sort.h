@@ -0,0 +1,107 @@
+#ifndef PARALLEL_SORT_H
+#define PARALLEL_SORT_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "fork_join_pool.h"
+
+/*
+Recursive sorts of contiguous arrays - anything with size() and data() - on a
+ForkJoinPool. Each recursion step joins its two halves, so idle workers steal
+the largest unsorted parts first, and ranges below SEQUENTIAL_SORT_CUTOFF
+elements are sorted on the thread which reaches them.
+*/
+
+namespace parallel_sort_detail {
+
+// Below this many elements forking costs more than it can save
+inline constexpr size_t SEQUENTIAL_SORT_CUTOFF = 4096;
+
+template <typename T, typename Compare>
+void quicksort(T *first, T *last, Compare &comp) {
+  const size_t size = static_cast<size_t>(last - first);
+  if (size < SEQUENTIAL_SORT_CUTOFF) {
+    std::sort(first, last, comp);
+    return;
+  }
+
+  // Median of three pivot, then a three-way partition: elements equal to the
+  // pivot are not touched again, so many duplicates do not make it quadratic
+  T *middle = first + size / 2;
+  T *back = last - 1;
+  if (comp(*middle, *first)) {
+    std::iter_swap(middle, first);
+  }
+  if (comp(*back, *middle)) {
+    std::iter_swap(back, middle);
+    if (comp(*middle, *first)) {
+      std::iter_swap(middle, first);
+    }
+  }
+  const T pivot = *middle;
+
+  T *lessEnd = std::partition(
+      first, last, [&](const T &elem) { return comp(elem, pivot); });
+  T *equalEnd = std::partition(
+      lessEnd, last, [&](const T &elem) { return !comp(pivot, elem); });
+
+  ForkJoinPool::join([&] { quicksort(first, lessEnd, comp); },
+                     [&] { quicksort(equalEnd, last, comp); });
+}
+
+template <typename T, typename Compare>
+void mergeSort(T *data, T *buffer, size_t size, Compare &comp) {
+  if (size < SEQUENTIAL_SORT_CUTOFF) {
+    std::stable_sort(data, data + size, comp);
+    return;
+  }
+
+  const size_t middle = size / 2;
+  ForkJoinPool::join(
+      [&] { mergeSort(data, buffer, middle, comp); },
+      [&] { mergeSort(data + middle, buffer + middle, size - middle, comp); });
+
+  std::merge(std::make_move_iterator(data),
+             std::make_move_iterator(data + middle),
+             std::make_move_iterator(data + middle),
+             std::make_move_iterator(data + size), buffer, comp);
+  std::move(buffer, buffer + size, data);
+}
+
+}  // namespace parallel_sort_detail
+
+/**
+ * Sorts the array with quicksort; equal elements may be reordered
+ */
+template <typename Array, typename Compare = std::less<>>
+void parallel_quicksort(Array &arr, Compare comp = {},
+                        ForkJoinPool &pool = defaultForkJoinPool()) {
+  auto *data = arr.data();
+  pool.invoke([&] {
+    parallel_sort_detail::quicksort(data, data + arr.size(), comp);
+  });
+}
+
+/**
+ * Sorts the array with merge sort, keeping the order of equal elements. Uses
+ * a buffer of the same size as the array, so the elements must be default
+ * constructible.
+ */
+template <typename Array, typename Compare = std::less<>>
+void parallel_merge_sort(Array &arr, Compare comp = {},
+                         ForkJoinPool &pool = defaultForkJoinPool()) {
+  using T = std::remove_reference_t<decltype(*arr.data())>;
+  std::vector<T> buffer(arr.size());
+  auto *data = arr.data();
+  pool.invoke([&] {
+    parallel_sort_detail::mergeSort(data, buffer.data(), arr.size(), comp);
+  });
+}
+
+#endif
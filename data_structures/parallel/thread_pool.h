@@ -0,0 +1,191 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Fixed set of threads running data parallel jobs.
+ *
+ * run(taskCount, task) calls task(i) for every i in [0, taskCount) and
+ * returns when all calls are done. The calling thread takes part in the work,
+ * so a pool of size() N has N - 1 worker threads. Tasks are claimed one by
+ * one from a shared counter, which balances chunks that take different time.
+ *
+ * Jobs run one at a time. A run() call made from inside a task runs its tasks
+ * inline on the calling thread instead of waiting for the busy pool.
+ */
+class ThreadPool {
+ public:
+  explicit ThreadPool(size_t threadCount = defaultThreadCount());
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  ~ThreadPool();
+
+  /**
+   * Returns the number of threads running the tasks, including the thread
+   * that calls run()
+   */
+  size_t size() const noexcept { return m_workers.size() + 1; }
+
+  /**
+   * Calls task(i) for every i in [0, taskCount) on the threads of the pool.
+   * If tasks throw, the first exception is rethrown once all tasks are done.
+   */
+  template <typename Task>
+  void run(size_t taskCount, Task &&task);
+
+  /**
+   * Returns the number of hardware threads, at least 1
+   */
+  static size_t defaultThreadCount() {
+    return std::max<size_t>(1, std::thread::hardware_concurrency());
+  }
+
+ private:
+  struct Job {
+    void (*invoke)(void *task, size_t index);
+    void *task;
+    size_t taskCount;
+    std::atomic<size_t> next{0};
+    size_t activeWorkers = 0;  // guarded by m_mutex
+    std::mutex errorMutex;
+    std::exception_ptr error;
+  };
+
+  void workerLoop();
+  static void execute(Job &job);
+
+  static bool &insideTask() {
+    static thread_local bool inside = false;
+    return inside;
+  }
+
+  std::vector<std::thread> m_workers;
+  std::mutex m_runMutex;  // lets only one job run at a time
+  std::mutex m_mutex;
+  std::condition_variable m_jobAvailable;
+  std::condition_variable m_workersDone;
+  Job *m_job = nullptr;
+  size_t m_generation = 0;
+  bool m_stop = false;
+};
+
+/**
+ * Returns the pool shared by the parallel algorithms, with one thread per
+ * hardware thread
+ */
+inline ThreadPool &defaultThreadPool() {
+  static ThreadPool pool;
+  return pool;
+}
+
+inline ThreadPool::ThreadPool(size_t threadCount) {
+  for (size_t i = 1; i < threadCount; i++) {
+    m_workers.emplace_back([this] { workerLoop(); });
+  }
+}
+
+inline ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard lock{m_mutex};
+    m_stop = true;
+  }
+  m_jobAvailable.notify_all();
+
+  for (std::thread &worker : m_workers) {
+    worker.join();
+  }
+}
+
+template <typename Task>
+void ThreadPool::run(size_t taskCount, Task &&task) {
+  if (m_workers.empty() || taskCount <= 1 || insideTask()) {
+    for (size_t i = 0; i < taskCount; i++) {
+      task(i);
+    }
+    return;
+  }
+
+  using TaskType = std::remove_reference_t<Task>;
+  Job job;
+  job.invoke = [](void *function, size_t index) {
+    (*static_cast<TaskType *>(function))(index);
+  };
+  job.task = const_cast<void *>(static_cast<const void *>(&task));
+  job.taskCount = taskCount;
+
+  std::lock_guard runLock{m_runMutex};
+  {
+    std::lock_guard lock{m_mutex};
+    m_job = &job;
+    ++m_generation;
+  }
+  m_jobAvailable.notify_all();
+
+  execute(job);
+
+  {
+    // no worker may pick the job up from now on; wait for the ones that did
+    std::unique_lock lock{m_mutex};
+    m_job = nullptr;
+    m_workersDone.wait(lock, [&job] { return job.activeWorkers == 0; });
+  }
+
+  if (job.error) {
+    std::rethrow_exception(job.error);
+  }
+}
+
+inline void ThreadPool::workerLoop() {
+  size_t seenGeneration = 0;
+  std::unique_lock lock{m_mutex};
+  while (true) {
+    m_jobAvailable.wait(lock, [this, &seenGeneration] {
+      return m_stop || (m_job && m_generation != seenGeneration);
+    });
+    if (m_stop) {
+      return;
+    }
+
+    seenGeneration = m_generation;
+    Job &job = *m_job;
+    ++job.activeWorkers;
+
+    lock.unlock();
+    execute(job);
+    lock.lock();
+
+    if (--job.activeWorkers == 0) {
+      m_workersDone.notify_all();
+    }
+  }
+}
+
+inline void ThreadPool::execute(Job &job) {
+  insideTask() = true;
+  for (size_t i = job.next.fetch_add(1, std::memory_order_relaxed);
+       i < job.taskCount;
+       i = job.next.fetch_add(1, std::memory_order_relaxed)) {
+    try {
+      job.invoke(job.task, i);
+    } catch (...) {
+      std::lock_guard lock{job.errorMutex};
+      if (!job.error) {
+        job.error = std::current_exception();
+      }
+    }
+  }
+  insideTask() = false;
+}
+
+#endif
@@ -0,0 +1,318 @@
+#include "catch.hpp"
+#include "fork_join_pool.h"
+#include "hazard_pointers.h"
+#include "parallel_algorithms.h"
+#include "parallel_sort.h"
+#include "thread_pool.h"
+#include "../dynamic_array_template/dynamic_array.h"
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+TEST_CASE("Thread pool runs every task exactly once") {
+  ThreadPool pool{4};
+  REQUIRE(pool.size() == 4);
+
+  std::vector<std::atomic<int>> calls(10'000);
+  pool.run(calls.size(), [&calls](size_t i) { ++calls[i]; });
+
+  for (std::atomic<int> &count : calls) {
+    REQUIRE(count == 1);
+  }
+}
+
+TEST_CASE("Thread pool of size one runs the tasks on the calling thread") {
+  ThreadPool pool{1};
+  REQUIRE(pool.size() == 1);
+
+  const std::thread::id caller = std::this_thread::get_id();
+  bool sameThread = true;
+  pool.run(100, [&](size_t) {
+    sameThread = sameThread && std::this_thread::get_id() == caller;
+  });
+  REQUIRE(sameThread);
+}
+
+TEST_CASE("Thread pool can run many jobs in a row") {
+  ThreadPool pool{3};
+  std::atomic<size_t> total = 0;
+  for (int job = 0; job < 1000; job++) {
+    pool.run(7, [&total](size_t i) { total += i; });
+  }
+
+  REQUIRE(total == 1000 * 21);
+}
+
+TEST_CASE("Thread pool rethrows an exception thrown by a task") {
+  ThreadPool pool{4};
+  std::atomic<int> calls = 0;
+  REQUIRE_THROWS_AS(pool.run(100,
+                             [&calls](size_t i) {
+                               ++calls;
+                               if (i == 50) {
+                                 throw std::runtime_error{"task failed"};
+                               }
+                             }),
+                    std::runtime_error);
+
+  // the other tasks still ran and the pool is still usable
+  REQUIRE(calls == 100);
+  pool.run(10, [&calls](size_t) { ++calls; });
+  REQUIRE(calls == 110);
+}
+
+TEST_CASE("Thread pool runs nested jobs inline") {
+  ThreadPool pool{4};
+  std::atomic<int> calls = 0;
+  pool.run(8, [&](size_t) { pool.run(8, [&calls](size_t) { ++calls; }); });
+  REQUIRE(calls == 64);
+}
+
+TEST_CASE("Parallel fill and for each visit every element") {
+  ThreadPool pool{4};
+  DynamicArray<long long> arr{1'000'003};
+
+  parallel_fill(arr, 3, pool);
+  parallel_for_each(arr, [](long long &value) { value *= 2; }, pool);
+
+  for (size_t i = 0; i < arr.size(); i++) {
+    REQUIRE(arr[i] == 6);
+  }
+}
+
+TEST_CASE("Parallel transform writes every element of the output") {
+  ThreadPool pool{4};
+  DynamicArray<int> in{500'001};
+  for (size_t i = 0; i < in.size(); i++) {
+    in[i] = static_cast<int>(i);
+  }
+
+  DynamicArray<std::string> out{in.size()};
+  parallel_transform(
+      in, out, [](int value) { return std::to_string(value); }, pool);
+  for (size_t i = 0; i < in.size(); i++) {
+    REQUIRE(out[i] == std::to_string(i));
+  }
+
+  // in place
+  parallel_transform(in, in, [](int value) { return -value; }, pool);
+  REQUIRE(in[500'000] == -500'000);
+}
+
+TEST_CASE("Parallel transform requires arrays of equal size") {
+  DynamicArray<int> in{10};
+  DynamicArray<int> out{11};
+  auto identity = [](int value) { return value; };
+  REQUIRE_THROWS_AS(parallel_transform(in, out, identity),
+                    std::invalid_argument);
+}
+
+TEST_CASE("Parallel reduce matches a sequential sum") {
+  ThreadPool pool{4};
+  DynamicArray<long long> arr;
+  long long expected = 0;
+  for (long long i = 0; i < 2'000'000; i++) {
+    arr.push_back(i % 1000);
+    expected += i % 1000;
+  }
+
+  REQUIRE(parallel_reduce(arr, 0LL, std::plus<>{}, pool) == expected);
+  REQUIRE(parallel_reduce(arr, 5LL, std::plus<>{}, pool) == expected + 5);
+}
+
+TEST_CASE("Parallel reduce keeps the order of the elements") {
+  ThreadPool pool{4};
+  DynamicArray<std::string> arr;
+  std::string expected;
+  for (int i = 0; i < 200'000; i++) {
+    arr.push_back(std::string(1, static_cast<char>('a' + i % 26)));
+    expected += arr.back();
+  }
+
+  // concatenation is associative but not commutative
+  REQUIRE(parallel_reduce(arr, std::string{}, std::plus<>{}, pool) ==
+          expected);
+}
+
+TEST_CASE("Parallel reduce of an empty array returns the initial value") {
+  DynamicArray<int> arr;
+  REQUIRE(parallel_reduce(arr, 42, std::plus<>{}) == 42);
+}
+
+TEST_CASE("Parallel reduce of chunks hands every element to one chunk") {
+  ThreadPool pool{4};
+  DynamicArray<int> arr{300'000};
+  for (size_t i = 0; i < arr.size(); i++) {
+    arr[i] = 1;
+  }
+
+  const size_t count = parallel_reduce_chunks(
+      arr, size_t{0},
+      [](const int *data, size_t count) {
+        size_t ones = 0;
+        for (size_t i = 0; i < count; i++) {
+          ones += data[i];
+        }
+        return ones;
+      },
+      std::plus<>{}, pool);
+  REQUIRE(count == arr.size());
+}
+
+namespace {
+
+struct Tracked {
+  explicit Tracked(bool &deleted) : m_deleted{deleted} {}
+  ~Tracked() { m_deleted = true; }
+
+  bool &m_deleted;
+};
+
+}  // namespace
+
+TEST_CASE("Hazard pointers keep a retired pointer until it is cleared") {
+  bool deleted = false;
+  auto *tracked = new Tracked{deleted};
+
+  HazardPointers::set(0, tracked);
+  HazardPointers::retire(tracked);
+  HazardPointers::reclaim();
+  REQUIRE(!deleted);
+
+  HazardPointers::clear(0);
+  HazardPointers::reclaim();
+  REQUIRE(deleted);
+}
+
+TEST_CASE("Hazard pointers reclaim what an exited thread had retired") {
+  bool deleted = false;
+  auto *tracked = new Tracked{deleted};
+  HazardPointers::set(1, tracked);
+
+  // the thread cannot delete tracked before it exits, so it leaves it behind
+  std::thread{[tracked] { HazardPointers::retire(tracked); }}.join();
+  REQUIRE(!deleted);
+
+  HazardPointers::clear(1);
+  HazardPointers::reclaim();
+  REQUIRE(deleted);
+}
+
+namespace {
+
+long long fibonacci(int n) {
+  if (n < 2) {
+    return n;
+  }
+
+  long long a, b;
+  ForkJoinPool::join([&] { a = fibonacci(n - 1); },
+                     [&] { b = fibonacci(n - 2); });
+  return a + b;
+}
+
+}  // namespace
+
+TEST_CASE("Fork join pool runs both halves of every join") {
+  // fibonacci(20) joins 10945 times, forking one task each time
+  const size_t JOINS = 10945;
+
+  SECTION("Outside of a pool") { REQUIRE(fibonacci(20) == 6765); }
+
+  SECTION("In a pool of one thread") {
+    ForkJoinPool pool{1};
+    REQUIRE(pool.invoke([] { return fibonacci(20); }) == 6765);
+    REQUIRE(pool.stats().tasksRun == JOINS);
+    REQUIRE(pool.stats().steals == 0);
+  }
+
+  SECTION("In a pool of four threads") {
+    ForkJoinPool pool{4};
+    REQUIRE(pool.size() == 4);
+    for (int i = 0; i < 10; i++) {
+      REQUIRE(pool.invoke([] { return fibonacci(20); }) == 6765);
+    }
+    REQUIRE(pool.stats().tasksRun == 10 * JOINS);
+  }
+}
+
+TEST_CASE("Fork join pool rethrows an exception after both halves ran") {
+  ForkJoinPool pool{4};
+  std::atomic<int> finished = 0;
+  auto work = [&finished] {
+    long long result = fibonacci(15);
+    ++finished;
+    return result;
+  };
+
+  REQUIRE_THROWS_AS(pool.invoke([&] {
+    ForkJoinPool::join([&] { throw std::runtime_error{"first"}; }, work);
+  }),
+                    std::runtime_error);
+  REQUIRE(finished == 1);
+
+  REQUIRE_THROWS_WITH(pool.invoke([&] {
+    ForkJoinPool::join(work, [] { throw std::logic_error{"second"}; });
+  }),
+                      "second");
+  REQUIRE(finished == 2);
+
+  // the pool is still usable
+  REQUIRE(pool.invoke([] { return fibonacci(15); }) == 610);
+}
+
+TEST_CASE("Fork join pool runs a nested invoke inline") {
+  ForkJoinPool pool{4};
+  REQUIRE(pool.invoke([&pool] {
+    return pool.invoke([] { return fibonacci(10); });
+  }) == 55);
+}
+
+TEST_CASE("Parallel quicksort and merge sort match std::sort") {
+  ForkJoinPool pool{4};
+  std::mt19937 random{42};
+  // Few distinct values, so that many elements are equal to the pivot
+  std::uniform_int_distribution<int> values{0, 999};
+
+  for (size_t size : {0, 1, 100, 100'000}) {
+    DynamicArray<int> arr{size};
+    for (size_t i = 0; i < size; i++) {
+      arr[i] = values(random);
+    }
+    std::vector<int> expected(arr.begin(), arr.end());
+    std::sort(expected.begin(), expected.end());
+
+    DynamicArray<int> quick = arr;
+    parallel_quicksort(quick, std::less<>{}, pool);
+    REQUIRE(std::equal(quick.begin(), quick.end(), expected.begin(),
+                       expected.end()));
+
+    DynamicArray<int> merged = arr;
+    parallel_merge_sort(merged, std::less<>{}, pool);
+    REQUIRE(std::equal(merged.begin(), merged.end(), expected.begin(),
+                       expected.end()));
+
+    parallel_quicksort(quick, std::greater<>{}, pool);
+    REQUIRE(std::equal(quick.begin(), quick.end(), expected.rbegin(),
+                       expected.rend()));
+  }
+}
+
+TEST_CASE("Parallel merge sort keeps the order of equal elements") {
+  ForkJoinPool pool{4};
+  std::vector<std::pair<int, int>> pairs;
+  for (int i = 0; i < 50'000; i++) {
+    pairs.emplace_back((i * 7919) % 100, i);
+  }
+
+  parallel_merge_sort(
+      pairs, [](const auto &a, const auto &b) { return a.first < b.first; },
+      pool);
+  REQUIRE(std::is_sorted(pairs.begin(), pairs.end()));
+}
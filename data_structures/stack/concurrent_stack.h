@@ -0,0 +1,266 @@
+#ifndef CONCURRENT_STACK_H
+#define CONCURRENT_STACK_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#include "../parallel/hazard_pointers.h"
+
+/**
+ * Lock-free stack which any number of threads can push to and pop from at
+ * the same time (Treiber stack).
+ *
+ * The elements are kept in a linked list, whose head is replaced with a
+ * compare-and-swap. Popped nodes are retired to HazardPointers, so a thread
+ * which is still reading a node it lost the race for never reads freed
+ * memory. The head also carries a 16 bit tag, incremented on every change,
+ * which protects the compare-and-swap from ABA.
+ *
+ * Under contention the compare-and-swap on the head fails often. A push
+ * whose compare-and-swap failed offers its node in a slot of an elimination
+ * array for a while, and a pop whose compare-and-swap failed looks for an
+ * offer there. A push and a pop which meet cancel out without touching the
+ * head at all. The pop leaves a TAKEN mark in the slot, which only the
+ * offering push clears, so the slot cannot hold a new offer of a node at the
+ * same address before that push has seen its own offer taken (ABA).
+ *
+ * There is no top(): the top element may be popped by another thread right
+ * after it is read, so pop() returns the element instead. Neither is there a
+ * size(), which would be stale by the time it is returned.
+ */
+template <typename T>
+class ConcurrentStack {
+ public:
+  ConcurrentStack() = default;
+
+  ConcurrentStack(const ConcurrentStack &) = delete;
+  ConcurrentStack &operator=(const ConcurrentStack &) = delete;
+
+  /**
+   * Destroys the remaining elements. No other thread may use the stack.
+   */
+  ~ConcurrentStack();
+
+  void push(const T &newElem);
+  void push(T &&newElem);
+
+  /**
+   * Constructs a new element in place on the top of the stack from the given
+   * arguments
+   */
+  template <typename... Args>
+  void emplace(Args &&...args);
+
+  /**
+   * Removes the top element and returns it, or returns std::nullopt if the
+   * stack is empty
+   */
+  std::optional<T> pop();
+
+  /**
+   * Returns whether the stack is empty of elements or not, at the time of
+   * the call
+   */
+  bool empty() const;
+
+ private:
+  struct Node {
+    T value;
+    Node *next;
+  };
+
+  // A node pointer in the low 48 bits and the tag in the high 16 bits.
+  // User space addresses are 48 bits wide on x86-64 and AArch64.
+  using TaggedPointer = std::uint64_t;
+  static_assert(sizeof(void *) == 8, "Tagged pointers need 64 bit pointers.");
+
+  static constexpr int TAG_SHIFT = 48;
+  static constexpr TaggedPointer POINTER_MASK =
+      (TaggedPointer{1} << TAG_SHIFT) - 1;
+
+  static Node *pointerOf(TaggedPointer tagged) {
+    return reinterpret_cast<Node *>(tagged & POINTER_MASK);
+  }
+
+  static TaggedPointer retag(Node *node, TaggedPointer previous) {
+    const TaggedPointer tag = (previous >> TAG_SHIFT) + 1;
+    return (tag << TAG_SHIFT) | reinterpret_cast<TaggedPointer>(node);
+  }
+
+  void pushNode(Node *node);
+
+  // Offers node to a pop in a random elimination slot. Returns whether a pop
+  // took it; otherwise node is still owned by the caller.
+  bool tryEliminatePush(Node *node);
+
+  // Takes a node offered by a push, or returns nullptr
+  Node *tryEliminatePop();
+
+  // Marks a slot whose offer a pop took, until the offering push empties it;
+  // never the address of a node
+  static Node *taken() { return reinterpret_cast<Node *>(std::uintptr_t{1}); }
+
+  static size_t randomSlot();
+
+  static constexpr size_t ELIMINATION_SLOTS = 16;
+  static constexpr int ELIMINATION_SPINS = 64;
+
+  // Each in its own cache line, so that pairs meeting in different slots do
+  // not slow each other down
+  struct alignas(64) EliminationSlot {
+    std::atomic<Node *> offer{nullptr};
+  };
+
+  alignas(64) std::atomic<TaggedPointer> m_head{0};
+  EliminationSlot m_elimination[ELIMINATION_SLOTS];
+};
+
+template <typename T>
+ConcurrentStack<T>::~ConcurrentStack() {
+  Node *node = pointerOf(m_head.load(std::memory_order_relaxed));
+  while (node) {
+    delete std::exchange(node, node->next);
+  }
+}
+
+template <typename T>
+void ConcurrentStack<T>::push(const T &newElem) {
+  emplace(newElem);
+}
+
+template <typename T>
+void ConcurrentStack<T>::push(T &&newElem) {
+  emplace(std::move(newElem));
+}
+
+template <typename T>
+template <typename... Args>
+void ConcurrentStack<T>::emplace(Args &&...args) {
+  pushNode(new Node{T(std::forward<Args>(args)...), nullptr});
+}
+
+template <typename T>
+void ConcurrentStack<T>::pushNode(Node *node) {
+  TaggedPointer head = m_head.load(std::memory_order_relaxed);
+  while (true) {
+    node->next = pointerOf(head);
+    if (m_head.compare_exchange_weak(head, retag(node, head),
+                                     std::memory_order_release,
+                                     std::memory_order_relaxed)) {
+      return;
+    }
+
+    if (tryEliminatePush(node)) {
+      return;
+    }
+    head = m_head.load(std::memory_order_relaxed);
+  }
+}
+
+template <typename T>
+std::optional<T> ConcurrentStack<T>::pop() {
+  while (true) {
+    TaggedPointer head = m_head.load(std::memory_order_acquire);
+    Node *node = pointerOf(head);
+    if (!node) {
+      return std::nullopt;
+    }
+
+    // Once published, node cannot be freed. It must be checked to still be
+    // the head afterwards, as it could have been freed before publishing.
+    HazardPointers::set(0, node);
+    if (m_head.load(std::memory_order_seq_cst) != head) {
+      continue;
+    }
+
+    if (m_head.compare_exchange_strong(head, retag(node->next, head),
+                                       std::memory_order_acquire,
+                                       std::memory_order_relaxed)) {
+      HazardPointers::clear(0);
+      std::optional<T> result{std::move(node->value)};
+      HazardPointers::retire(node);
+      return result;
+    }
+
+    HazardPointers::clear(0);
+    if (Node *offered = tryEliminatePop()) {
+      // an offered node was never in the list, so nobody else can read it
+      std::optional<T> result{std::move(offered->value)};
+      delete offered;
+      return result;
+    }
+  }
+}
+
+template <typename T>
+bool ConcurrentStack<T>::empty() const {
+  return pointerOf(m_head.load(std::memory_order_acquire)) == nullptr;
+}
+
+template <typename T>
+bool ConcurrentStack<T>::tryEliminatePush(Node *node) {
+  std::atomic<Node *> &offer = m_elimination[randomSlot()].offer;
+  Node *expected = nullptr;
+  if (!offer.compare_exchange_strong(expected, node,
+                                     std::memory_order_release,
+                                     std::memory_order_relaxed)) {
+    return false;
+  }
+
+  for (int i = 0; i < ELIMINATION_SPINS; i++) {
+    if (offer.load(std::memory_order_acquire) == taken()) {
+      offer.store(nullptr, std::memory_order_release);
+      return true;
+    }
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#endif
+  }
+
+  // Withdraw the offer, unless a pop took it in the meantime. Nobody but
+  // this push can replace the offer or the TAKEN mark, so expected fails
+  // only on TAKEN.
+  expected = node;
+  if (offer.compare_exchange_strong(expected, nullptr,
+                                    std::memory_order_acq_rel,
+                                    std::memory_order_acquire)) {
+    return false;
+  }
+
+  offer.store(nullptr, std::memory_order_release);
+  return true;
+}
+
+template <typename T>
+typename ConcurrentStack<T>::Node *ConcurrentStack<T>::tryEliminatePop() {
+  std::atomic<Node *> &offer = m_elimination[randomSlot()].offer;
+  Node *node = offer.load(std::memory_order_acquire);
+  if (node && node != taken() &&
+      offer.compare_exchange_strong(node, taken(), std::memory_order_acq_rel,
+                                    std::memory_order_relaxed)) {
+    return node;
+  }
+
+  return nullptr;
+}
+
+template <typename T>
+size_t ConcurrentStack<T>::randomSlot() {
+  // xorshift, seeded differently in every thread
+  static thread_local std::uint32_t state =
+      static_cast<std::uint32_t>(reinterpret_cast<std::uintptr_t>(&state)) |
+      1;
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return state % ELIMINATION_SLOTS;
+}
+
+#endif
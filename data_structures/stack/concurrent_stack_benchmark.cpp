@@ -0,0 +1,124 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "concurrent_stack.h"
+#include "stack_dynamic_array.h"
+
+/*
+A stack of work items shared between threads, each of which pops an item and
+pushes a new one:
+- StackDynamicArrayImpl, with push and top + pop under a std::mutex
+- ConcurrentStack, lock-free, with an elimination array
+
+Every thread starts with a few pushes and then alternates pop and push, so
+the stack stays small and all threads fight over its top. The number of
+operations stays the same, it is split between 1, 2, 4, ... up to the given
+number of threads (64 by default).
+
+Run:
+$> ./concurrent_stack_benchmark [number of operations] [maximum threads]
+*/
+
+namespace {
+
+class LockedStack {
+ public:
+  void push(long long value) {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_stack.push(value);
+  }
+
+  std::optional<long long> pop() {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    if (m_stack.empty()) {
+      return std::nullopt;
+    }
+
+    const long long value = m_stack.top();
+    m_stack.pop();
+    return value;
+  }
+
+ private:
+  std::mutex m_mutex;
+  StackDynamicArrayImpl<long long> m_stack;
+};
+
+constexpr int INITIAL_ITEMS_PER_THREAD = 4;
+
+// Millions of operations per second, each thread doing its share of count
+template <typename StackType>
+double operationsPerSecond(size_t count, size_t threadCount) {
+  StackType stack;
+  std::vector<std::thread> threads;
+  std::vector<long long> sums(threadCount);
+
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t t = 0; t < threadCount; t++) {
+    threads.emplace_back([&stack, &sums, t, count, threadCount] {
+      for (int i = 0; i < INITIAL_ITEMS_PER_THREAD; i++) {
+        stack.push(1);
+      }
+
+      const size_t pairs = count / threadCount / 2;
+      long long sum = 0;
+      for (size_t i = 0; i < pairs; i++) {
+        if (std::optional<long long> item = stack.pop()) {
+          sum += *item;
+        }
+        stack.push(1);
+      }
+      sums[t] = sum;
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  const auto end = std::chrono::steady_clock::now();
+
+  // every push adds one item and every successful pop removes one
+  long long items = 0;
+  while (std::optional<long long> item = stack.pop()) {
+    items += *item;
+  }
+  long long popped = 0;
+  for (long long sum : sums) {
+    popped += sum;
+  }
+  const size_t pushed =
+      threadCount * (INITIAL_ITEMS_PER_THREAD + count / threadCount / 2);
+  if (static_cast<size_t>(items + popped) != pushed) {
+    std::cerr << "lost items: " << items + popped << " of " << pushed << "\n";
+    std::exit(1);
+  }
+
+  const double seconds = std::chrono::duration<double>(end - start).count();
+  return count / seconds / 1e6;
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  const size_t count =
+      argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+  const size_t maxThreads =
+      argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 64;
+
+  for (size_t threads = 1; threads <= maxThreads; threads *= 2) {
+    std::cout << threads << " threads\n"
+              << "  StackDynamicArrayImpl + mutex: "
+              << operationsPerSecond<LockedStack>(count, threads)
+              << " M operations/s\n"
+              << "  ConcurrentStack: "
+              << operationsPerSecond<ConcurrentStack<long long>>(count,
+                                                                 threads)
+              << " M operations/s\n";
+  }
+
+  return 0;
+}
@@ -0,0 +1,220 @@
+#ifndef FIXED_CAPACITY_ARRAY_H
+#define FIXED_CAPACITY_ARRAY_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+/**
+ * Array of at most Capacity elements, all stored inside the object. It never
+ * allocates; appending to a full array throws exception. Has the back end of
+ * the interface of DynamicArray, so it can be used as storage of a Stack.
+ *
+ * @tparam Capacity Maximum number of elements
+ */
+template <typename T, size_t Capacity>
+class FixedCapacityArray {
+  static_assert(Capacity > 0, "Capacity must be positive.");
+
+ public:
+  FixedCapacityArray() = default;
+  FixedCapacityArray(const FixedCapacityArray &);
+  FixedCapacityArray(FixedCapacityArray &&) noexcept(
+      std::is_nothrow_move_constructible_v<T>);
+  FixedCapacityArray &operator=(const FixedCapacityArray &);
+  FixedCapacityArray &operator=(FixedCapacityArray &&) noexcept(
+      std::is_nothrow_move_constructible_v<T>);
+  ~FixedCapacityArray();
+
+  /**
+   * Appends the given element value to the end of the container.
+   * Throws exception if the array is full.
+   * @throw std::length_error
+   */
+  void push_back(const T &value);
+  void push_back(T &&value);
+
+  /**
+   * Constructs a new element in place at the end of the container from the
+   * given arguments.
+   * Throws exception if the array is full.
+   * @throw std::length_error
+   *
+   * @return Reference to the constructed element
+   */
+  template <typename... Args>
+  T &emplace_back(Args &&...args);
+
+  /**
+   * Removes the last element of the container.
+   * Calling pop_back on an empty container throws exception.
+   * @throw std::runtime_error
+   */
+  void pop_back();
+
+  /**
+   * Access element without checking if index is out of bounds
+   */
+  T &operator[](size_t index);
+  const T &operator[](size_t index) const;
+
+  /**
+   * Returns a reference to the last element in the array.
+   */
+  T &back();
+  const T &back() const;
+
+  /**
+   * Returns number of elements in the array
+   */
+  size_t size() const;
+
+  /**
+   * Returns the maximum number of elements, Capacity
+   */
+  static constexpr size_t capacity() { return Capacity; }
+
+  /**
+   * Returns whether the array is empty of elements or not
+   */
+  bool empty() const;
+
+  /**
+   * Destroys all elements
+   */
+  void clear();
+
+ private:
+  T *elements() { return std::launder(reinterpret_cast<T *>(m_buffer)); }
+  const T *elements() const {
+    return std::launder(reinterpret_cast<const T *>(m_buffer));
+  }
+
+  alignas(T) unsigned char m_buffer[Capacity * sizeof(T)];
+  size_t m_currentSize = 0;
+};
+
+template <typename T, size_t Capacity>
+FixedCapacityArray<T, Capacity>::FixedCapacityArray(
+    const FixedCapacityArray &other) {
+  std::uninitialized_copy_n(other.elements(), other.m_currentSize,
+                            elements());
+  m_currentSize = other.m_currentSize;
+}
+
+template <typename T, size_t Capacity>
+FixedCapacityArray<T, Capacity>::FixedCapacityArray(
+    FixedCapacityArray &&other) noexcept(
+    std::is_nothrow_move_constructible_v<T>) {
+  std::uninitialized_move_n(other.elements(), other.m_currentSize,
+                            elements());
+  m_currentSize = other.m_currentSize;
+  other.clear();
+}
+
+template <typename T, size_t Capacity>
+FixedCapacityArray<T, Capacity> &FixedCapacityArray<T, Capacity>::operator=(
+    const FixedCapacityArray &other) {
+  if (this != &other) {
+    clear();
+    std::uninitialized_copy_n(other.elements(), other.m_currentSize,
+                              elements());
+    m_currentSize = other.m_currentSize;
+  }
+
+  return *this;
+}
+
+template <typename T, size_t Capacity>
+FixedCapacityArray<T, Capacity> &FixedCapacityArray<T, Capacity>::operator=(
+    FixedCapacityArray &&other) noexcept(
+    std::is_nothrow_move_constructible_v<T>) {
+  if (this != &other) {
+    clear();
+    std::uninitialized_move_n(other.elements(), other.m_currentSize,
+                              elements());
+    m_currentSize = other.m_currentSize;
+    other.clear();
+  }
+
+  return *this;
+}
+
+template <typename T, size_t Capacity>
+FixedCapacityArray<T, Capacity>::~FixedCapacityArray() {
+  clear();
+}
+
+template <typename T, size_t Capacity>
+void FixedCapacityArray<T, Capacity>::push_back(const T &value) {
+  emplace_back(value);
+}
+
+template <typename T, size_t Capacity>
+void FixedCapacityArray<T, Capacity>::push_back(T &&value) {
+  emplace_back(std::move(value));
+}
+
+template <typename T, size_t Capacity>
+template <typename... Args>
+T &FixedCapacityArray<T, Capacity>::emplace_back(Args &&...args) {
+  if (m_currentSize == Capacity) {
+    throw std::length_error{"Fixed capacity array is full."};
+  }
+
+  T *elem = ::new (static_cast<void *>(elements() + m_currentSize))
+      T(std::forward<Args>(args)...);
+  ++m_currentSize;
+  return *elem;
+}
+
+template <typename T, size_t Capacity>
+void FixedCapacityArray<T, Capacity>::pop_back() {
+  if (empty()) {
+    throw std::runtime_error("Calling pop_back() on an empty container.");
+  }
+
+  --m_currentSize;
+  elements()[m_currentSize].~T();
+}
+
+template <typename T, size_t Capacity>
+T &FixedCapacityArray<T, Capacity>::operator[](size_t index) {
+  return elements()[index];
+}
+
+template <typename T, size_t Capacity>
+const T &FixedCapacityArray<T, Capacity>::operator[](size_t index) const {
+  return elements()[index];
+}
+
+template <typename T, size_t Capacity>
+T &FixedCapacityArray<T, Capacity>::back() {
+  return elements()[m_currentSize - 1];
+}
+
+template <typename T, size_t Capacity>
+const T &FixedCapacityArray<T, Capacity>::back() const {
+  return elements()[m_currentSize - 1];
+}
+
+template <typename T, size_t Capacity>
+size_t FixedCapacityArray<T, Capacity>::size() const {
+  return m_currentSize;
+}
+
+template <typename T, size_t Capacity>
+bool FixedCapacityArray<T, Capacity>::empty() const {
+  return m_currentSize == 0;
+}
+
+template <typename T, size_t Capacity>
+void FixedCapacityArray<T, Capacity>::clear() {
+  std::destroy_n(elements(), m_currentSize);
+  m_currentSize = 0;
+}
+
+#endif
@@ -0,0 +1,210 @@
+#ifndef FIXED_STACK_H
+#define FIXED_STACK_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+/**
+ * Stack of at most N elements, all stored inside the object. It never
+ * allocates and its operations do not check their preconditions in release
+ * builds: pushing to a full stack, or popping or reading an empty one, is
+ * undefined behavior, caught by assert only when NDEBUG is not defined. Every
+ * operation is a fixed handful of instructions, which suits the explicit
+ * stack of a loop replacing recursion of bounded depth.
+ *
+ * Use Stack<T, FixedCapacityArray<T, N>> for the same storage with the
+ * checks of Stack.
+ *
+ * @tparam N Maximum number of elements
+ */
+template <typename T, size_t N>
+class FixedStack {
+  static_assert(N > 0, "Capacity must be positive.");
+
+ public:
+  FixedStack() = default;
+  FixedStack(const FixedStack &);
+  FixedStack(FixedStack &&) noexcept(std::is_nothrow_move_constructible_v<T>);
+  FixedStack &operator=(const FixedStack &);
+  FixedStack &operator=(FixedStack &&) noexcept(
+      std::is_nothrow_move_constructible_v<T>);
+  ~FixedStack();
+
+  /**
+   * The stack must not be full
+   */
+  void push(const T &newElem);
+  void push(T &&newElem);
+
+  template <typename... Args>
+  T &emplace(Args &&...args);
+
+  /**
+   * Pushes the given elements in order; the last one ends on top. There
+   * must be room for all of them.
+   */
+  void push_n(std::span<const T> newElems);
+
+  /**
+   * The stack must not be empty
+   */
+  void pop();
+
+  /**
+   * Moves the top out.size() elements into out, in push order, and removes
+   * them. The stack must have that many elements.
+   */
+  void pop_n(std::span<T> out);
+
+  /**
+   * The stack must not be empty
+   */
+  T &top();
+  const T &top() const;
+
+  /**
+   * Copies the top out.size() elements into out, in push order. The stack
+   * must have that many elements.
+   */
+  void top_n(std::span<T> out) const;
+
+  size_t size() const { return m_currentSize; }
+  bool empty() const { return m_currentSize == 0; }
+  bool full() const { return m_currentSize == N; }
+  static constexpr size_t capacity() { return N; }
+
+ private:
+  T *elements() { return std::launder(reinterpret_cast<T *>(m_buffer)); }
+  const T *elements() const {
+    return std::launder(reinterpret_cast<const T *>(m_buffer));
+  }
+
+  void clear();
+
+  alignas(T) unsigned char m_buffer[N * sizeof(T)];
+  size_t m_currentSize = 0;
+};
+
+template <typename T, size_t N>
+FixedStack<T, N>::FixedStack(const FixedStack &other) {
+  std::uninitialized_copy_n(other.elements(), other.m_currentSize,
+                            elements());
+  m_currentSize = other.m_currentSize;
+}
+
+template <typename T, size_t N>
+FixedStack<T, N>::FixedStack(FixedStack &&other) noexcept(
+    std::is_nothrow_move_constructible_v<T>) {
+  std::uninitialized_move_n(other.elements(), other.m_currentSize,
+                            elements());
+  m_currentSize = other.m_currentSize;
+  other.clear();
+}
+
+template <typename T, size_t N>
+FixedStack<T, N> &FixedStack<T, N>::operator=(const FixedStack &other) {
+  if (this != &other) {
+    clear();
+    std::uninitialized_copy_n(other.elements(), other.m_currentSize,
+                              elements());
+    m_currentSize = other.m_currentSize;
+  }
+
+  return *this;
+}
+
+template <typename T, size_t N>
+FixedStack<T, N> &FixedStack<T, N>::operator=(FixedStack &&other) noexcept(
+    std::is_nothrow_move_constructible_v<T>) {
+  if (this != &other) {
+    clear();
+    std::uninitialized_move_n(other.elements(), other.m_currentSize,
+                              elements());
+    m_currentSize = other.m_currentSize;
+    other.clear();
+  }
+
+  return *this;
+}
+
+template <typename T, size_t N>
+FixedStack<T, N>::~FixedStack() {
+  clear();
+}
+
+template <typename T, size_t N>
+void FixedStack<T, N>::push(const T &newElem) {
+  emplace(newElem);
+}
+
+template <typename T, size_t N>
+void FixedStack<T, N>::push(T &&newElem) {
+  emplace(std::move(newElem));
+}
+
+template <typename T, size_t N>
+template <typename... Args>
+T &FixedStack<T, N>::emplace(Args &&...args) {
+  assert(!full());
+  T *elem = ::new (static_cast<void *>(elements() + m_currentSize))
+      T(std::forward<Args>(args)...);
+  ++m_currentSize;
+  return *elem;
+}
+
+template <typename T, size_t N>
+void FixedStack<T, N>::push_n(std::span<const T> newElems) {
+  assert(newElems.size() <= N - m_currentSize);
+  std::uninitialized_copy(newElems.begin(), newElems.end(),
+                          elements() + m_currentSize);
+  m_currentSize += newElems.size();
+}
+
+template <typename T, size_t N>
+void FixedStack<T, N>::pop() {
+  assert(!empty());
+  --m_currentSize;
+  elements()[m_currentSize].~T();
+}
+
+template <typename T, size_t N>
+void FixedStack<T, N>::pop_n(std::span<T> out) {
+  assert(out.size() <= m_currentSize);
+  T *first = elements() + m_currentSize - out.size();
+  std::move(first, first + out.size(), out.begin());
+  std::destroy_n(first, out.size());
+  m_currentSize -= out.size();
+}
+
+template <typename T, size_t N>
+T &FixedStack<T, N>::top() {
+  assert(!empty());
+  return elements()[m_currentSize - 1];
+}
+
+template <typename T, size_t N>
+const T &FixedStack<T, N>::top() const {
+  assert(!empty());
+  return elements()[m_currentSize - 1];
+}
+
+template <typename T, size_t N>
+void FixedStack<T, N>::top_n(std::span<T> out) const {
+  assert(out.size() <= m_currentSize);
+  const T *first = elements() + m_currentSize - out.size();
+  std::copy_n(first, out.size(), out.begin());
+}
+
+template <typename T, size_t N>
+void FixedStack<T, N>::clear() {
+  std::destroy_n(elements(), m_currentSize);
+  m_currentSize = 0;
+}
+
+#endif
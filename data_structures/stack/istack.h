@@ -2,16 +2,49 @@
 #define ISTACK_H
 
 #include <cstddef>
+#include <span>
 
 template <typename T>
 class IStack {
  public:
+  virtual ~IStack() = default;
+
   virtual void push(const T &newElem) = 0;
   virtual void pop() = 0;
   virtual T &top() = 0;
   virtual const T &top() const = 0;
+
+  // Block versions of push, pop and top: one virtual call for many elements
+  virtual void push_n(std::span<const T> newElems) = 0;
+  virtual void pop_n(std::span<T> out) = 0;
+  virtual void top_n(std::span<T> out) const = 0;
+
   virtual size_t size() const = 0;
   virtual bool empty() const = 0;
 };
 
+/**
+ * Implements IStack by forwarding to a stack resolved at compile time, e.g.
+ * Stack<T, Deque<T>>. Code which takes an IStack works with any storage
+ * chosen at run time, for the price of a virtual call per operation.
+ */
+template <typename T, typename StackType>
+class IStackAdaptor final : public IStack<T> {
+ public:
+  virtual void push(const T &newElem) override { m_stack.push(newElem); }
+  virtual void pop() override { m_stack.pop(); }
+  virtual T &top() override { return m_stack.top(); }
+  virtual const T &top() const override { return m_stack.top(); }
+  virtual void push_n(std::span<const T> newElems) override {
+    m_stack.push_n(newElems);
+  }
+  virtual void pop_n(std::span<T> out) override { m_stack.pop_n(out); }
+  virtual void top_n(std::span<T> out) const override { m_stack.top_n(out); }
+  virtual size_t size() const override { return m_stack.size(); }
+  virtual bool empty() const override { return m_stack.empty(); }
+
+ private:
+  StackType m_stack;
+};
+
 #endif
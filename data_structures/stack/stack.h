@@ -0,0 +1,209 @@
+#ifndef STACK_H
+#define STACK_H
+
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
+#include "../dynamic_array_template/dynamic_array.h"
+
+/**
+ * A container the elements of a Stack can be kept in: it adds and removes
+ * elements at its back. DynamicArray, SmallDynamicArray, Deque,
+ * DoublyLinkedList and FixedCapacityArray all satisfy it.
+ */
+template <typename Storage, typename T>
+concept StackStorage =
+    std::default_initializable<Storage> &&
+    requires(Storage storage, const Storage constStorage, const T &value) {
+      storage.push_back(value);
+      storage.pop_back();
+      { storage.back() } -> std::same_as<T &>;
+      { constStorage.back() } -> std::same_as<const T &>;
+      { constStorage.size() } -> std::convertible_to<size_t>;
+      { constStorage.empty() } -> std::convertible_to<bool>;
+    };
+
+/**
+ * Stack with the interface of IStack, resolved at compile time: there are no
+ * virtual functions, so push, pop and top can be inlined into the caller.
+ * Use IStackAdaptor (istack.h) where the storage has to be chosen at run
+ * time.
+ *
+ * @tparam Storage The container the elements are kept in, see StackStorage
+ */
+template <typename T, StackStorage<T> Storage = DynamicArray<T>>
+class Stack {
+ public:
+  void push(const T &newElem);
+  void push(T &&newElem);
+
+  /**
+   * Pushes the given elements in order, so that the last one ends on top.
+   * Storages which can append a range (DynamicArray) grow once for the whole
+   * block.
+   */
+  void push_n(std::span<const T> newElems);
+
+  /**
+   * Removes the top element.
+   * Calling pop on an empty stack throws exception.
+   * @throw std::runtime_error
+   */
+  void pop();
+
+  /**
+   * Moves the top out.size() elements into out and removes them. out ends in
+   * push order: out.back() receives the top element.
+   * Calling pop_n with more elements than the stack has throws exception.
+   * @throw std::runtime_error
+   */
+  void pop_n(std::span<T> out);
+
+  /**
+   * Returns the top element.
+   * Calling top on an empty stack throws exception.
+   * @throw std::runtime_error
+   */
+  T &top();
+  const T &top() const;
+
+  /**
+   * Copies the top out.size() elements into out, in push order, without
+   * removing them.
+   * Calling top_n with more elements than the stack has throws exception.
+   * @throw std::runtime_error
+   */
+  void top_n(std::span<T> out) const;
+
+  size_t size() const;
+  bool empty() const;
+
+ private:
+  static constexpr bool INDEXABLE =
+      requires(const Storage storage, size_t index) {
+        { storage[index] } -> std::same_as<const T &>;
+      };
+
+  Storage m_storage;
+};
+
+template <typename T, StackStorage<T> Storage>
+void Stack<T, Storage>::push(const T &newElem) {
+  m_storage.push_back(newElem);
+}
+
+template <typename T, StackStorage<T> Storage>
+void Stack<T, Storage>::push(T &&newElem) {
+  m_storage.push_back(std::move(newElem));
+}
+
+template <typename T, StackStorage<T> Storage>
+void Stack<T, Storage>::pop() {
+  // Not every storage checks, e.g. Deque::pop_back on an empty deque is
+  // undefined behavior
+  if (empty()) {
+    throw std::runtime_error{"Calling pop() on an empty stack."};
+  }
+
+  m_storage.pop_back();
+}
+
+template <typename T, StackStorage<T> Storage>
+void Stack<T, Storage>::push_n(std::span<const T> newElems) {
+  if constexpr (requires { m_storage.append(newElems.begin(),
+                                            newElems.end()); }) {
+    m_storage.append(newElems.begin(), newElems.end());
+  } else {
+    for (const T &newElem : newElems) {
+      m_storage.push_back(newElem);
+    }
+  }
+}
+
+template <typename T, StackStorage<T> Storage>
+void Stack<T, Storage>::pop_n(std::span<T> out) {
+  const size_t count = out.size();
+  if (count > size()) {
+    throw std::runtime_error{
+        "Calling pop_n() with more elements than the stack has."};
+  }
+
+  if constexpr (INDEXABLE) {
+    const size_t first = size() - count;
+    for (size_t i = 0; i < count; i++) {
+      out[i] = std::move(m_storage[first + i]);
+    }
+
+    if constexpr (requires { m_storage.erase(m_storage.end() - count,
+                                             m_storage.end()); }) {
+      m_storage.erase(m_storage.end() - count, m_storage.end());
+    } else {
+      for (size_t i = 0; i < count; i++) {
+        m_storage.pop_back();
+      }
+    }
+  } else {
+    for (size_t i = count; i > 0; i--) {
+      out[i - 1] = std::move(m_storage.back());
+      m_storage.pop_back();
+    }
+  }
+}
+
+template <typename T, StackStorage<T> Storage>
+T &Stack<T, Storage>::top() {
+  if (empty()) {
+    throw std::runtime_error{"Trying to access top element of empty stack."};
+  }
+
+  return m_storage.back();
+}
+
+template <typename T, StackStorage<T> Storage>
+const T &Stack<T, Storage>::top() const {
+  if (empty()) {
+    throw std::runtime_error{"Trying to access top element of empty stack."};
+  }
+
+  return m_storage.back();
+}
+
+template <typename T, StackStorage<T> Storage>
+void Stack<T, Storage>::top_n(std::span<T> out) const {
+  const size_t count = out.size();
+  if (count > size()) {
+    throw std::runtime_error{
+        "Calling top_n() with more elements than the stack has."};
+  }
+
+  const size_t first = size() - count;
+  if constexpr (INDEXABLE) {
+    for (size_t i = 0; i < count; i++) {
+      out[i] = m_storage[first + i];
+    }
+  } else {
+    // A list can only be walked from its front
+    auto it = m_storage.begin();
+    for (size_t i = 0; i < first; i++) {
+      ++it;
+    }
+    for (size_t i = 0; i < count; i++, ++it) {
+      out[i] = *it;
+    }
+  }
+}
+
+template <typename T, StackStorage<T> Storage>
+size_t Stack<T, Storage>::size() const {
+  return m_storage.size();
+}
+
+template <typename T, StackStorage<T> Storage>
+bool Stack<T, Storage>::empty() const {
+  return m_storage.empty();
+}
+
+#endif
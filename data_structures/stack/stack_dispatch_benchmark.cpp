@@ -0,0 +1,110 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "../deque/deque.h"
+#include "istack.h"
+#include "stack.h"
+
+/*
+Virtual against static dispatch of the stack operations, in a loop shaped
+like the inner loop of a stack based interpreter: push two operands, pop
+them, push the result, and unwind the stack when it gets deep.
+
+- IStack: the storage is chosen at run time (as it would be from a
+  configuration), so every push, pop and top is an indirect call through the
+  vtable of IStackAdaptor
+- Stack<T, Storage>: the same operations, known at compile time and inlined
+  into the loop
+
+Both are measured over a DynamicArray and over a Deque.
+
+Run:
+$> ./stack_dispatch_benchmark [number of iterations]
+*/
+
+namespace {
+
+template <typename StackType>
+long long interpret(StackType &stack, size_t iterations) {
+  long long result = 0;
+  for (size_t i = 0; i < iterations; i++) {
+    stack.push(static_cast<long long>(i & 1023));
+    stack.push(3);
+
+    const long long rhs = stack.top();
+    stack.pop();
+    const long long lhs = stack.top();
+    stack.pop();
+    stack.push(lhs * rhs);
+
+    if (stack.size() == 64) {
+      while (!stack.empty()) {
+        result += stack.top();
+        stack.pop();
+      }
+    }
+  }
+
+  return result;
+}
+
+std::unique_ptr<IStack<long long>> makeStack(const std::string &storage) {
+  if (storage == "deque") {
+    return std::make_unique<
+        IStackAdaptor<long long, Stack<long long, Deque<long long>>>>();
+  }
+
+  return std::make_unique<IStackAdaptor<long long, Stack<long long>>>();
+}
+
+template <typename Run>
+double millisecondsOf(Run run, long long &result) {
+  const auto start = std::chrono::steady_clock::now();
+  result = run();
+  const auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+template <typename Storage>
+void compare(const std::string &storage, size_t iterations) {
+  long long virtualResult = 0;
+  const double virtualDispatch = millisecondsOf(
+      [&] {
+        std::unique_ptr<IStack<long long>> stack = makeStack(storage);
+        return interpret(*stack, iterations);
+      },
+      virtualResult);
+
+  long long staticResult = 0;
+  const double staticDispatch = millisecondsOf(
+      [&] {
+        Stack<long long, Storage> stack;
+        return interpret(stack, iterations);
+      },
+      staticResult);
+
+  if (virtualResult != staticResult) {
+    std::cerr << "results differ\n";
+    std::exit(1);
+  }
+
+  std::cout << storage << " x " << iterations << '\n'
+            << "  IStack (virtual): " << virtualDispatch << " ms\n"
+            << "  Stack (static): " << staticDispatch << " ms\n"
+            << "  speedup: " << virtualDispatch / staticDispatch << "x\n";
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  const size_t iterations =
+      argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100'000'000;
+
+  compare<DynamicArray<long long>>("dynamic array", iterations);
+  compare<Deque<long long>>("deque", iterations);
+
+  return 0;
+}
@@ -0,0 +1,121 @@
+#include "catch.hpp"
+#include "concurrent_stack.h"
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Concurrent stack pops in LIFO order on a single thread") {
+  ConcurrentStack<std::string> stack;
+  REQUIRE(stack.empty());
+  REQUIRE(stack.pop() == std::nullopt);
+
+  for (int i = 0; i < 100; i++) {
+    stack.push(std::to_string(i));
+  }
+  stack.emplace(3, 'x');
+  REQUIRE(!stack.empty());
+
+  REQUIRE(stack.pop() == "xxx");
+  for (int i = 99; i >= 0; i--) {
+    REQUIRE(stack.pop() == std::to_string(i));
+  }
+  REQUIRE(stack.empty());
+  REQUIRE(stack.pop() == std::nullopt);
+}
+
+TEST_CASE("Concurrent stack destroys the elements left in it") {
+  auto counter = std::make_shared<int>(0);
+  {
+    ConcurrentStack<std::shared_ptr<int>> stack;
+    for (int i = 0; i < 10; i++) {
+      stack.push(counter);
+    }
+    stack.pop();
+    REQUIRE(counter.use_count() == 10);
+  }
+  REQUIRE(counter.use_count() == 1);
+}
+
+TEST_CASE("Concurrent stack pops every pushed element exactly once") {
+  // Small enough to run under ThreadSanitizer in reasonable time
+  constexpr int THREADS = 8;
+  constexpr int PER_THREAD = 20'000;
+
+  ConcurrentStack<int> stack;
+  std::vector<std::vector<int>> popped(THREADS);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < THREADS; t++) {
+    threads.emplace_back([&stack, &popped, t] {
+      // pushes and pops interleave, so that both the head and the
+      // elimination array are contended
+      for (int i = 0; i < PER_THREAD; i++) {
+        stack.push(t * PER_THREAD + i);
+        if (i % 2 == 1) {
+          for (int j = 0; j < 2; j++) {
+            if (std::optional<int> value = stack.pop()) {
+              popped[t].push_back(*value);
+            }
+          }
+        }
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  std::vector<int> seen(THREADS * PER_THREAD, 0);
+  for (const std::vector<int> &values : popped) {
+    for (int value : values) {
+      seen[value]++;
+    }
+  }
+  while (std::optional<int> value = stack.pop()) {
+    seen[*value]++;
+  }
+
+  for (int count : seen) {
+    REQUIRE(count == 1);
+  }
+}
+
+TEST_CASE("Concurrent stack hands every element over exactly once while "
+          "elimination slots are reused") {
+  // Every push is followed by a pop, so that freed nodes are allocated again
+  // at once and offered in the elimination slots again at the same addresses
+  constexpr int THREADS = 8;
+  constexpr int PER_THREAD = 20'000;
+
+  ConcurrentStack<int> stack;
+  std::vector<std::vector<int>> popped(THREADS);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < THREADS; t++) {
+    threads.emplace_back([&stack, &popped, t] {
+      for (int i = 0; i < PER_THREAD; i++) {
+        stack.push(t * PER_THREAD + i);
+        if (std::optional<int> value = stack.pop()) {
+          popped[t].push_back(*value);
+        }
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  std::vector<int> seen(THREADS * PER_THREAD, 0);
+  for (const std::vector<int> &values : popped) {
+    for (int value : values) {
+      seen[value]++;
+    }
+  }
+  while (std::optional<int> value = stack.pop()) {
+    seen[*value]++;
+  }
+
+  for (int count : seen) {
+    REQUIRE(count == 1);
+  }
+}
@@ -1,4 +1,5 @@
 #include "catch.hpp"
+#include "../dynamic_array_template/small_dynamic_array.h"
 #include "stack_dynamic_array.h"
 
 TEST_CASE("Stack is empty on construction with default constructor") {
@@ -39,3 +40,21 @@ TEST_CASE("Push and pop many elements on stack") {
 
   REQUIRE(stack.empty());
 }
+
+TEST_CASE("Stack works over a small dynamic array") {
+  StackDynamicArrayImpl<int, SmallDynamicArray<int, 4>> stack;
+
+  for (size_t i = 1; i <= 100; i++) {
+    stack.push(static_cast<int>(i));
+    REQUIRE(stack.top() == static_cast<int>(i));
+    REQUIRE(stack.size() == i);
+  }
+
+  for (int i = 100; i >= 1; i--) {
+    REQUIRE(stack.top() == i);
+    stack.pop();
+  }
+
+  REQUIRE(stack.empty());
+  REQUIRE_THROWS_AS(stack.top(), std::runtime_error);
+}
@@ -0,0 +1,198 @@
+#include "catch.hpp"
+#include "fixed_capacity_array.h"
+#include "fixed_stack.h"
+#include "istack.h"
+#include "stack.h"
+#include "stack_dynamic_array.h"
+#include "../deque/deque.h"
+#include "../doubly_linked_list/doubly_linked_list.h"
+#include "../dynamic_array_template/small_dynamic_array.h"
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+
+static_assert(StackStorage<DynamicArray<int>, int>);
+static_assert(StackStorage<Deque<int>, int>);
+static_assert(StackStorage<DoublyLinkedList<int>, int>);
+static_assert(StackStorage<FixedCapacityArray<int, 8>, int>);
+static_assert(!StackStorage<DynamicArray<int>, std::string>);
+static_assert(!StackStorage<std::string *, std::string>);
+
+TEMPLATE_TEST_CASE("Stack works over every storage", "", DynamicArray<int>,
+                   (SmallDynamicArray<int, 4>), Deque<int>,
+                   DoublyLinkedList<int>, (FixedCapacityArray<int, 1000>)) {
+  Stack<int, TestType> stack;
+  REQUIRE(stack.empty());
+  REQUIRE_THROWS_AS(stack.top(), std::runtime_error);
+  REQUIRE_THROWS_AS(stack.pop(), std::runtime_error);
+
+  for (size_t i = 1; i <= 1000; i++) {
+    stack.push(static_cast<int>(i));
+    REQUIRE(stack.top() == static_cast<int>(i));
+    REQUIRE(stack.size() == i);
+  }
+
+  const Stack<int, TestType> &constStack = stack;
+  REQUIRE(constStack.top() == 1000);
+
+  for (int i = 1000; i >= 1; i--) {
+    REQUIRE(stack.top() == i);
+    stack.pop();
+  }
+
+  REQUIRE(stack.empty());
+  REQUIRE_THROWS_AS(stack.pop(), std::runtime_error);
+}
+
+TEST_CASE("Stack moves pushed temporaries into the storage") {
+  Stack<std::unique_ptr<int>> stack;
+  stack.push(std::make_unique<int>(5));
+  REQUIRE(*stack.top() == 5);
+
+  Stack<std::string, FixedCapacityArray<std::string, 2>> strings;
+  strings.push(std::string(100, 'x'));
+  REQUIRE(strings.top().size() == 100);
+}
+
+TEST_CASE("Stack over a fixed capacity array throws when it is full") {
+  Stack<int, FixedCapacityArray<int, 3>> stack;
+  stack.push(1);
+  stack.push(2);
+  stack.push(3);
+  REQUIRE_THROWS_AS(stack.push(4), std::length_error);
+  REQUIRE(stack.size() == 3);
+  REQUIRE(stack.top() == 3);
+}
+
+TEST_CASE("Fixed capacity array copies and destroys its elements") {
+  auto counter = std::make_shared<int>(0);
+  {
+    FixedCapacityArray<std::shared_ptr<int>, 4> arr;
+    arr.push_back(counter);
+    arr.push_back(counter);
+
+    FixedCapacityArray<std::shared_ptr<int>, 4> copy{arr};
+    REQUIRE(counter.use_count() == 5);
+
+    FixedCapacityArray<std::shared_ptr<int>, 4> moved{std::move(copy)};
+    REQUIRE(copy.empty());
+    REQUIRE(moved.size() == 2);
+    REQUIRE(counter.use_count() == 5);
+
+    arr = moved;
+    REQUIRE(counter.use_count() == 5);
+    arr.pop_back();
+    REQUIRE(counter.use_count() == 4);
+  }
+  REQUIRE(counter.use_count() == 1);
+}
+
+TEST_CASE("IStack adaptor lets the storage be chosen at run time") {
+  for (bool useDeque : {false, true}) {
+    std::unique_ptr<IStack<int>> stack;
+    if (useDeque) {
+      stack = std::make_unique<IStackAdaptor<int, Stack<int, Deque<int>>>>();
+    } else {
+      stack = std::make_unique<IStackAdaptor<int, Stack<int>>>();
+    }
+
+    for (int i = 0; i < 100; i++) {
+      stack->push(i);
+    }
+    REQUIRE(stack->size() == 100);
+    REQUIRE(stack->top() == 99);
+    stack->pop();
+    REQUIRE(stack->top() == 98);
+  }
+}
+
+TEMPLATE_TEST_CASE("Stack pushes, pops and reads blocks of elements", "",
+                   DynamicArray<int>, (SmallDynamicArray<int, 4>), Deque<int>,
+                   DoublyLinkedList<int>, (FixedCapacityArray<int, 100>)) {
+  Stack<int, TestType> stack;
+  const int block[] = {1, 2, 3, 4, 5, 6, 7};
+  stack.push_n(block);
+  stack.push(8);
+  REQUIRE(stack.size() == 8);
+  REQUIRE(stack.top() == 8);
+
+  int top[3] = {};
+  stack.top_n(top);
+  REQUIRE(top[0] == 6);
+  REQUIRE(top[1] == 7);
+  REQUIRE(top[2] == 8);
+  REQUIRE(stack.size() == 8);
+
+  int popped[5] = {};
+  stack.pop_n(popped);
+  REQUIRE(popped[0] == 4);
+  REQUIRE(popped[4] == 8);
+  REQUIRE(stack.size() == 3);
+  REQUIRE(stack.top() == 3);
+
+  int tooMany[4] = {};
+  REQUIRE_THROWS_AS(stack.pop_n(tooMany), std::runtime_error);
+  REQUIRE_THROWS_AS(stack.top_n(tooMany), std::runtime_error);
+  REQUIRE(stack.size() == 3);
+
+  stack.pop_n(std::span<int>{tooMany, 3});
+  REQUIRE(stack.empty());
+  REQUIRE(tooMany[0] == 1);
+}
+
+TEST_CASE("IStack moves blocks of elements through one call") {
+  std::unique_ptr<IStack<std::string>> stack =
+      std::make_unique<StackDynamicArrayImpl<std::string>>();
+  const std::string words[] = {"a", "b", "c"};
+  stack->push_n(words);
+
+  std::string popped[2];
+  stack->pop_n(popped);
+  REQUIRE(popped[0] == "b");
+  REQUIRE(popped[1] == "c");
+  REQUIRE(stack->top() == "a");
+}
+
+TEST_CASE("Fixed stack keeps its elements inline") {
+  FixedStack<std::string, 8> stack;
+  REQUIRE(stack.empty());
+  REQUIRE(FixedStack<std::string, 8>::capacity() == 8);
+
+  stack.push("a");
+  stack.emplace(3, 'b');
+  const std::string more[] = {"c", "d"};
+  stack.push_n(more);
+  REQUIRE(stack.size() == 4);
+  REQUIRE(stack.top() == "d");
+
+  FixedStack<std::string, 8> copy{stack};
+  std::string popped[3];
+  stack.pop_n(popped);
+  REQUIRE(popped[0] == "bbb");
+  REQUIRE(popped[2] == "d");
+  REQUIRE(stack.top() == "a");
+  stack.pop();
+  REQUIRE(stack.empty());
+
+  std::string top[2];
+  copy.top_n(top);
+  REQUIRE(top[0] == "c");
+  REQUIRE(copy.size() == 4);
+
+  stack = std::move(copy);
+  REQUIRE(stack.size() == 4);
+  REQUIRE(copy.empty());
+  for (int i = 0; i < 4; i++) {
+    stack.push("x");
+  }
+  REQUIRE(stack.full());
+}
+
+TEST_CASE("IStack adaptor works over a fixed stack") {
+  IStackAdaptor<int, FixedStack<int, 16>> stack;
+  stack.push(1);
+  stack.push(2);
+  REQUIRE(stack.top() == 2);
+  REQUIRE(stack.size() == 2);
+}